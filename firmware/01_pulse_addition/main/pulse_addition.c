@@ -19,10 +19,12 @@
 #include "driver/gpio.h"
 #include "driver/pulse_cnt.h"
 #include "esp_timer.h"
+#include "pulse_bench.h"
 
 // Configuration
 #define PULSE_GPIO      4       // GPIO pin for pulse generation
 #define PCNT_HIGH_LIMIT 32767   // Max count before overflow
+#define BENCH_BURST     1000    // Pulses per benchmark iteration, well under the limit
 
 // Handles
 static pcnt_unit_handle_t pcnt_unit = NULL;
@@ -100,6 +102,16 @@ static void clear_count(void) {
     pcnt_unit_clear_count(pcnt_unit);
 }
 
+/**
+ * Benchmark iteration: count a fresh burst of BENCH_BURST pulses
+ */
+static void bench_pulses(void *ctx, uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        clear_count();
+        generate_pulses(BENCH_BURST);
+    }
+}
+
 /**
  * Run a test: generate N pulses, verify PCNT = N
  */
@@ -216,23 +228,20 @@ void app_main(void) {
     
     clear_count();
     int benchmark_pulses = 30000;  // Stay under 32767 limit
-    
-    int64_t start = esp_timer_get_time();
     generate_pulses(benchmark_pulses);
-    int64_t end = esp_timer_get_time();
-    
     int final_count = get_count();
-    float time_ms = (float)(end - start) / 1000.0f;
-    float pulses_per_sec = (float)benchmark_pulses / time_ms * 1000.0f;
     
     printf("\n  Benchmark: %d pulses\n", benchmark_pulses);
-    printf("    Time: %.2f ms\n", time_ms);
-    printf("    Rate: %.0f pulses/second\n", pulses_per_sec);
     printf("    Final count: %d (expected %d)\n", final_count, benchmark_pulses);
     
     bool benchmark_pass = (final_count == benchmark_pulses);
     printf("    Result: %s\n", benchmark_pass ? "PASS" : "FAIL");
     
+    bench_begin("01_pulse_addition");
+    bench_run(&(bench_case_t){ .name = "generate_pulses", .params = "burst=1000",
+                               .unit = "pulses", .work = BENCH_BURST, .fn = bench_pulses });
+    bench_end();
+    
     if (benchmark_pass) {
         tests_passed++;
     }
@@ -16,17 +16,29 @@
  *   weight =  0: send nothing
  * 
  * Hardware setup: Internal loopback (PARLIO output -> PCNT input)
+ *
+ * The argmax over the four dot products can be raced in hardware: the
+ * first counter to reach a threshold freezes the others through ETM.
  */
 
 #include <stdio.h>
+#include <stdint.h>
 #include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "driver/gpio.h"
+#include "driver/gpio_etm.h"
 #include "driver/pulse_cnt.h"
 #include "driver/parlio_tx.h"
+#include "esp_private/etm_interface.h"  // GPIO task channel for the netlist
+#include "soc/soc_etm_source.h"
+#include "esp_attr.h"
+#include "esp_cpu.h"
 #include "esp_timer.h"
 #include "esp_heap_caps.h"
+#include "etm_net.h"                    // pulse_lab component
+#include "net_arena.h"                  // pulse_lab component
+#include "pulse_bench.h"                // pulse_lab component
 
 // ============================================================
 // Configuration
@@ -54,6 +66,14 @@ static const int gpio_neg[NUM_NEURONS] = {GPIO_N0_NEG, GPIO_N1_NEG, GPIO_N2_NEG,
 #define PARLIO_FREQ_HZ      10000000 // 10 MHz
 #define MAX_PATTERN_BYTES   1024
 
+// Winner-take-all argmax (see "Winner-take-all argmax" below)
+#define WTA_GATE_GPIO       18      // driven by ETM; level input of every PCNT channel
+#define WTA_MAX_INPUT       15      // 4-bit inputs
+#define WTA_THRESHOLD       (INPUT_DIM * WTA_MAX_INPUT + 1)     // above any dot product
+#define WTA_RAMP_STEPS      (2 * WTA_THRESHOLD - 1)             // enough from the lowest one
+#define WTA_RAMP_BYTE       0x55    // every neuron's positive channel
+#define ARGMAX_TRIALS       200     // Random cases in the argmax benchmark
+
 // ============================================================
 // Hardware handles
 // ============================================================
@@ -62,7 +82,10 @@ static pcnt_unit_handle_t pcnt_units[NUM_NEURONS] = {NULL};
 static pcnt_channel_handle_t pcnt_ch_pos[NUM_NEURONS] = {NULL};
 static pcnt_channel_handle_t pcnt_ch_neg[NUM_NEURONS] = {NULL};
 static parlio_tx_unit_handle_t parlio_tx = NULL;
+static net_arena_t dma_arena;           // DMA-capable; holds pattern_buffer
 static uint8_t *pattern_buffer = NULL;
+static esp_etm_task_handle_t wta_gate_task = NULL;
+static etm_net_t wta_net;               // pcnt.thresh -> gate set
 
 // ============================================================
 // Ternary weight storage
@@ -76,6 +99,24 @@ typedef struct {
 
 static ternary_weights_t weights[NUM_NEURONS];
 
+// ============================================================
+// Winner latch
+// Written by the PCNT watch callback of the unit(s) that reach
+// WTA_THRESHOLD; the ETM route has frozen the counters by then
+// ============================================================
+
+static volatile uint32_t wta_winners = 0;   // bit n = neuron n reached the threshold
+static volatile int64_t wta_time_us = 0;    // when the first one did
+static volatile uint32_t wta_irqs = 0;      // callback entries, for the argmax benchmark
+
+static bool IRAM_ATTR wta_on_reach(pcnt_unit_handle_t unit, const pcnt_watch_event_data_t *edata,
+                                   void *user_ctx) {
+    wta_irqs++;
+    if (!wta_winners) wta_time_us = esp_timer_get_time();
+    wta_winners |= 1u << (int)(intptr_t)user_ctx;
+    return false;
+}
+
 // ============================================================
 // Hardware initialization
 // ============================================================
@@ -90,6 +131,15 @@ static void init_gpio(void) {
         };
         ESP_ERROR_CHECK(gpio_config(&io_conf));
     }
+
+    // Gate pin: ETM sets it, the PCNT channels read it back
+    gpio_config_t gate_conf = {
+        .pin_bit_mask = 1ULL << WTA_GATE_GPIO,
+        .mode = GPIO_MODE_INPUT_OUTPUT,
+        .pull_down_en = GPIO_PULLDOWN_ENABLE,
+    };
+    ESP_ERROR_CHECK(gpio_config(&gate_conf));
+    ESP_ERROR_CHECK(gpio_set_level(WTA_GATE_GPIO, 0));
 }
 
 static void init_pcnt(void) {
@@ -104,7 +154,7 @@ static void init_pcnt(void) {
         // Channel for positive counts
         pcnt_chan_config_t ch_pos_cfg = {
             .edge_gpio_num = gpio_pos[n],
-            .level_gpio_num = -1,
+            .level_gpio_num = WTA_GATE_GPIO,
         };
         ESP_ERROR_CHECK(pcnt_new_channel(pcnt_units[n], &ch_pos_cfg, &pcnt_ch_pos[n]));
         ESP_ERROR_CHECK(pcnt_channel_set_edge_action(pcnt_ch_pos[n],
@@ -114,13 +164,24 @@ static void init_pcnt(void) {
         // Channel for negative counts
         pcnt_chan_config_t ch_neg_cfg = {
             .edge_gpio_num = gpio_neg[n],
-            .level_gpio_num = -1,
+            .level_gpio_num = WTA_GATE_GPIO,
         };
         ESP_ERROR_CHECK(pcnt_new_channel(pcnt_units[n], &ch_neg_cfg, &pcnt_ch_neg[n]));
         ESP_ERROR_CHECK(pcnt_channel_set_edge_action(pcnt_ch_neg[n],
             PCNT_CHANNEL_EDGE_ACTION_DECREASE,  // Negative channel subtracts!
             PCNT_CHANNEL_EDGE_ACTION_HOLD));
         
+        // Gate high freezes the count (winner-take-all)
+        ESP_ERROR_CHECK(pcnt_channel_set_level_action(pcnt_ch_pos[n],
+            PCNT_CHANNEL_LEVEL_ACTION_HOLD, PCNT_CHANNEL_LEVEL_ACTION_KEEP));
+        ESP_ERROR_CHECK(pcnt_channel_set_level_action(pcnt_ch_neg[n],
+            PCNT_CHANNEL_LEVEL_ACTION_HOLD, PCNT_CHANNEL_LEVEL_ACTION_KEEP));
+        
+        // Watch point out of reach of any dot product
+        pcnt_event_callbacks_t cbs = { .on_reach = wta_on_reach };
+        ESP_ERROR_CHECK(pcnt_unit_register_event_callbacks(pcnt_units[n], &cbs, (void *)(intptr_t)n));
+        ESP_ERROR_CHECK(pcnt_unit_add_watch_point(pcnt_units[n], WTA_THRESHOLD));
+        
         // Enable and start
         ESP_ERROR_CHECK(pcnt_unit_enable(pcnt_units[n]));
         ESP_ERROR_CHECK(pcnt_unit_clear_count(pcnt_units[n]));
@@ -153,9 +214,25 @@ static void init_parlio(void) {
     ESP_ERROR_CHECK(parlio_new_tx_unit(&cfg, &parlio_tx));
     ESP_ERROR_CHECK(parlio_tx_unit_enable(parlio_tx));
     
-    // Allocate DMA buffer
-    pattern_buffer = heap_caps_aligned_alloc(4, MAX_PATTERN_BYTES, 
-                                              MALLOC_CAP_DMA | MALLOC_CAP_8BIT);
+    // DMA buffer, cache-line aligned, from an arena sized for it
+    ESP_ERROR_CHECK(net_arena_init(&dma_arena, MAX_PATTERN_BYTES, MALLOC_CAP_DMA | MALLOC_CAP_8BIT)
+                    ? ESP_ERR_NO_MEM : ESP_OK);
+    pattern_buffer = net_arena_alloc(&dma_arena, MAX_PATTERN_BYTES);
+    ESP_ERROR_CHECK(pattern_buffer ? ESP_OK : ESP_ERR_NO_MEM);
+}
+
+static void init_wta_route(void) {
+    gpio_etm_task_config_t task_cfg = { .action = GPIO_ETM_TASK_ACTION_SET };
+    ESP_ERROR_CHECK(gpio_new_etm_task(&task_cfg, &wta_gate_task));
+    ESP_ERROR_CHECK(gpio_etm_task_add_gpio(wta_gate_task, WTA_GATE_GPIO));
+    
+    // PCNT events have no IDF handle: name the edge in a netlist, which
+    // takes a free channel from the allocator
+    char set[ETM_NET_NAME_LEN];
+    snprintf(set, sizeof(set), "gpio.ch%d.set", (int)(wta_gate_task->task_id - GPIO_TASK_CH0_SET));
+    etm_net_init(&wta_net, "wta");
+    ESP_ERROR_CHECK(etm_net_connect(&wta_net, "pcnt.thresh", set, ETM_CHANNEL_AUTO));
+    ESP_ERROR_CHECK(etm_net_load(&wta_net));
 }
 
 // ============================================================
@@ -168,9 +245,12 @@ static void clear_counts(void) {
     }
 }
 
+static uint32_t counter_reads = 0;  // pcnt_unit_get_count() calls, for the argmax benchmark
+
 static void get_counts(int *results) {
     for (int n = 0; n < NUM_NEURONS; n++) {
         pcnt_unit_get_count(pcnt_units[n], &results[n]);
+        counter_reads++;
     }
 }
 
@@ -240,6 +320,98 @@ static void parallel_dot(const uint8_t *inputs, int *results) {
     get_counts(results);
 }
 
+// ============================================================
+// Winner-take-all argmax
+// ============================================================
+//
+// Reading four counters and comparing them costs four driver calls after
+// the transfer. Instead, race them: after the dot product the pattern
+// carries a ramp that pulses every positive channel together, so the
+// counters keep their order and the largest reaches WTA_THRESHOLD first.
+// Its watch point raises the PCNT threshold event:
+//
+//   PCNT threshold --ETM--> GPIO SET gate pin --> every PCNT channel: HOLD
+//
+// ETM has no task that stops PARLIO on the C6, so the ramp runs to its end
+// and the gate freezes the counters instead. The gate must close within
+// one ramp step (200 ns at 10 MHz). Neurons tied for the maximum reach
+// the threshold on the same step and latch together.
+
+#ifdef PULSE_LAB_HOST
+#define CPU_CLOCK_UNIT      "TSC ticks"     // esp_cpu.h shim: the host's own counter
+#else
+#define CPU_CLOCK_UNIT      "cycles"
+#endif
+
+typedef struct {
+    int64_t known_us;       // transfer start -> argmax available to software
+    uint32_t cpu_cycles;    // CPU spent finding it once the transfer is done
+    uint32_t reads;         // pcnt_unit_get_count() calls
+    uint32_t irqs;          // wta_on_reach() entries
+} argmax_timing_t;
+
+static int first_max(const int *values) {
+    int best = 0;
+    for (int n = 1; n < NUM_NEURONS; n++) {
+        if (values[n] > values[best]) best = n;
+    }
+    return best;
+}
+
+static int read_compare_argmax(const uint8_t *inputs, argmax_timing_t *t) {
+    int results[NUM_NEURONS];
+    clear_counts();
+    int pattern_len = generate_pattern(inputs);
+    uint32_t reads = counter_reads, irqs = wta_irqs;
+    int64_t start = esp_timer_get_time();
+    transmit_pattern(pattern_len);
+    uint32_t c0 = esp_cpu_get_cycle_count();
+    get_counts(results);
+    int winner = first_max(results);
+    uint32_t c1 = esp_cpu_get_cycle_count();
+    t->known_us = esp_timer_get_time() - start;
+    t->cpu_cycles = c1 - c0;
+    t->reads = counter_reads - reads;
+    t->irqs = wta_irqs - irqs;
+    return winner;
+}
+
+// Take the route down, reopen the gate and zero the counters a race left
+// frozen
+static void wta_release(void) {
+    etm_net_unload(&wta_net);
+    ESP_ERROR_CHECK(gpio_set_level(WTA_GATE_GPIO, 0));
+    clear_counts();
+}
+
+/**
+ * Argmax by race: the dot product, then the ramp. Returns the winner
+ * (lowest index on a tie) or -1. The counters stay frozen, so callers
+ * may read them, until wta_release().
+ */
+static int wta_argmax(const uint8_t *inputs, argmax_timing_t *t) {
+    wta_release();
+    ESP_ERROR_CHECK(etm_net_load(&wta_net));
+    wta_winners = 0;
+    int pattern_len = generate_pattern(inputs);
+    for (int s = 0; s < WTA_RAMP_STEPS; s++) {
+        pattern_buffer[pattern_len++] = WTA_RAMP_BYTE;
+        pattern_buffer[pattern_len++] = 0x00;
+    }
+    uint32_t reads = counter_reads, irqs = wta_irqs;
+    int64_t start = esp_timer_get_time();
+    transmit_pattern(pattern_len);
+    uint32_t c0 = esp_cpu_get_cycle_count();
+    uint32_t winners = wta_winners;
+    int winner = winners ? __builtin_ctz(winners) : -1;
+    uint32_t c1 = esp_cpu_get_cycle_count();
+    t->known_us = winners ? wta_time_us - start : esp_timer_get_time() - start;
+    t->cpu_cycles = c1 - c0;
+    t->reads = counter_reads - reads;
+    t->irqs = wta_irqs - irqs;
+    return winner;
+}
+
 // ============================================================
 // Reference implementation (for verification)
 // ============================================================
@@ -316,6 +488,84 @@ static bool run_verification_test(const char *name, const uint8_t *inputs) {
     return all_pass;
 }
 
+// Neuron n = x[n] - x[n+1]: unlike the demo set, whose neuron 0 is
+// never beaten (neuron 1 is its negation), any neuron can win
+static const ternary_weights_t wta_selector_weights[NUM_NEURONS] = {
+    { .pos_mask = 0x01, .neg_mask = 0x02 },
+    { .pos_mask = 0x02, .neg_mask = 0x04 },
+    { .pos_mask = 0x04, .neg_mask = 0x08 },
+    { .pos_mask = 0x08, .neg_mask = 0x01 },
+};
+
+/**
+ * Race each input to the threshold under weight set `w`. The winner must
+ * be the reference first maximum, every neuron tied for the maximum must
+ * have latched, and the frozen counts must sit exactly (threshold - max)
+ * ramp steps above the dot products: nobody counted past the gate.
+ */
+static bool run_wta_rows(const char *label, const ternary_weights_t *w,
+                         const uint8_t tests[][INPUT_DIM], int num_tests) {
+    memcpy(weights, w, sizeof(weights));
+    printf("    %s\n", label);
+    
+    bool all_pass = true;
+    for (int t = 0; t < num_tests; t++) {
+        const uint8_t *in = tests[t];
+        int ref[NUM_NEURONS], frozen[NUM_NEURONS];
+        for (int n = 0; n < NUM_NEURONS; n++) {
+            reference_dot(in, &weights[n], &ref[n]);
+        }
+        int ref_winner = first_max(ref);
+        uint32_t ref_tied = 0;
+        for (int n = 0; n < NUM_NEURONS; n++) {
+            if (ref[n] == ref[ref_winner]) ref_tied |= 1u << n;
+        }
+        
+        argmax_timing_t timing;
+        int winner = wta_argmax(in, &timing);
+        uint32_t latched = wta_winners;
+        get_counts(frozen);
+        
+        int steps = WTA_THRESHOLD - ref[ref_winner];
+        bool match = (winner == ref_winner && latched == ref_tied);
+        for (int n = 0; n < NUM_NEURONS; n++) {
+            if (frozen[n] != ref[n] + steps) match = false;
+        }
+        if (!match) all_pass = false;
+        printf("    [%2d,%2d,%2d,%2d] | %3d %3d %3d %3d  |  %d  |  %2d  |   0x%lx   | %3d %3d %3d %3d  |  %s\n",
+               in[0], in[1], in[2], in[3], ref[0], ref[1], ref[2], ref[3],
+               ref_winner, winner, (unsigned long)latched,
+               frozen[0], frozen[1], frozen[2], frozen[3], match ? "OK" : "FAIL");
+    }
+    wta_release();
+    return all_pass;
+}
+
+static bool run_wta_test(const uint8_t demo_tests[][INPUT_DIM], int num_demo,
+                         const uint8_t selector_tests[][INPUT_DIM], int num_selector) {
+    printf("\n  Test 6: Winner-take-all argmax (threshold %d)\n", WTA_THRESHOLD);
+    printf("    Input         | Dot products     | Ref | Race | Latched | Frozen counts    | Match\n");
+    printf("    --------------+------------------+-----+------+---------+------------------+------\n");
+    
+    ternary_weights_t demo[NUM_NEURONS];
+    memcpy(demo, weights, sizeof(demo));
+    bool all_pass = run_wta_rows("Demo weights", demo, demo_tests, num_demo);
+    all_pass &= run_wta_rows("Selector weights x[n] - x[n+1]", wta_selector_weights,
+                             selector_tests, num_selector);
+    memcpy(weights, demo, sizeof(weights));
+    
+    printf("    Result: %s\n", all_pass ? "PASS" : "FAIL");
+    return all_pass;
+}
+
+static void bench_dot(void *ctx, uint32_t iterations) {
+    const uint8_t *inputs = ctx;
+    int results[NUM_NEURONS];
+    for (uint32_t i = 0; i < iterations; i++) {
+        parallel_dot(inputs, results);
+    }
+}
+
 static void run_benchmark(void) {
     printf("\n");
     printf("----------------------------------------------------------------------\n");
@@ -323,25 +573,100 @@ static void run_benchmark(void) {
     printf("----------------------------------------------------------------------\n");
     
     uint8_t inputs[INPUT_DIM] = {8, 8, 8, 8};
-    int results[NUM_NEURONS];
-    int iterations = 1000;
     
-    int64_t start = esp_timer_get_time();
-    for (int i = 0; i < iterations; i++) {
-        parallel_dot(inputs, results);
+    bench_begin("02_parallel_dot");
+    bench_result_t r = bench_run(&(bench_case_t){
+        .name = "parallel_dot", .params = "neurons=4,input=8",
+        .unit = "dots", .fn = bench_dot, .ctx = inputs,
+    });
+    bench_end();
+    
+    printf("  Note: Each 'dot product' computes 4 neurons in PARALLEL.\n");
+    printf("  Effective rate: %.0f neuron-updates/second\n", r.throughput * NUM_NEURONS);
+    printf("  Pattern memory: %zu-byte DMA arena, %lu allocations, peak %zu bytes\n",
+           dma_arena.capacity, (unsigned long)dma_arena.allocs, dma_arena.peak);
+}
+
+static bool run_argmax_benchmark(void) {
+    printf("\n");
+    printf("----------------------------------------------------------------------\n");
+    printf("  BENCHMARK: Argmax - Read and Compare vs Race to Threshold\n");
+    printf("----------------------------------------------------------------------\n");
+    
+    const int trials = ARGMAX_TRIALS;
+    static double rc_ns[ARGMAX_TRIALS], wta_ns[ARGMAX_TRIALS];
+    uint32_t seed = 12345;
+    int rc_ok = 0, wta_ok = 0, ties = 0;
+    int64_t rc_known = 0, wta_known = 0;
+    uint64_t rc_cpu = 0, wta_cpu = 0;
+    uint32_t rc_reads = 0, rc_irqs = 0, wta_reads = 0, wta_irqs_total = 0;
+    
+    // Random weights too: with the test set, neuron 0 always wins
+    for (int i = 0; i < trials; i++) {
+        uint8_t inputs[INPUT_DIM];
+        for (int j = 0; j < INPUT_DIM; j++) {
+            seed = seed * 1103515245 + 12345;
+            inputs[j] = (seed >> 16) % (WTA_MAX_INPUT + 1);
+        }
+        for (int n = 0; n < NUM_NEURONS; n++) {
+            seed = seed * 1103515245 + 12345;
+            uint32_t pos = (seed >> 16) & 0x0F;
+            weights[n].pos_mask = pos;
+            weights[n].neg_mask = (seed >> 20) & 0x0F & ~pos;
+        }
+        int ref[NUM_NEURONS];
+        for (int n = 0; n < NUM_NEURONS; n++) {
+            reference_dot(inputs, &weights[n], &ref[n]);
+        }
+        int ref_winner = first_max(ref);
+        for (int n = ref_winner + 1; n < NUM_NEURONS; n++) {
+            if (ref[n] == ref[ref_winner]) { ties++; break; }
+        }
+        
+        argmax_timing_t t;
+        if (read_compare_argmax(inputs, &t) == ref_winner) rc_ok++;
+        rc_known += t.known_us;
+        rc_cpu += t.cpu_cycles;
+        rc_reads += t.reads;
+        rc_irqs += t.irqs;
+        rc_ns[i] = t.known_us * 1e3;
+        if (wta_argmax(inputs, &t) == ref_winner) wta_ok++;
+        wta_known += t.known_us;
+        wta_cpu += t.cpu_cycles;
+        wta_reads += t.reads;
+        wta_irqs_total += t.irqs;
+        wta_ns[i] = t.known_us * 1e3;
+        wta_release();
     }
-    int64_t end = esp_timer_get_time();
-    
-    float total_ms = (float)(end - start) / 1000.0f;
-    float per_dot_us = (float)(end - start) / iterations;
-    float dots_per_sec = 1000000.0f / per_dot_us;
-    
-    printf("\n  %d iterations completed\n", iterations);
-    printf("  Total time: %.2f ms\n", total_ms);
-    printf("  Per dot product: %.1f us\n", per_dot_us);
-    printf("  Throughput: %.0f dot products/second\n", dots_per_sec);
-    printf("\n  Note: Each 'dot product' computes 4 neurons in PARALLEL.\n");
-    printf("  Effective rate: %.0f neuron-updates/second\n", dots_per_sec * NUM_NEURONS);
+    init_test_weights();
+    
+    printf("\n  %d random weights and inputs in [0, %d], %d with a tied maximum\n", trials, WTA_MAX_INPUT, ties);
+    printf("\n  Per trial (mean), argmax CPU in %s:\n", CPU_CLOCK_UNIT);
+    printf("\n  Method           | Correct | Known at | Argmax CPU | Counter reads | IRQs\n");
+    printf("  -----------------+---------+----------+------------+---------------+-----\n");
+    printf("  Read and compare | %3d/%3d | %5.1f us | %10.1f | %13.2f | %4.2f\n",
+           rc_ok, trials, (float)rc_known / trials, (float)rc_cpu / trials,
+           (float)rc_reads / trials, (float)rc_irqs / trials);
+    printf("  Race (ETM gate)  | %3d/%3d | %5.1f us | %10.1f | %13.2f | %4.2f\n",
+           wta_ok, trials, (float)wta_known / trials, (float)wta_cpu / trials,
+           (float)wta_reads / trials, (float)wta_irqs_total / trials);
+    printf("\n  Known at: from transfer start. The race also runs the ramp, up to\n");
+    printf("  %d steps (%.1f us), but no counter is read: the CPU is free until\n",
+           WTA_RAMP_STEPS, WTA_RAMP_STEPS * 2 * 1e6f / PARLIO_FREQ_HZ);
+    printf("  the winners' interrupts (one per unit tied at the maximum), and the\n");
+    printf("  frozen counts hold the margins.\n");
+    
+    // Per-trial "known at" distributions
+    bench_begin("02_parallel_dot");
+    bench_samples(&(bench_case_t){ .name = "argmax_known", .params = "method=read_compare" },
+                  rc_ns, trials, 1);
+    bench_samples(&(bench_case_t){ .name = "argmax_known", .params = "method=race" },
+                  wta_ns, trials, 1);
+    bench_end();
+    
+    bool pass = (rc_ok == trials && wta_ok == trials);
+    printf("\n  Result: %s\n", pass ? "PASS" : "FAIL");
+    return pass;
 }
 
 // ============================================================
@@ -366,6 +691,7 @@ void app_main(void) {
     init_gpio();
     init_pcnt();
     init_parlio();
+    init_wta_route();
     init_test_weights();
     printf("  Ready.\n");
     
@@ -397,10 +723,22 @@ void app_main(void) {
     uint8_t test5[] = {15, 15, 15, 15};
     tests_total++; if (run_verification_test("Test 5: Max input [15,15,15,15]", test5)) tests_passed++;
     
+    const uint8_t wta_tests[][INPUT_DIM] = {
+        {1, 1, 1, 1}, {10, 10, 10, 10}, {15, 0, 15, 0}, {1, 2, 3, 4}, {15, 15, 15, 15}, {0, 9, 0, 2},
+    };
+    // Neuron 1, 2 and 3 wins, then a 1/3 tie
+    const uint8_t wta_selector_tests[][INPUT_DIM] = {
+        {5, 9, 0, 3}, {0, 0, 12, 1}, {0, 4, 2, 15}, {0, 7, 0, 7},
+    };
+    tests_total++; if (run_wta_test(wta_tests, sizeof(wta_tests) / sizeof(wta_tests[0]),
+                                    wta_selector_tests,
+                                    sizeof(wta_selector_tests) / sizeof(wta_selector_tests[0]))) tests_passed++;
+    
     // ========================================
-    // Benchmark
+    // Benchmarks
     // ========================================
     run_benchmark();
+    tests_total++; if (run_argmax_benchmark()) tests_passed++;
     
     // ========================================
     // Summary
@@ -421,6 +759,7 @@ void app_main(void) {
         printf("    2. Ternary weights: +1 adds, -1 subtracts, 0 skips\n");
         printf("    3. Hardware matches reference implementation exactly\n");
         printf("    4. PARLIO + PCNT = parallel accumulation\n");
+        printf("    5. Argmax by race: first counter to the threshold wins via ETM\n");
         printf("\n");
         printf("  This is the foundation of neural network inference.\n");
         printf("  Next: 03_spectral_oscillator - add phase dynamics.\n");
@@ -431,6 +770,9 @@ void app_main(void) {
     printf("\n");
     printf("======================================================================\n");
     
+#ifdef PULSE_LAB_HOST
+    return;
+#endif
     while (1) {
         vTaskDelay(pdMS_TO_TICKS(1000));
     }
@@ -0,0 +1,582 @@
+/**
+ * spectral_net.c - Q15 oscillator network of demo 03
+ *
+ * See spectral_net.h. Moved out of spectral_oscillator.c unchanged apart
+ * from the explicit network pointer; the host attractor search in
+ * host/falsify/q15_cycles.c steps the same code.
+ */
+
+#include <math.h>
+#include "spectral_net.h"
+#include "pulse_stages.h"            // pulse_lab component
+
+// Band characteristics
+const float BAND_DECAY[NUM_BANDS] = { 0.98f, 0.90f, 0.70f, 0.30f };
+const float BAND_FREQ[NUM_BANDS] = { 0.1f, 0.3f, 1.0f, 3.0f };
+
+const spectral_feedback_t SPECTRAL_FEEDBACK = {
+    .high_threshold = COHERENCE_HIGH_THRESHOLD,
+    .low_threshold = COHERENCE_LOW_THRESHOLD,
+    .decay = COUPLING_DECAY,
+    .growth = COUPLING_GROWTH,
+    .min = COUPLING_MIN,
+    .max = COUPLING_MAX,
+};
+
+// ============================================================
+// Q15 Fixed-Point Math
+// ============================================================
+
+// Trig lookup tables (256 entries = ~1.4 degree resolution)
+#define TRIG_TABLE_SIZE     256
+static int16_t sin_table[TRIG_TABLE_SIZE];
+static int16_t cos_table[TRIG_TABLE_SIZE];
+
+void spectral_init_tables(void) {
+    for (int i = 0; i < TRIG_TABLE_SIZE; i++) {
+        float angle = (2.0f * M_PI * i) / TRIG_TABLE_SIZE;
+        sin_table[i] = (int16_t)(sinf(angle) * Q15_ONE);
+        cos_table[i] = (int16_t)(cosf(angle) * Q15_ONE);
+    }
+}
+
+static inline int16_t q15_sin(uint8_t angle_idx) { return sin_table[angle_idx]; }
+static inline int16_t q15_cos(uint8_t angle_idx) { return cos_table[angle_idx]; }
+static inline int16_t q15_mul(int16_t a, int16_t b) {
+    return (int16_t)(((int32_t)a * b) >> 15);
+}
+
+// ============================================================
+// Phase extraction (atan2 approximation)
+// ============================================================
+
+uint8_t spectral_phase_idx(const complex_q15_t *z) {
+    int16_t r = z->real;
+    int16_t i = z->imag;
+
+    int quadrant = 0;
+    if (r < 0) { r = -r; quadrant |= 2; }
+    if (i < 0) { i = -i; quadrant |= 1; }
+
+    int angle;
+    if (r > i) {
+        angle = (i * 32) / (r + 1);
+    } else {
+        angle = 64 - (r * 32) / (i + 1);
+    }
+
+    switch (quadrant) {
+        case 0: return angle;
+        case 2: return 128 - angle;
+        case 3: return 128 + angle;
+        case 1: return 256 - angle;
+    }
+    return 0;
+}
+
+int16_t spectral_magnitude(const complex_q15_t *z) {
+    int32_t r = z->real;
+    int32_t i = z->imag;
+    if (r < 0) r = -r;
+    if (i < 0) i = -i;
+    // Fast approximation: max + 0.4*min
+    if (r > i) {
+        return (int16_t)(r + ((i * 13) >> 5));
+    } else {
+        return (int16_t)(i + ((r * 13) >> 5));
+    }
+}
+
+// ============================================================
+// Initialization
+// ============================================================
+
+void spectral_set_phase(spectral_network_t *net, int b, int n, uint8_t phase) {
+    net->oscillator[b][n].real = q15_cos(phase);
+    net->oscillator[b][n].imag = q15_sin(phase);
+}
+
+void spectral_init(spectral_network_t *net, float coupling_strength, uint32_t seed) {
+    net_rng_t rng = net_rng_lcg(seed);
+    spectral_init_rng(net, coupling_strength, &rng);
+}
+
+void spectral_init_rng(spectral_network_t *net, float coupling_strength, net_rng_t *rng) {
+    for (int b = 0; b < NUM_BANDS; b++) {
+        for (int n = 0; n < NEURONS_PER_BAND; n++) {
+            // Random initial phase
+            spectral_set_phase(net, b, n, net_rng_next(rng) & 0xFF);
+            net->phase_velocity[b][n] = (int16_t)(BAND_FREQ[b] * 1000);
+
+            // Random ternary input weights
+            net->input_pos_mask[b][n] = 0;
+            net->input_neg_mask[b][n] = 0;
+            for (int i = 0; i < INPUT_DIM; i++) {
+                int r = net_rng_next(rng) % 3;
+                if (r == 0) net->input_pos_mask[b][n] |= (1 << i);
+                else if (r == 1) net->input_neg_mask[b][n] |= (1 << i);
+            }
+        }
+    }
+
+    // Initialize coupling matrix
+    for (int i = 0; i < NUM_BANDS; i++) {
+        for (int j = 0; j < NUM_BANDS; j++) {
+            if (i == j) {
+                net->coupling[i][j] = 0.0f;
+            } else {
+                net->coupling[i][j] = coupling_strength;
+            }
+        }
+    }
+
+    net->coherence = 0;
+}
+
+// ============================================================
+// Single Evolution Step
+// ============================================================
+
+STAGE_SET(spectral_step_stages, "spectral_step",
+          "inject", "rotate+decay", "coupling", "coherence");
+
+void spectral_step(spectral_network_t *net, const uint8_t *input) {
+    STAGE_BEGIN();
+
+    // 1. Inject input energy
+    for (int b = 0; b < NUM_BANDS; b++) {
+        for (int n = 0; n < NEURONS_PER_BAND; n++) {
+            int energy = 0;
+            for (int i = 0; i < INPUT_DIM; i++) {
+                if (net->input_pos_mask[b][n] & (1 << i)) energy += input[i];
+                if (net->input_neg_mask[b][n] & (1 << i)) energy -= input[i];
+            }
+
+            // Only inject if magnitude is low (prevents runaway)
+            int16_t mag = spectral_magnitude(&net->oscillator[b][n]);
+            if (mag < Q15_HALF) {
+                net->oscillator[b][n].real += energy * 50;
+                net->oscillator[b][n].imag += energy * 25;
+            }
+        }
+    }
+    STAGE_END(spectral_step_stages, 0);
+
+    // 2. Rotate oscillators (phase advance)
+    for (int b = 0; b < NUM_BANDS; b++) {
+        for (int n = 0; n < NEURONS_PER_BAND; n++) {
+            uint8_t angle_idx = (uint8_t)((net->phase_velocity[b][n] >> 8) & 0xFF);
+            int16_t c = q15_cos(angle_idx);
+            int16_t s = q15_sin(angle_idx);
+
+            // z_new = z * e^(i*angle) = (r+ij)(c+is) = (rc-is) + i(rs+ic)
+            int16_t new_real = q15_mul(net->oscillator[b][n].real, c)
+                             - q15_mul(net->oscillator[b][n].imag, s);
+            int16_t new_imag = q15_mul(net->oscillator[b][n].real, s)
+                             + q15_mul(net->oscillator[b][n].imag, c);
+
+            // Apply decay
+            int16_t decay_q15 = (int16_t)(BAND_DECAY[b] * Q15_ONE);
+            net->oscillator[b][n].real = q15_mul(new_real, decay_q15);
+            net->oscillator[b][n].imag = q15_mul(new_imag, decay_q15);
+        }
+    }
+    STAGE_END(spectral_step_stages, 1);
+
+    // 3. Kuramoto coupling: bands influence each other's phase velocities
+    int32_t velocity_delta[NUM_BANDS][NEURONS_PER_BAND] = {0};
+
+    for (int src = 0; src < NUM_BANDS; src++) {
+        for (int dst = 0; dst < NUM_BANDS; dst++) {
+            if (src == dst) continue;
+            float strength = net->coupling[src][dst];
+            if (strength < 0.01f) continue;
+
+            // Compute average phase difference
+            int32_t phase_diff_sum = 0;
+            for (int n = 0; n < NEURONS_PER_BAND; n++) {
+                uint8_t src_phase = spectral_phase_idx(&net->oscillator[src][n]);
+                uint8_t dst_phase = spectral_phase_idx(&net->oscillator[dst][n]);
+                int diff = (int)src_phase - (int)dst_phase;
+                while (diff > 127) diff -= 256;
+                while (diff < -128) diff += 256;
+                phase_diff_sum += diff;
+            }
+            int avg_diff = phase_diff_sum / NEURONS_PER_BAND;
+
+            // Pull destination toward source
+            int16_t pull = (int16_t)(strength * avg_diff * 10);
+            for (int n = 0; n < NEURONS_PER_BAND; n++) {
+                velocity_delta[dst][n] += pull;
+            }
+        }
+    }
+
+    // Apply velocity changes
+    for (int b = 0; b < NUM_BANDS; b++) {
+        for (int n = 0; n < NEURONS_PER_BAND; n++) {
+            net->phase_velocity[b][n] += velocity_delta[b][n] / 10;
+            // Clamp
+            if (net->phase_velocity[b][n] > 10000) net->phase_velocity[b][n] = 10000;
+            if (net->phase_velocity[b][n] < -10000) net->phase_velocity[b][n] = -10000;
+        }
+    }
+    STAGE_END(spectral_step_stages, 2);
+
+    // 4. Compute global coherence (Kuramoto order parameter)
+    // coherence = |mean(e^(i*phase))| = |mean(z/|z|)|
+    // This measures PHASE alignment, independent of magnitude
+    int32_t sum_real = 0, sum_imag = 0;
+    int valid_count = 0;
+    for (int b = 0; b < NUM_BANDS; b++) {
+        for (int n = 0; n < NEURONS_PER_BAND; n++) {
+            int16_t mag = spectral_magnitude(&net->oscillator[b][n]);
+            if (mag > 100) {  // Only count oscillators with meaningful magnitude
+                // Normalize to unit vector: z/|z|
+                // Scale to Q15: (real * 32767) / mag
+                int32_t norm_real = ((int32_t)net->oscillator[b][n].real * Q15_ONE) / mag;
+                int32_t norm_imag = ((int32_t)net->oscillator[b][n].imag * Q15_ONE) / mag;
+                sum_real += norm_real;
+                sum_imag += norm_imag;
+                valid_count++;
+            }
+        }
+    }
+    if (valid_count > 0) {
+        sum_real /= valid_count;
+        sum_imag /= valid_count;
+        complex_q15_t avg = { .real = (int16_t)sum_real, .imag = (int16_t)sum_imag };
+        net->coherence = spectral_magnitude(&avg);
+    } else {
+        net->coherence = 0;
+    }
+    STAGE_END(spectral_step_stages, 3);
+}
+
+// ============================================================
+// Evolution Step WITH Coherence Feedback
+// ============================================================
+
+void spectral_step_feedback(spectral_network_t *net, const uint8_t *input) {
+    spectral_step_feedback_with(net, input, &SPECTRAL_FEEDBACK);
+}
+
+void spectral_step_feedback_with(spectral_network_t *net, const uint8_t *input,
+                                 const spectral_feedback_t *fb) {
+    // First, do normal evolution
+    spectral_step(net, input);
+
+    // Then, modulate coupling based on coherence
+    // High coherence -> reduce coupling (prevent over-synchronization)
+    // Low coherence -> increase coupling (encourage coordination)
+
+    float modifier = 1.0f;
+
+    if (net->coherence > fb->high_threshold) {
+        // Too synchronized - reduce coupling
+        modifier = fb->decay;
+    } else if (net->coherence < fb->low_threshold) {
+        // Too desynchronized - increase coupling
+        modifier = fb->growth;
+    }
+
+    // Apply to all cross-band couplings
+    for (int i = 0; i < NUM_BANDS; i++) {
+        for (int j = 0; j < NUM_BANDS; j++) {
+            if (i != j) {
+                net->coupling[i][j] *= modifier;
+
+                // Clamp to valid range
+                if (net->coupling[i][j] < fb->min) {
+                    net->coupling[i][j] = fb->min;
+                }
+                if (net->coupling[i][j] > fb->max) {
+                    net->coupling[i][j] = fb->max;
+                }
+            }
+        }
+    }
+}
+
+// Get average coupling strength (for reporting)
+float spectral_avg_coupling(const spectral_network_t *net) {
+    float sum = 0.0f;
+    int count = 0;
+    for (int i = 0; i < NUM_BANDS; i++) {
+        for (int j = 0; j < NUM_BANDS; j++) {
+            if (i != j) {
+                sum += net->coupling[i][j];
+                count++;
+            }
+        }
+    }
+    return sum / count;
+}
+
+int16_t spectral_band_coherence(const spectral_network_t *net, int band) {
+    // Measure phase coherence within a single band
+    int32_t sum_real = 0, sum_imag = 0;
+    int valid = 0;
+    for (int n = 0; n < NEURONS_PER_BAND; n++) {
+        int16_t mag = spectral_magnitude(&net->oscillator[band][n]);
+        if (mag > 100) {
+            uint8_t phase = spectral_phase_idx(&net->oscillator[band][n]);
+            sum_real += q15_cos(phase);
+            sum_imag += q15_sin(phase);
+            valid++;
+        }
+    }
+    if (valid == 0) return 0;
+    sum_real /= valid;
+    sum_imag /= valid;
+    complex_q15_t avg = { .real = (int16_t)sum_real, .imag = (int16_t)sum_imag };
+    return spectral_magnitude(&avg);
+}
+
+// ============================================================
+// Lockstep Lanes
+// ============================================================
+//
+// spectral_step() takes the same branches for every network except the
+// magnitude gates, the coupling threshold and the clamps, so networks can
+// advance together; those become per-lane selects. The helpers below are
+// branch-free forms of the scalar ones, equal for every int16 input, so
+// the loops over lanes vectorize.
+
+// spectral_magnitude(): max + 0.4*min
+static inline int16_t lane_magnitude(int16_t re, int16_t im) {
+    int32_t r = (re < 0) ? -re : re;
+    int32_t i = (im < 0) ? -im : im;
+    int32_t hi = (r > i) ? r : i;
+    int32_t lo = (r > i) ? i : r;
+    return (int16_t)(hi + ((lo * 13) >> 5));
+}
+
+// spectral_phase_idx(), including its int16 negation of -32768. The
+// numerators stay below 2^24, so the float quotient truncates to the
+// integer one.
+static inline uint8_t lane_phase_idx(int16_t re, int16_t im) {
+    int16_t r = (int16_t)((re < 0) ? -re : re);
+    int16_t i = (int16_t)((im < 0) ? -im : im);
+    int angle_lo = (int)((float)(i * 32) / (float)(r + 1));
+    int angle_hi = 64 - (int)((float)(r * 32) / (float)(i + 1));
+    int angle = (r > i) ? angle_lo : angle_hi;
+    int a = (re < 0) ? 128 - angle : angle;     // Quadrant 2 / 0
+    a = (im < 0) ? ((re < 0) ? 128 + angle : 256 - angle) : a;
+    return (uint8_t)a;
+}
+
+// (a * Q15_ONE) / mag for 100 < mag: a float estimate within one of the
+// quotient, corrected on the integer remainder
+static inline int32_t lane_normalize(int16_t a, int16_t mag) {
+    int32_t num = (int32_t)a * Q15_ONE;
+    int32_t q = (int32_t)((float)num / (float)mag);
+    int32_t rem = num - q * mag;
+    int32_t fix_pos = (rem >= mag) - (rem < 0);     // Want 0 <= rem < mag
+    int32_t fix_neg = (rem > 0) - (rem <= -mag);    // Want -mag < rem <= 0
+    return q + ((num >= 0) ? fix_pos : fix_neg);
+}
+
+void spectral_lanes_load(spectral_lanes_t *lanes, int k, const spectral_network_t *net,
+                         const uint8_t *input) {
+    for (int b = 0; b < NUM_BANDS; b++) {
+        for (int n = 0; n < NEURONS_PER_BAND; n++) {
+            int energy = 0;
+            for (int i = 0; i < INPUT_DIM; i++) {
+                if (net->input_pos_mask[b][n] & (1 << i)) energy += input[i];
+                if (net->input_neg_mask[b][n] & (1 << i)) energy -= input[i];
+            }
+            lanes->real[b][n][k] = net->oscillator[b][n].real;
+            lanes->imag[b][n][k] = net->oscillator[b][n].imag;
+            lanes->velocity[b][n][k] = net->phase_velocity[b][n];
+            lanes->energy[b][n][k] = (int16_t)energy;
+        }
+        for (int j = 0; j < NUM_BANDS; j++) lanes->coupling[b][j][k] = net->coupling[b][j];
+    }
+    lanes->coherence[k] = net->coherence;
+}
+
+void spectral_lanes_store(const spectral_lanes_t *lanes, int k, spectral_network_t *net) {
+    for (int b = 0; b < NUM_BANDS; b++) {
+        for (int n = 0; n < NEURONS_PER_BAND; n++) {
+            net->oscillator[b][n].real = lanes->real[b][n][k];
+            net->oscillator[b][n].imag = lanes->imag[b][n][k];
+            net->phase_velocity[b][n] = lanes->velocity[b][n][k];
+        }
+        for (int j = 0; j < NUM_BANDS; j++) net->coupling[b][j] = lanes->coupling[b][j][k];
+    }
+    net->coherence = lanes->coherence[k];
+}
+
+void spectral_lanes_step(spectral_lanes_t *lanes, const spectral_feedback_t *fb) {
+    // 1. Inject input energy (gated per lane)
+    for (int b = 0; b < NUM_BANDS; b++) {
+        for (int n = 0; n < NEURONS_PER_BAND; n++) {
+            int16_t *re = lanes->real[b][n];
+            int16_t *im = lanes->imag[b][n];
+            const int16_t *e = lanes->energy[b][n];
+            for (int k = 0; k < SPECTRAL_LANES; k++) {
+                int gate = lane_magnitude(re[k], im[k]) < Q15_HALF;
+                re[k] = (int16_t)(re[k] + gate * e[k] * 50);
+                im[k] = (int16_t)(im[k] + gate * e[k] * 25);
+            }
+        }
+    }
+
+    // 2. Rotate + decay
+    for (int b = 0; b < NUM_BANDS; b++) {
+        int16_t decay_q15 = (int16_t)(BAND_DECAY[b] * Q15_ONE);
+        for (int n = 0; n < NEURONS_PER_BAND; n++) {
+            int16_t *re = lanes->real[b][n];
+            int16_t *im = lanes->imag[b][n];
+            const int16_t *v = lanes->velocity[b][n];
+            int16_t c[SPECTRAL_LANES], s[SPECTRAL_LANES];
+            for (int k = 0; k < SPECTRAL_LANES; k++) {  // Table lookups stay scalar
+                uint8_t angle_idx = (uint8_t)((v[k] >> 8) & 0xFF);
+                c[k] = q15_cos(angle_idx);
+                s[k] = q15_sin(angle_idx);
+            }
+            for (int k = 0; k < SPECTRAL_LANES; k++) {
+                int16_t new_real = q15_mul(re[k], c[k]) - q15_mul(im[k], s[k]);
+                int16_t new_imag = q15_mul(re[k], s[k]) + q15_mul(im[k], c[k]);
+                re[k] = q15_mul(new_real, decay_q15);
+                im[k] = q15_mul(new_imag, decay_q15);
+            }
+        }
+    }
+
+    // 3. Kuramoto coupling (phases extracted once, reused by every pair)
+    for (int b = 0; b < NUM_BANDS; b++) {
+        for (int n = 0; n < NEURONS_PER_BAND; n++) {
+            const int16_t *re = lanes->real[b][n];
+            const int16_t *im = lanes->imag[b][n];
+            for (int k = 0; k < SPECTRAL_LANES; k++) {
+                lanes->phase[b][n][k] = lane_phase_idx(re[k], im[k]);
+            }
+        }
+    }
+
+    int32_t velocity_delta[NUM_BANDS][SPECTRAL_LANES] = {0};  // Same pull for a whole band
+    for (int src = 0; src < NUM_BANDS; src++) {
+        for (int dst = 0; dst < NUM_BANDS; dst++) {
+            if (src == dst) continue;
+            const float *strength = lanes->coupling[src][dst];
+            int32_t phase_diff_sum[SPECTRAL_LANES] = {0};
+            for (int n = 0; n < NEURONS_PER_BAND; n++) {
+                const uint8_t *ps = lanes->phase[src][n];
+                const uint8_t *pd = lanes->phase[dst][n];
+                for (int k = 0; k < SPECTRAL_LANES; k++) {
+                    // Wrap to [-128, 127] without the while loops
+                    phase_diff_sum[k] += (((int)ps[k] - (int)pd[k] + 128) & 0xFF) - 128;
+                }
+            }
+            for (int k = 0; k < SPECTRAL_LANES; k++) {
+                int avg_diff = phase_diff_sum[k] / NEURONS_PER_BAND;
+                int16_t pull = (int16_t)(strength[k] * avg_diff * 10);
+                velocity_delta[dst][k] += strength[k] < 0.01f ? 0 : pull;
+            }
+        }
+    }
+    for (int b = 0; b < NUM_BANDS; b++) {
+        for (int n = 0; n < NEURONS_PER_BAND; n++) {
+            int16_t *v = lanes->velocity[b][n];
+            for (int k = 0; k < SPECTRAL_LANES; k++) {
+                int16_t nv = (int16_t)(v[k] + velocity_delta[b][k] / 10);
+                nv = (nv > 10000) ? 10000 : nv;
+                v[k] = (nv < -10000) ? -10000 : nv;
+            }
+        }
+    }
+
+    // 4. Global coherence over oscillators with meaningful magnitude
+    int32_t sum_real[SPECTRAL_LANES] = {0}, sum_imag[SPECTRAL_LANES] = {0};
+    int32_t valid_count[SPECTRAL_LANES] = {0};
+    for (int b = 0; b < NUM_BANDS; b++) {
+        for (int n = 0; n < NEURONS_PER_BAND; n++) {
+            const int16_t *re = lanes->real[b][n];
+            const int16_t *im = lanes->imag[b][n];
+            for (int k = 0; k < SPECTRAL_LANES; k++) {
+                int16_t mag = lane_magnitude(re[k], im[k]);
+                bool valid = mag > 100;
+                int16_t div = valid ? mag : Q15_ONE;
+                sum_real[k] += valid * lane_normalize(re[k], div);
+                sum_imag[k] += valid * lane_normalize(im[k], div);
+                valid_count[k] += valid;
+            }
+        }
+    }
+    for (int k = 0; k < SPECTRAL_LANES; k++) {
+        int32_t count = valid_count[k] ? valid_count[k] : 1;
+        int16_t avg_real = (int16_t)(sum_real[k] / count);
+        int16_t avg_imag = (int16_t)(sum_imag[k] / count);
+        lanes->coherence[k] = valid_count[k] ? lane_magnitude(avg_real, avg_imag) : 0;
+    }
+
+    // 5. Coherence feedback on every cross-band coupling
+    if (!fb) return;
+    const int high = fb->high_threshold, low = fb->low_threshold;
+    const float decay = fb->decay, growth = fb->growth, min = fb->min, max = fb->max;
+    float modifier[SPECTRAL_LANES];
+    for (int k = 0; k < SPECTRAL_LANES; k++) {
+        int16_t coherence = lanes->coherence[k];
+        modifier[k] = coherence > high ? decay : coherence < low ? growth : 1.0f;
+    }
+    for (int i = 0; i < NUM_BANDS; i++) {
+        for (int j = 0; j < NUM_BANDS; j++) {
+            if (i == j) continue;
+            float *c = lanes->coupling[i][j];
+            for (int k = 0; k < SPECTRAL_LANES; k++) {
+                float v = c[k] * modifier[k];
+                v = v < min ? min : v;
+                c[k] = v > max ? max : v;
+            }
+        }
+    }
+}
+
+// ============================================================
+// Claim 6 Ablation
+// ============================================================
+
+void spectral_trace(spectral_trace_t *trace, float coupling, const spectral_feedback_t *fb,
+                    const uint8_t *input, int steps) {
+    spectral_network_t net;
+    spectral_init(&net, coupling, SPECTRAL_SEED);
+    int sample_interval = steps / (ABLATION_SAMPLES - 1);
+    int sample_idx = 0;
+
+    trace->coupling[0] = spectral_avg_coupling(&net);
+    trace->coherence[0] = net.coherence;
+    sample_idx++;
+
+    for (int s = 1; s <= steps; s++) {
+        if (fb) spectral_step_feedback_with(&net, input, fb);
+        else spectral_step(&net, input);
+
+        if (s % sample_interval == 0 && sample_idx < ABLATION_SAMPLES) {
+            trace->coupling[sample_idx] = spectral_avg_coupling(&net);
+            trace->coherence[sample_idx] = net.coherence;
+            sample_idx++;
+        }
+    }
+}
+
+void spectral_ablation_score(spectral_ablation_t *a) {
+    for (int c = 0; c < 2; c++) {
+        const float *coupling = a->run[c].coupling;
+        a->change[c] = coupling[ABLATION_SAMPLES - 1] - coupling[0];
+
+        // Calculate coupling variance (did it actually change?)
+        float var = 0;
+        for (int i = 0; i < ABLATION_SAMPLES; i++) {
+            var += (coupling[i] - coupling[0]) * (coupling[i] - coupling[0]);
+        }
+        a->variance[c] = var / ABLATION_SAMPLES;
+    }
+
+    float final_no_fb = a->run[0].coupling[ABLATION_SAMPLES - 1];
+    float final_with_fb = a->run[1].coupling[ABLATION_SAMPLES - 1];
+    a->coupling_changed = (a->variance[1] > a->variance[0] * 10) ||
+                          (fabsf(a->change[1]) > 0.01f);
+    a->feedback_different = fabsf(final_with_fb - final_no_fb) > 0.01f;
+}
@@ -0,0 +1,181 @@
+/**
+ * spectral_net.h - Q15 oscillator network of demo 03
+ *
+ * 16 complex Q15 oscillators in 4 bands, Kuramoto coupling between the
+ * bands and optional coherence feedback on the coupling. Every function
+ * takes the network it works on, so a host tool can step many networks
+ * side by side with the exact firmware arithmetic.
+ *
+ * Under a constant input the network is a finite deterministic map: the
+ * next state depends only on the oscillators, the phase velocities and the
+ * coupling matrix, the first SPECTRAL_STATE_BYTES of spectral_network_t.
+ * The input masks are fixed at init and the coherence is recomputed every
+ * step. Two networks with the same state bytes have the same future.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "net_rng.h"
+
+#if PULSE_STAGE_PROFILE
+#include "pulse_stages.h"           // pulse_lab component
+extern stage_set_t spectral_step_stages;    // Per-stage times of spectral_step()
+#endif
+
+#define NUM_BANDS           4       // Delta, Theta, Alpha, Gamma
+#define NEURONS_PER_BAND    4       // 4 oscillators per band
+#define TOTAL_NEURONS       (NUM_BANDS * NEURONS_PER_BAND)
+#define INPUT_DIM           4
+
+// Band indices
+#define BAND_DELTA          0       // Slowest
+#define BAND_THETA          1
+#define BAND_ALPHA          2
+#define BAND_GAMMA          3       // Fastest
+
+#define Q15_ONE             32767
+#define Q15_HALF            16384
+
+#define SPECTRAL_SEED       12345   // PRNG seed of init (the demo's network)
+#define SPECTRAL_STREAM_INIT 0      // Counter stream of spectral_init_rng()
+
+// Coherence feedback parameters
+#define COHERENCE_HIGH_THRESHOLD    20000   // Above this: reduce coupling
+#define COHERENCE_LOW_THRESHOLD     8000    // Below this: increase coupling
+#define COUPLING_DECAY              0.995f  // Multiplicative reduction
+#define COUPLING_GROWTH             1.005f  // Multiplicative increase
+#define COUPLING_MIN                0.01f   // Floor
+#define COUPLING_MAX                2.0f    // Ceiling
+
+// Claim 6 ablation: runs of ABLATION_STEPS, sampled ABLATION_SAMPLES times
+#define ABLATION_STEPS      500
+#define ABLATION_SAMPLES    11      // Step 0, then every steps / 10
+
+extern const float BAND_DECAY[NUM_BANDS];
+extern const float BAND_FREQ[NUM_BANDS];
+
+typedef struct {
+    int16_t real;
+    int16_t imag;
+} complex_q15_t;
+
+typedef struct {
+    // Oscillator states
+    complex_q15_t oscillator[NUM_BANDS][NEURONS_PER_BAND];
+    int16_t phase_velocity[NUM_BANDS][NEURONS_PER_BAND];
+
+    // Cross-band coupling (how strongly bands influence each other)
+    float coupling[NUM_BANDS][NUM_BANDS];
+
+    // Input projection (ternary weights)
+    uint32_t input_pos_mask[NUM_BANDS][NEURONS_PER_BAND];
+    uint32_t input_neg_mask[NUM_BANDS][NEURONS_PER_BAND];
+
+    // Coherence (synchronization measure)
+    int16_t coherence;
+
+} spectral_network_t;
+
+// Coherence feedback rule; SPECTRAL_FEEDBACK holds the #defines above
+typedef struct {
+    int high_threshold;     // Coherence above: coupling *= decay
+    int low_threshold;      // Coherence below: coupling *= growth
+    float decay;
+    float growth;
+    float min;              // Clamp of every cross-band coupling
+    float max;
+} spectral_feedback_t;
+
+extern const spectral_feedback_t SPECTRAL_FEEDBACK;
+
+// One condition of the ablation: avg coupling and coherence at each sample
+typedef struct {
+    float coupling[ABLATION_SAMPLES];
+    int16_t coherence[ABLATION_SAMPLES];
+} spectral_trace_t;
+
+// Both conditions and the statistics the verdict is drawn from
+typedef struct {
+    spectral_trace_t run[2];    // [0] without feedback, [1] with
+    float change[2];            // Final minus initial avg coupling
+    float variance[2];          // Mean squared deviation from the initial
+    bool coupling_changed;      // Test 1: feedback moves the coupling
+    bool feedback_different;    // Test 2: and away from the control
+} spectral_ablation_t;
+
+// Lockstep lanes: SPECTRAL_LANES networks stepped together, one per lane.
+// State is lane-innermost so every per-oscillator operation is a straight
+// loop over networks that the compiler can vectorize.
+#define SPECTRAL_LANES      16
+
+typedef struct {
+    int16_t real[NUM_BANDS][NEURONS_PER_BAND][SPECTRAL_LANES];
+    int16_t imag[NUM_BANDS][NEURONS_PER_BAND][SPECTRAL_LANES];
+    int16_t velocity[NUM_BANDS][NEURONS_PER_BAND][SPECTRAL_LANES];
+    int16_t energy[NUM_BANDS][NEURONS_PER_BAND][SPECTRAL_LANES];   // Masks . input
+    float coupling[NUM_BANDS][NUM_BANDS][SPECTRAL_LANES];
+    int16_t coherence[SPECTRAL_LANES];
+    uint8_t phase[NUM_BANDS][NEURONS_PER_BAND][SPECTRAL_LANES];    // Scratch
+} spectral_lanes_t;
+
+// Bytes of spectral_network_t that evolve: oscillators, velocities, coupling
+#define SPECTRAL_STATE_BYTES    offsetof(spectral_network_t, input_pos_mask)
+
+/** Fill the 256-entry trig tables; call once before anything else. */
+void spectral_init_tables(void);
+
+/** Random phases and ternary input masks from `seed`, uniform coupling. */
+void spectral_init(spectral_network_t *net, float coupling_strength, uint32_t seed);
+
+/**
+ * spectral_init() drawing from `rng`. net_rng_lcg(seed) is spectral_init();
+ * net_rng_counter(seed, k, SPECTRAL_STREAM_INIT) gives network k of an
+ * ensemble its own phases and masks, independent of the other networks.
+ */
+void spectral_init_rng(spectral_network_t *net, float coupling_strength, net_rng_t *rng);
+
+/** Put oscillator (b, n) on the unit circle at angle index `phase`. */
+void spectral_set_phase(spectral_network_t *net, int b, int n, uint8_t phase);
+
+/** One step: inject input, rotate and decay, couple, measure coherence. */
+void spectral_step(spectral_network_t *net, const uint8_t *input);
+
+/** spectral_step(), then scale the coupling by the coherence feedback. */
+void spectral_step_feedback(spectral_network_t *net, const uint8_t *input);
+
+/** spectral_step_feedback() with the rule in `fb` instead of the #defines. */
+void spectral_step_feedback_with(spectral_network_t *net, const uint8_t *input,
+                                 const spectral_feedback_t *fb);
+
+float spectral_avg_coupling(const spectral_network_t *net);
+int16_t spectral_band_coherence(const spectral_network_t *net, int band);
+
+/**
+ * Run the demo's network (SPECTRAL_SEED) from `coupling` for `steps` steps
+ * (a multiple of 10) under `input`, with feedback rule `fb` or none (NULL).
+ */
+void spectral_trace(spectral_trace_t *trace, float coupling, const spectral_feedback_t *fb,
+                    const uint8_t *input, int steps);
+
+/** Put `net` under constant `input` into lane k (its masks become energies). */
+void spectral_lanes_load(spectral_lanes_t *lanes, int k, const spectral_network_t *net,
+                         const uint8_t *input);
+
+/** Copy lane k's oscillators, velocities, coupling and coherence into `net`. */
+void spectral_lanes_store(const spectral_lanes_t *lanes, int k, spectral_network_t *net);
+
+/**
+ * spectral_step() (fb NULL) or spectral_step_feedback_with() on every lane,
+ * bit-exact with the single-network step. Unused lanes may hold zeros.
+ */
+void spectral_lanes_step(spectral_lanes_t *lanes, const spectral_feedback_t *fb);
+
+/** Fill the statistics and tests of `a` from its two runs. */
+void spectral_ablation_score(spectral_ablation_t *a);
+
+// Phase as a 0-255 angle index (atan2 approximation), |z| as max + 0.4*min
+uint8_t spectral_phase_idx(const complex_q15_t *z);
+int16_t spectral_magnitude(const complex_q15_t *z);
@@ -21,344 +21,24 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_timer.h"
+#include "spectral_net.h"
+#include "pulse_bench.h"            // pulse_lab component
+#include "pulse_stages.h"           // pulse_lab component
 
 // ============================================================
-// Configuration
+// Network State (dynamics in spectral_net.c)
 // ============================================================
 
-#define NUM_BANDS           4       // Delta, Theta, Alpha, Gamma
-#define NEURONS_PER_BAND    4       // 4 oscillators per band
-#define TOTAL_NEURONS       (NUM_BANDS * NEURONS_PER_BAND)
-#define INPUT_DIM           4
-
-// Band indices
-#define BAND_DELTA          0       // Slowest
-#define BAND_THETA          1
-#define BAND_ALPHA          2
-#define BAND_GAMMA          3       // Fastest
-
-// Band characteristics
-static const float BAND_DECAY[NUM_BANDS] = { 0.98f, 0.90f, 0.70f, 0.30f };
-static const float BAND_FREQ[NUM_BANDS] = { 0.1f, 0.3f, 1.0f, 3.0f };
 static const char* BAND_NAMES[NUM_BANDS] = { "Delta", "Theta", "Alpha", "Gamma" };
 
-// ============================================================
-// Q15 Fixed-Point Math
-// ============================================================
-
-typedef struct {
-    int16_t real;
-    int16_t imag;
-} complex_q15_t;
-
-#define Q15_ONE     32767
-#define Q15_HALF    16384
-
-// Trig lookup tables (256 entries = ~1.4 degree resolution)
-#define TRIG_TABLE_SIZE     256
-static int16_t sin_table[TRIG_TABLE_SIZE];
-static int16_t cos_table[TRIG_TABLE_SIZE];
-
-static void init_trig_tables(void) {
-    for (int i = 0; i < TRIG_TABLE_SIZE; i++) {
-        float angle = (2.0f * M_PI * i) / TRIG_TABLE_SIZE;
-        sin_table[i] = (int16_t)(sinf(angle) * Q15_ONE);
-        cos_table[i] = (int16_t)(cosf(angle) * Q15_ONE);
-    }
-}
-
-static inline int16_t q15_sin(uint8_t angle_idx) { return sin_table[angle_idx]; }
-static inline int16_t q15_cos(uint8_t angle_idx) { return cos_table[angle_idx]; }
-static inline int16_t q15_mul(int16_t a, int16_t b) { 
-    return (int16_t)(((int32_t)a * b) >> 15); 
-}
-
-// ============================================================
-// Phase extraction (atan2 approximation)
-// ============================================================
-
-static uint8_t get_phase_idx(complex_q15_t* z) {
-    int16_t r = z->real;
-    int16_t i = z->imag;
-    
-    int quadrant = 0;
-    if (r < 0) { r = -r; quadrant |= 2; }
-    if (i < 0) { i = -i; quadrant |= 1; }
-    
-    int angle;
-    if (r > i) {
-        angle = (i * 32) / (r + 1);
-    } else {
-        angle = 64 - (r * 32) / (i + 1);
-    }
-    
-    switch (quadrant) {
-        case 0: return angle;
-        case 2: return 128 - angle;
-        case 3: return 128 + angle;
-        case 1: return 256 - angle;
-    }
-    return 0;
-}
-
-static int16_t get_magnitude(complex_q15_t* z) {
-    int32_t r = z->real;
-    int32_t i = z->imag;
-    if (r < 0) r = -r;
-    if (i < 0) i = -i;
-    // Fast approximation: max + 0.4*min
-    if (r > i) {
-        return (int16_t)(r + ((i * 13) >> 5));
-    } else {
-        return (int16_t)(i + ((r * 13) >> 5));
-    }
-}
-
-// ============================================================
-// Network State
-// ============================================================
-
-typedef struct {
-    // Oscillator states
-    complex_q15_t oscillator[NUM_BANDS][NEURONS_PER_BAND];
-    int16_t phase_velocity[NUM_BANDS][NEURONS_PER_BAND];
-    
-    // Cross-band coupling (how strongly bands influence each other)
-    float coupling[NUM_BANDS][NUM_BANDS];
-    
-    // Input projection (ternary weights)
-    uint32_t input_pos_mask[NUM_BANDS][NEURONS_PER_BAND];
-    uint32_t input_neg_mask[NUM_BANDS][NEURONS_PER_BAND];
-    
-    // Coherence (synchronization measure)
-    int16_t coherence;
-    
-} spectral_network_t;
-
 static spectral_network_t network;
 
-// Simple PRNG for reproducibility
-static uint32_t prng_state = 12345;
-static uint32_t prng(void) {
-    prng_state = prng_state * 1103515245 + 12345;
-    return (prng_state >> 16) & 0x7fff;
-}
-
-// ============================================================
-// Initialization
-// ============================================================
-
 static void init_network(float coupling_strength) {
-    prng_state = 12345;  // Reset for reproducibility
-    
-    for (int b = 0; b < NUM_BANDS; b++) {
-        for (int n = 0; n < NEURONS_PER_BAND; n++) {
-            // Random initial phase
-            uint8_t phase = prng() & 0xFF;
-            network.oscillator[b][n].real = q15_cos(phase);
-            network.oscillator[b][n].imag = q15_sin(phase);
-            network.phase_velocity[b][n] = (int16_t)(BAND_FREQ[b] * 1000);
-            
-            // Random ternary input weights
-            network.input_pos_mask[b][n] = 0;
-            network.input_neg_mask[b][n] = 0;
-            for (int i = 0; i < INPUT_DIM; i++) {
-                int r = prng() % 3;
-                if (r == 0) network.input_pos_mask[b][n] |= (1 << i);
-                else if (r == 1) network.input_neg_mask[b][n] |= (1 << i);
-            }
-        }
-    }
-    
-    // Initialize coupling matrix
-    for (int i = 0; i < NUM_BANDS; i++) {
-        for (int j = 0; j < NUM_BANDS; j++) {
-            if (i == j) {
-                network.coupling[i][j] = 0.0f;
-            } else {
-                network.coupling[i][j] = coupling_strength;
-            }
-        }
-    }
-    
-    network.coherence = 0;
+    spectral_init(&network, coupling_strength, SPECTRAL_SEED);
 }
 
-// ============================================================
-// Coherence Feedback Parameters
-// ============================================================
-
-#define COHERENCE_HIGH_THRESHOLD    20000   // Above this: reduce coupling
-#define COHERENCE_LOW_THRESHOLD     8000    // Below this: increase coupling
-#define COUPLING_DECAY              0.995f  // Multiplicative reduction
-#define COUPLING_GROWTH             1.005f  // Multiplicative increase
-#define COUPLING_MIN                0.01f   // Floor
-#define COUPLING_MAX                2.0f    // Ceiling
-
-// ============================================================
-// Single Evolution Step
-// ============================================================
-
 static void evolve_step(const uint8_t* input) {
-    // 1. Inject input energy
-    for (int b = 0; b < NUM_BANDS; b++) {
-        for (int n = 0; n < NEURONS_PER_BAND; n++) {
-            int energy = 0;
-            for (int i = 0; i < INPUT_DIM; i++) {
-                if (network.input_pos_mask[b][n] & (1 << i)) energy += input[i];
-                if (network.input_neg_mask[b][n] & (1 << i)) energy -= input[i];
-            }
-            
-            // Only inject if magnitude is low (prevents runaway)
-            int16_t mag = get_magnitude(&network.oscillator[b][n]);
-            if (mag < Q15_HALF) {
-                network.oscillator[b][n].real += energy * 50;
-                network.oscillator[b][n].imag += energy * 25;
-            }
-        }
-    }
-    
-    // 2. Rotate oscillators (phase advance)
-    for (int b = 0; b < NUM_BANDS; b++) {
-        for (int n = 0; n < NEURONS_PER_BAND; n++) {
-            uint8_t angle_idx = (uint8_t)((network.phase_velocity[b][n] >> 8) & 0xFF);
-            int16_t c = q15_cos(angle_idx);
-            int16_t s = q15_sin(angle_idx);
-            
-            // z_new = z * e^(i*angle) = (r+ij)(c+is) = (rc-is) + i(rs+ic)
-            int16_t new_real = q15_mul(network.oscillator[b][n].real, c) 
-                             - q15_mul(network.oscillator[b][n].imag, s);
-            int16_t new_imag = q15_mul(network.oscillator[b][n].real, s) 
-                             + q15_mul(network.oscillator[b][n].imag, c);
-            
-            // Apply decay
-            int16_t decay_q15 = (int16_t)(BAND_DECAY[b] * Q15_ONE);
-            network.oscillator[b][n].real = q15_mul(new_real, decay_q15);
-            network.oscillator[b][n].imag = q15_mul(new_imag, decay_q15);
-        }
-    }
-    
-    // 3. Kuramoto coupling: bands influence each other's phase velocities
-    int32_t velocity_delta[NUM_BANDS][NEURONS_PER_BAND] = {0};
-    
-    for (int src = 0; src < NUM_BANDS; src++) {
-        for (int dst = 0; dst < NUM_BANDS; dst++) {
-            if (src == dst) continue;
-            float strength = network.coupling[src][dst];
-            if (strength < 0.01f) continue;
-            
-            // Compute average phase difference
-            int32_t phase_diff_sum = 0;
-            for (int n = 0; n < NEURONS_PER_BAND; n++) {
-                uint8_t src_phase = get_phase_idx(&network.oscillator[src][n]);
-                uint8_t dst_phase = get_phase_idx(&network.oscillator[dst][n]);
-                int diff = (int)src_phase - (int)dst_phase;
-                while (diff > 127) diff -= 256;
-                while (diff < -128) diff += 256;
-                phase_diff_sum += diff;
-            }
-            int avg_diff = phase_diff_sum / NEURONS_PER_BAND;
-            
-            // Pull destination toward source
-            int16_t pull = (int16_t)(strength * avg_diff * 10);
-            for (int n = 0; n < NEURONS_PER_BAND; n++) {
-                velocity_delta[dst][n] += pull;
-            }
-        }
-    }
-    
-    // Apply velocity changes
-    for (int b = 0; b < NUM_BANDS; b++) {
-        for (int n = 0; n < NEURONS_PER_BAND; n++) {
-            network.phase_velocity[b][n] += velocity_delta[b][n] / 10;
-            // Clamp
-            if (network.phase_velocity[b][n] > 10000) network.phase_velocity[b][n] = 10000;
-            if (network.phase_velocity[b][n] < -10000) network.phase_velocity[b][n] = -10000;
-        }
-    }
-    
-    // 4. Compute global coherence (Kuramoto order parameter)
-    // coherence = |mean(e^(i*phase))| = |mean(z/|z|)|
-    // This measures PHASE alignment, independent of magnitude
-    int32_t sum_real = 0, sum_imag = 0;
-    int valid_count = 0;
-    for (int b = 0; b < NUM_BANDS; b++) {
-        for (int n = 0; n < NEURONS_PER_BAND; n++) {
-            int16_t mag = get_magnitude(&network.oscillator[b][n]);
-            if (mag > 100) {  // Only count oscillators with meaningful magnitude
-                // Normalize to unit vector: z/|z|
-                // Scale to Q15: (real * 32767) / mag
-                int32_t norm_real = ((int32_t)network.oscillator[b][n].real * Q15_ONE) / mag;
-                int32_t norm_imag = ((int32_t)network.oscillator[b][n].imag * Q15_ONE) / mag;
-                sum_real += norm_real;
-                sum_imag += norm_imag;
-                valid_count++;
-            }
-        }
-    }
-    if (valid_count > 0) {
-        sum_real /= valid_count;
-        sum_imag /= valid_count;
-        complex_q15_t avg = { .real = (int16_t)sum_real, .imag = (int16_t)sum_imag };
-        network.coherence = get_magnitude(&avg);
-    } else {
-        network.coherence = 0;
-    }
-}
-
-// ============================================================
-// Evolution Step WITH Coherence Feedback
-// ============================================================
-
-static void evolve_step_with_feedback(const uint8_t* input) {
-    // First, do normal evolution
-    evolve_step(input);
-    
-    // Then, modulate coupling based on coherence
-    // High coherence -> reduce coupling (prevent over-synchronization)
-    // Low coherence -> increase coupling (encourage coordination)
-    
-    float modifier = 1.0f;
-    
-    if (network.coherence > COHERENCE_HIGH_THRESHOLD) {
-        // Too synchronized - reduce coupling
-        modifier = COUPLING_DECAY;
-    } else if (network.coherence < COHERENCE_LOW_THRESHOLD) {
-        // Too desynchronized - increase coupling
-        modifier = COUPLING_GROWTH;
-    }
-    
-    // Apply to all cross-band couplings
-    for (int i = 0; i < NUM_BANDS; i++) {
-        for (int j = 0; j < NUM_BANDS; j++) {
-            if (i != j) {
-                network.coupling[i][j] *= modifier;
-                
-                // Clamp to valid range
-                if (network.coupling[i][j] < COUPLING_MIN) {
-                    network.coupling[i][j] = COUPLING_MIN;
-                }
-                if (network.coupling[i][j] > COUPLING_MAX) {
-                    network.coupling[i][j] = COUPLING_MAX;
-                }
-            }
-        }
-    }
-}
-
-// Get average coupling strength (for reporting)
-static float get_avg_coupling(void) {
-    float sum = 0.0f;
-    int count = 0;
-    for (int i = 0; i < NUM_BANDS; i++) {
-        for (int j = 0; j < NUM_BANDS; j++) {
-            if (i != j) {
-                sum += network.coupling[i][j];
-                count++;
-            }
-        }
-    }
-    return sum / count;
+    spectral_step(&network, input);
 }
 
 // ============================================================
@@ -372,8 +52,8 @@ static void print_network_state(void) {
     for (int b = 0; b < NUM_BANDS; b++) {
         int32_t phase_sum = 0, mag_sum = 0, vel_sum = 0;
         for (int n = 0; n < NEURONS_PER_BAND; n++) {
-            phase_sum += get_phase_idx(&network.oscillator[b][n]);
-            mag_sum += get_magnitude(&network.oscillator[b][n]);
+            phase_sum += spectral_phase_idx(&network.oscillator[b][n]);
+            mag_sum += spectral_magnitude(&network.oscillator[b][n]);
             vel_sum += network.phase_velocity[b][n];
         }
         printf("    %-6s |    %3d      |     %5d       |    %5d\n",
@@ -391,23 +71,7 @@ static void print_network_state(void) {
 // ============================================================
 
 static int16_t measure_band_coherence(int band) {
-    // Measure phase coherence within a single band
-    int32_t sum_real = 0, sum_imag = 0;
-    int valid = 0;
-    for (int n = 0; n < NEURONS_PER_BAND; n++) {
-        int16_t mag = get_magnitude(&network.oscillator[band][n]);
-        if (mag > 100) {
-            uint8_t phase = get_phase_idx(&network.oscillator[band][n]);
-            sum_real += q15_cos(phase);
-            sum_imag += q15_sin(phase);
-            valid++;
-        }
-    }
-    if (valid == 0) return 0;
-    sum_real /= valid;
-    sum_imag /= valid;
-    complex_q15_t avg = { .real = (int16_t)sum_real, .imag = (int16_t)sum_imag };
-    return get_magnitude(&avg);
+    return spectral_band_coherence(&network, band);
 }
 
 static void test_coupling_effect(void) {
@@ -498,6 +162,13 @@ static void test_band_frequencies(void) {
     printf("            Delta decays slowest (highest magnitude).\n");
 }
 
+static void bench_evolve(void *ctx, uint32_t iterations) {
+    const uint8_t *input = ctx;
+    for (uint32_t i = 0; i < iterations; i++) {
+        evolve_step(input);
+    }
+}
+
 static void run_benchmark(void) {
     printf("\n");
     printf("----------------------------------------------------------------------\n");
@@ -506,28 +177,35 @@ static void run_benchmark(void) {
     
     init_network(0.3f);
     uint8_t input[INPUT_DIM] = {8, 8, 8, 8};
-    int iterations = 10000;
-    
-    int64_t start = esp_timer_get_time();
-    for (int i = 0; i < iterations; i++) {
-        evolve_step(input);
-    }
-    int64_t end = esp_timer_get_time();
-    
-    float total_ms = (float)(end - start) / 1000.0f;
-    float per_step_us = (float)(end - start) / iterations;
-    float steps_per_sec = 1000000.0f / per_step_us;
     
-    printf("\n  %d evolution steps\n", iterations);
-    printf("  Total time: %.2f ms\n", total_ms);
-    printf("  Per step: %.1f us\n", per_step_us);
-    printf("  Throughput: %.0f steps/second\n", steps_per_sec);
+    STAGE_RESET(spectral_step_stages);
+    bench_begin("03_spectral_oscillator");
+    bench_run(&(bench_case_t){
+        .name = "evolve_step", .params = "coupling=0.3,input=8",
+        .unit = "steps", .fn = bench_evolve, .ctx = input,
+    });
+    bench_end();
+    STAGE_REPORT(spectral_step_stages, STAGE_SIZE(NUM_BANDS, NEURONS_PER_BAND));
 }
 
 // ============================================================
 // CLAIM 6 ABLATION TEST: Self-Modification via Coherence
 // ============================================================
 
+static void print_trace(const spectral_trace_t *trace) {
+    int sample_interval = ABLATION_STEPS / (ABLATION_SAMPLES - 1);
+
+    printf("  Step | Coherence | Avg Coupling | Coupling Change\n");
+    printf("  -----+-----------+--------------+----------------\n");
+    printf("  %4d |   %5d   |    %.4f    |     ---\n", 
+           0, trace->coherence[0], trace->coupling[0]);
+    for (int i = 1; i < ABLATION_SAMPLES; i++) {
+        float change = trace->coupling[i] - trace->coupling[0];
+        printf("  %4d |   %5d   |    %.4f    |   %+.4f\n", 
+               i * sample_interval, trace->coherence[i], trace->coupling[i], change);
+    }
+}
+
 static void test_coherence_feedback_ablation(void) {
     printf("\n");
     printf("======================================================================\n");
@@ -539,8 +217,7 @@ static void test_coherence_feedback_ablation(void) {
     printf("\n");
     
     uint8_t input[INPUT_DIM] = {8, 8, 8, 8};
-    int steps = 500;
-    int sample_interval = 50;
+    spectral_ablation_t ablation;
     
     // ========== CONDITION 1: WITHOUT FEEDBACK ==========
     printf("----------------------------------------------------------------------\n");
@@ -548,38 +225,9 @@ static void test_coherence_feedback_ablation(void) {
     printf("----------------------------------------------------------------------\n");
     printf("\n");
     
-    init_network(0.5f);  // Start with moderate coupling
-    float initial_coupling_no_fb = get_avg_coupling();
-    
-    printf("  Step | Coherence | Avg Coupling | Coupling Change\n");
-    printf("  -----+-----------+--------------+----------------\n");
-    
-    float coupling_no_fb[11];
-    int16_t coherence_no_fb[11];
-    int sample_idx = 0;
-    
-    coupling_no_fb[0] = initial_coupling_no_fb;
-    coherence_no_fb[0] = network.coherence;
-    printf("  %4d |   %5d   |    %.4f    |     ---\n", 
-           0, network.coherence, get_avg_coupling());
-    sample_idx++;
-    
-    for (int s = 1; s <= steps; s++) {
-        evolve_step(input);  // NO feedback
-        
-        if (s % sample_interval == 0 && sample_idx < 11) {
-            float curr_coupling = get_avg_coupling();
-            float change = curr_coupling - initial_coupling_no_fb;
-            printf("  %4d |   %5d   |    %.4f    |   %+.4f\n", 
-                   s, network.coherence, curr_coupling, change);
-            coupling_no_fb[sample_idx] = curr_coupling;
-            coherence_no_fb[sample_idx] = network.coherence;
-            sample_idx++;
-        }
-    }
-    
-    float final_coupling_no_fb = get_avg_coupling();
-    float total_change_no_fb = final_coupling_no_fb - initial_coupling_no_fb;
+    // Start with moderate coupling
+    spectral_trace(&ablation.run[0], 0.5f, NULL, input, ABLATION_STEPS);
+    print_trace(&ablation.run[0]);
     
     // ========== CONDITION 2: WITH FEEDBACK ==========
     printf("\n");
@@ -588,40 +236,15 @@ static void test_coherence_feedback_ablation(void) {
     printf("----------------------------------------------------------------------\n");
     printf("\n");
     
-    init_network(0.5f);  // Same initial conditions
-    float initial_coupling_with_fb = get_avg_coupling();
-    
-    printf("  Step | Coherence | Avg Coupling | Coupling Change\n");
-    printf("  -----+-----------+--------------+----------------\n");
-    
-    float coupling_with_fb[11];
-    int16_t coherence_with_fb[11];
-    sample_idx = 0;
-    
-    coupling_with_fb[0] = initial_coupling_with_fb;
-    coherence_with_fb[0] = network.coherence;
-    printf("  %4d |   %5d   |    %.4f    |     ---\n", 
-           0, network.coherence, get_avg_coupling());
-    sample_idx++;
-    
-    for (int s = 1; s <= steps; s++) {
-        evolve_step_with_feedback(input);  // WITH feedback
-        
-        if (s % sample_interval == 0 && sample_idx < 11) {
-            float curr_coupling = get_avg_coupling();
-            float change = curr_coupling - initial_coupling_with_fb;
-            printf("  %4d |   %5d   |    %.4f    |   %+.4f\n", 
-                   s, network.coherence, curr_coupling, change);
-            coupling_with_fb[sample_idx] = curr_coupling;
-            coherence_with_fb[sample_idx] = network.coherence;
-            sample_idx++;
-        }
-    }
-    
-    float final_coupling_with_fb = get_avg_coupling();
-    float total_change_with_fb = final_coupling_with_fb - initial_coupling_with_fb;
+    // Same initial conditions
+    spectral_trace(&ablation.run[1], 0.5f, &SPECTRAL_FEEDBACK, input, ABLATION_STEPS);
+    print_trace(&ablation.run[1]);
     
     // ========== ANALYSIS ==========
+    spectral_ablation_score(&ablation);
+    const float *no_fb = ablation.run[0].coupling, *with_fb = ablation.run[1].coupling;
+    const int last = ABLATION_SAMPLES - 1;
+    
     printf("\n");
     printf("----------------------------------------------------------------------\n");
     printf("  ABLATION RESULTS\n");
@@ -631,34 +254,20 @@ static void test_coherence_feedback_ablation(void) {
     printf("  Metric                    | WITHOUT FB | WITH FB  | Difference\n");
     printf("  --------------------------+------------+----------+-----------\n");
     printf("  Initial coupling          |   %.4f   |  %.4f  |    ---\n",
-           initial_coupling_no_fb, initial_coupling_with_fb);
+           no_fb[0], with_fb[0]);
     printf("  Final coupling            |   %.4f   |  %.4f  |  %+.4f\n",
-           final_coupling_no_fb, final_coupling_with_fb,
-           final_coupling_with_fb - final_coupling_no_fb);
+           no_fb[last], with_fb[last], with_fb[last] - no_fb[last]);
     printf("  Total coupling change     |  %+.4f   | %+.4f  |  %+.4f\n",
-           total_change_no_fb, total_change_with_fb,
-           total_change_with_fb - total_change_no_fb);
-    
-    // Calculate coupling variance (did it actually change?)
-    float var_no_fb = 0, var_with_fb = 0;
-    for (int i = 0; i < 11; i++) {
-        var_no_fb += (coupling_no_fb[i] - initial_coupling_no_fb) * 
-                     (coupling_no_fb[i] - initial_coupling_no_fb);
-        var_with_fb += (coupling_with_fb[i] - initial_coupling_with_fb) * 
-                       (coupling_with_fb[i] - initial_coupling_with_fb);
-    }
-    var_no_fb /= 11;
-    var_with_fb /= 11;
-    
+           ablation.change[0], ablation.change[1], ablation.change[1] - ablation.change[0]);
     printf("  Coupling variance         |  %.6f  | %.6f |  %+.6f\n",
-           var_no_fb, var_with_fb, var_with_fb - var_no_fb);
+           ablation.variance[0], ablation.variance[1],
+           ablation.variance[1] - ablation.variance[0]);
     
     printf("\n");
     
     // ========== VERDICT ==========
-    bool coupling_changed = (var_with_fb > var_no_fb * 10) || 
-                           (fabsf(total_change_with_fb) > 0.01f);
-    bool feedback_different = fabsf(final_coupling_with_fb - final_coupling_no_fb) > 0.01f;
+    bool coupling_changed = ablation.coupling_changed;
+    bool feedback_different = ablation.feedback_different;
     
     printf("----------------------------------------------------------------------\n");
     printf("  CLAIM 6 VERIFICATION\n");
@@ -708,7 +317,7 @@ void app_main(void) {
     
     // Initialize
     printf("  Initializing trig tables...\n");
-    init_trig_tables();
+    spectral_init_tables();
     printf("  Ready.\n");
     
     vTaskDelay(pdMS_TO_TICKS(100));
@@ -739,6 +348,9 @@ void app_main(void) {
     printf("\n");
     printf("======================================================================\n");
     
+#ifdef PULSE_LAB_HOST
+    return;
+#endif
     while (1) {
         vTaskDelay(pdMS_TO_TICKS(1000));
     }
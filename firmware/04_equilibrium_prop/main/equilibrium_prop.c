@@ -29,6 +29,20 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_timer.h"
+#include "net_rng.h"                    // pulse_lab component
+#include "pulse_bench.h"                // pulse_lab component
+#include "pulse_stages.h"               // pulse_lab component
+
+#ifdef PULSE_LAB_HOST
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#else
+#include "esp_partition.h"
+#include "esp_heap_caps.h"
+#endif
 
 // ============================================================
 // Configuration (simplified from demo 03)
@@ -45,8 +59,22 @@
 // Equilibrium propagation parameters
 #define FREE_PHASE_STEPS    30
 #define NUDGE_PHASE_STEPS   30
-#define NUDGE_STRENGTH      0.5f
+#define NUDGE_STRENGTH_Q15  16384   // 0.5 in Q15 (exact, so both learning paths nudge identically)
 #define LEARNING_RATE       0.005f
+#define TRAIN_EPOCHS        150
+
+// Integer learning path (no FPU on the C6 - float here is soft-float)
+// Couplings live in Q15 with 1.0 = 32768 (clamped to 32767).
+#define COUPLING_Q15_MIN    328     // 0.01
+#define COUPLING_Q15_MAX    32767   // ~1.0
+#define COUPLING_Q15_INIT   6554    // 0.2
+#define LEARNING_RATE_Q16   328     // 0.005 in Q16: dw = (delta_q15 * lr) >> 16
+
+// Input mask learning: each ternary input weight steps by one (-1/0/+1)
+// with probability |x * contrast| >> MASK_FLIP_SHIFT (out of 65536)
+#define MASK_FLIP_SHIFT     6
+#define MASK_VEL_SHIFT      4       // Velocity contrast to phase turn (256 = full circle)
+#define MASK_FLIP_MIN       524288  // Below this never flips (turns under ~40 at input 15)
 
 static const float BAND_DECAY[NUM_BANDS] = { 0.98f, 0.90f, 0.70f, 0.30f };
 static const float BAND_FREQ[NUM_BANDS] = { 0.1f, 0.3f, 1.0f, 3.0f };
@@ -104,26 +132,65 @@ static int16_t get_magnitude(complex_q15_t* z) {
 // Network State
 // ============================================================
 
+// Everything inference reads besides oscillator state. Fixed-width
+// fields and no padding, so a model blob can hold it verbatim.
 typedef struct {
-    complex_q15_t oscillator[NUM_BANDS][NEURONS_PER_BAND];
-    int16_t phase_velocity[NUM_BANDS][NEURONS_PER_BAND];
     uint32_t input_pos_mask[NUM_BANDS][NEURONS_PER_BAND];
     uint32_t input_neg_mask[NUM_BANDS][NEURONS_PER_BAND];
-    float coupling[NUM_BANDS][NUM_BANDS];  // LEARNABLE
+    int16_t coupling_q15[NUM_BANDS][NUM_BANDS];    // LEARNABLE (Q15 path)
+    int16_t band_decay_q15[NUM_BANDS];
+    int16_t band_velocity[NUM_BANDS];              // Initial phase velocity
+} model_params_t;
+
+typedef struct {
+    complex_q15_t oscillator[NUM_BANDS][NEURONS_PER_BAND];
+    int16_t phase_velocity[NUM_BANDS][NEURONS_PER_BAND];
+    float coupling[NUM_BANDS][NUM_BANDS];          // LEARNABLE (float path)
+    model_params_t params;
 } network_t;
 
 typedef struct {
     float band_correlation[NUM_BANDS][NUM_BANDS];
+    int16_t band_correlation_q15[NUM_BANDS][NUM_BANDS];
     int16_t output_phase;
+    complex_q15_t state[NUM_BANDS][NEURONS_PER_BAND];
+    int16_t velocity[NUM_BANDS][NEURONS_PER_BAND];
 } snapshot_t;
 
+// Which coupling representation evolve/snapshot/update use.
+// LEARN_FLOAT is the original algorithm, kept as the reference.
+typedef enum {
+    LEARN_FLOAT,    // float couplings, cosf() correlations
+    LEARN_Q15,      // Q15 couplings, table correlations, stochastic rounding
+} learn_mode_t;
+
 static network_t net;
 static snapshot_t snap_free, snap_nudged;
 
-static uint32_t prng_state = 42;
+// Weights the dynamics read. Normally net.params; after load_model() it
+// points straight into the mapped model blob (read-only, no copy).
+static const model_params_t* model = &net.params;
+static learn_mode_t learn_mode = LEARN_Q15;
+static bool learn_couplings = true;     // Apply the coupling update
+static uint8_t learn_mask_bands = 0;    // Bands whose input masks also learn (bit per band)
+
+#define ALL_BANDS           ((1u << NUM_BANDS) - 1)
+
+// Initialization draws: demo 03's generator in its LCG mode, seed 42
+#define INIT_SEED           42
+static net_rng_t init_rng = { .mode = NET_RNG_LCG, .lcg = INIT_SEED };
 static uint32_t prng(void) {
-    prng_state = prng_state * 1103515245 + 12345;
-    return (prng_state >> 16) & 0x7fff;
+    return net_rng_next(&init_rng);
+}
+
+// Separate xorshift stream for stochastic rounding, so learning never
+// perturbs the initialization sequence above
+static uint32_t round_state = 0x9E3779B9;
+static inline uint32_t round_rand(void) {
+    round_state ^= round_state << 13;
+    round_state ^= round_state >> 17;
+    round_state ^= round_state << 5;
+    return round_state;
 }
 
 // ============================================================
@@ -131,7 +198,8 @@ static uint32_t prng(void) {
 // ============================================================
 
 static void init_network(void) {
-    prng_state = 42;
+    init_rng = net_rng_lcg(INIT_SEED);
+    round_state = 0x9E3779B9;
     
     for (int b = 0; b < NUM_BANDS; b++) {
         for (int n = 0; n < NEURONS_PER_BAND; n++) {
@@ -141,28 +209,33 @@ static void init_network(void) {
             net.phase_velocity[b][n] = (int16_t)(BAND_FREQ[b] * 1000);
             
             // Structured input weights
-            net.input_pos_mask[b][n] = 0;
-            net.input_neg_mask[b][n] = 0;
+            net.params.input_pos_mask[b][n] = 0;
+            net.params.input_neg_mask[b][n] = 0;
             if (b == BAND_DELTA) {
-                net.input_pos_mask[b][n] = 0x0C;  // Respond to inputs 2,3
-                net.input_neg_mask[b][n] = 0x03;
+                net.params.input_pos_mask[b][n] = 0x0C;  // Respond to inputs 2,3
+                net.params.input_neg_mask[b][n] = 0x03;
             } else if (b == BAND_GAMMA) {
-                net.input_pos_mask[b][n] = 0x03;  // Respond to inputs 0,1
-                net.input_neg_mask[b][n] = 0x0C;
+                net.params.input_pos_mask[b][n] = 0x03;  // Respond to inputs 0,1
+                net.params.input_neg_mask[b][n] = 0x0C;
             } else {
                 for (int i = 0; i < INPUT_DIM; i++) {
                     int r = prng() % 3;
-                    if (r == 0) net.input_pos_mask[b][n] |= (1 << i);
-                    else if (r == 1) net.input_neg_mask[b][n] |= (1 << i);
+                    if (r == 0) net.params.input_pos_mask[b][n] |= (1 << i);
+                    else if (r == 1) net.params.input_neg_mask[b][n] |= (1 << i);
                 }
             }
         }
+        // Band tables in the form the dynamics use them
+        net.params.band_decay_q15[b] = (int16_t)(BAND_DECAY[b] * Q15_ONE);
+        net.params.band_velocity[b] = (int16_t)(BAND_FREQ[b] * 1000);
     }
+    model = &net.params;
     
     // Uniform coupling
     for (int i = 0; i < NUM_BANDS; i++) {
         for (int j = 0; j < NUM_BANDS; j++) {
             net.coupling[i][j] = (i == j) ? 0.0f : 0.2f;
+            net.params.coupling_q15[i][j] = (i == j) ? 0 : COUPLING_Q15_INIT;
         }
     }
 }
@@ -173,7 +246,7 @@ static void reset_oscillators(void) {
             uint8_t phase = (uint8_t)((b * 64 + n * 16) & 0xFF);
             net.oscillator[b][n].real = q15_cos(phase);
             net.oscillator[b][n].imag = q15_sin(phase);
-            net.phase_velocity[b][n] = (int16_t)(BAND_FREQ[b] * 1000);
+            net.phase_velocity[b][n] = model->band_velocity[b];
         }
     }
 }
@@ -182,14 +255,18 @@ static void reset_oscillators(void) {
 // Evolution Step (with optional nudge)
 // ============================================================
 
-static void evolve_step(const uint8_t* input, int16_t* nudge_target, float nudge_str) {
+STAGE_SET(evolve_stages, "evolve_step", "inject", "rotate+decay", "coupling", "nudge");
+
+static void evolve_step(const uint8_t* input, int16_t* nudge_target, int16_t nudge_q15) {
+    STAGE_BEGIN();
+    
     // 1. Inject input
     for (int b = 0; b < NUM_BANDS; b++) {
         for (int n = 0; n < NEURONS_PER_BAND; n++) {
             int energy = 0;
             for (int i = 0; i < INPUT_DIM; i++) {
-                if (net.input_pos_mask[b][n] & (1 << i)) energy += input[i];
-                if (net.input_neg_mask[b][n] & (1 << i)) energy -= input[i];
+                if (model->input_pos_mask[b][n] & (1 << i)) energy += input[i];
+                if (model->input_neg_mask[b][n] & (1 << i)) energy -= input[i];
             }
             if (get_magnitude(&net.oscillator[b][n]) < Q15_HALF) {
                 net.oscillator[b][n].real += energy * 50;
@@ -197,6 +274,7 @@ static void evolve_step(const uint8_t* input, int16_t* nudge_target, float nudge
             }
         }
     }
+    STAGE_END(evolve_stages, 0);
     
     // 2. Rotate + decay
     for (int b = 0; b < NUM_BANDS; b++) {
@@ -205,17 +283,20 @@ static void evolve_step(const uint8_t* input, int16_t* nudge_target, float nudge
             int16_t c = q15_cos(angle), s = q15_sin(angle);
             int16_t nr = q15_mul(net.oscillator[b][n].real, c) - q15_mul(net.oscillator[b][n].imag, s);
             int16_t ni = q15_mul(net.oscillator[b][n].real, s) + q15_mul(net.oscillator[b][n].imag, c);
-            int16_t decay = (int16_t)(BAND_DECAY[b] * Q15_ONE);
+            int16_t decay = model->band_decay_q15[b];
             net.oscillator[b][n].real = q15_mul(nr, decay);
             net.oscillator[b][n].imag = q15_mul(ni, decay);
         }
     }
+    STAGE_END(evolve_stages, 1);
     
     // 3. Kuramoto coupling
     int32_t vel_delta[NUM_BANDS][NEURONS_PER_BAND] = {0};
     for (int src = 0; src < NUM_BANDS; src++) {
         for (int dst = 0; dst < NUM_BANDS; dst++) {
-            if (src == dst || net.coupling[src][dst] < 0.01f) continue;
+            if (src == dst) continue;
+            if (learn_mode == LEARN_Q15 ? model->coupling_q15[src][dst] < COUPLING_Q15_MIN
+                                        : net.coupling[src][dst] < 0.01f) continue;
             int32_t diff_sum = 0;
             for (int n = 0; n < NEURONS_PER_BAND; n++) {
                 int diff = (int)get_phase_idx(&net.oscillator[src][n]) - 
@@ -224,7 +305,11 @@ static void evolve_step(const uint8_t* input, int16_t* nudge_target, float nudge
                 while (diff < -128) diff += 256;
                 diff_sum += diff;
             }
-            int16_t pull = (int16_t)(net.coupling[src][dst] * (diff_sum / NEURONS_PER_BAND) * 10);
+            int avg_diff = diff_sum / NEURONS_PER_BAND;
+            // Division (not >>) truncates toward zero like the float cast does
+            int16_t pull = (learn_mode == LEARN_Q15)
+                ? (int16_t)((model->coupling_q15[src][dst] * avg_diff * 10) / 32768)
+                : (int16_t)(net.coupling[src][dst] * avg_diff * 10);
             for (int n = 0; n < NEURONS_PER_BAND; n++) vel_delta[dst][n] += pull;
         }
     }
@@ -235,20 +320,22 @@ static void evolve_step(const uint8_t* input, int16_t* nudge_target, float nudge
             if (net.phase_velocity[b][n] < -10000) net.phase_velocity[b][n] = -10000;
         }
     }
+    STAGE_END(evolve_stages, 2);
     
     // 4. NUDGE (if target provided)
-    if (nudge_target && nudge_str > 0) {
+    if (nudge_target && nudge_q15 > 0) {
         uint8_t gamma_ph = get_phase_idx(&net.oscillator[BAND_GAMMA][0]);
         uint8_t delta_ph = get_phase_idx(&net.oscillator[BAND_DELTA][0]);
         int16_t current = (int16_t)gamma_ph - (int16_t)delta_ph;
         int16_t error = *nudge_target - current;
         while (error > 127) error -= 256;
         while (error < -128) error += 256;
-        int16_t nudge = (int16_t)(error * nudge_str);
+        int16_t nudge = (int16_t)((error * nudge_q15) / 32768);
         for (int n = 0; n < NEURONS_PER_BAND; n++) {
             net.phase_velocity[BAND_GAMMA][n] += nudge;
         }
     }
+    STAGE_END(evolve_stages, 3);
 }
 
 // ============================================================
@@ -258,7 +345,22 @@ static void evolve_step(const uint8_t* input, int16_t* nudge_target, float nudge
 static void take_snapshot(snapshot_t* snap) {
     for (int i = 0; i < NUM_BANDS; i++) {
         for (int j = 0; j < NUM_BANDS; j++) {
-            if (i == j) { snap->band_correlation[i][j] = 1.0f; continue; }
+            if (i == j) {
+                snap->band_correlation[i][j] = 1.0f;
+                snap->band_correlation_q15[i][j] = Q15_ONE;
+                continue;
+            }
+            if (learn_mode == LEARN_Q15) {
+                // Same cos(diff) as below, read from the 256-entry table
+                int32_t corr = 0;
+                for (int n = 0; n < NEURONS_PER_BAND; n++) {
+                    int diff = (int)get_phase_idx(&net.oscillator[i][n]) - 
+                               (int)get_phase_idx(&net.oscillator[j][n]);
+                    corr += q15_cos((uint8_t)diff);
+                }
+                snap->band_correlation_q15[i][j] = (int16_t)(corr / NEURONS_PER_BAND);
+                continue;
+            }
             float corr = 0;
             for (int n = 0; n < NEURONS_PER_BAND; n++) {
                 int diff = (int)get_phase_idx(&net.oscillator[i][n]) - 
@@ -270,23 +372,23 @@ static void take_snapshot(snapshot_t* snap) {
     }
     snap->output_phase = (int16_t)get_phase_idx(&net.oscillator[BAND_GAMMA][0]) - 
                          (int16_t)get_phase_idx(&net.oscillator[BAND_DELTA][0]);
+    
+    // The mask rule needs each neuron's state and velocity
+    if (learn_mask_bands) {
+        for (int b = 0; b < NUM_BANDS; b++) {
+            for (int n = 0; n < NEURONS_PER_BAND; n++) {
+                snap->state[b][n] = net.oscillator[b][n];
+                snap->velocity[b][n] = net.phase_velocity[b][n];
+            }
+        }
+    }
 }
 
 // ============================================================
 // Learning Step
 // ============================================================
 
-static float learn_step(const uint8_t* input, int16_t target) {
-    // FREE PHASE
-    reset_oscillators();
-    for (int t = 0; t < FREE_PHASE_STEPS; t++) evolve_step(input, NULL, 0);
-    take_snapshot(&snap_free);
-    
-    // NUDGED PHASE
-    for (int t = 0; t < NUDGE_PHASE_STEPS; t++) evolve_step(input, &target, NUDGE_STRENGTH);
-    take_snapshot(&snap_nudged);
-    
-    // WEIGHT UPDATE
+static void update_coupling_float(void) {
     for (int i = 0; i < NUM_BANDS; i++) {
         for (int j = 0; j < NUM_BANDS; j++) {
             if (i == j) continue;
@@ -296,12 +398,116 @@ static float learn_step(const uint8_t* input, int16_t target) {
             if (net.coupling[i][j] > 1.0f) net.coupling[i][j] = 1.0f;
         }
     }
+}
+
+static void update_coupling_q15(void) {
+    for (int i = 0; i < NUM_BANDS; i++) {
+        for (int j = 0; j < NUM_BANDS; j++) {
+            if (i == j) continue;
+            int32_t delta = (int32_t)snap_nudged.band_correlation_q15[i][j] - 
+                            snap_free.band_correlation_q15[i][j];
+            // Typical |lr * delta| is well under one Q15 LSB. Adding uniform
+            // noise below the cut keeps the update unbiased instead of zero.
+            int32_t scaled = delta * LEARNING_RATE_Q16;
+            int32_t dw = (scaled + (int32_t)(round_rand() & 0xFFFF)) >> 16;
+            int32_t w = net.params.coupling_q15[i][j] + dw;
+            if (w < COUPLING_Q15_MIN) w = COUPLING_Q15_MIN;
+            if (w > COUPLING_Q15_MAX) w = COUPLING_Q15_MAX;
+            net.params.coupling_q15[i][j] = (int16_t)w;
+        }
+    }
+}
+
+// Input injection pushes along (50, 25): a neuron's drive is its state
+// projected on that direction
+static inline int32_t input_drive(complex_q15_t z) {
+    return 2 * (int32_t)z.real + z.imag;
+}
+
+// Contrastive Hebbian rule for the ternary input weights: dw ~ x * (s_nudged - s_free).
+// The nudge acts on phase velocity, so s_nudged is the free state turned
+// by the extra rotation the nudge asked for. The weight stays in
+// {-1, 0, +1} (still two bitmasks); instead of a fractional step it
+// moves one level with probability set by |dw|.
+static void update_input_masks(const uint8_t* input) {
+    for (int b = 0; b < NUM_BANDS; b++) {
+        if (!(learn_mask_bands & (1u << b))) continue;
+        for (int n = 0; n < NEURONS_PER_BAND; n++) {
+            int shift = (snap_nudged.velocity[b][n] - snap_free.velocity[b][n]) >> MASK_VEL_SHIFT;
+            if (shift > 128) shift = 128;
+            if (shift < -128) shift = -128;
+            // Unit vector at the phase the readout sees, so a neuron whose
+            // weights cancel (state ~0, phase still defined) can recover
+            uint8_t ph = get_phase_idx(&snap_free.state[b][n]);
+            complex_q15_t z = { q15_cos(ph), q15_sin(ph) };
+            int16_t c = q15_cos((uint8_t)shift), s = q15_sin((uint8_t)shift);
+            complex_q15_t turned = {
+                .real = q15_mul(z.real, c) - q15_mul(z.imag, s),
+                .imag = q15_mul(z.real, s) + q15_mul(z.imag, c),
+            };
+            int32_t contrast = input_drive(turned) - input_drive(z);
+            
+            for (int i = 0; i < INPUT_DIM; i++) {
+                int32_t corr = contrast * input[i];
+                int32_t mag = (corr < 0) ? -corr : corr;
+                if (mag < MASK_FLIP_MIN) continue;
+                if ((round_rand() & 0xFFFF) >= (uint32_t)(mag >> MASK_FLIP_SHIFT)) continue;
+                
+                uint32_t bit = 1u << i;
+                int w = (net.params.input_pos_mask[b][n] & bit) ? 1 :
+                        (net.params.input_neg_mask[b][n] & bit) ? -1 : 0;
+                w += (corr > 0) ? 1 : -1;
+                if (w > 1 || w < -1) continue;
+                net.params.input_pos_mask[b][n] &= ~bit;
+                net.params.input_neg_mask[b][n] &= ~bit;
+                if (w > 0) net.params.input_pos_mask[b][n] |= bit;
+                if (w < 0) net.params.input_neg_mask[b][n] |= bit;
+            }
+        }
+    }
+}
+
+// Apply the free/nudged contrast in snap_free/snap_nudged
+static void update_weights(const uint8_t* input) {
+    if (learn_couplings) {
+        if (learn_mode == LEARN_Q15) {
+            update_coupling_q15();
+        } else {
+            update_coupling_float();
+        }
+    }
+    if (learn_mask_bands) update_input_masks(input);
+}
+
+STAGE_SET(learn_stages, "learn_step", "free phase", "free snap", "nudged phase",
+          "nudged snap", "update");
+
+// Returns the free-phase squared phase error (loss * 65536)
+static int32_t learn_step(const uint8_t* input, int16_t target) {
+    STAGE_BEGIN();
+    
+    // FREE PHASE
+    reset_oscillators();
+    for (int t = 0; t < FREE_PHASE_STEPS; t++) evolve_step(input, NULL, 0);
+    STAGE_END(learn_stages, 0);
+    take_snapshot(&snap_free);
+    STAGE_END(learn_stages, 1);
+    
+    // NUDGED PHASE
+    for (int t = 0; t < NUDGE_PHASE_STEPS; t++) evolve_step(input, &target, NUDGE_STRENGTH_Q15);
+    STAGE_END(learn_stages, 2);
+    take_snapshot(&snap_nudged);
+    STAGE_END(learn_stages, 3);
+    
+    // WEIGHT UPDATE
+    update_weights(input);
+    STAGE_END(learn_stages, 4);
     
     // Return loss
     int16_t err = target - snap_free.output_phase;
     while (err > 127) err -= 256;
     while (err < -128) err += 256;
-    return (float)(err * err) / (256.0f * 256.0f);
+    return (int32_t)err * err;
 }
 
 static int16_t forward_pass(const uint8_t* input) {
@@ -311,10 +517,188 @@ static int16_t forward_pass(const uint8_t* input) {
            (int16_t)get_phase_idx(&net.oscillator[BAND_DELTA][0]);
 }
 
+// ============================================================
+// Batched Inference (lockstep, one sample per lane)
+// ============================================================
+//
+// forward_pass() takes the same branches for every input except the
+// magnitude gate and the clamps, so B samples can advance together.
+// State is stored lane-innermost ([band][neuron][lane]) so each Q15
+// operation is a straight loop over samples that the compiler can
+// vectorize. The magnitude gate and clamps become per-lane selects.
+// Results are bit-exact with forward_pass().
+
+#define BATCH_LANES         16
+
+typedef struct {
+    int16_t real[NUM_BANDS][NEURONS_PER_BAND][BATCH_LANES];
+    int16_t imag[NUM_BANDS][NEURONS_PER_BAND][BATCH_LANES];
+    int16_t vel[NUM_BANDS][NEURONS_PER_BAND][BATCH_LANES];
+    int16_t energy[NUM_BANDS][NEURONS_PER_BAND][BATCH_LANES];   // Input is constant per pass
+    uint8_t phase[NUM_BANDS][NEURONS_PER_BAND][BATCH_LANES];    // Scratch for coupling
+} batch_state_t;
+
+static batch_state_t batch;
+
+// Branch-free get_magnitude(): max + 0.4*min
+static inline int16_t lane_magnitude(int16_t re, int16_t im) {
+    int32_t r = (re < 0) ? -re : re;
+    int32_t i = (im < 0) ? -im : im;
+    int32_t hi = (r > i) ? r : i;
+    int32_t lo = (r > i) ? i : r;
+    return (int16_t)(hi + ((lo * 13) >> 5));
+}
+
+static void batch_evolve_step(int lanes) {
+    // 1. Inject input (gated per lane)
+    for (int b = 0; b < NUM_BANDS; b++) {
+        for (int n = 0; n < NEURONS_PER_BAND; n++) {
+            int16_t* re = batch.real[b][n];
+            int16_t* im = batch.imag[b][n];
+            const int16_t* e = batch.energy[b][n];
+            for (int k = 0; k < lanes; k++) {
+                bool low = lane_magnitude(re[k], im[k]) < Q15_HALF;
+                re[k] = low ? (int16_t)(re[k] + e[k] * 50) : re[k];
+                im[k] = low ? (int16_t)(im[k] + e[k] * 25) : im[k];
+            }
+        }
+    }
+    
+    // 2. Rotate + decay
+    for (int b = 0; b < NUM_BANDS; b++) {
+        int16_t decay = model->band_decay_q15[b];
+        for (int n = 0; n < NEURONS_PER_BAND; n++) {
+            int16_t* re = batch.real[b][n];
+            int16_t* im = batch.imag[b][n];
+            const int16_t* v = batch.vel[b][n];
+            for (int k = 0; k < lanes; k++) {
+                uint8_t angle = (uint8_t)((v[k] >> 8) & 0xFF);
+                int16_t c = q15_cos(angle), s = q15_sin(angle);
+                int16_t nr = q15_mul(re[k], c) - q15_mul(im[k], s);
+                int16_t ni = q15_mul(re[k], s) + q15_mul(im[k], c);
+                re[k] = q15_mul(nr, decay);
+                im[k] = q15_mul(ni, decay);
+            }
+        }
+    }
+    
+    // 3. Kuramoto coupling (phases extracted once, reused by every pair)
+    for (int b = 0; b < NUM_BANDS; b++) {
+        for (int n = 0; n < NEURONS_PER_BAND; n++) {
+            for (int k = 0; k < lanes; k++) {
+                complex_q15_t z = { .real = batch.real[b][n][k], .imag = batch.imag[b][n][k] };
+                batch.phase[b][n][k] = get_phase_idx(&z);
+            }
+        }
+    }
+    
+    int32_t vel_delta[NUM_BANDS][BATCH_LANES] = {0};    // Same pull for every neuron in a band
+    for (int src = 0; src < NUM_BANDS; src++) {
+        for (int dst = 0; dst < NUM_BANDS; dst++) {
+            if (src == dst) continue;
+            if (learn_mode == LEARN_Q15 ? model->coupling_q15[src][dst] < COUPLING_Q15_MIN
+                                        : net.coupling[src][dst] < 0.01f) continue;
+            int32_t diff_sum[BATCH_LANES] = {0};
+            for (int n = 0; n < NEURONS_PER_BAND; n++) {
+                const uint8_t* ps = batch.phase[src][n];
+                const uint8_t* pd = batch.phase[dst][n];
+                for (int k = 0; k < lanes; k++) {
+                    // Wrap to [-128, 127] without the while loops
+                    diff_sum[k] += (((int)ps[k] - (int)pd[k] + 128) & 0xFF) - 128;
+                }
+            }
+            if (learn_mode == LEARN_Q15) {
+                int32_t c = model->coupling_q15[src][dst];
+                for (int k = 0; k < lanes; k++) {
+                    vel_delta[dst][k] += (int16_t)((c * (diff_sum[k] / NEURONS_PER_BAND) * 10) / 32768);
+                }
+            } else {
+                float c = net.coupling[src][dst];
+                for (int k = 0; k < lanes; k++) {
+                    vel_delta[dst][k] += (int16_t)(c * (diff_sum[k] / NEURONS_PER_BAND) * 10);
+                }
+            }
+        }
+    }
+    for (int b = 0; b < NUM_BANDS; b++) {
+        for (int n = 0; n < NEURONS_PER_BAND; n++) {
+            int16_t* v = batch.vel[b][n];
+            for (int k = 0; k < lanes; k++) {
+                int16_t nv = (int16_t)(v[k] + vel_delta[b][k] / 10);
+                nv = (nv > 10000) ? 10000 : nv;
+                v[k] = (nv < -10000) ? -10000 : nv;
+            }
+        }
+    }
+}
+
+// Run up to BATCH_LANES samples through the free phase together
+static void batch_run_lanes(const uint8_t (*inputs)[INPUT_DIM], int lanes) {
+    for (int b = 0; b < NUM_BANDS; b++) {
+        for (int n = 0; n < NEURONS_PER_BAND; n++) {
+            // reset_oscillators(), broadcast across lanes
+            uint8_t phase = (uint8_t)((b * 64 + n * 16) & 0xFF);
+            int16_t vel = model->band_velocity[b];
+            for (int k = 0; k < lanes; k++) {
+                int energy = 0;
+                for (int i = 0; i < INPUT_DIM; i++) {
+                    if (model->input_pos_mask[b][n] & (1 << i)) energy += inputs[k][i];
+                    if (model->input_neg_mask[b][n] & (1 << i)) energy -= inputs[k][i];
+                }
+                batch.energy[b][n][k] = (int16_t)energy;
+                batch.real[b][n][k] = q15_cos(phase);
+                batch.imag[b][n][k] = q15_sin(phase);
+                batch.vel[b][n][k] = vel;
+            }
+        }
+    }
+    
+    for (int t = 0; t < FREE_PHASE_STEPS; t++) batch_evolve_step(lanes);
+}
+
+static inline uint8_t lane_phase(int b, int n, int k) {
+    complex_q15_t z = { .real = batch.real[b][n][k], .imag = batch.imag[b][n][k] };
+    return get_phase_idx(&z);
+}
+
+static void batch_forward_lanes(const uint8_t (*inputs)[INPUT_DIM], int lanes, int16_t* outputs) {
+    batch_run_lanes(inputs, lanes);
+    for (int k = 0; k < lanes; k++) {
+        outputs[k] = (int16_t)lane_phase(BAND_GAMMA, 0, k) - (int16_t)lane_phase(BAND_DELTA, 0, k);
+    }
+}
+
+// forward_pass() over any number of samples, BATCH_LANES at a time
+static void forward_pass_batch(const uint8_t (*inputs)[INPUT_DIM], int count, int16_t* outputs) {
+    for (int base = 0; base < count; base += BATCH_LANES) {
+        int lanes = count - base;
+        if (lanes > BATCH_LANES) lanes = BATCH_LANES;
+        batch_forward_lanes(inputs + base, lanes, outputs + base);
+    }
+}
+
 // ============================================================
 // Training
 // ============================================================
 
+// Training data
+static const uint8_t patterns[2][INPUT_DIM] = {
+    {0, 0, 15, 15},   // Pattern 0: energy in dims 2,3 → Delta
+    {15, 15, 0, 0},   // Pattern 1: energy in dims 0,1 → Gamma
+};
+static const int16_t targets[2] = {0, 128};  // Opposite phases
+
+static int wrap_phase(int d) {
+    while (d > 127) d -= 256;
+    while (d < -128) d += 256;
+    return d;
+}
+
+static float coupling_value(int i, int j) {
+    return (learn_mode == LEARN_Q15) ? (float)model->coupling_q15[i][j] / 32768.0f
+                                     : net.coupling[i][j];
+}
+
 static void train_and_evaluate(void) {
     printf("\n");
     printf("======================================================================\n");
@@ -322,37 +706,29 @@ static void train_and_evaluate(void) {
     printf("======================================================================\n");
     printf("\n");
     
-    // Training data
-    uint8_t patterns[2][INPUT_DIM] = {
-        {0, 0, 15, 15},   // Pattern 0: energy in dims 2,3 → Delta
-        {15, 15, 0, 0},   // Pattern 1: energy in dims 0,1 → Gamma
-    };
-    int16_t targets[2] = {0, 128};  // Opposite phases
-    
     printf("  Training data:\n");
     printf("    Pattern 0: [0,0,15,15] → target phase 0\n");
     printf("    Pattern 1: [15,15,0,0] → target phase 128\n");
+    printf("  Couplings: %s\n",
+           learn_mode == LEARN_Q15 ? "Q15, stochastic rounding" : "float");
     printf("\n");
     
     // Train
-    int epochs = 150;
     printf("  Epoch | Loss    | Output 0 | Output 1 | Separation\n");
     printf("  ------+---------+----------+----------+-----------\n");
     
-    for (int e = 0; e < epochs; e++) {
-        float loss = 0;
+    for (int e = 0; e < TRAIN_EPOCHS; e++) {
+        int32_t loss = 0;
         for (int p = 0; p < 2; p++) {
             loss += learn_step(patterns[p], targets[p]);
         }
         
-        if (e % 25 == 0 || e == epochs - 1) {
+        if (e % 25 == 0 || e == TRAIN_EPOCHS - 1) {
             int16_t out0 = forward_pass(patterns[0]);
             int16_t out1 = forward_pass(patterns[1]);
-            int sep = out1 - out0;
-            while (sep > 127) sep -= 256;
-            while (sep < -128) sep += 256;
+            int sep = wrap_phase(out1 - out0);
             printf("  %5d | %.5f |   %4d   |   %4d   |    %4d\n",
-                   e, loss / 2, out0, out1, sep);
+                   e, (float)loss / (2 * 65536.0f), out0, out1, sep);
         }
     }
     
@@ -361,14 +737,10 @@ static void train_and_evaluate(void) {
     int16_t out0 = forward_pass(patterns[0]);
     int16_t out1 = forward_pass(patterns[1]);
     int16_t err0 = targets[0] - out0; if (err0 < 0) err0 = -err0;
-    int16_t err1 = targets[1] - out1; 
-    while (err1 > 127) err1 -= 256;
-    while (err1 < -128) err1 += 256;
+    int16_t err1 = wrap_phase(targets[1] - out1);
     if (err1 < 0) err1 = -err1;
     
-    int sep = out1 - out0;
-    while (sep > 127) sep -= 256;
-    while (sep < -128) sep += 256;
+    int sep = wrap_phase(out1 - out0);
     
     printf("    Pattern 0: target=%d, output=%d, error=%d\n", targets[0], out0, err0);
     printf("    Pattern 1: target=%d, output=%d, error=%d\n", targets[1], out1, err1);
@@ -378,41 +750,961 @@ static void train_and_evaluate(void) {
     printf("\n  Final coupling matrix:\n    ");
     for (int i = 0; i < NUM_BANDS; i++) {
         for (int j = 0; j < NUM_BANDS; j++) {
-            printf("%.2f ", net.coupling[i][j]);
+            printf("%.2f ", coupling_value(i, j));
         }
         printf("\n    ");
     }
 }
 
+// ============================================================
+// Float vs Q15 Learning Curves
+// ============================================================
+
+#define CURVE_LOSS_TOLERANCE    0.03f   // Mean |loss_q15 - loss_float| per epoch
+#define CURVE_SEP_TOLERANCE     16      // |separation| at the end, phase units
+
+// Train from scratch in the given mode, recording loss and |separation| per epoch
+static void train_curve(learn_mode_t mode, float* loss_curve, int* sep_curve) {
+    learn_mode = mode;
+    init_network();
+    for (int e = 0; e < TRAIN_EPOCHS; e++) {
+        int32_t loss = 0;
+        for (int p = 0; p < 2; p++) {
+            loss += learn_step(patterns[p], targets[p]);
+        }
+        int sep = wrap_phase(forward_pass(patterns[1]) - forward_pass(patterns[0]));
+        loss_curve[e] = (float)loss / (2 * 65536.0f);
+        sep_curve[e] = (sep < 0) ? -sep : sep;
+    }
+}
+
+static bool compare_learning_curves(void) {
+    printf("\n");
+    printf("----------------------------------------------------------------------\n");
+    printf("  FLOAT vs Q15 LEARNING CURVES\n");
+    printf("----------------------------------------------------------------------\n");
+    printf("\n");
+    
+    static float loss_f[TRAIN_EPOCHS], loss_q[TRAIN_EPOCHS];
+    static int sep_f[TRAIN_EPOCHS], sep_q[TRAIN_EPOCHS];
+    
+    learn_mode_t saved = learn_mode;
+    train_curve(LEARN_FLOAT, loss_f, sep_f);
+    train_curve(LEARN_Q15, loss_q, sep_q);
+    learn_mode = saved;
+    
+    printf("  Epoch | Loss float | Loss Q15 | |Sep| float | |Sep| Q15\n");
+    printf("  ------+------------+----------+------------+----------\n");
+    float loss_gap = 0;
+    for (int e = 0; e < TRAIN_EPOCHS; e++) {
+        loss_gap += fabsf(loss_q[e] - loss_f[e]);
+        if (e % 25 == 0 || e == TRAIN_EPOCHS - 1) {
+            printf("  %5d |  %.5f   | %.5f  |    %4d    |   %4d\n",
+                   e, loss_f[e], loss_q[e], sep_f[e], sep_q[e]);
+        }
+    }
+    loss_gap /= TRAIN_EPOCHS;
+    int sep_gap = sep_q[TRAIN_EPOCHS - 1] - sep_f[TRAIN_EPOCHS - 1];
+    if (sep_gap < 0) sep_gap = -sep_gap;
+    
+    bool pass = (loss_gap <= CURVE_LOSS_TOLERANCE) && (sep_gap <= CURVE_SEP_TOLERANCE);
+    printf("\n  Mean loss gap: %.5f (tolerance %.2f)\n", loss_gap, CURVE_LOSS_TOLERANCE);
+    printf("  Final separation gap: %d (tolerance %d)\n", sep_gap, CURVE_SEP_TOLERANCE);
+    printf("  Result: %s\n", pass ? "PASS" : "FAIL");
+    return pass;
+}
+
+// ============================================================
+// Input Mask Learning: Steps to Separation
+// ============================================================
+
+#define MASK_TRIALS         16
+#define MASK_EPOCHS         50      // Per trial; ~35 s for the whole table on the C6
+#define MASK_SEP_TARGET     100     // |separation| counted as solved (78%)
+
+// Replace every band's masks (including Delta/Gamma's hand-made ones)
+// with random ternary weights, so the task has no built-in projection
+static void randomize_input_masks(uint32_t seed) {
+    init_rng = net_rng_lcg(seed);
+    for (int b = 0; b < NUM_BANDS; b++) {
+        for (int n = 0; n < NEURONS_PER_BAND; n++) {
+            net.params.input_pos_mask[b][n] = 0;
+            net.params.input_neg_mask[b][n] = 0;
+            for (int i = 0; i < INPUT_DIM; i++) {
+                int r = prng() % 3;
+                if (r == 0) net.params.input_pos_mask[b][n] |= (1 << i);
+                else if (r == 1) net.params.input_neg_mask[b][n] |= (1 << i);
+            }
+        }
+    }
+}
+
+// Train MASK_EPOCHS from the given masks. Returns the epoch |separation|
+// first reached MASK_SEP_TARGET (or -1); *held is whether it still does
+// at the end.
+static int epochs_to_separation(bool structured, uint32_t seed, bool masks, bool* held) {
+    init_network();
+    if (!structured) randomize_input_masks(seed);
+    round_state ^= seed;
+    learn_mask_bands = masks ? ALL_BANDS : 0;
+    int reached = -1;
+    int sep = 0;
+    for (int e = 0; e < MASK_EPOCHS; e++) {
+        for (int p = 0; p < 2; p++) learn_step(patterns[p], targets[p]);
+        sep = wrap_phase(forward_pass(patterns[1]) - forward_pass(patterns[0]));
+        if (sep < 0) sep = -sep;
+        if (reached < 0 && sep >= MASK_SEP_TARGET) reached = e + 1;
+    }
+    learn_mask_bands = 0;
+    *held = (sep >= MASK_SEP_TARGET);
+    return reached;
+}
+
+static bool benchmark_mask_learning(void) {
+    printf("\n");
+    printf("----------------------------------------------------------------------\n");
+    printf("  INPUT MASK LEARNING (%d seeds x %d epochs, target |sep| >= %d)\n",
+           MASK_TRIALS, MASK_EPOCHS, MASK_SEP_TARGET);
+    printf("----------------------------------------------------------------------\n");
+    printf("\n");
+    
+    static const struct {
+        const char* name;
+        bool structured;
+        bool masks;
+    } configs[] = {
+        { "hand-made masks, couplings only", true,  false },
+        { "random masks, couplings only",    false, false },
+        { "random masks, + mask learning",   false, true  },
+    };
+    int solved[3] = {0};
+    
+    learn_mode_t saved = learn_mode;
+    learn_mode = LEARN_Q15;
+    printf("  Masks / learning                 | Reached | Mean epochs | Held at end\n");
+    printf("  ---------------------------------+---------+-------------+------------\n");
+    for (int c = 0; c < 3; c++) {
+        int total_epochs = 0, held_count = 0;
+        for (int t = 0; t < MASK_TRIALS; t++) {
+            bool held;
+            int epochs = epochs_to_separation(configs[c].structured, 1000 + t * 7919,
+                                              configs[c].masks, &held);
+            if (epochs > 0) {
+                solved[c]++;
+                total_epochs += epochs;
+            }
+            if (held) held_count++;
+        }
+        if (solved[c] > 0) {
+            printf("  %-32s |  %2d/%-2d  |    %5.1f    |   %2d/%-2d\n", configs[c].name,
+                   solved[c], MASK_TRIALS, (float)total_epochs / solved[c], held_count, MASK_TRIALS);
+        } else {
+            printf("  %-32s |  %2d/%-2d  |       -     |   %2d/%-2d\n", configs[c].name,
+                   solved[c], MASK_TRIALS, held_count, MASK_TRIALS);
+        }
+    }
+    learn_mode = saved;
+    
+    bool pass = solved[2] > solved[1];
+    printf("\n  Result: %s (mask learning separates more random-mask networks)\n",
+           pass ? "PASS" : "FAIL");
+    return pass;
+}
+
+// ============================================================
+// Multi-Class Readout
+// ============================================================
+//
+// Class k owns the output pair (Gamma[k], Delta[k]). The predicted class
+// is the pair whose phases end closest to aligned. Training nudges the
+// true pair toward 0 and every other pair toward 128.
+//
+// Gamma's phase is set by the sign of its input (decay 0.3 forgets the
+// rest), while Delta's follows its velocity. So the nudge pushes the two
+// ends of a pair apart in velocity, and only the Gamma input masks learn:
+// they decide which side of its Delta reference each Gamma lands on.
+// Delta output masks start at zero and the couplings stay fixed, since
+// both move the reference phase for every class at once.
+
+#define NUM_CLASSES         4       // One output pair per class
+#define CLASS_ALIGNED       0       // Pair target for the true class
+#define CLASS_OPPOSED       128     // Pair target for the others
+#define CLASS_MARGIN        16      // Phase units past the boundary that count as correct
+#define CLASS_TRAIN_PER     8       // Training samples per class
+#define CLASS_TEST_PER      32      // Test samples per class
+#define CLASS_EPOCHS        40
+#define CLASS_NOISE         4       // Off-class inputs are uniform in [0, CLASS_NOISE)
+#define CLASS_SEED          7
+#define CLASS_MIN_ACCURACY  0.90f
+
+_Static_assert(NUM_CLASSES <= NEURONS_PER_BAND, "one output pair per class");
+_Static_assert(NUM_CLASSES <= INPUT_DIM, "each class has its own input line");
+
+// Argmax of cos(Gamma[k] - Delta[k]) over the output pairs
+static int pair_class(const uint8_t* gamma_ph, const uint8_t* delta_ph) {
+    int best = 0;
+    int16_t best_score = INT16_MIN;
+    for (int k = 0; k < NUM_CLASSES; k++) {
+        int16_t score = q15_cos((uint8_t)(gamma_ph[k] - delta_ph[k]));
+        if (score > best_score) {
+            best_score = score;
+            best = k;
+        }
+    }
+    return best;
+}
+
+static int classify(const uint8_t* input) {
+    reset_oscillators();
+    for (int t = 0; t < FREE_PHASE_STEPS; t++) evolve_step(input, NULL, 0);
+    uint8_t g[NUM_CLASSES], d[NUM_CLASSES];
+    for (int k = 0; k < NUM_CLASSES; k++) {
+        g[k] = get_phase_idx(&net.oscillator[BAND_GAMMA][k]);
+        d[k] = get_phase_idx(&net.oscillator[BAND_DELTA][k]);
+    }
+    return pair_class(g, d);
+}
+
+// classify() over any number of samples, BATCH_LANES at a time
+static void classify_batch(const uint8_t (*inputs)[INPUT_DIM], int count, uint8_t* classes) {
+    for (int base = 0; base < count; base += BATCH_LANES) {
+        int lanes = count - base;
+        if (lanes > BATCH_LANES) lanes = BATCH_LANES;
+        batch_run_lanes(inputs + base, lanes);
+        for (int k = 0; k < lanes; k++) {
+            uint8_t g[NUM_CLASSES], d[NUM_CLASSES];
+            for (int c = 0; c < NUM_CLASSES; c++) {
+                g[c] = lane_phase(BAND_GAMMA, c, k);
+                d[c] = lane_phase(BAND_DELTA, c, k);
+            }
+            classes[base + k] = (uint8_t)pair_class(g, d);
+        }
+    }
+}
+
+// Squared phase error of every output pair against its target. With
+// nudge_q15 > 0, also pulls each Gamma[k] toward its target (the class
+// version of step 4 in evolve_step(), on both ends of each pair). Pairs
+// already on the right side of the decision boundary by CLASS_MARGIN
+// count as no error, so a correct sample stops nudging.
+static int32_t nudge_class_pairs(int label, int16_t nudge_q15) {
+    int32_t loss = 0;
+    for (int k = 0; k < NUM_CLASSES; k++) {
+        int diff = wrap_phase((int)get_phase_idx(&net.oscillator[BAND_GAMMA][k]) - 
+                              (int)get_phase_idx(&net.oscillator[BAND_DELTA][k]));
+        int dist = (diff < 0) ? -diff : diff;
+        int error = 0;
+        if (k == label && dist > 64 - CLASS_MARGIN) error = wrap_phase(CLASS_ALIGNED - diff);
+        if (k != label && dist < 64 + CLASS_MARGIN) error = wrap_phase(CLASS_OPPOSED - diff);
+        loss += (int32_t)error * error;
+        int16_t nudge = (int16_t)((error * nudge_q15) / 32768);
+        net.phase_velocity[BAND_GAMMA][k] += nudge;
+        net.phase_velocity[BAND_DELTA][k] -= nudge;
+    }
+    return loss;
+}
+
+// learn_step() with the class targets. Returns the free-phase loss
+// summed over pairs (* 65536).
+static int32_t learn_class_step(const uint8_t* input, int label) {
+    reset_oscillators();
+    for (int t = 0; t < FREE_PHASE_STEPS; t++) evolve_step(input, NULL, 0);
+    take_snapshot(&snap_free);
+    int32_t loss = nudge_class_pairs(label, 0);
+    
+    for (int t = 0; t < NUDGE_PHASE_STEPS; t++) {
+        evolve_step(input, NULL, 0);
+        nudge_class_pairs(label, NUDGE_STRENGTH_Q15);
+    }
+    take_snapshot(&snap_nudged);
+    
+    // A sample already past the margin on every pair gets no nudge, but
+    // the two snapshots still differ by free drift; learning from that
+    // would keep flipping masks the training set no longer asks about
+    if (loss > 0) update_weights(input);
+    return loss;
+}
+
+// Class c drives input line c; the other lines carry low-level noise
+static void make_class_sample(int label, uint8_t* out) {
+    for (int i = 0; i < INPUT_DIM; i++) {
+        out[i] = (i == label) ? 15 : (uint8_t)(prng() % CLASS_NOISE);
+    }
+}
+
+static float class_accuracy(const uint8_t (*inputs)[INPUT_DIM], const uint8_t* labels,
+                            int count, uint8_t* predicted) {
+    classify_batch(inputs, count, predicted);
+    int correct = 0;
+    for (int i = 0; i < count; i++) correct += (predicted[i] == labels[i]);
+    return (float)correct / count;
+}
+
+// Benchmark cases (pulse_bench.h) over a set of samples
+typedef struct {
+    const uint8_t (*inputs)[INPUT_DIM];
+    int count;
+    int16_t *outputs;
+    uint8_t *classes;
+} bench_set_t;
+
+static void bench_classify(void *ctx, uint32_t iterations) {
+    const bench_set_t *set = ctx;
+    for (uint32_t i = 0; i < iterations; i++) {
+        for (int k = 0; k < set->count; k++) set->classes[k] = (uint8_t)classify(set->inputs[k]);
+    }
+}
+
+static void bench_classify_batch(void *ctx, uint32_t iterations) {
+    const bench_set_t *set = ctx;
+    for (uint32_t i = 0; i < iterations; i++) classify_batch(set->inputs, set->count, set->classes);
+}
+
+static bool test_multiclass(void) {
+    printf("\n");
+    printf("----------------------------------------------------------------------\n");
+    printf("  MULTI-CLASS READOUT (%d classes, one output pair each)\n", NUM_CLASSES);
+    printf("----------------------------------------------------------------------\n");
+    printf("\n");
+    
+    enum {
+        TRAIN_COUNT = NUM_CLASSES * CLASS_TRAIN_PER,
+        TEST_COUNT = NUM_CLASSES * CLASS_TEST_PER,
+    };
+    static uint8_t train_x[TRAIN_COUNT][INPUT_DIM], test_x[TEST_COUNT][INPUT_DIM];
+    static uint8_t train_y[TRAIN_COUNT], test_y[TEST_COUNT], predicted[TEST_COUNT];
+    
+    learn_mode_t saved = learn_mode;
+    learn_mode = LEARN_Q15;
+    init_network();
+    randomize_input_masks(CLASS_SEED);
+    for (int k = 0; k < NUM_CLASSES; k++) {
+        net.params.input_pos_mask[BAND_DELTA][k] = 0;
+        net.params.input_neg_mask[BAND_DELTA][k] = 0;
+    }
+    
+    // Classes interleaved, so one pass over the set is one epoch
+    for (int i = 0; i < TRAIN_COUNT; i++) {
+        train_y[i] = (uint8_t)(i % NUM_CLASSES);
+        make_class_sample(train_y[i], train_x[i]);
+    }
+    for (int i = 0; i < TEST_COUNT; i++) {
+        test_y[i] = (uint8_t)(i % NUM_CLASSES);
+        make_class_sample(test_y[i], test_x[i]);
+    }
+    printf("  Class c: input line c = 15, others uniform in [0,%d)\n", CLASS_NOISE);
+    printf("  %d training / %d test samples, Gamma input masks learned\n",
+           TRAIN_COUNT, TEST_COUNT);
+    printf("\n");
+    
+    // Train. Samples past the margin stop updating, so the masks settle
+    // once the whole training set is; the last epoch's masks are kept.
+    float train_acc = 0.0f;
+    printf("  Epoch | Loss    | Train acc | Test acc\n");
+    printf("  ------+---------+-----------+---------\n");
+    learn_couplings = false;
+    learn_mask_bands = 1u << BAND_GAMMA;
+    for (int e = 0; e < CLASS_EPOCHS; e++) {
+        int32_t loss = 0;
+        for (int i = 0; i < TRAIN_COUNT; i++) loss += learn_class_step(train_x[i], train_y[i]);
+        train_acc = class_accuracy(train_x, train_y, TRAIN_COUNT, predicted);
+        if (e % 10 == 0 || e == CLASS_EPOCHS - 1) {
+            float test_acc = class_accuracy(test_x, test_y, TEST_COUNT, predicted);
+            printf("  %5d | %.5f |   %5.1f%%  |  %5.1f%%\n", e,
+                   (float)loss / (TRAIN_COUNT * NUM_CLASSES * 65536.0f),
+                   100.0f * train_acc, 100.0f * test_acc);
+        }
+    }
+    learn_mask_bands = 0;
+    learn_couplings = true;
+    printf("\n  Final-epoch masks kept (train accuracy %.1f%%)\n", 100.0f * train_acc);
+    
+    // Evaluate
+    float accuracy = class_accuracy(test_x, test_y, TEST_COUNT, predicted);
+    int confusion[NUM_CLASSES][NUM_CLASSES] = {0};
+    int mismatches = 0;
+    for (int i = 0; i < TEST_COUNT; i++) {
+        confusion[test_y[i]][predicted[i]]++;
+        if (classify(test_x[i]) != predicted[i]) mismatches++;
+    }
+    
+    printf("\n  Confusion matrix on test set (rows: true class, columns: predicted):\n\n");
+    printf("         ");
+    for (int c = 0; c < NUM_CLASSES; c++) printf("   %d", c);
+    printf("\n");
+    for (int r = 0; r < NUM_CLASSES; r++) {
+        printf("      %d |", r);
+        for (int c = 0; c < NUM_CLASSES; c++) printf(" %3d", confusion[r][c]);
+        printf("\n");
+    }
+    
+    printf("\n  Test accuracy: %.1f%% (chance %.1f%%)\n", 100.0f * accuracy, 100.0f / NUM_CLASSES);
+    printf("  Batched vs scalar readout: %d / %d mismatches\n", mismatches, TEST_COUNT);
+    
+    // Throughput: one iteration classifies the whole test set
+    bench_set_t set = { .inputs = test_x, .count = TEST_COUNT, .classes = predicted };
+#define CLASS_BENCH_PARAMS  "classes=" STAGE_STR(NUM_CLASSES)
+    bench_begin("04_equilibrium_prop");
+    bench_run(&(bench_case_t){ .name = "classify", .params = CLASS_BENCH_PARAMS,
+                               .unit = "samples", .work = TEST_COUNT,
+                               .fn = bench_classify, .ctx = &set });
+    bench_run(&(bench_case_t){ .name = "classify_batch", .params = CLASS_BENCH_PARAMS ",lanes=" STAGE_STR(BATCH_LANES),
+                               .unit = "samples", .work = TEST_COUNT,
+                               .fn = bench_classify_batch, .ctx = &set });
+    bench_end();
+    
+    learn_mode = saved;
+    bool pass = (accuracy >= CLASS_MIN_ACCURACY) && (mismatches == 0);
+    printf("  Result: %s\n", pass ? "PASS" : "FAIL");
+    return pass;
+}
+
 // ============================================================
 // Benchmark
 // ============================================================
 
+static const uint8_t bench_input[INPUT_DIM] = {8, 8, 8, 8};
+#define BENCH_TARGET        64
+#define BENCH_LEARN_STEPS   20          // The network training starts from
+
+static void bench_learn(void *ctx, uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) learn_step(bench_input, BENCH_TARGET);
+}
+
+static void bench_forward(void *ctx, uint32_t iterations) {
+    const bench_set_t *set = ctx;
+    for (uint32_t i = 0; i < iterations; i++) {
+        for (int k = 0; k < set->count; k++) set->outputs[k] = forward_pass(set->inputs[k]);
+    }
+}
+
+static void bench_forward_batch(void *ctx, uint32_t iterations) {
+    const bench_set_t *set = ctx;
+    for (uint32_t i = 0; i < iterations; i++) forward_pass_batch(set->inputs, set->count, set->outputs);
+}
+
+static void benchmark_mode(learn_mode_t mode, const char* params) {
+    int16_t output;
+    bench_set_t one = { .inputs = &bench_input, .count = 1, .outputs = &output };
+    
+    learn_mode = mode;
+    init_network();
+    bench_run(&(bench_case_t){ .name = "learn_step", .params = params,
+                               .unit = "steps", .fn = bench_learn });
+    bench_run(&(bench_case_t){ .name = "forward_pass", .params = params,
+                               .unit = "inferences", .fn = bench_forward, .ctx = &one });
+    
+    // Training picks up from the benchmark's network: leave it as
+    // BENCH_LEARN_STEPS steps from init, however many calibration took
+    init_network();
+    for (int i = 0; i < BENCH_LEARN_STEPS; i++) learn_step(bench_input, BENCH_TARGET);
+}
+
+#if PULSE_STAGE_PROFILE
+#define STAGE_PROFILE_STEPS 200
+
+// Where a learn step's time goes, per mode, over STAGE_PROFILE_STEPS
+// steps from init. Ends on the network benchmark_mode(LEARN_Q15) left.
+static void profile_stages(void) {
+    static const char* params[2] = {
+        "mode=float," STAGE_SIZE(NUM_BANDS, NEURONS_PER_BAND),
+        "mode=q15," STAGE_SIZE(NUM_BANDS, NEURONS_PER_BAND),
+    };
+    for (int m = 0; m < 2; m++) {
+        learn_mode = (m == 0) ? LEARN_FLOAT : LEARN_Q15;
+        init_network();
+        STAGE_RESET(learn_stages);
+        STAGE_RESET(evolve_stages);
+        for (int i = 0; i < STAGE_PROFILE_STEPS; i++) learn_step(bench_input, BENCH_TARGET);
+        STAGE_REPORT(learn_stages, params[m]);
+        STAGE_REPORT(evolve_stages, params[m]);
+    }
+    init_network();
+    for (int i = 0; i < BENCH_LEARN_STEPS; i++) learn_step(bench_input, BENCH_TARGET);
+}
+#endif
+
 static void run_benchmark(void) {
     printf("\n");
     printf("----------------------------------------------------------------------\n");
     printf("  BENCHMARK\n");
     printf("----------------------------------------------------------------------\n");
     
-    uint8_t input[INPUT_DIM] = {8, 8, 8, 8};
-    int16_t target = 64;
+    learn_mode_t saved = learn_mode;
+    bench_begin("04_equilibrium_prop");
+    benchmark_mode(LEARN_FLOAT, "mode=float");
+    benchmark_mode(LEARN_Q15, "mode=q15");
+    bench_end();
+#if PULSE_STAGE_PROFILE
+    profile_stages();
+#endif
+    learn_mode = saved;
+}
+
+// ============================================================
+// Batched Inference: Exactness and Throughput
+// ============================================================
+
+#define BATCH_TEST_SAMPLES  256
+#define NUM_BATCH_SIZES     7           // 1 ... BATCH_TEST_SAMPLES
+
+static bool test_batched_inference(void) {
+    printf("\n");
+    printf("----------------------------------------------------------------------\n");
+    printf("  BATCHED INFERENCE (%d lanes, lockstep)\n", BATCH_LANES);
+    printf("----------------------------------------------------------------------\n");
+    printf("\n");
+    
+    static uint8_t inputs[BATCH_TEST_SAMPLES][INPUT_DIM];
+    static int16_t out_scalar[BATCH_TEST_SAMPLES], out_batch[BATCH_TEST_SAMPLES];
+    
+    // Random 4-bit inputs, drawn from the xorshift stream so prng() is untouched
+    for (int i = 0; i < BATCH_TEST_SAMPLES; i++) {
+        for (int d = 0; d < INPUT_DIM; d++) inputs[i][d] = round_rand() & 0x0F;
+    }
+    
+    bool pass = true;
+    learn_mode_t saved = learn_mode;
+    for (int m = 0; m < 2; m++) {
+        learn_mode = (m == 0) ? LEARN_FLOAT : LEARN_Q15;
+        for (int i = 0; i < BATCH_TEST_SAMPLES; i++) out_scalar[i] = forward_pass(inputs[i]);
+        forward_pass_batch(inputs, BATCH_TEST_SAMPLES, out_batch);
+        
+        int mismatches = 0;
+        for (int i = 0; i < BATCH_TEST_SAMPLES; i++) {
+            if (out_scalar[i] != out_batch[i]) mismatches++;
+        }
+        printf("  %-5s couplings: %d samples, %d mismatches vs forward_pass()\n",
+               m == 0 ? "Float" : "Q15", BATCH_TEST_SAMPLES, mismatches);
+        if (mismatches) pass = false;
+    }
+    learn_mode = saved;
+    printf("  Result: %s\n", pass ? "PASS" : "FAIL");
+    
+    // Throughput vs batch size
+    static const int sizes[] = {1, 2, 4, 8, 16, 64, 256};
+    static char params[NUM_BATCH_SIZES][24];
+    bench_set_t set = { .inputs = inputs, .count = BATCH_LANES, .outputs = out_scalar };
+    bench_begin("04_equilibrium_prop");
+    bench_result_t scalar = bench_run(&(bench_case_t){
+        .name = "forward_pass", .params = "batch=16", .unit = "inferences",
+        .work = BATCH_LANES, .fn = bench_forward, .ctx = &set,
+    });
+    float speedup[NUM_BATCH_SIZES];
+    for (int s = 0; s < NUM_BATCH_SIZES; s++) {
+        set = (bench_set_t){ .inputs = inputs, .count = sizes[s], .outputs = out_batch };
+        snprintf(params[s], sizeof(params[s]), "batch=%d", sizes[s]);
+        bench_result_t r = bench_run(&(bench_case_t){
+            .name = "forward_pass_batch", .params = params[s], .unit = "inferences",
+            .work = sizes[s], .fn = bench_forward_batch, .ctx = &set,
+        });
+        speedup[s] = scalar.throughput > 0 ? r.throughput / scalar.throughput : 0.0f;
+    }
+    printf("\n  Batched vs scalar:");
+    for (int s = 0; s < NUM_BATCH_SIZES; s++) printf(" %d: %.2fx", sizes[s], speedup[s]);
+    printf("\n");
+    bench_end();
+    
+    return pass;
+}
+
+// ============================================================
+// Model Blob: Export and Zero-Copy Load
+// ============================================================
+//
+// A trained network as one read-only blob:
+//
+//   model_header_t     offset 0
+//   params section     offset params_offset (MODEL_ALIGN-aligned)
+//
+// The params section is sized by the header dimensions:
+//   pos_mask[bands*neurons] u32, neg_mask[bands*neurons] u32,
+//   coupling[bands*bands] Q15, decay[bands] Q15, velocity[bands] i16
+// For this demo's dimensions that is byte-for-byte a model_params_t, so
+// loading is a header check plus a pointer cast. Little-endian, like
+// both the C6 and x86 hosts.
+//
+// Host: the blob is a file, mapped with mmap().
+// Device: the blob lives in the "ep_model" flash partition and is mapped
+// into the data address space with esp_partition_mmap().
+
+#define MODEL_MAGIC         0x314D5045  // "EPM1"
+#define MODEL_VERSION       1
+#define MODEL_ALIGN         32
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t header_bytes;
+    uint16_t num_bands;
+    uint16_t neurons_per_band;
+    uint16_t input_dim;
+    uint16_t coupling_frac_bits;    // 15 = Q15
+    uint32_t params_offset;
+    uint32_t params_bytes;
+    uint32_t params_fnv1a;          // Checked on request, not on load
+    uint32_t reserved;
+} model_header_t;
+
+#define MODEL_PARAMS_BYTES(bands, neurons) \
+    (8u * (bands) * (neurons) + 2u * (bands) * (bands) + 4u * (bands))
+
+_Static_assert(sizeof(model_header_t) == 32, "model header is 32 bytes on disk");
+_Static_assert(sizeof(model_params_t) == MODEL_PARAMS_BYTES(NUM_BANDS, NEURONS_PER_BAND),
+               "model_params_t must match the blob layout (no padding)");
+
+#define MODEL_PARAMS_OFFSET ((sizeof(model_header_t) + MODEL_ALIGN - 1) & ~(MODEL_ALIGN - 1))
+#define MODEL_BLOB_BYTES    (MODEL_PARAMS_OFFSET + sizeof(model_params_t))
+
+static uint32_t fnv1a(const uint8_t* data, size_t len) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        h ^= data[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static void model_fill_header(model_header_t* h, uint16_t bands, uint16_t neurons,
+                              const uint8_t* params) {
+    memset(h, 0, sizeof(*h));
+    h->magic = MODEL_MAGIC;
+    h->version = MODEL_VERSION;
+    h->header_bytes = sizeof(model_header_t);
+    h->num_bands = bands;
+    h->neurons_per_band = neurons;
+    h->input_dim = INPUT_DIM;
+    h->coupling_frac_bits = 15;
+    h->params_offset = MODEL_PARAMS_OFFSET;
+    h->params_bytes = MODEL_PARAMS_BYTES(bands, neurons);
+    h->params_fnv1a = fnv1a(params, h->params_bytes);
+}
+
+// Serialize the current network into buf (MODEL_BLOB_BYTES). Float-path
+// couplings are quantized to Q15 on the way out.
+static size_t export_model(uint8_t* buf) {
+    model_params_t* out = (model_params_t*)(buf + MODEL_PARAMS_OFFSET);
+    memset(buf, 0, MODEL_PARAMS_OFFSET);
+    memcpy(out, model, sizeof(*out));
+    if (learn_mode == LEARN_FLOAT) {
+        for (int i = 0; i < NUM_BANDS; i++) {
+            for (int j = 0; j < NUM_BANDS; j++) {
+                int32_t q = (int32_t)(net.coupling[i][j] * 32768.0f + 0.5f);
+                out->coupling_q15[i][j] = (int16_t)((q > COUPLING_Q15_MAX) ? COUPLING_Q15_MAX : q);
+            }
+        }
+    }
+    model_fill_header((model_header_t*)buf, NUM_BANDS, NEURONS_PER_BAND, (const uint8_t*)out);
+    return MODEL_BLOB_BYTES;
+}
+
+// Structural checks only: touches the header, never the payload
+static const model_header_t* model_check_header(const void* blob, size_t size) {
+    const model_header_t* h = (const model_header_t*)blob;
+    if (size < sizeof(*h)) return NULL;
+    if (h->magic != MODEL_MAGIC || h->version != MODEL_VERSION) return NULL;
+    if (h->header_bytes != sizeof(*h) || h->coupling_frac_bits != 15) return NULL;
+    if (h->params_offset % MODEL_ALIGN != 0) return NULL;
+    if (h->params_bytes != MODEL_PARAMS_BYTES(h->num_bands, h->neurons_per_band)) return NULL;
+    if ((uint64_t)h->params_offset + h->params_bytes > size) return NULL;
+    return h;
+}
+
+// Returns the in-place weights if the blob matches this build's dimensions
+static const model_params_t* model_validate(const void* blob, size_t size) {
+    const model_header_t* h = model_check_header(blob, size);
+    if (!h) return NULL;
+    if (h->num_bands != NUM_BANDS || h->neurons_per_band != NEURONS_PER_BAND ||
+        h->input_dim != INPUT_DIM) return NULL;
+    return (const model_params_t*)((const uint8_t*)blob + h->params_offset);
+}
+
+static bool model_verify_checksum(const void* blob) {
+    const model_header_t* h = (const model_header_t*)blob;
+    return fnv1a((const uint8_t*)blob + h->params_offset, h->params_bytes) == h->params_fnv1a;
+}
+
+#ifdef PULSE_LAB_HOST
+
+#define MODEL_FILE          "ep_model.epm"
+
+static bool save_model_blob(const char* path, const uint8_t* blob, size_t size) {
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    bool ok = fwrite(blob, 1, size, f) == size;
+    return (fclose(f) == 0) && ok;
+}
+
+static const void* map_model_blob(const char* path, size_t* size) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) { close(fd); return NULL; }
+    void* p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);  // The mapping keeps the file referenced
+    if (p == MAP_FAILED) return NULL;
+    *size = (size_t)st.st_size;
+    return p;
+}
+
+static void unmap_model_blob(const void* blob, size_t size) {
+    munmap((void*)blob, size);
+}
+
+// Resident set size in bytes
+static size_t memory_in_use(void) {
+    long pages = 0, resident = 0;
+    FILE* f = fopen("/proc/self/statm", "r");
+    if (f) {
+        if (fscanf(f, "%ld %ld", &pages, &resident) != 2) resident = 0;
+        fclose(f);
+    }
+    return (size_t)resident * (size_t)sysconf(_SC_PAGESIZE);
+}
+
+// Pages of the mapping holding addr that are in this process's page
+// tables (smaps Rss), in bytes. Page cache the file happens to sit in
+// does not count, nor does any other mapping.
+static size_t mapping_resident(const void* addr) {
+    FILE* f = fopen("/proc/self/smaps", "r");
+    if (!f) return 0;
+    char line[256];
+    bool inside = false;
+    size_t rss_kb = 0;
+    while (fgets(line, sizeof(line), f)) {
+        unsigned long lo, hi;
+        if (sscanf(line, "%lx-%lx ", &lo, &hi) == 2 && strchr(line, '-') < strchr(line, ' ')) {
+            inside = (uintptr_t)addr >= lo && (uintptr_t)addr < hi;
+        } else if (inside && sscanf(line, "Rss: %zu kB", &rss_kb) == 1) {
+            break;
+        }
+    }
+    fclose(f);
+    return rss_kb * 1024;
+}
+
+#else
+
+#define MODEL_FILE          "ep_model"  // Partition label (partitions.csv)
+
+static esp_partition_mmap_handle_t model_map_handle;
+
+// Flash wears per erase: when the partition already holds this blob
+// (same header, stored params match its checksum), leave it alone
+static bool model_blob_stored(const esp_partition_t* part, const uint8_t* blob) {
+    const model_header_t* h = (const model_header_t*)blob;
+    model_header_t stored;
+    if (esp_partition_read(part, 0, &stored, sizeof(stored)) != ESP_OK) return false;
+    if (memcmp(&stored, h, sizeof(stored)) != 0) return false;
+    uint8_t chunk[256];
+    uint32_t hash = 2166136261u;
+    for (size_t off = 0; off < h->params_bytes; off += sizeof(chunk)) {
+        size_t n = (h->params_bytes - off < sizeof(chunk)) ? h->params_bytes - off : sizeof(chunk);
+        if (esp_partition_read(part, h->params_offset + off, chunk, n) != ESP_OK) return false;
+        for (size_t i = 0; i < n; i++) {
+            hash ^= chunk[i];
+            hash *= 16777619u;
+        }
+    }
+    return hash == h->params_fnv1a;
+}
+
+static bool save_model_blob(const char* label, const uint8_t* blob, size_t size) {
+    const esp_partition_t* part = esp_partition_find_first(
+        ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+    if (!part || size > part->size) return false;
+    if (model_blob_stored(part, blob)) {
+        printf("  Partition already holds this blob: no erase, no write\n");
+        return true;
+    }
+    size_t erase = (size + part->erase_size - 1) & ~(part->erase_size - 1);
+    if (esp_partition_erase_range(part, 0, erase) != ESP_OK) return false;
+    return esp_partition_write(part, 0, blob, size) == ESP_OK;
+}
+
+static const void* map_model_blob(const char* label, size_t* size) {
+    const esp_partition_t* part = esp_partition_find_first(
+        ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+    if (!part) return NULL;
+    const void* p = NULL;
+    if (esp_partition_mmap(part, 0, part->size, ESP_PARTITION_MMAP_DATA,
+                           &p, &model_map_handle) != ESP_OK) return NULL;
+    *size = part->size;
+    return p;
+}
+
+static void unmap_model_blob(const void* blob, size_t size) {
+    esp_partition_munmap(model_map_handle);
+}
+
+// Heap in use in bytes (weights are never copied to the heap)
+static size_t memory_in_use(void) {
+    return heap_caps_get_total_size(MALLOC_CAP_DEFAULT) - heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+}
+
+#endif
+
+static const void* loaded_blob = NULL;
+static size_t loaded_size = 0;
+
+// Map a model and run inference from it in place. Learning is not
+// possible on a loaded model (the weights are read-only).
+static bool load_model(const char* location) {
+    size_t size = 0;
+    const void* blob = map_model_blob(location, &size);
+    if (!blob) return false;
+    const model_params_t* params = model_validate(blob, size);
+    if (!params) {
+        unmap_model_blob(blob, size);
+        return false;
+    }
+    loaded_blob = blob;
+    loaded_size = size;
+    model = params;
+    learn_mode = LEARN_Q15;     // Blobs only carry Q15 couplings
+    return true;
+}
+
+static void unload_model(void) {
+    if (!loaded_blob) return;
+    model = &net.params;
+    unmap_model_blob(loaded_blob, loaded_size);
+    loaded_blob = NULL;
+    loaded_size = 0;
+}
+
+// ============================================================
+// Model Export / Load Test
+// ============================================================
+
+#define MODEL_TEST_SAMPLES  64
+
+static bool test_model_roundtrip(void) {
+    printf("\n");
+    printf("----------------------------------------------------------------------\n");
+    printf("  MODEL EXPORT AND ZERO-COPY LOAD\n");
+    printf("----------------------------------------------------------------------\n");
+    printf("\n");
+    
+    static uint8_t blob[MODEL_BLOB_BYTES] __attribute__((aligned(MODEL_ALIGN)));
+    static uint8_t inputs[MODEL_TEST_SAMPLES][INPUT_DIM];
+    static int16_t out_ram[MODEL_TEST_SAMPLES];
+    
+    learn_mode_t saved = learn_mode;
+    learn_mode = LEARN_Q15;
+    for (int i = 0; i < MODEL_TEST_SAMPLES; i++) {
+        for (int d = 0; d < INPUT_DIM; d++) inputs[i][d] = round_rand() & 0x0F;
+        out_ram[i] = forward_pass(inputs[i]);
+    }
+    
+    size_t size = export_model(blob);
+    printf("  Blob: %u bytes (header %u, params %u), version %d\n",
+           (unsigned)size, (unsigned)sizeof(model_header_t),
+           (unsigned)sizeof(model_params_t), MODEL_VERSION);
+    if (!save_model_blob(MODEL_FILE, blob, size)) {
+        printf("  Could not write model to %s\n", MODEL_FILE);
+        printf("  Result: FAIL\n");
+        learn_mode = saved;
+        return false;
+    }
     
-    // Learning
+    size_t mem_before = memory_in_use();
     int64_t start = esp_timer_get_time();
-    for (int i = 0; i < 20; i++) learn_step(input, target);
+    bool loaded = load_model(MODEL_FILE);
     int64_t end = esp_timer_get_time();
-    float learn_us = (float)(end - start) / 20;
+    size_t mem_after = memory_in_use();
+    if (!loaded) {
+        printf("  Could not map/validate %s\n", MODEL_FILE);
+        printf("  Result: FAIL\n");
+        learn_mode = saved;
+        return false;
+    }
+    
+    int64_t sum_start = esp_timer_get_time();
+    bool checksum_ok = model_verify_checksum(loaded_blob);
+    int64_t sum_end = esp_timer_get_time();
+    
+    int mismatches = 0;
+    for (int i = 0; i < MODEL_TEST_SAMPLES; i++) {
+        if (forward_pass(inputs[i]) != out_ram[i]) mismatches++;
+    }
+    
+    printf("  Load (map + header check): %lld us\n", (long long)(end - start));
+    printf("  Checksum (optional): %lld us, %s\n", (long long)(sum_end - sum_start),
+           checksum_ok ? "OK" : "BAD");
+    printf("  Memory in use after load: %+ld bytes\n", (long)mem_after - (long)mem_before);
+    printf("  Weights read in place at %p (outside RAM copy %p)\n",
+           (const void*)model, (const void*)&net.params);
+    printf("  Inference mismatches vs RAM weights: %d / %d\n", mismatches, MODEL_TEST_SAMPLES);
+    
+    unload_model();
+    learn_mode = saved;
+    
+    bool pass = checksum_ok && mismatches == 0;
+    printf("  Result: %s\n", pass ? "PASS" : "FAIL");
+    return pass;
+}
+
+#ifdef PULSE_LAB_HOST
+
+// Zero-copy vs read-into-heap for big blobs. Only the header check runs,
+// as for a real model; the dimensions are synthetic so inference is not
+// attempted. Resident is each load's own pages once it has loaded (smaps
+// Rss of the mapping, or of the heap copy's mapping), not a process RSS
+// delta that allocator and page cache side effects would blur.
+static void measure_large_model_load(void) {
+    printf("\n  Large blobs (synthetic dimensions), resident = the load's own pages:\n");
+    printf("    Size    | mmap load | mmap res | read load | read res | checksum\n");
+    printf("    --------+-----------+----------+-----------+----------+----------\n");
     
-    // Inference
-    start = esp_timer_get_time();
-    for (int i = 0; i < 100; i++) forward_pass(input);
-    end = esp_timer_get_time();
-    float infer_us = (float)(end - start) / 100;
+    static const uint16_t neurons[] = {4096, 16384, 32768};
+    const uint16_t bands = 128;
+    const char* path = "ep_model_large.epm";
     
-    printf("\n  Learning step: %.1f us (%.0f Hz)\n", learn_us, 1000000.0f / learn_us);
-    printf("  Inference only: %.1f us (%.0f Hz)\n", infer_us, 1000000.0f / infer_us);
+    for (int s = 0; s < (int)(sizeof(neurons) / sizeof(neurons[0])); s++) {
+        size_t params_bytes = MODEL_PARAMS_BYTES(bands, neurons[s]);
+        size_t size = MODEL_PARAMS_OFFSET + params_bytes;
+        uint8_t* buf = calloc(1, size);
+        if (!buf) return;
+        for (size_t i = MODEL_PARAMS_OFFSET; i < size; i += 4096) buf[i] = (uint8_t)i;
+        model_fill_header((model_header_t*)buf, bands, neurons[s], buf + MODEL_PARAMS_OFFSET);
+        bool saved_ok = save_model_blob(path, buf, size);
+        free(buf);
+        if (!saved_ok) return;
+        
+        // Zero-copy: map + header check
+        int64_t t0 = esp_timer_get_time();
+        size_t mapped_size = 0;
+        const void* blob = map_model_blob(path, &mapped_size);
+        bool ok = blob && model_check_header(blob, mapped_size);
+        int64_t t1 = esp_timer_get_time();
+        size_t map_resident = blob ? mapping_resident(blob) : 0;
+        int64_t c0 = esp_timer_get_time();
+        if (ok) ok = model_verify_checksum(blob);
+        int64_t c1 = esp_timer_get_time();
+        if (blob) unmap_model_blob(blob, mapped_size);
+        
+        // Baseline: read the whole file into the heap
+        int64_t t2 = esp_timer_get_time();
+        FILE* f = fopen(path, "rb");
+        uint8_t* copy = malloc(size);
+        bool read_ok = f && copy && fread(copy, 1, size, f) == size;
+        if (f) fclose(f);
+        if (read_ok) read_ok = model_check_header(copy, size) != NULL;
+        int64_t t3 = esp_timer_get_time();
+        size_t read_resident = copy ? mapping_resident(copy) : 0;
+        free(copy);
+        
+        printf("    %4u MB | %6lld us | %5zu KB | %6lld us | %5zu KB | %5lld us%s\n",
+               (unsigned)(size >> 20), (long long)(t1 - t0), map_resident / 1024,
+               (long long)(t3 - t2), read_resident / 1024,
+               (long long)(c1 - c0), (ok && read_ok) ? "" : " BAD");
+    }
+    unlink(path);
 }
 
+#endif
+
 // ============================================================
 // Main
 // ============================================================
@@ -440,6 +1732,14 @@ void app_main(void) {
     
     run_benchmark();
     train_and_evaluate();
+    compare_learning_curves();
+    benchmark_mask_learning();
+    test_multiclass();
+    test_batched_inference();
+    test_model_roundtrip();
+#ifdef PULSE_LAB_HOST
+    measure_large_model_load();
+#endif
     
     printf("\n");
     printf("======================================================================\n");
@@ -456,6 +1756,9 @@ void app_main(void) {
     printf("\n");
     printf("======================================================================\n");
     
+#ifdef PULSE_LAB_HOST
+    return;
+#endif
     while (1) {
         vTaskDelay(pdMS_TO_TICKS(1000));
     }
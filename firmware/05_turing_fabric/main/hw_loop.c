@@ -0,0 +1,151 @@
+/**
+ * hw_loop.c - Autonomous hardware FOR loop on the ETM fabric
+ *
+ * See hw_loop.h. The body route (timer alarm → GPIO toggle) goes through
+ * the IDF ETM driver; the exit route needs a PCNT event, which IDF does
+ * not expose, so it is a one-case etm_switch.
+ */
+
+#include <string.h>
+#include "esp_log.h"
+#include "esp_attr.h"
+#include "driver/gpio.h"
+#include "driver/gpio_etm.h"
+#include "hw_loop.h"
+#include "etm_regs.h"
+
+static const char *TAG = "HW_LOOP";
+
+static bool IRAM_ATTR loop_exit_cb(pcnt_unit_handle_t unit, const pcnt_watch_event_data_t *edata, void *ctx) {
+    hw_loop_t *loop = ctx;
+    BaseType_t woken = pdFALSE;
+    loop->wakeups++;
+    xSemaphoreGiveFromISR(loop->done, &woken);
+    return woken == pdTRUE;
+}
+
+esp_err_t hw_loop_new(const hw_loop_config_t *cfg, hw_loop_t *loop) {
+    memset(loop, 0, sizeof(*loop));
+    etm_switch_init(&loop->exit);
+    if (cfg->iterations < 1 || cfg->iterations > HW_LOOP_MAX_ITERATIONS || cfg->period_us < 2) {
+        ESP_LOGE(TAG, "%d iterations at %lu us not supported", cfg->iterations, (unsigned long)cfg->period_us);
+        return ESP_ERR_INVALID_ARG;
+    }
+    loop->cfg = *cfg;
+
+    loop->done = xSemaphoreCreateBinary();
+    if (!loop->done) return ESP_ERR_NO_MEM;
+
+    // Iteration clock
+    gptimer_config_t tcfg = {
+        .clk_src = GPTIMER_CLK_SRC_DEFAULT,
+        .direction = GPTIMER_COUNT_UP,
+        .resolution_hz = 1000000,
+    };
+    esp_err_t ret = gptimer_new_timer(&tcfg, &loop->timer);
+    if (ret != ESP_OK) goto err;
+    gptimer_alarm_config_t alarm = {
+        .alarm_count = cfg->period_us,
+        .reload_count = 0,
+        .flags.auto_reload_on_alarm = true,
+    };
+    gptimer_set_alarm_action(loop->timer, &alarm);
+    gptimer_enable(loop->timer);
+
+    // Loop counter: one count per toggle
+    pcnt_unit_config_t ucfg = {
+        .low_limit = -1,
+        .high_limit = HW_LOOP_MAX_ITERATIONS,
+    };
+    ret = pcnt_new_unit(&ucfg, &loop->pcnt);
+    if (ret != ESP_OK) goto err;
+    pcnt_event_callbacks_t cbs = { .on_reach = loop_exit_cb };
+    pcnt_unit_register_event_callbacks(loop->pcnt, &cbs, loop);
+    pcnt_chan_config_t ccfg = {
+        .edge_gpio_num = cfg->gpio,
+        .level_gpio_num = -1,
+        .flags.io_loop_back = true,
+    };
+    ret = pcnt_new_channel(loop->pcnt, &ccfg, &loop->pcnt_chan);
+    if (ret != ESP_OK) goto err;
+    pcnt_channel_set_edge_action(loop->pcnt_chan, PCNT_CHANNEL_EDGE_ACTION_INCREASE, PCNT_CHANNEL_EDGE_ACTION_INCREASE);
+    gpio_set_direction(cfg->gpio, GPIO_MODE_INPUT_OUTPUT);
+
+    // Body: alarm → toggle the loop pin
+    gptimer_etm_event_config_t ecfg = { .event_type = GPTIMER_ETM_EVENT_ALARM_MATCH };
+    gpio_etm_task_config_t gcfg = { .action = GPIO_ETM_TASK_ACTION_TOG };
+    esp_etm_channel_config_t chcfg = {0};
+    if ((ret = gptimer_new_etm_event(loop->timer, &ecfg, &loop->alarm_event)) != ESP_OK ||
+        (ret = gpio_new_etm_task(&gcfg, &loop->toggle_task)) != ESP_OK ||
+        (ret = gpio_etm_task_add_gpio(loop->toggle_task, cfg->gpio)) != ESP_OK ||
+        (ret = esp_etm_new_channel(&chcfg, &loop->body)) != ESP_OK) {
+        goto err;
+    }
+    esp_etm_channel_connect(loop->body, loop->alarm_event, loop->toggle_task);
+    esp_etm_channel_enable(loop->body);
+
+    // Exit: terminal count → stop the iteration clock
+    etm_case_t terminal = {
+        .kind = ETM_CASE_PCNT_WATCH,
+        .sources = { { loop->pcnt, cfg->iterations } }, .num_sources = 1,
+        .tasks = { TIMER0_TASK_CNT_STOP_TIMER0 }, .num_tasks = 1,
+        .channel = ETM_CHANNEL_AUTO,
+    };
+    if ((ret = etm_switch_add_case(&loop->exit, &terminal)) != ESP_OK ||
+        (ret = etm_switch_load(&loop->exit)) != ESP_OK) {
+        goto err;
+    }
+
+    pcnt_unit_enable(loop->pcnt);
+    pcnt_unit_start(loop->pcnt);
+    return ESP_OK;
+
+err:
+    ESP_LOGE(TAG, "setup failed: %s", esp_err_to_name(ret));
+    hw_loop_del(loop);
+    return ret;
+}
+
+esp_err_t hw_loop_run(hw_loop_t *loop, int timeout_ms) {
+    pcnt_unit_clear_count(loop->pcnt);
+    gptimer_set_raw_count(loop->timer, 0);
+    esp_err_t ret = gptimer_start(loop->timer);
+    if (ret != ESP_OK) return ret;
+
+    bool exited = xSemaphoreTake(loop->done, pdMS_TO_TICKS(timeout_ms)) == pdTRUE;
+
+    // The fabric already stopped the counter; bring the driver along
+    gptimer_stop(loop->timer);
+    return exited ? ESP_OK : ESP_ERR_TIMEOUT;
+}
+
+int hw_loop_count(hw_loop_t *loop) {
+    int count = 0;
+    pcnt_unit_get_count(loop->pcnt, &count);
+    return count;
+}
+
+void hw_loop_del(hw_loop_t *loop) {
+    etm_switch_unload(&loop->exit);
+    if (loop->body) {
+        esp_etm_channel_disable(loop->body);
+        esp_etm_del_channel(loop->body);
+    }
+    if (loop->toggle_task) {
+        gpio_etm_task_rm_gpio(loop->toggle_task, loop->cfg.gpio);
+        esp_etm_del_task(loop->toggle_task);
+    }
+    if (loop->alarm_event) esp_etm_del_event(loop->alarm_event);
+    if (loop->pcnt) {
+        pcnt_unit_stop(loop->pcnt);
+        pcnt_unit_disable(loop->pcnt);
+        if (loop->pcnt_chan) pcnt_del_channel(loop->pcnt_chan);
+        pcnt_del_unit(loop->pcnt);
+    }
+    if (loop->timer) {
+        gptimer_disable(loop->timer);
+        gptimer_del_timer(loop->timer);
+    }
+    if (loop->done) vSemaphoreDelete(loop->done);
+    memset(loop, 0, sizeof(*loop));
+}
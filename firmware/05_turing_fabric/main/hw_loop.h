@@ -0,0 +1,62 @@
+/**
+ * hw_loop.h - Autonomous hardware FOR loop on the ETM fabric
+ *
+ *   for (i = 0; i < N; i++) body;      // no CPU until the loop exits
+ *
+ *   iteration clock   GPTimer auto-reload alarm every period_us
+ *   body              alarm ─ETM─► GPIO toggle on the loop pin (IDF esp_etm)
+ *   loop counter      PCNT counts both edges of the loop pin
+ *   terminal count    PCNT watch point N ─ETM─► timer STOP (etm_switch)
+ *   exit              the same watch point's callback gives one semaphore
+ *
+ * The timer stops within one ETM hop of the N-th edge, long before the
+ * next alarm, so the loop runs exactly N iterations and the CPU takes one
+ * interrupt per loop. hw_loop_run() clears the counter and restarts the
+ * timer, so a loop is re-run without rebuilding it.
+ *
+ * On the C6 ETM cannot restart PARLIO's DMA channel (IDF owns it and
+ * exposes no ETM task), so the body is the ETM task itself; more tasks
+ * can hang off the same alarm event.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_etm.h"
+#include "driver/gptimer.h"
+#include "driver/pulse_cnt.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "etm_switch.h"
+
+#define HW_LOOP_MAX_ITERATIONS  32767   // PCNT high limit
+
+typedef struct {
+    int gpio;                   // loop pin: ETM toggles it, PCNT counts it
+    uint32_t period_us;         // iteration period, >= 2
+    int iterations;             // N, 1..HW_LOOP_MAX_ITERATIONS
+} hw_loop_config_t;
+
+typedef struct {
+    hw_loop_config_t cfg;
+    gptimer_handle_t timer;
+    pcnt_unit_handle_t pcnt;
+    pcnt_channel_handle_t pcnt_chan;
+    esp_etm_event_handle_t alarm_event;
+    esp_etm_task_handle_t toggle_task;
+    esp_etm_channel_handle_t body;
+    etm_switch_t exit;
+    SemaphoreHandle_t done;
+    volatile uint32_t wakeups;  // PCNT interrupts taken by the CPU
+} hw_loop_t;
+
+// The loop timer must come out as hardware timer 0 (no other GPTimer
+// allocated): the exit route's TIMER0 STOP task is a raw ETM task ID
+esp_err_t hw_loop_new(const hw_loop_config_t *cfg, hw_loop_t *loop);
+
+// Runs the loop once and sleeps until it exits; ESP_ERR_TIMEOUT if it
+// does not finish within timeout_ms
+esp_err_t hw_loop_run(hw_loop_t *loop, int timeout_ms);
+int hw_loop_count(hw_loop_t *loop);
+void hw_loop_del(hw_loop_t *loop);
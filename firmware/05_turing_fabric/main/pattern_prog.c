@@ -0,0 +1,96 @@
+/**
+ * pattern_prog.c - Long PARLIO pulse streams from small buffers
+ *
+ * See pattern_prog.h.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#include "esp_log.h"
+#include "pattern_prog.h"
+
+static const char *TAG = "PATTERN";
+
+void pattern_prog_init(pattern_prog_t *prog) {
+    memset(prog, 0, sizeof(*prog));
+}
+
+esp_err_t pattern_prog_add(pattern_prog_t *prog, const uint8_t *buf, size_t bytes, uint32_t repeat) {
+    if (!buf || bytes == 0 || bytes > PATTERN_BLOCK_MAX || repeat == 0) {
+        ESP_LOGE(TAG, "block of %u bytes x %lu not supported (1..%d bytes)",
+                 (unsigned)bytes, (unsigned long)repeat, PATTERN_BLOCK_MAX);
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (prog->num_ops >= PATTERN_PROG_MAX_OPS) {
+        ESP_LOGE(TAG, "at most %d blocks", PATTERN_PROG_MAX_OPS);
+        return ESP_ERR_NO_MEM;
+    }
+    prog->ops[prog->num_ops++] = (pattern_op_t){ buf, (uint32_t)bytes, repeat };
+    prog->bytes += (uint64_t)bytes * repeat;
+    return ESP_OK;
+}
+
+esp_err_t pattern_prog_add_replay(pattern_prog_t *prog, const uint8_t *pattern, size_t pattern_bytes,
+                                  uint8_t *block, size_t block_cap, uint64_t total_bytes) {
+    if (block_cap > PATTERN_BLOCK_MAX) block_cap = PATTERN_BLOCK_MAX;
+    if (!pattern || !block || pattern_bytes == 0 || pattern_bytes > block_cap ||
+        total_bytes == 0 || total_bytes % pattern_bytes) {
+        ESP_LOGE(TAG, "cannot replay %u bytes to %llu", (unsigned)pattern_bytes, (unsigned long long)total_bytes);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // Whole patterns only, so every block boundary is a pattern boundary
+    size_t block_bytes = (block_cap / pattern_bytes) * pattern_bytes;
+    if (block_bytes > total_bytes) block_bytes = total_bytes;
+    for (size_t off = 0; off < block_bytes; off += pattern_bytes) {
+        memcpy(block + off, pattern, pattern_bytes);
+    }
+
+    uint64_t full = total_bytes / block_bytes;
+    size_t tail = total_bytes % block_bytes;
+    if (full > UINT32_MAX) return ESP_ERR_INVALID_ARG;
+    esp_err_t ret = pattern_prog_add(prog, block, block_bytes, (uint32_t)full);
+    if (ret == ESP_OK && tail) ret = pattern_prog_add(prog, block, tail, 1);
+    return ret;
+}
+
+uint32_t pattern_prog_transactions(const pattern_prog_t *prog) {
+    uint32_t n = 0;
+    for (int i = 0; i < prog->num_ops; i++) n += prog->ops[i].repeat;
+    return n;
+}
+
+size_t pattern_prog_memory(const pattern_prog_t *prog) {
+    size_t bytes = sizeof(*prog);
+    for (int i = 0; i < prog->num_ops; i++) {
+        // Count each buffer once, at its largest use
+        size_t largest = prog->ops[i].bytes;
+        bool seen = false;
+        for (int j = 0; j < prog->num_ops; j++) {
+            if (prog->ops[j].buf != prog->ops[i].buf) continue;
+            if (j < i) seen = true;
+            if (prog->ops[j].bytes > largest) largest = prog->ops[j].bytes;
+        }
+        if (!seen) bytes += largest;
+    }
+    return bytes;
+}
+
+esp_err_t pattern_prog_transmit(parlio_tx_unit_handle_t tx, const pattern_prog_t *prog,
+                                const parlio_transmit_config_t *cfg, uint32_t *issued) {
+    uint32_t n = 0;
+    esp_err_t ret = ESP_OK;
+    for (int i = 0; i < prog->num_ops && ret == ESP_OK; i++) {
+        const pattern_op_t *op = &prog->ops[i];
+        for (uint32_t r = 0; r < op->repeat; r++) {
+            ret = parlio_tx_unit_transmit(tx, op->buf, op->bytes * 8, cfg);
+            if (ret != ESP_OK) {
+                ESP_LOGE(TAG, "block %d repeat %lu: %s", i, (unsigned long)r, esp_err_to_name(ret));
+                break;
+            }
+            n++;
+        }
+    }
+    if (issued) *issued = n;
+    return ret;
+}
@@ -0,0 +1,63 @@
+/**
+ * pattern_prog.h - Long PARLIO pulse streams from small buffers
+ *
+ * A pattern program is a list of blocks, each played `repeat` times:
+ *
+ *   { block, 4032 B } x 260  ─┐
+ *   { block,  256 B } x 1    ─┴─► 1 MiB of stream from one 4 KB buffer
+ *
+ * pattern_prog_add_replay() unrolls a small pattern into one block of up
+ * to PATTERN_BLOCK_MAX bytes, so every transaction fills a whole GDMA
+ * descriptor, and the repeats reuse that block. pattern_prog_transmit()
+ * queues the repeats for the caller: the stream is still one driver call
+ * and one done interrupt per block, just 63x fewer than 64-byte
+ * transactions, and the caller blocks on the driver queue until the last
+ * one is queued.
+ *
+ * On the C6 the IDF PARLIO driver owns its GDMA channel and mounts its own
+ * descriptors over each transaction's buffer, so a program cannot be
+ * handed over as a linked descriptor list, and IDF 5.4 has no PARLIO TX
+ * loop transmission to repeat one. Each repeat is one queued transaction
+ * of one descriptor, and the driver queue holds pointers, so memory stays
+ * at the block size.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "driver/parlio_tx.h"
+
+#define PATTERN_BLOCK_MAX       4092    // one GDMA descriptor: 4095 rounded down to words
+#define PATTERN_PROG_MAX_OPS    16
+
+typedef struct {
+    const uint8_t *buf;
+    uint32_t bytes;             // 1..PATTERN_BLOCK_MAX
+    uint32_t repeat;
+} pattern_op_t;
+
+typedef struct {
+    pattern_op_t ops[PATTERN_PROG_MAX_OPS];
+    int num_ops;
+    uint64_t bytes;             // stream length
+} pattern_prog_t;
+
+void pattern_prog_init(pattern_prog_t *prog);
+
+// Play buf (DMA-capable, kept alive by the caller) `repeat` times
+esp_err_t pattern_prog_add(pattern_prog_t *prog, const uint8_t *buf, size_t bytes, uint32_t repeat);
+
+// Play `pattern` until total_bytes (a multiple of pattern_bytes): unrolls
+// it into block (block_cap bytes, DMA-capable) and repeats the block
+esp_err_t pattern_prog_add_replay(pattern_prog_t *prog, const uint8_t *pattern, size_t pattern_bytes,
+                                  uint8_t *block, size_t block_cap, uint64_t total_bytes);
+
+uint32_t pattern_prog_transactions(const pattern_prog_t *prog);
+size_t pattern_prog_memory(const pattern_prog_t *prog);    // distinct buffers + the program
+
+// Queues every transaction, blocking while the driver queue is full;
+// *issued (optional) counts the transactions queued
+esp_err_t pattern_prog_transmit(parlio_tx_unit_handle_t tx, const pattern_prog_t *prog,
+                                const parlio_transmit_config_t *cfg, uint32_t *issued);
@@ -0,0 +1,176 @@
+/**
+ * pcnt_cascade.c - Wide edge counts from chained 16-bit PCNT units
+ *
+ * See pcnt_cascade.h. The carry line is one GPIO ETM task channel with a
+ * SET and a CLEAR task; PCNT events have no IDF handles, so the routes
+ * onto those tasks are an etm_net netlist.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "esp_log.h"
+#include "driver/gpio.h"
+#include "driver/gpio_etm.h"
+#include "esp_private/etm_interface.h"  // GPIO task channel for the netlist
+#include "soc/soc_etm_source.h"
+#include "pcnt_cascade.h"
+
+static const char *TAG = "CASCADE";
+
+// x^-1 mod m, or 0 if gcd(x, m) != 1
+static uint32_t mod_inverse(uint64_t x, uint32_t m) {
+    int64_t r0 = m, r1 = (int64_t)(x % m), t0 = 0, t1 = 1;
+    while (r1) {
+        int64_t q = r0 / r1, tmp;
+        tmp = r0 - q * r1; r0 = r1; r1 = tmp;
+        tmp = t0 - q * t1; t0 = t1; t1 = tmp;
+    }
+    if (r0 != 1) return 0;
+    return (uint32_t)((t0 % m + m) % m);
+}
+
+static esp_err_t new_stage(pcnt_cascade_t *c, int i, int gpio, bool loop_back) {
+    pcnt_unit_config_t ucfg = {
+        .low_limit = -1,
+        .high_limit = c->cfg.limits[i],
+    };
+    esp_err_t ret = pcnt_new_unit(&ucfg, &c->units[i]);
+    if (ret != ESP_OK) return ret;
+    pcnt_chan_config_t ccfg = {
+        .edge_gpio_num = gpio,
+        .level_gpio_num = -1,
+        .flags.io_loop_back = loop_back,
+    };
+    ret = pcnt_new_channel(c->units[i], &ccfg, &c->chans[i]);
+    if (ret != ESP_OK) return ret;
+    return pcnt_channel_set_edge_action(c->chans[i], PCNT_CHANNEL_EDGE_ACTION_INCREASE,
+                                        PCNT_CHANNEL_EDGE_ACTION_HOLD);
+}
+
+esp_err_t pcnt_cascade_new(const pcnt_cascade_config_t *cfg, pcnt_cascade_t *c) {
+    memset(c, 0, sizeof(*c));
+    etm_net_init(&c->carry, "carry");
+    int n = cfg->num_stages;
+    if (n < 2 || n > PCNT_CASCADE_MAX_STAGES) {
+        ESP_LOGE(TAG, "%d stages not supported (2..%d)", n, PCNT_CASCADE_MAX_STAGES);
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (int i = 0; i < n; i++) {
+        if (cfg->limits[i] < 2 || cfg->limits[i] > PCNT_CASCADE_MAX_LIMIT) {
+            ESP_LOGE(TAG, "stage %d: limit %d out of range (2..%d)", i, cfg->limits[i], PCNT_CASCADE_MAX_LIMIT);
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+    if (cfg->limits[0] % 2) {
+        ESP_LOGE(TAG, "stage 0: limit %d must be even (carry clears at L/2)", cfg->limits[0]);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // Garner's constants: every upper modulus coprime with those below it
+    uint64_t product = cfg->limits[1];
+    for (int i = 2; i < n; i++) {
+        c->inverse[i] = mod_inverse(product, cfg->limits[i]);
+        if (!c->inverse[i]) {
+            ESP_LOGE(TAG, "stage %d: limit %d shares a factor with the stages below", i, cfg->limits[i]);
+            return ESP_ERR_INVALID_ARG;
+        }
+        product *= cfg->limits[i];
+    }
+    c->cfg = *cfg;
+    c->range = product * cfg->limits[0];
+
+    esp_err_t ret = new_stage(c, 0, cfg->input_gpio, false);
+    for (int i = 1; i < n && ret == ESP_OK; i++) ret = new_stage(c, i, cfg->carry_gpio, true);
+    if (ret != ESP_OK) goto err;
+    pcnt_unit_add_watch_point(c->units[0], cfg->limits[0] / 2);
+    pcnt_unit_add_watch_point(c->units[0], cfg->limits[0]);     // enables the limit event
+    gpio_set_direction(cfg->carry_gpio, GPIO_MODE_INPUT_OUTPUT);
+    gpio_set_level(cfg->carry_gpio, 0);
+
+    // Carry line: SET and CLEAR share one GPIO task channel
+    gpio_etm_task_config_t gcfg = { .actions = { GPIO_ETM_TASK_ACTION_SET, GPIO_ETM_TASK_ACTION_CLR } };
+    if ((ret = gpio_new_etm_task(&gcfg, &c->carry_set, &c->carry_clear)) != ESP_OK ||
+        (ret = gpio_etm_task_add_gpio(c->carry_set, cfg->carry_gpio)) != ESP_OK) {
+        goto err;
+    }
+    char set[ETM_NET_NAME_LEN], clear[ETM_NET_NAME_LEN];
+    int k = c->carry_set->task_id - GPIO_TASK_CH0_SET;
+    snprintf(set, sizeof(set), "gpio.ch%d.set", k);
+    snprintf(clear, sizeof(clear), "gpio.ch%d.clear", k);
+    if ((ret = etm_net_connect(&c->carry, "pcnt.limit", set, ETM_CHANNEL_AUTO)) != ESP_OK ||
+        (ret = etm_net_connect(&c->carry, "pcnt.thresh", clear, ETM_CHANNEL_AUTO)) != ESP_OK ||
+        (ret = etm_net_load(&c->carry)) != ESP_OK) {
+        goto err;
+    }
+
+    for (int i = 0; i < n; i++) pcnt_unit_enable(c->units[i]);
+    return ESP_OK;
+
+err:
+    ESP_LOGE(TAG, "setup failed: %s", esp_err_to_name(ret));
+    pcnt_cascade_del(c);
+    return ret;
+}
+
+void pcnt_cascade_start(pcnt_cascade_t *c) {
+    // Top down, so no carry arrives at a stage that is not counting yet
+    for (int i = c->cfg.num_stages - 1; i >= 0; i--) pcnt_unit_start(c->units[i]);
+}
+
+void pcnt_cascade_stop(pcnt_cascade_t *c) {
+    for (int i = 0; i < c->cfg.num_stages; i++) pcnt_unit_stop(c->units[i]);
+}
+
+void pcnt_cascade_clear(pcnt_cascade_t *c) {
+    // A high carry line is cleared at stage 0's L/2, before its next wrap
+    for (int i = 0; i < c->cfg.num_stages; i++) pcnt_unit_clear_count(c->units[i]);
+    c->retries = 0;
+}
+
+static void read_upper(pcnt_cascade_t *c, int *r) {
+    for (int i = 1; i < c->cfg.num_stages; i++) pcnt_unit_get_count(c->units[i], &r[i]);
+}
+
+uint64_t pcnt_cascade_read(pcnt_cascade_t *c) {
+    int hi[PCNT_CASCADE_MAX_STAGES], again[PCNT_CASCADE_MAX_STAGES], lo;
+    int n = c->cfg.num_stages;
+    read_upper(c, hi);
+    for (;;) {
+        pcnt_unit_get_count(c->units[0], &lo);
+        read_upper(c, again);
+        if (memcmp(&hi[1], &again[1], (n - 1) * sizeof(int)) == 0) break;
+        memcpy(hi, again, sizeof(hi));
+        c->retries++;
+    }
+
+    // Garner: carries = r1 + M1 * (t2 + M2 * (t3 + ...))
+    uint64_t carries = hi[1], modulus = c->cfg.limits[1];
+    for (int i = 2; i < n; i++) {
+        uint32_t m = c->cfg.limits[i];
+        uint64_t diff = (hi[i] + m - carries % m) % m;
+        carries += modulus * (diff * c->inverse[i] % m);
+        modulus *= m;
+    }
+    return carries * c->cfg.limits[0] + lo;
+}
+
+int pcnt_cascade_bits(const pcnt_cascade_t *c) {
+    return c->range ? 63 - __builtin_clzll(c->range) : 0;
+}
+
+void pcnt_cascade_del(pcnt_cascade_t *c) {
+    etm_net_unload(&c->carry);
+    if (c->carry_set) {
+        gpio_etm_task_rm_gpio(c->carry_set, c->cfg.carry_gpio);
+        esp_etm_del_task(c->carry_set);
+    }
+    if (c->carry_clear) esp_etm_del_task(c->carry_clear);
+    for (int i = 0; i < PCNT_CASCADE_MAX_STAGES; i++) {
+        if (!c->units[i]) continue;
+        pcnt_unit_stop(c->units[i]);
+        pcnt_unit_disable(c->units[i]);
+        if (c->chans[i]) pcnt_del_channel(c->chans[i]);
+        pcnt_del_unit(c->units[i]);
+    }
+    memset(c, 0, sizeof(*c));
+}
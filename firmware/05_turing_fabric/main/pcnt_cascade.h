@@ -0,0 +1,67 @@
+/**
+ * pcnt_cascade.h - Wide edge counts from chained 16-bit PCNT units
+ *
+ *   input ──► stage 0 (limit L) ──ETM──► carry line ──► stage 1 (mod M1)
+ *                                                   ├──► stage 2 (mod M2)
+ *                                                   └──► ...
+ *
+ *   pcnt.limit  ─ETM─► GPIO SET   carry line    (stage 0 wraps)
+ *   pcnt.thresh ─ETM─► GPIO CLEAR carry line    (stage 0 at L/2)
+ *
+ * Stage 0 counts the input and wraps every L edges; each wrap raises the
+ * carry line once and the upper stages count its rising edges. On the C6
+ * the PCNT ETM events are shared by all units, so an upper stage's own
+ * limit event cannot be told apart from stage 0's and cannot carry into
+ * the next stage. The upper stages therefore all count the one carry line
+ * against pairwise coprime limits, and the reader rebuilds the carry count
+ * from their residues (CRT):
+ *
+ *   count = L * crt(c1 mod M1, c2 mod M2, ...) + c0,  range L * M1 * M2 ...
+ *
+ * An upper stage only wraps on a carry edge, while the line is already
+ * high, so its aliased SET changes nothing. That holds while the line
+ * stays high for longer than one carry hop: L/2 input edges > the carry
+ * latency (PCNT event + ETM route), which bounds the counting rate.
+ *
+ * pcnt_cascade_read() is consistent while counting: it reads the upper
+ * stages, stage 0, then the upper stages again and retries if a carry
+ * landed in between. Each driver read outlasts the carry latency, so the
+ * second read includes any wrap stage 0 showed.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_etm.h"
+#include "driver/pulse_cnt.h"
+#include "etm_net.h"
+
+#define PCNT_CASCADE_MAX_STAGES     4       // PCNT units on the C6
+#define PCNT_CASCADE_MAX_LIMIT      32767
+
+typedef struct {
+    int input_gpio;             // rising edges are counted
+    int carry_gpio;             // driven by ETM, read back by the upper stages
+    int limits[PCNT_CASCADE_MAX_STAGES];    // stage 0 period (even), then coprime moduli
+    int num_stages;             // 2..PCNT_CASCADE_MAX_STAGES
+} pcnt_cascade_config_t;
+
+typedef struct {
+    pcnt_cascade_config_t cfg;
+    pcnt_unit_handle_t units[PCNT_CASCADE_MAX_STAGES];
+    pcnt_channel_handle_t chans[PCNT_CASCADE_MAX_STAGES];
+    esp_etm_task_handle_t carry_set, carry_clear;
+    etm_net_t carry;
+    uint32_t inverse[PCNT_CASCADE_MAX_STAGES];  // (M1 * ... * Mi-1)^-1 mod Mi
+    uint64_t range;             // counts before the cascade wraps
+    uint32_t retries;           // reads repeated because a carry landed
+} pcnt_cascade_t;
+
+esp_err_t pcnt_cascade_new(const pcnt_cascade_config_t *cfg, pcnt_cascade_t *c);
+void pcnt_cascade_start(pcnt_cascade_t *c);
+void pcnt_cascade_stop(pcnt_cascade_t *c);
+void pcnt_cascade_clear(pcnt_cascade_t *c);     // call stopped, with the input idle
+uint64_t pcnt_cascade_read(pcnt_cascade_t *c);
+int pcnt_cascade_bits(const pcnt_cascade_t *c); // floor(log2(range))
+void pcnt_cascade_del(pcnt_cascade_t *c);
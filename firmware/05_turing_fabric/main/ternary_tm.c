@@ -0,0 +1,234 @@
+/**
+ * ternary_tm.c - Ternary Turing machine compiler and fabric runtime
+ *
+ * See ternary_tm.h for the lowering. Every step, the fabric reads the
+ * head cell: PARLIO plays the cell's burst into two PCNT units, their
+ * boundary events capture two timers through ETM, and the number of
+ * fresh captures indexes the state's lookup.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "esp_log.h"
+#include "ternary_tm.h"
+#include "etm_regs.h"
+
+static const char *TAG = "TTM";
+
+// ============================================================
+// Compiler
+// ============================================================
+
+static esp_err_t check_program(const ttm_program_t *p) {
+    if (p->num_states == 0 || p->num_states > TTM_MAX_STATES) {
+        ESP_LOGE(TAG, "%s: %d states (1..%d)", p->name, p->num_states, TTM_MAX_STATES);
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (p->start >= p->num_states) {
+        ESP_LOGE(TAG, "%s: start state %d out of range", p->name, p->start);
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (int q = 0; q < p->num_states; q++) {
+        for (int s = 0; s < TTM_NUM_SYMBOLS; s++) {
+            const ttm_rule_t *r = &p->rules[q][s];
+            if ((r->next >= p->num_states && r->next != TTM_HALT) ||
+                r->write < -1 || r->write > 1 || r->move < -1 || r->move > 1) {
+                ESP_LOGE(TAG, "%s: bad rule at state %d symbol %+d", p->name, q, s - 1);
+                return ESP_ERR_INVALID_ARG;
+            }
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t ttm_compile(const ttm_program_t *program, int first_channel, ttm_image_t *image) {
+    esp_err_t ret = check_program(program);
+    if (ret != ESP_OK) return ret;
+    if (first_channel < 0 || first_channel + TTM_ETM_ROUTES > ETM_NUM_CHANNELS) {
+        ESP_LOGE(TAG, "ETM channels %d..%d out of range (0..%d)",
+                 first_channel, first_channel + TTM_ETM_ROUTES - 1, ETM_NUM_CHANNELS - 1);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(image, 0, sizeof(*image));
+    image->program = program;
+
+    // Symbol bursts; bytes past the burst stay 0 (idle), so every cell
+    // plays the same TTM_PATTERN_BITS
+    for (int s = 0; s < TTM_NUM_SYMBOLS; s++) {
+        int edges = TTM_BASE_EDGES + s * TTM_STEP_EDGES;
+        memset(image->pattern[s], 0x55, edges / TTM_EDGES_PER_BYTE);
+    }
+
+    // Symbol s crosses s + 1 boundaries, so crossings index the rules
+    for (int q = 0; q < program->num_states; q++) {
+        for (int c = 0; c < TTM_NUM_SYMBOLS; c++) {
+            const ttm_rule_t *r = &program->rules[q][c];
+            image->lookup[q][c] = (ttm_step_t){ r->next, r->move, image->pattern[r->write + 1] };
+        }
+    }
+
+    // Boundaries halfway between neighbouring bursts
+    image->lo_limit = TTM_BASE_EDGES + TTM_STEP_EDGES / 2;
+    image->hi_watch = image->lo_limit + TTM_STEP_EDGES;
+    image->margin_edges = TTM_STEP_EDGES / 2;
+
+    image->routes[0] = (ttm_route_t){ first_channel, PCNT_EVT_CNT_EQ_LMT, TIMER0_TASK_CNT_CAP_TIMER0 };
+    image->routes[1] = (ttm_route_t){ first_channel + 1, PCNT_EVT_CNT_EQ_THRESH, TIMER1_TASK_CNT_CAP_TIMER0 };
+    return ESP_OK;
+}
+
+// ============================================================
+// Reference
+// ============================================================
+
+static void reference_apply(const ttm_program_t *program, ttm_machine_t *m, int8_t symbol) {
+    const ttm_rule_t *r = &program->rules[m->state][symbol + 1];
+    m->tape[m->head] = r->write;
+    m->steps++;
+    if (r->next == TTM_HALT) {
+        m->halted = true;
+        return;
+    }
+    m->state = r->next;
+    m->head += r->move;
+    if (m->head < 0 || m->head >= m->tape_len) m->fault = true;
+}
+
+void ttm_reference_run(const ttm_program_t *program, ttm_machine_t *m, uint64_t max_steps) {
+    while (!m->halted && !m->fault && m->steps < max_steps) {
+        reference_apply(program, m, m->tape[m->head]);
+    }
+}
+
+// ============================================================
+// Fabric Runtime
+// ============================================================
+
+esp_err_t ttm_fabric_load(ttm_fabric_t *f, const ttm_image_t *image,
+                          parlio_tx_unit_handle_t parlio, int pattern_gpio) {
+    memset(f, 0, sizeof(*f));
+    f->image = image;
+    f->parlio = parlio;
+
+    // LO resets at its limit (LMT); HI keeps counting past its watch point
+    esp_err_t ret = etm_pcnt_new_counter(pattern_gpio, image->lo_limit, &f->pcnt_lo, &f->chan_lo);
+    if (ret != ESP_OK) return ret;
+    ret = etm_pcnt_new_counter(pattern_gpio, 32767, &f->pcnt_hi, &f->chan_hi);
+    if (ret != ESP_OK) return ret;
+
+    gptimer_config_t tcfg = {
+        .clk_src = GPTIMER_CLK_SRC_DEFAULT,
+        .direction = GPTIMER_COUNT_UP,
+        .resolution_hz = 1000000,
+    };
+    for (int i = 0; i < 2; i++) {
+        ret = gptimer_new_timer(&tcfg, &f->timer[i]);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "need both GPTimers free: %s", esp_err_to_name(ret));
+            return ret;
+        }
+        gptimer_enable(f->timer[i]);
+        gptimer_start(f->timer[i]);
+    }
+
+    // The routes are a two-case switch: LO's limit and HI's watch point
+    const ttm_route_t *lo = &image->routes[0], *hi = &image->routes[1];
+    etm_switch_init(&f->branch);
+    etm_case_t lo_case = {
+        .kind = ETM_CASE_PCNT_LIMIT,
+        .sources = { { f->pcnt_lo, image->lo_limit } }, .num_sources = 1,
+        .tasks = { lo->task_id }, .num_tasks = 1,
+        .channel = lo->channel,
+    };
+    etm_case_t hi_case = {
+        .kind = ETM_CASE_PCNT_WATCH,
+        .sources = { { f->pcnt_hi, image->hi_watch } }, .num_sources = 1,
+        .tasks = { hi->task_id }, .num_tasks = 1,
+        .channel = hi->channel,
+    };
+    if ((ret = etm_switch_add_case(&f->branch, &lo_case)) != ESP_OK) return ret;
+    if ((ret = etm_switch_add_case(&f->branch, &hi_case)) != ESP_OK) return ret;
+    if ((ret = etm_switch_load(&f->branch)) != ESP_OK) return ret;
+
+    pcnt_unit_enable(f->pcnt_lo);
+    pcnt_unit_enable(f->pcnt_hi);
+    pcnt_unit_start(f->pcnt_lo);
+    pcnt_unit_start(f->pcnt_hi);
+    return ESP_OK;
+}
+
+// One fabric read of the head cell: play its burst, count fresh captures
+static esp_err_t fabric_read(ttm_fabric_t *f, const uint8_t *cell, int *crossings) {
+    uint64_t start[2], cap[2];
+
+    pcnt_unit_clear_count(f->pcnt_lo);
+    pcnt_unit_clear_count(f->pcnt_hi);
+    gptimer_get_raw_count(f->timer[0], &start[0]);
+    gptimer_get_raw_count(f->timer[1], &start[1]);
+
+    parlio_transmit_config_t tx_cfg = { .idle_value = 0 };
+    esp_err_t ret = parlio_tx_unit_transmit(f->parlio, cell, TTM_PATTERN_BITS, &tx_cfg);
+    if (ret != ESP_OK) return ret;
+    ret = parlio_tx_unit_wait_all_done(f->parlio, 100);
+    if (ret != ESP_OK) return ret;
+
+    gptimer_get_captured_count(f->timer[0], &cap[0]);
+    gptimer_get_captured_count(f->timer[1], &cap[1]);
+    *crossings = (cap[0] > start[0]) + (cap[1] > start[1]);
+    return ESP_OK;
+}
+
+void ttm_apply(ttm_fabric_t *f, ttm_machine_t *m, int crossings) {
+    const ttm_step_t *st = &f->image->lookup[m->state][crossings];
+    f->tape[m->head] = st->write;
+    m->steps++;
+    if (st->next == TTM_HALT) {
+        m->halted = true;
+        return;
+    }
+    m->state = st->next;
+    m->head += st->move;
+    if (m->head < 0 || m->head >= m->tape_len) m->fault = true;
+}
+
+esp_err_t ttm_fabric_run(ttm_fabric_t *f, ttm_machine_t *m, uint64_t max_steps) {
+    const ttm_image_t *img = f->image;
+    if (m->tape_len > TTM_MAX_TAPE) {
+        ESP_LOGE(TAG, "tape of %d cells (at most %d)", m->tape_len, TTM_MAX_TAPE);
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (int i = 0; i < m->tape_len; i++) f->tape[i] = img->pattern[m->tape[i] + 1];
+
+    esp_err_t ret = ESP_OK;
+    while (!m->halted && !m->fault && m->steps < max_steps) {
+        int crossings;
+        ret = fabric_read(f, f->tape[m->head], &crossings);
+        if (ret != ESP_OK) break;
+        ttm_apply(f, m, crossings);
+    }
+
+    for (int i = 0; i < m->tape_len; i++) {
+        m->tape[i] = (int8_t)((f->tape[i] - img->pattern[0]) / TTM_PATTERN_BYTES - 1);
+    }
+    return ret;
+}
+
+void ttm_fabric_unload(ttm_fabric_t *f) {
+    etm_switch_unload(&f->branch);
+    for (int i = 0; i < 2; i++) {
+        if (!f->timer[i]) continue;
+        gptimer_stop(f->timer[i]);
+        gptimer_disable(f->timer[i]);
+        gptimer_del_timer(f->timer[i]);
+    }
+    pcnt_unit_handle_t units[2] = { f->pcnt_lo, f->pcnt_hi };
+    pcnt_channel_handle_t chans[2] = { f->chan_lo, f->chan_hi };
+    for (int i = 0; i < 2; i++) {
+        if (!units[i]) continue;
+        pcnt_unit_stop(units[i]);
+        pcnt_unit_disable(units[i]);
+        if (chans[i]) pcnt_del_channel(chans[i]);
+        pcnt_del_unit(units[i]);
+    }
+}
@@ -0,0 +1,123 @@
+/**
+ * ternary_tm.h - Ternary Turing machine compiler for the ETM fabric
+ *
+ * A program is a transition table over trit symbols {-1, 0, +1}: for each
+ * (state, symbol) a rule gives the next state, the trit to write and the
+ * head move. ttm_compile() lowers it onto fabric resources:
+ *
+ *   DMA patterns   one buffer per symbol, a burst of 0x55 bytes whose
+ *                  rising-edge count encodes the symbol (4 / 12 / 20),
+ *                  padded with idle bytes to one length
+ *   PCNT           unit LO counts the burst with its limit at 8 edges
+ *                  (PCNT_EVT_CNT_EQ_LMT), unit HI with a watch point at
+ *                  16 edges (PCNT_EVT_CNT_EQ_THRESH)
+ *   ETM            LMT → capture timer 0, THRESH → capture timer 1,
+ *                  loaded as a two-case etm_switch
+ *   Lookup         per state, the rule for each crossing count (0..2):
+ *                  next state, the pattern buffer to write, head move
+ *
+ * so the 3-way read of the head cell is decided in hardware: a capture
+ * newer than the step start means its threshold was crossed. The tape
+ * the fabric runs holds pattern-buffer pointers, not trits, and a step is
+ * "play the head cell's buffer, index the lookup with the crossings".
+ * The C6 cannot select a DMA buffer from data, so the CPU still queues
+ * the buffer and follows the lookup between steps, but it never reads a
+ * symbol: the crossing count is the only input to ttm_apply().
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "driver/gptimer.h"
+#include "driver/pulse_cnt.h"
+#include "driver/parlio_tx.h"
+#include "etm_switch.h"
+
+#define TTM_MAX_STATES      16
+#define TTM_NUM_SYMBOLS     3       // -1, 0, +1
+#define TTM_HALT            0xFF    // next state that stops the machine
+
+// Symbol encoding: -1 → BASE edges, each step up adds STEP edges
+#define TTM_BASE_EDGES      4
+#define TTM_STEP_EDGES      8
+#define TTM_EDGES_PER_BYTE  4       // 0x55 = 4 rising edges
+#define TTM_PATTERN_BYTES   ((TTM_BASE_EDGES + (TTM_NUM_SYMBOLS - 1) * TTM_STEP_EDGES) / TTM_EDGES_PER_BYTE)
+#define TTM_PATTERN_BITS    (TTM_PATTERN_BYTES * 8)     // every burst, idle-padded
+#define TTM_ETM_ROUTES      2
+#define TTM_MAX_TAPE        64
+
+typedef struct {
+    uint8_t next;           // state index or TTM_HALT
+    int8_t write;           // trit written to the head cell
+    int8_t move;            // -1 left, 0 stay, +1 right
+} ttm_rule_t;
+
+typedef struct {
+    const char *name;
+    uint8_t num_states;
+    uint8_t start;
+    ttm_rule_t rules[TTM_MAX_STATES][TTM_NUM_SYMBOLS];  // [state][symbol + 1]
+} ttm_program_t;
+
+typedef struct {
+    uint8_t channel;
+    uint8_t event_id;
+    uint8_t task_id;
+} ttm_route_t;
+
+// A rule lowered for the fabric: what follows a read of `crossings`
+typedef struct {
+    uint8_t next;           // state index or TTM_HALT
+    int8_t move;            // -1 left, 0 stay, +1 right
+    const uint8_t *write;   // pattern buffer of the written trit
+} ttm_step_t;
+
+// Compiled fabric image
+typedef struct {
+    const ttm_program_t *program;
+    uint8_t pattern[TTM_NUM_SYMBOLS][TTM_PATTERN_BYTES];
+    ttm_step_t lookup[TTM_MAX_STATES][TTM_NUM_SYMBOLS];     // [state][crossings]
+    int lo_limit;           // PCNT unit LO high limit (LMT event)
+    int hi_watch;           // PCNT unit HI watch point (THRESH event)
+    int margin_edges;       // closest any symbol burst gets to a boundary
+    ttm_route_t routes[TTM_ETM_ROUTES];
+} ttm_image_t;
+
+typedef struct {
+    int8_t *tape;
+    int tape_len;
+    int head;
+    uint8_t state;
+    uint64_t steps;
+    bool halted;
+    bool fault;             // head left the tape
+} ttm_machine_t;
+
+// Fabric resources owned by a loaded image
+typedef struct {
+    const ttm_image_t *image;
+    parlio_tx_unit_handle_t parlio;
+    pcnt_unit_handle_t pcnt_lo, pcnt_hi;
+    pcnt_channel_handle_t chan_lo, chan_hi;
+    gptimer_handle_t timer[2];
+    etm_switch_t branch;    // the routes as a two-case switch
+    const uint8_t *tape[TTM_MAX_TAPE];  // the machine's tape as pattern buffers
+} ttm_fabric_t;
+
+esp_err_t ttm_compile(const ttm_program_t *program, int first_channel, ttm_image_t *image);
+
+// Rule table run on a trit tape in memory, to check the fabric against
+void ttm_reference_run(const ttm_program_t *program, ttm_machine_t *m, uint64_t max_steps);
+
+// Creates two PCNT units on pattern_gpio and two GPTimers (both must be
+// free, so the routes' TIMER0/TIMER1 task IDs hit them), wires the routes.
+esp_err_t ttm_fabric_load(ttm_fabric_t *f, const ttm_image_t *image,
+                          parlio_tx_unit_handle_t parlio, int pattern_gpio);
+// Runs m on the fabric: its trit tape is lowered to pattern buffers first
+// and raised back when the machine stops (halt, fault or max_steps)
+esp_err_t ttm_fabric_run(ttm_fabric_t *f, ttm_machine_t *m, uint64_t max_steps);
+// One step from the fabric's read of the head cell
+void ttm_apply(ttm_fabric_t *f, ttm_machine_t *m, int crossings);
+void ttm_fabric_unload(ttm_fabric_t *f);
@@ -30,6 +30,9 @@
 
 #include <stdio.h>
 #include <string.h>
+#ifdef PULSE_LAB_HOST
+#include <time.h>
+#endif
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_timer.h"
@@ -38,26 +41,19 @@
 #include "driver/pulse_cnt.h"
 #include "driver/parlio_tx.h"
 #include "driver/gpio.h"
+#include "driver/gpio_etm.h"
 #include "soc/soc_etm_source.h"
+#include "etm_regs.h"  // bare metal - PCNT ETM not in ESP-IDF API
+#include "ternary_tm.h"
+#include "etm_switch.h"
+#include "etm_net.h"
+#include "pcnt_cascade.h"
+#include "hw_loop.h"
+#include "pattern_prog.h"
+#include "pulse_bench.h"    // pulse_lab component
 
 static const char *TAG = "TURING";
 
-// ============================================================
-// ETM Register Definitions (bare metal - PCNT ETM not in ESP-IDF API)
-// ============================================================
-
-#define ETM_BASE                    0x600B8000
-#define ETM_CH_ENA_SET_REG          (ETM_BASE + 0x04)
-#define ETM_CH_ENA_CLR_REG          (ETM_BASE + 0x08)
-#define ETM_CH_EVT_ID_REG(n)        (ETM_BASE + 0x18 + (n) * 8)
-#define ETM_CH_TASK_ID_REG(n)       (ETM_BASE + 0x1C + (n) * 8)
-
-#define ETM_REG(addr)               (*(volatile uint32_t*)(addr))
-
-// PCR for ETM clock
-#define PCR_BASE                    0x60096000
-#define PCR_SOC_ETM_CONF            (PCR_BASE + 0x90)
-
 // ============================================================
 // Configuration
 // ============================================================
@@ -66,6 +62,7 @@ static const char *TAG = "TURING";
 #define PARLIO_CLK_HZ       2000000 // 2 MHz pulse rate
 #define THRESHOLD_EDGES     256     // PCNT threshold for conditional branch
 #define TIMER_ALARM_US      10000   // Timer alarm at 10ms (should NOT reach if ETM works)
+#define BRANCH_ETM_CHANNEL  10      // PCNT threshold → Timer stop (test 2)
 
 // ============================================================
 // Global Handles
@@ -82,6 +79,8 @@ static parlio_tx_unit_handle_t parlio = NULL;
 static uint8_t __attribute__((aligned(4))) pattern_256_edges[64];
 
 static volatile int tx_done_count = 0;
+static volatile int tx_done_target = 0;
+static TaskHandle_t tx_waiter = NULL;      // notified when tx_done_count hits the target
 
 // ============================================================
 // ETM Clock Enable
@@ -98,22 +97,27 @@ static void etm_enable_clock(void) {
 // THE KEY: Wire PCNT threshold → Timer stop via ETM
 // ============================================================
 
+static etm_net_t branch_net;     // handed back before test 5
+
 static void etm_wire_pcnt_to_timer_stop(int etm_channel) {
-    // PCNT doesn't have ESP-IDF ETM API, so we wire it directly via registers
+    // PCNT doesn't have ESP-IDF ETM API, so the netlist writes the matrix
     //
-    // Event: PCNT_EVT_CNT_EQ_THRESH (45)
+    // Event: pcnt.thresh = PCNT_EVT_CNT_EQ_THRESH (45)
     //   - Fires when PCNT count reaches a watch point value
     //
-    // Task: TIMER0_TASK_CNT_STOP_TIMER0 (92)
+    // Task: timer0.stop = TIMER0_TASK_CNT_STOP_TIMER0 (92)
     //   - Stops Timer0 counting
     //
     // This creates hardware IF/ELSE:
     //   IF (PCNT >= threshold) → Timer STOPS
     //   ELSE → Timer continues
     
-    ETM_REG(ETM_CH_EVT_ID_REG(etm_channel)) = PCNT_EVT_CNT_EQ_THRESH;      // Event 45
-    ETM_REG(ETM_CH_TASK_ID_REG(etm_channel)) = TIMER0_TASK_CNT_STOP_TIMER0; // Task 92
-    ETM_REG(ETM_CH_ENA_SET_REG) = (1 << etm_channel);
+    etm_net_init(&branch_net, "branch");
+    if (etm_net_connect(&branch_net, "pcnt.thresh", "timer0.stop", etm_channel) != ESP_OK ||
+        etm_net_load(&branch_net) != ESP_OK) {
+        ESP_LOGE(TAG, "ETM CH%d: PCNT threshold → Timer0 STOP not wired", etm_channel);
+        return;
+    }
     
     ESP_LOGI(TAG, "ETM CH%d: PCNT threshold (%d) → Timer0 STOP", 
              etm_channel, THRESHOLD_EDGES);
@@ -174,16 +178,16 @@ static esp_err_t setup_pcnt(void) {
     return ESP_OK;
 }
 
-static esp_err_t setup_parlio(void) {
+static esp_err_t setup_parlio(uint32_t clk_hz) {
     parlio_tx_unit_config_t cfg = {
         .clk_src = PARLIO_CLK_SRC_DEFAULT,
         .clk_in_gpio_num = -1,
-        .output_clk_freq_hz = PARLIO_CLK_HZ,
+        .output_clk_freq_hz = clk_hz,
         .data_width = 1,
         .clk_out_gpio_num = -1,
         .valid_gpio_num = -1,
         .trans_queue_depth = 16,
-        .max_transfer_size = 256,
+        .max_transfer_size = PATTERN_BLOCK_MAX,    // one GDMA descriptor (test 9)
         .sample_edge = PARLIO_SAMPLE_EDGE_POS,
         .bit_pack_order = PARLIO_BIT_PACK_ORDER_LSB,
         .flags = { .io_loop_back = 1 },  // Internal loopback: output feeds back to input
@@ -197,8 +201,6 @@ static esp_err_t setup_parlio(void) {
     if (ret != ESP_OK) return ret;
     
     parlio_tx_unit_enable(parlio);
-    
-    ESP_LOGI(TAG, "PARLIO: GPIO%d at %d Hz with loopback", TEST_GPIO, PARLIO_CLK_HZ);
     return ESP_OK;
 }
 
@@ -219,6 +221,13 @@ static bool IRAM_ATTR parlio_done_cb(parlio_tx_unit_handle_t unit,
                                       const parlio_tx_done_event_data_t *edata, 
                                       void *user_ctx) {
     tx_done_count++;
+    
+    // One task wake-up per batch, not per transmission
+    if (tx_waiter && tx_done_count == tx_done_target) {
+        BaseType_t woken = pdFALSE;
+        vTaskNotifyGiveFromISR(tx_waiter, &woken);
+        return woken == pdTRUE;
+    }
     return false;
 }
 
@@ -264,7 +273,7 @@ static bool test_conditional_branch(void) {
     printf("----------------------------------------------------------------------\n");
     
     // Wire ETM: PCNT threshold → Timer stop
-    etm_wire_pcnt_to_timer_stop(10);  // Use ETM channel 10
+    etm_wire_pcnt_to_timer_stop(BRANCH_ETM_CHANNEL);
     
     // Reset counters
     pcnt_unit_clear_count(pcnt);
@@ -371,63 +380,1246 @@ static bool test_else_branch(void) {
 // TEST 4: Autonomous Operation (CPU idle while hardware executes)
 // ============================================================
 
-static bool test_autonomous_operation(void) {
-    printf("\n");
-    printf("----------------------------------------------------------------------\n");
-    printf("  TEST 4: Autonomous Operation (CPU Idle)\n");
-    printf("----------------------------------------------------------------------\n");
-    
-    // Register callback to count completions
-    parlio_tx_event_callbacks_t cbs = { .on_trans_done = parlio_done_cb };
-    parlio_tx_unit_register_event_callbacks(parlio, &cbs, NULL);
-    
+typedef enum { WAIT_SPIN, WAIT_NOTIFY } wait_mode_t;
+
+// CPU busy is the part of the wait the CPU was not idle. On the device,
+// the wait minus the idle task's run time from the FreeRTOS run-time
+// counters (us, see sdkconfig.defaults). On the host, the waiting
+// thread's CPU time minus what the simulator spent modelling hardware
+// while the firmware was blocked, over the wait's wall-clock time.
+#if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS || defined(PULSE_LAB_HOST)
+#define CPU_BUSY_MEASURED   1
+#else
+#define CPU_BUSY_MEASURED   0
+#endif
+
+#ifdef PULSE_LAB_HOST
+static int64_t clock_ns(clockid_t id) {
+    struct timespec ts;
+    clock_gettime(id, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+#endif
+
+typedef struct {
+    int64_t queue_us, wait_us, total_us;
+    double busy;                // share of the wait the CPU was busy (CPU_BUSY_MEASURED only)
+    int spins, wakeups, done, edges;
+} autonomous_run_t;
+
+static void run_autonomous(wait_mode_t mode, int num_tx, autonomous_run_t *r) {
+    memset(r, 0, sizeof(*r));
     pcnt_unit_clear_count(pcnt);
     tx_done_count = 0;
-    
-    int num_tx = 100;
+    ulTaskNotifyTake(pdTRUE, 0);
+    tx_done_target = num_tx;
+    tx_waiter = (mode == WAIT_NOTIFY) ? xTaskGetCurrentTaskHandle() : NULL;
+
     parlio_transmit_config_t tx_cfg = { .idle_value = 0 };
-    
-    printf("  Queueing %d transmissions...\n", num_tx);
-    
     int64_t start = esp_timer_get_time();
-    
+
     // Queue all transmissions (CPU does work here)
     for (int i = 0; i < num_tx; i++) {
         parlio_tx_unit_transmit(parlio, pattern_256_edges, 64 * 8, &tx_cfg);
     }
-    
     int64_t queued = esp_timer_get_time();
-    printf("  Queue time: %lld us\n", queued - start);
-    printf("  CPU now idle while hardware executes...\n");
-    
-    // CPU idle loop - just spin while hardware does work
-    // In real application, CPU could enter WFI (wait for interrupt) or light sleep
-    int loops = 0;
-    while (tx_done_count < num_tx && loops < 10000000) {
-        __asm__ volatile("nop");
-        loops++;
+#ifdef PULSE_LAB_HOST
+    int64_t wall_start = clock_ns(CLOCK_MONOTONIC);
+    int64_t cpu_start = clock_ns(CLOCK_THREAD_CPUTIME_ID);
+    uint64_t blocked_start = etm_sim_blocked_cpu_ns();
+#elif CPU_BUSY_MEASURED
+    configRUN_TIME_COUNTER_TYPE idle_start = ulTaskGetIdleRunTimeCounter();
+#endif
+
+    if (mode == WAIT_SPIN) {
+        // Polling keeps the core busy for the whole run
+        while (tx_done_count < num_tx && r->spins < 10000000) {
+            CPU_RELAX();
+            r->spins++;
+        }
+    } else {
+        // Blocked: the scheduler runs other tasks or the idle task's WFI,
+        // and the ISR wakes us once, on the last completion
+        while (tx_done_count < num_tx) {
+            if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000)) == 0) break;
+            r->wakeups++;
+        }
     }
-    
     int64_t end = esp_timer_get_time();
+#ifdef PULSE_LAB_HOST
+    int64_t busy_ns = clock_ns(CLOCK_THREAD_CPUTIME_ID) - cpu_start
+                    - (int64_t)(etm_sim_blocked_cpu_ns() - blocked_start);
+    int64_t wall_ns = clock_ns(CLOCK_MONOTONIC) - wall_start;
+    r->busy = (wall_ns > 0 && busy_ns > 0) ? (double)busy_ns / wall_ns : 0.0;
+#elif CPU_BUSY_MEASURED
+    int64_t idle_us = (int64_t)(configRUN_TIME_COUNTER_TYPE)(ulTaskGetIdleRunTimeCounter() - idle_start);
+    r->busy = (end > queued && idle_us < end - queued) ? (double)(end - queued - idle_us) / (end - queued) : 0.0;
+#endif
+    tx_waiter = NULL;
+
+    r->queue_us = queued - start;
+    r->wait_us = end - queued;
+    r->total_us = end - start;
+    r->done = tx_done_count;
+    pcnt_unit_get_count(pcnt, &r->edges);
+}
+
+static bool test_autonomous_operation(void) {
+    printf("\n");
+    printf("----------------------------------------------------------------------\n");
+    printf("  TEST 4: Autonomous Operation (CPU Idle)\n");
+    printf("----------------------------------------------------------------------\n");
     
-    int count;
-    pcnt_unit_get_count(pcnt, &count);
-    int expected = num_tx * 256;
+    // Register callback to count completions
+    parlio_tx_event_callbacks_t cbs = { .on_trans_done = parlio_done_cb };
+    parlio_tx_unit_register_event_callbacks(parlio, &cbs, NULL);
     
-    printf("  Total time: %lld us\n", end - start);
-    printf("  TX completed: %d/%d\n", tx_done_count, num_tx);
-    printf("  PCNT count: %d (expected: %d)\n", count, expected);
-    printf("  CPU spin loops: %d\n", loops);
+    int num_tx = 100;
+    int expected = num_tx * 256;
+    printf("  Queueing %d transmissions, then waiting for the hardware...\n", num_tx);
+    
+    autonomous_run_t runs[2];
+    run_autonomous(WAIT_SPIN, num_tx, &runs[0]);
+    vTaskDelay(pdMS_TO_TICKS(10));
+    run_autonomous(WAIT_NOTIFY, num_tx, &runs[1]);
+    
+    printf("  Queue time: %lld us (blocked on the driver queue)\n", runs[1].queue_us);
+#if CPU_BUSY_MEASURED
+    printf("  %-8s %8s %8s %10s %9s %8s %9s %8s\n",
+           "Wait", "TX done", "Edges", "Wait (us)", "CPU busy", "Polls", "Wake-ups", "TX IRQs");
+#else
+    printf("  %-8s %8s %8s %10s %8s %9s %8s\n",
+           "Wait", "TX done", "Edges", "Wait (us)", "Polls", "Wake-ups", "TX IRQs");
+#endif
+    bool pass = true;
+    for (int m = 0; m < 2; m++) {
+        const autonomous_run_t *r = &runs[m];
+#if CPU_BUSY_MEASURED
+        printf("  %-8s %4d/%-3d %8d %10lld %8.1f%% %8d %9d %8d\n",
+               m == WAIT_SPIN ? "spin" : "notify", r->done, num_tx, r->edges,
+               r->wait_us, 100.0 * r->busy, r->spins, r->wakeups, r->done);
+#else
+        printf("  %-8s %4d/%-3d %8d %10lld %8d %9d %8d\n",
+               m == WAIT_SPIN ? "spin" : "notify", r->done, num_tx, r->edges,
+               r->wait_us, r->spins, r->wakeups, r->done);
+#endif
+        pass = pass && r->done == num_tx && r->edges == expected;
+    }
+#if !CPU_BUSY_MEASURED
+    printf("  CPU busy not measured: needs CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS\n");
+#endif
     
-    int accuracy = (expected > 0) ? (count * 100) / expected : 0;
+    int accuracy = (expected > 0) ? (runs[1].edges * 100) / expected : 0;
     printf("  Accuracy: %d%%\n", accuracy);
     
-    bool pass = (tx_done_count == num_tx && accuracy == 100);
+    pass = pass && runs[1].wakeups == 1;
     printf("  Result: %s\n", pass ? "PASS" : "FAIL");
     
     return pass;
 }
 
+// ============================================================
+// TEST 5: Ternary Turing Machine (compiled onto the fabric)
+// ============================================================
+
+#define TTM_ETM_CHANNEL     11      // first of the compiler's two channels
+#define TTM_COUNTER_BITS    6
+#define TTM_INVERTER_BITS   16
+#define TTM_MAX_STEPS       100000
+#define TTM_TAPE_MAX        (TTM_INVERTER_BITS + 2)
+
+#define B                   (-1)    // blank
+#define RULE(next, write, move)     { (next), (write), (move) }
+
+// Flip every bit left to right, halt on the blank
+static const ttm_program_t ttm_inverter = {
+    .name = "inverter",
+    .num_states = 1,
+    .start = 0,
+    .rules = {
+        //        blank                 0                 1
+        { RULE(TTM_HALT, B, 0), RULE(0, 1, +1), RULE(0, 0, +1) },
+    },
+};
+
+// Count up from 0 until the carry runs off the left end (2^bits increments)
+static const ttm_program_t ttm_binary_counter = {
+    .name = "binary_counter",
+    .num_states = 2,
+    .start = 0,
+    .rules = {
+        //        blank                 0                 1
+        { RULE(1, B, -1),        RULE(0, 0, +1), RULE(0, 1, +1) },  // SCAN right
+        { RULE(TTM_HALT, B, 0),  RULE(0, 1, +1), RULE(1, 0, -1) },  // CARRY left
+    },
+};
+
+// Tape: blank, bits (LSB on the right), blank; head on the first bit
+static void ttm_setup(ttm_machine_t *m, int8_t *tape, int bits, uint32_t value, uint8_t start) {
+    tape[0] = B;
+    for (int i = 0; i < bits; i++) tape[1 + i] = (value >> (bits - 1 - i)) & 1;
+    tape[bits + 1] = B;
+    *m = (ttm_machine_t){ .tape = tape, .tape_len = bits + 2, .head = 1, .state = start };
+}
+
+static void print_image(const ttm_image_t *img) {
+    printf("  Compiled '%s': %d states x %d symbols\n",
+           img->program->name, img->program->num_states, TTM_NUM_SYMBOLS);
+    for (int s = 0; s < TTM_NUM_SYMBOLS; s++) {
+        printf("    DMA pattern %+d: %d bytes (%d edges)\n", s - 1,
+               TTM_PATTERN_BYTES, TTM_BASE_EDGES + s * TTM_STEP_EDGES);
+    }
+    printf("    PCNT LO limit %d, PCNT HI watch point %d (margin %d edges)\n",
+           img->lo_limit, img->hi_watch, img->margin_edges);
+    for (int i = 0; i < TTM_ETM_ROUTES; i++) {
+        printf("    ETM CH%d: event %d → task %d\n",
+               img->routes[i].channel, img->routes[i].event_id, img->routes[i].task_id);
+    }
+    printf("    Lookup, crossings → next state / written pattern / move:\n");
+    for (int q = 0; q < img->program->num_states; q++) {
+        printf("      state %d:", q);
+        for (int c = 0; c < TTM_NUM_SYMBOLS; c++) {
+            const ttm_step_t *st = &img->lookup[q][c];
+            char next[8];
+            if (st->next == TTM_HALT) snprintf(next, sizeof(next), "halt");
+            else snprintf(next, sizeof(next), "%d", st->next);
+            printf("  %d → %s/%+d/%+d", c, next,
+                   (int)((st->write - img->pattern[0]) / TTM_PATTERN_BYTES) - 1, st->move);
+        }
+        printf("\n");
+    }
+}
+
+static bool test_ternary_tm(void) {
+    printf("\n");
+    printf("----------------------------------------------------------------------\n");
+    printf("  TEST 5: Ternary Turing Machine (compiled onto the fabric)\n");
+    printf("----------------------------------------------------------------------\n");
+
+    // Hand the fabric over: test 2's channel and PCNT unit would see this
+    // test's PCNT events (they are shared by all units), and the runtime
+    // needs both GPTimers
+    etm_net_unload(&branch_net);
+    pcnt_unit_stop(pcnt);
+    gptimer_stop(timer0);
+    gptimer_disable(timer0);
+    gptimer_del_timer(timer0);
+    timer0 = NULL;
+
+    const ttm_program_t *programs[] = { &ttm_inverter, &ttm_binary_counter };
+    const int bits[] = { TTM_INVERTER_BITS, TTM_COUNTER_BITS };
+    const uint32_t input[] = { 0xB2C5, 0 };
+    int n_programs = sizeof(programs) / sizeof(programs[0]);
+
+    bool pass = true;
+    uint64_t total_steps = 0;
+    int64_t total_us = 0;
+#ifdef PULSE_LAB_HOST
+    double wall_s = 0;
+#endif
+
+    printf("  %-16s %8s %8s %8s\n", "Program", "Steps", "Halted", "Match");
+    for (int p = 0; p < n_programs; p++) {
+        ttm_image_t image;
+        if (ttm_compile(programs[p], TTM_ETM_CHANNEL, &image) != ESP_OK) return false;
+        if (p == n_programs - 1) print_image(&image);
+
+        ttm_fabric_t fabric;
+        esp_err_t ret = ttm_fabric_load(&fabric, &image, parlio, TEST_GPIO);
+        if (ret != ESP_OK) {
+            printf("  Fabric load failed: %s\n", esp_err_to_name(ret));
+            ttm_fabric_unload(&fabric);
+            return false;
+        }
+
+        int8_t ref_tape[TTM_TAPE_MAX], fab_tape[TTM_TAPE_MAX];
+        ttm_machine_t ref, fab;
+        ttm_setup(&ref, ref_tape, bits[p], input[p], programs[p]->start);
+        ttm_setup(&fab, fab_tape, bits[p], input[p], programs[p]->start);
+        ttm_reference_run(programs[p], &ref, TTM_MAX_STEPS);
+
+#ifdef PULSE_LAB_HOST
+        struct timespec w0, w1;
+        clock_gettime(CLOCK_MONOTONIC, &w0);
+#endif
+        int64_t t0 = esp_timer_get_time();
+        ret = ttm_fabric_run(&fabric, &fab, TTM_MAX_STEPS);
+        total_us += esp_timer_get_time() - t0;
+#ifdef PULSE_LAB_HOST
+        clock_gettime(CLOCK_MONOTONIC, &w1);
+        wall_s += (w1.tv_sec - w0.tv_sec) + (w1.tv_nsec - w0.tv_nsec) * 1e-9;
+#endif
+        total_steps += fab.steps;
+
+        bool match = ret == ESP_OK && fab.steps == ref.steps && fab.halted == ref.halted &&
+                     fab.state == ref.state && fab.head == ref.head &&
+                     memcmp(fab_tape, ref_tape, fab.tape_len) == 0;
+        printf("  %-16s %8llu %8s %8s\n", programs[p]->name,
+               (unsigned long long)fab.steps, fab.halted ? "yes" : "NO", match ? "yes" : "NO");
+        pass = pass && match && fab.halted;
+
+        ttm_fabric_unload(&fabric);
+    }
+
+    printf("  Steps/s: %.0f (%llu steps in %lld us)\n",
+           total_us > 0 ? total_steps * 1e6 / total_us : 0.0,
+           (unsigned long long)total_steps, total_us);
+#ifdef PULSE_LAB_HOST
+    printf("  Steps/s on the simulator, wall clock: %.0f\n", wall_s > 0 ? total_steps / wall_s : 0.0);
+#endif
+    printf("  Result: %s\n", pass ? "PASS" : "FAIL");
+    return pass;
+}
+
+// ============================================================
+// TEST 6: Multi-way Branch (hardware switch/case)
+// ============================================================
+
+#define SWITCH_LIMIT_EDGES  64      // case 1: unit A limit → Timer0 STOP
+#define SWITCH_WATCH_EDGES  192     // case 2: unit B watch point → Timer1 STOP
+#define SWITCH_REPEATS      8
+
+static bool timer_is_stopped(gptimer_handle_t t) {
+    uint64_t c1, c2;
+    gptimer_get_raw_count(t, &c1);
+    vTaskDelay(pdMS_TO_TICKS(10));
+    gptimer_get_raw_count(t, &c2);
+    return c1 == c2;
+}
+
+static bool test_multiway_branch(void) {
+    printf("\n");
+    printf("----------------------------------------------------------------------\n");
+    printf("  TEST 6: Multi-way Branch (hardware switch/case)\n");
+    printf("----------------------------------------------------------------------\n");
+
+    pcnt_unit_handle_t unit_a = NULL, unit_b = NULL;
+    pcnt_channel_handle_t chan_a = NULL, chan_b = NULL;
+    gptimer_handle_t timers[2] = { NULL, NULL };
+    etm_switch_t sw;
+    etm_switch_init(&sw);
+    bool pass = false;
+
+    if (etm_pcnt_new_counter(TEST_GPIO, SWITCH_LIMIT_EDGES, &unit_a, &chan_a) != ESP_OK ||
+        etm_pcnt_new_counter(TEST_GPIO, 32767, &unit_b, &chan_b) != ESP_OK) {
+        printf("  PCNT setup failed\n");
+        goto cleanup;
+    }
+    gptimer_config_t tcfg = {
+        .clk_src = GPTIMER_CLK_SRC_DEFAULT,
+        .direction = GPTIMER_COUNT_UP,
+        .resolution_hz = 1000000,
+    };
+    for (int i = 0; i < 2; i++) {
+        if (gptimer_new_timer(&tcfg, &timers[i]) != ESP_OK) {
+            printf("  Timer setup failed\n");
+            goto cleanup;
+        }
+        gptimer_enable(timers[i]);
+    }
+
+    etm_case_t case_limit = {
+        .kind = ETM_CASE_PCNT_LIMIT,
+        .sources = { { unit_a, SWITCH_LIMIT_EDGES } }, .num_sources = 1,
+        .tasks = { TIMER0_TASK_CNT_STOP_TIMER0 }, .num_tasks = 1,
+        .channel = ETM_CHANNEL_AUTO,
+    };
+    etm_case_t case_watch = {
+        .kind = ETM_CASE_PCNT_WATCH,
+        .sources = { { unit_b, SWITCH_WATCH_EDGES } }, .num_sources = 1,
+        .tasks = { TIMER1_TASK_CNT_STOP_TIMER0 }, .num_tasks = 1,
+        .channel = ETM_CHANNEL_AUTO,
+    };
+    if (etm_switch_add_case(&sw, &case_limit) != ESP_OK ||
+        etm_switch_add_case(&sw, &case_watch) != ESP_OK) {
+        printf("  Switch build failed\n");
+        goto cleanup;
+    }
+
+    // A second watch-point case would raise the same shared THRESH event
+    etm_case_t clash = case_watch;
+    clash.sources[0].unit = unit_a;
+    clash.sources[0].threshold = SWITCH_LIMIT_EDGES / 2;
+    bool rejects = etm_switch_add_case(&sw, &clash) == ESP_ERR_INVALID_STATE;
+
+    // A limit case below the unit's high limit would never see LMT
+    etm_switch_t probe;
+    etm_switch_init(&probe);
+    etm_case_t short_limit = case_limit;
+    short_limit.sources[0].threshold = SWITCH_LIMIT_EDGES / 2;
+    rejects = rejects && etm_switch_add_case(&probe, &short_limit) == ESP_ERR_INVALID_ARG;
+
+    int free_before = etm_channel_free_count();
+    if (etm_switch_load(&sw) != ESP_OK) {
+        printf("  Switch load failed\n");
+        goto cleanup;
+    }
+    printf("  Case 1: PCNT A limit %3d → ETM CH%d → Timer0 STOP\n", SWITCH_LIMIT_EDGES, sw.channels[0][0]);
+    printf("  Case 2: PCNT B watch %3d → ETM CH%d → Timer1 STOP\n", SWITCH_WATCH_EDGES, sw.channels[1][0]);
+    printf("  Default: no event, both timers run\n");
+    printf("  ETM channels free: %d → %d of %d\n", free_before, etm_channel_free_count(), ETM_NUM_CHANNELS);
+
+    // The allocator refuses channels the C6 does not have or has given out
+    rejects = rejects &&
+              etm_channel_reserve(ETM_NUM_CHANNELS) == ESP_ERR_INVALID_ARG &&
+              etm_channel_reserve(sw.channels[0][0]) == ESP_ERR_INVALID_STATE;
+    printf("  Rejects shared event, wrong limit, channel %d, busy channel: %s\n",
+           ETM_NUM_CHANNELS, rejects ? "yes" : "NO");
+
+    pcnt_unit_enable(unit_a);
+    pcnt_unit_enable(unit_b);
+    pcnt_unit_start(unit_a);
+    pcnt_unit_start(unit_b);
+
+    const int edges[] = { SWITCH_LIMIT_EDGES / 2, (SWITCH_LIMIT_EDGES + SWITCH_WATCH_EDGES) / 2, 256 };
+    int n_inputs = sizeof(edges) / sizeof(edges[0]);
+    int correct = 0, trials = 0;
+
+    printf("  %8s %10s %10s\n", "Edges", "Expected", "Taken");
+    for (int e = 0; e < n_inputs; e++) {
+        int expected = (edges[e] >= SWITCH_LIMIT_EDGES) + (edges[e] >= SWITCH_WATCH_EDGES);
+        int taken = -1;
+        for (int r = 0; r < SWITCH_REPEATS; r++) {
+            for (int i = 0; i < 2; i++) {
+                gptimer_stop(timers[i]);
+                gptimer_set_raw_count(timers[i], 0);
+                gptimer_start(timers[i]);
+            }
+            pcnt_unit_clear_count(unit_a);
+            pcnt_unit_clear_count(unit_b);
+
+            parlio_transmit_config_t tx_cfg = { .idle_value = 0 };
+            parlio_tx_unit_transmit(parlio, pattern_256_edges, edges[e] * 2, &tx_cfg);
+            parlio_tx_unit_wait_all_done(parlio, 100);
+
+            // Thermometer code: every case up to the taken one has fired
+            taken = timer_is_stopped(timers[0]) + timer_is_stopped(timers[1]);
+            correct += (taken == expected);
+            trials++;
+        }
+        printf("  %8d %10d %10d\n", edges[e], expected, taken);
+    }
+    printf("  Correct: %d / %d (no CPU callbacks on the branch path)\n", correct, trials);
+    pass = rejects && correct == trials;
+
+cleanup:
+    etm_switch_unload(&sw);
+    for (int i = 0; i < 2; i++) {
+        if (!timers[i]) continue;
+        gptimer_stop(timers[i]);
+        gptimer_disable(timers[i]);
+        gptimer_del_timer(timers[i]);
+    }
+    pcnt_unit_handle_t units[2] = { unit_a, unit_b };
+    pcnt_channel_handle_t chans[2] = { chan_a, chan_b };
+    for (int i = 0; i < 2; i++) {
+        if (!units[i]) continue;
+        pcnt_unit_stop(units[i]);
+        pcnt_unit_disable(units[i]);
+        if (chans[i]) pcnt_del_channel(chans[i]);
+        pcnt_del_unit(units[i]);
+    }
+    printf("  Result: %s\n", pass ? "PASS" : "FAIL");
+    return pass;
+}
+
+// ============================================================
+// TEST 7: Hardware FOR Loop (N iterations, one CPU wake-up)
+// ============================================================
+
+#define LOOP_GPIO           5       // ETM-toggled loop pin, counted by PCNT
+#define LOOP_ITERATIONS     10000
+#define LOOP_PERIOD_US      2
+#define LOOP_RUNS           3       // re-runs reload the same loop
+#define QUEUED_ITERATIONS   100     // baseline: one CPU-queued TX per iteration
+
+static bool test_hardware_loop(void) {
+    printf("\n");
+    printf("----------------------------------------------------------------------\n");
+    printf("  TEST 7: Hardware FOR Loop (one CPU wake-up per loop)\n");
+    printf("----------------------------------------------------------------------\n");
+
+    hw_loop_t loop;
+    hw_loop_config_t cfg = {
+        .gpio = LOOP_GPIO,
+        .period_us = LOOP_PERIOD_US,
+        .iterations = LOOP_ITERATIONS,
+    };
+    esp_err_t ret = hw_loop_new(&cfg, &loop);
+    if (ret != ESP_OK) {
+        printf("  Loop setup failed: %s\n", esp_err_to_name(ret));
+        printf("  Result: FAIL\n");
+        return false;
+    }
+    printf("  for (i = 0; i < %d; i++) toggle(GPIO%d)   every %d us\n",
+           LOOP_ITERATIONS, LOOP_GPIO, LOOP_PERIOD_US);
+    printf("  Exit: PCNT watch %d → ETM CH%d → Timer0 STOP\n", LOOP_ITERATIONS, loop.exit.channels[0][0]);
+
+    bool exact = true;
+    int64_t loop_us = 0;
+    uint32_t loop_wakeups = 0;
+#ifdef PULSE_LAB_HOST
+    double wall_s = 0;
+#endif
+    for (int r = 0; r < LOOP_RUNS; r++) {
+        uint32_t w0 = loop.wakeups;
+#ifdef PULSE_LAB_HOST
+        struct timespec c0, c1;
+        clock_gettime(CLOCK_MONOTONIC, &c0);
+#endif
+        int64_t t0 = esp_timer_get_time();
+        ret = hw_loop_run(&loop, 1000);
+        int64_t dt = esp_timer_get_time() - t0;
+#ifdef PULSE_LAB_HOST
+        clock_gettime(CLOCK_MONOTONIC, &c1);
+        wall_s += (c1.tv_sec - c0.tv_sec) + (c1.tv_nsec - c0.tv_nsec) * 1e-9;
+#endif
+        int count = hw_loop_count(&loop);
+        uint32_t wakeups = loop.wakeups - w0;
+        printf("  Run %d: %5d iterations in %6lld us, %lu CPU wake-up(s)%s\n", r + 1, count, dt,
+               (unsigned long)wakeups, ret == ESP_OK ? "" : " (timeout)");
+        exact = exact && ret == ESP_OK && count == LOOP_ITERATIONS && wakeups == 1;
+        loop_us += dt;
+        loop_wakeups += wakeups;
+    }
+    hw_loop_del(&loop);
+
+    // Baseline: the CPU queues every iteration and takes every completion
+    parlio_tx_event_callbacks_t cbs = { .on_trans_done = parlio_done_cb };
+    parlio_tx_unit_register_event_callbacks(parlio, &cbs, NULL);
+    parlio_transmit_config_t tx_cfg = { .idle_value = 0 };
+    tx_done_count = 0;
+    int64_t t0 = esp_timer_get_time();
+    for (int i = 0; i < QUEUED_ITERATIONS; i++) {
+        parlio_tx_unit_transmit(parlio, pattern_256_edges, 8, &tx_cfg);
+    }
+    parlio_tx_unit_wait_all_done(parlio, 1000);
+    int64_t queued_us = esp_timer_get_time() - t0;
+    int queued_wakeups = tx_done_count;
+
+    int loop_total = LOOP_RUNS * LOOP_ITERATIONS;
+    printf("\n");
+    printf("  %-12s %10s %10s %12s %14s\n", "Loop", "Iterations", "Time (us)", "Iter/s", "Wake-ups/iter");
+    printf("  %-12s %10d %10lld %12.0f %14.4f\n", "Hardware", loop_total, loop_us,
+           loop_us > 0 ? loop_total * 1e6 / loop_us : 0.0, (double)loop_wakeups / loop_total);
+    printf("  %-12s %10d %10lld %12.0f %14.4f\n", "CPU-queued", QUEUED_ITERATIONS, queued_us,
+           queued_us > 0 ? QUEUED_ITERATIONS * 1e6 / queued_us : 0.0,
+           (double)queued_wakeups / QUEUED_ITERATIONS);
+#ifdef PULSE_LAB_HOST
+    printf("  Hardware iterations/s on the simulator, wall clock: %.0f\n", wall_s > 0 ? loop_total / wall_s : 0.0);
+#endif
+
+    bool pass = exact && queued_wakeups == QUEUED_ITERATIONS;
+    printf("  Result: %s\n", pass ? "PASS" : "FAIL");
+    return pass;
+}
+
+// ============================================================
+// TEST 8: Branch Benchmark (latency histogram, branches/s)
+// ============================================================
+
+#define BENCH_TRIALS        1000
+#define BENCH_EDGES         64          // watch point: one branch per 64-edge burst
+#define BENCH_TIMER_HZ      40000000    // 25 ns ticks (GPTimer divider >= 2 on 80 MHz)
+#define BENCH_NS_PER_TICK   (1000000000 / BENCH_TIMER_HZ)
+#define BENCH_MAX_TICKS     (BENCH_TIMER_HZ / 1000000)  // later than 1 us: not stopped
+#define BENCH_HIST_BINS     16          // one tick per bin, last bin collects the rest
+
+static int hist_percentile(const uint32_t *hist, int bins, int total, int pct) {
+    int target = (total * pct + 99) / 100;
+    int seen = 0;
+    for (int i = 0; i < bins; i++) {
+        seen += hist[i];
+        if (seen >= target) return i;
+    }
+    return bins - 1;
+}
+
+static bool test_branch_benchmark(void) {
+    printf("\n");
+    printf("----------------------------------------------------------------------\n");
+    printf("  TEST 8: Branch Benchmark (latency histogram, branches/s)\n");
+    printf("----------------------------------------------------------------------\n");
+
+    pcnt_unit_handle_t unit = NULL;
+    pcnt_channel_handle_t chan = NULL;
+    gptimer_handle_t timer = NULL;
+    esp_etm_event_handle_t edge_event = NULL;
+    esp_etm_task_handle_t capture_task = NULL;
+    esp_etm_channel_handle_t capture_route = NULL;
+    etm_switch_t sw;
+    etm_switch_init(&sw);
+    bool pass = false;
+
+    gptimer_config_t tcfg = {
+        .clk_src = GPTIMER_CLK_SRC_DEFAULT,
+        .direction = GPTIMER_COUNT_UP,
+        .resolution_hz = BENCH_TIMER_HZ,
+    };
+    if (gptimer_new_timer(&tcfg, &timer) != ESP_OK ||
+        etm_pcnt_new_counter(TEST_GPIO, 32767, &unit, &chan) != ESP_OK) {
+        printf("  Timer/PCNT setup failed\n");
+        goto cleanup;
+    }
+    gptimer_enable(timer);
+
+    // Reference: every rising edge captures the timer, so after a burst the
+    // capture holds the edge that crossed the threshold
+    gpio_etm_event_config_t ecfg = { .edge = GPIO_ETM_EVENT_EDGE_POS };
+    gptimer_etm_task_config_t kcfg = { .task_type = GPTIMER_ETM_TASK_CAPTURE };
+    esp_etm_channel_config_t chcfg = {0};
+    if (gpio_new_etm_event(&ecfg, &edge_event) != ESP_OK ||
+        gpio_etm_event_bind_gpio(edge_event, TEST_GPIO) != ESP_OK ||
+        gptimer_new_etm_task(timer, &kcfg, &capture_task) != ESP_OK ||
+        esp_etm_new_channel(&chcfg, &capture_route) != ESP_OK) {
+        printf("  Capture route setup failed\n");
+        goto cleanup;
+    }
+    esp_etm_channel_connect(capture_route, edge_event, capture_task);
+    esp_etm_channel_enable(capture_route);
+
+    // Branch: the same edge, through PCNT, stops the timer
+    etm_case_t branch = {
+        .kind = ETM_CASE_PCNT_WATCH,
+        .sources = { { unit, BENCH_EDGES } }, .num_sources = 1,
+        .tasks = { TIMER0_TASK_CNT_STOP_TIMER0 }, .num_tasks = 1,
+        .channel = ETM_CHANNEL_AUTO,
+    };
+    if (etm_switch_add_case(&sw, &branch) != ESP_OK || etm_switch_load(&sw) != ESP_OK) {
+        printf("  Branch route setup failed\n");
+        goto cleanup;
+    }
+    pcnt_unit_enable(unit);
+    pcnt_unit_start(unit);
+
+    printf("  Crossing: GPIO%d rising edge → ETM → Timer0 CAPTURE\n", TEST_GPIO);
+    printf("  Branch:   PCNT watch %d → ETM CH%d → Timer0 STOP\n", BENCH_EDGES, sw.channels[0][0]);
+    printf("  Latency = stopped count - captured count, %d ns/tick, %d trials\n",
+           BENCH_NS_PER_TICK, BENCH_TRIALS);
+
+    static uint32_t hist[BENCH_HIST_BINS];
+    static double lat_ns[BENCH_TRIALS];
+    memset(hist, 0, sizeof(hist));
+    int taken = 0, missed = 0;
+    uint64_t lat_min = UINT64_MAX, lat_max = 0;
+    parlio_transmit_config_t tx_cfg = { .idle_value = 0 };
+#ifdef PULSE_LAB_HOST
+    struct timespec w0, w1;
+    clock_gettime(CLOCK_MONOTONIC, &w0);
+#endif
+    int64_t t0 = esp_timer_get_time();
+    for (int i = 0; i < BENCH_TRIALS; i++) {
+        gptimer_stop(timer);
+        gptimer_set_raw_count(timer, 0);
+        gptimer_start(timer);
+        pcnt_unit_clear_count(unit);
+
+        parlio_tx_unit_transmit(parlio, pattern_256_edges, BENCH_EDGES * 2, &tx_cfg);
+        parlio_tx_unit_wait_all_done(parlio, 100);
+
+        uint64_t stopped, crossing;
+        gptimer_get_raw_count(timer, &stopped);
+        gptimer_get_captured_count(timer, &crossing);
+        if (stopped < crossing || stopped - crossing > BENCH_MAX_TICKS) {
+            missed++;
+            continue;
+        }
+        uint64_t lat = stopped - crossing;
+        hist[lat < BENCH_HIST_BINS ? lat : BENCH_HIST_BINS - 1]++;
+        if (lat < lat_min) lat_min = lat;
+        if (lat > lat_max) lat_max = lat;
+        lat_ns[taken++] = (double)lat * BENCH_NS_PER_TICK;
+    }
+    int64_t elapsed_us = esp_timer_get_time() - t0;
+#ifdef PULSE_LAB_HOST
+    clock_gettime(CLOCK_MONOTONIC, &w1);
+    double wall_s = (w1.tv_sec - w0.tv_sec) + (w1.tv_nsec - w0.tv_nsec) * 1e-9;
+#endif
+
+    printf("\n");
+    printf("  %8s %8s\n", "ns", "Branches");
+    for (int b = 0; b < BENCH_HIST_BINS; b++) {
+        if (!hist[b]) continue;
+        char bar[41];
+        int len = (int)((uint64_t)hist[b] * 40 / (taken > 0 ? taken : 1));
+        memset(bar, '#', len);
+        bar[len] = '\0';
+        printf("  %7d%s %8lu  %s\n", b * BENCH_NS_PER_TICK, b == BENCH_HIST_BINS - 1 ? "+" : " ",
+               (unsigned long)hist[b], bar);
+    }
+    printf("\n");
+    printf("  Taken: %d / %d (missed: %d)\n", taken, BENCH_TRIALS, missed);
+    if (taken > 0) {
+        int p50 = hist_percentile(hist, BENCH_HIST_BINS, taken, 50);
+        int p99 = hist_percentile(hist, BENCH_HIST_BINS, taken, 99);
+        printf("  Latency: min %llu  p50 %d  p99 %d  max %llu ns, jitter %llu ns p-p\n",
+               (unsigned long long)lat_min * BENCH_NS_PER_TICK, p50 * BENCH_NS_PER_TICK,
+               p99 * BENCH_NS_PER_TICK, (unsigned long long)lat_max * BENCH_NS_PER_TICK,
+               (unsigned long long)(lat_max - lat_min) * BENCH_NS_PER_TICK);
+    }
+    printf("  Branches/s, CPU re-arming each one: %.0f (%lld us)\n",
+           elapsed_us > 0 ? BENCH_TRIALS * 1e6 / elapsed_us : 0.0, elapsed_us);
+    printf("  Branches/s, fabric bound (%d edges at %d MHz): %d\n",
+           BENCH_EDGES, PARLIO_CLK_HZ / 1000000, PARLIO_CLK_HZ / 2 / BENCH_EDGES);
+#ifdef PULSE_LAB_HOST
+    printf("  Branches/s on the simulator, wall clock: %.0f\n", wall_s > 0 ? BENCH_TRIALS / wall_s : 0.0);
+#endif
+    bench_begin("05_turing_fabric");
+    bench_samples(&(bench_case_t){ .name = "branch_latency", .params = "edges=64,tick_ns=25" },
+                  lat_ns, taken, 1);
+    bench_end();
+    pass = missed == 0;
+
+cleanup:
+    etm_switch_unload(&sw);
+    if (capture_route) {
+        esp_etm_channel_disable(capture_route);
+        esp_etm_del_channel(capture_route);
+    }
+    if (capture_task) esp_etm_del_task(capture_task);
+    if (edge_event) esp_etm_del_event(edge_event);
+    if (timer) {
+        gptimer_stop(timer);
+        gptimer_disable(timer);
+        gptimer_del_timer(timer);
+    }
+    if (unit) {
+        pcnt_unit_stop(unit);
+        pcnt_unit_disable(unit);
+        if (chan) pcnt_del_channel(chan);
+        pcnt_del_unit(unit);
+    }
+    printf("  Result: %s\n", pass ? "PASS" : "FAIL");
+    return pass;
+}
+
+// ============================================================
+// TEST 9: Pattern Programs (long streams from small buffers)
+// ============================================================
+
+#define STREAM_BYTES        (1024 * 1024)   // 1 MiB of 0x55: 4M rising edges, ~4.2 s at 2 MHz
+#define STREAM_PCNT_LIMIT   32000           // limits fold into the count (accum_count)
+
+static uint8_t __attribute__((aligned(4))) pattern_block[PATTERN_BLOCK_MAX];
+
+typedef struct {
+    uint32_t transmits;
+    int done;
+    int64_t submit_us;      // caller inside parlio_tx_unit_transmit(), mostly blocked on the queue
+    int64_t us;
+    int edges;
+} stream_run_t;
+
+static void stream_begin(pcnt_unit_handle_t unit, int64_t *t0) {
+    pcnt_unit_clear_count(unit);
+    tx_done_count = 0;
+    *t0 = esp_timer_get_time();
+}
+
+static void stream_end(pcnt_unit_handle_t unit, int64_t t0, stream_run_t *run) {
+    parlio_tx_unit_wait_all_done(parlio, 30000);
+    run->us = esp_timer_get_time() - t0;
+    run->done = tx_done_count;
+    pcnt_unit_get_count(unit, &run->edges);
+}
+
+static bool test_pattern_program(void) {
+    printf("\n");
+    printf("----------------------------------------------------------------------\n");
+    printf("  TEST 9: Pattern Programs (1 MiB stream from a 4 KB block)\n");
+    printf("----------------------------------------------------------------------\n");
+
+    pcnt_unit_handle_t unit = NULL;
+    pcnt_channel_handle_t chan = NULL;
+    pcnt_unit_config_t ucfg = {
+        .low_limit = -1,
+        .high_limit = STREAM_PCNT_LIMIT,
+        .flags.accum_count = true,
+    };
+    pcnt_chan_config_t ccfg = {
+        .edge_gpio_num = TEST_GPIO,
+        .level_gpio_num = -1,
+    };
+    if (pcnt_new_unit(&ucfg, &unit) != ESP_OK || pcnt_new_channel(unit, &ccfg, &chan) != ESP_OK) {
+        printf("  PCNT setup failed\n");
+        printf("  Result: FAIL\n");
+        return false;
+    }
+    pcnt_channel_set_edge_action(chan, PCNT_CHANNEL_EDGE_ACTION_INCREASE, PCNT_CHANNEL_EDGE_ACTION_HOLD);
+    pcnt_unit_add_watch_point(unit, STREAM_PCNT_LIMIT);
+    pcnt_unit_enable(unit);
+    pcnt_unit_start(unit);
+
+    const int expected = STREAM_BYTES * 4;
+    parlio_transmit_config_t tx_cfg = { .idle_value = 0 };
+    stream_run_t queued = {0}, program = {0};
+    int64_t t0;
+
+    // Today's approach: one 64-byte transaction per 256 edges
+    stream_begin(unit, &t0);
+    for (int i = 0; i < STREAM_BYTES / (int)sizeof(pattern_256_edges); i++) {
+        parlio_tx_unit_transmit(parlio, pattern_256_edges, sizeof(pattern_256_edges) * 8, &tx_cfg);
+        queued.transmits++;
+    }
+    queued.submit_us = esp_timer_get_time() - t0;
+    stream_end(unit, t0, &queued);
+
+    // Pattern program: the same 64 bytes unrolled once, the block replayed
+    pattern_prog_t prog;
+    pattern_prog_init(&prog);
+    esp_err_t ret = pattern_prog_add_replay(&prog, pattern_256_edges, sizeof(pattern_256_edges),
+                                            pattern_block, sizeof(pattern_block), STREAM_BYTES);
+    if (ret == ESP_OK) {
+        for (int i = 0; i < prog.num_ops; i++) {
+            printf("  Block %d: %4lu bytes x %lu\n", i, (unsigned long)prog.ops[i].bytes,
+                   (unsigned long)prog.ops[i].repeat);
+        }
+#ifdef PULSE_LAB_HOST
+        struct timespec w0, w1;
+        clock_gettime(CLOCK_MONOTONIC, &w0);
+#endif
+        stream_begin(unit, &t0);
+        ret = pattern_prog_transmit(parlio, &prog, &tx_cfg, &program.transmits);
+        program.submit_us = esp_timer_get_time() - t0;
+        stream_end(unit, t0, &program);
+#ifdef PULSE_LAB_HOST
+        clock_gettime(CLOCK_MONOTONIC, &w1);
+        double wall_s = (w1.tv_sec - w0.tv_sec) + (w1.tv_nsec - w0.tv_nsec) * 1e-9;
+        printf("  Stream on the simulator, wall clock: %.1f Mbit/s\n",
+               wall_s > 0 ? STREAM_BYTES * 8 / wall_s / 1e6 : 0.0);
+#endif
+    }
+
+    uint32_t flat_transmits = (STREAM_BYTES + PATTERN_BLOCK_MAX - 1) / PATTERN_BLOCK_MAX;
+    printf("\n");
+    printf("  %-16s %10s %10s %10s %12s %12s %10s\n", "Stream", "Memory (B)", "Transmits", "Done IRQs",
+           "Submit (us)", "Time (us)", "Edges");
+    printf("  %-16s %10u %10lu %10d %12lld %12lld %10d\n", "Queue of 64 B", (unsigned)sizeof(pattern_256_edges),
+           (unsigned long)queued.transmits, queued.done, queued.submit_us, queued.us, queued.edges);
+    printf("  %-16s %10d %10lu %10s %12s %12s %10s\n", "Flat buffer", STREAM_BYTES,
+           (unsigned long)flat_transmits, "-", "-", "not run", "(> SRAM)");
+    printf("  %-16s %10u %10lu %10d %12lld %12lld %10d\n", "Pattern program", (unsigned)pattern_prog_memory(&prog),
+           (unsigned long)program.transmits, program.done, program.submit_us, program.us, program.edges);
+    printf("  Driver calls and done IRQs: %lu → %lu; submit = caller blocked on the driver queue\n",
+           (unsigned long)queued.transmits, (unsigned long)program.transmits);
+
+    bool pass = ret == ESP_OK && queued.edges == expected && program.edges == expected &&
+                program.transmits == pattern_prog_transactions(&prog) && program.done == (int)program.transmits;
+
+    pcnt_unit_stop(unit);
+    pcnt_unit_disable(unit);
+    pcnt_del_channel(chan);
+    pcnt_del_unit(unit);
+    printf("  Result: %s\n", pass ? "PASS" : "FAIL");
+    return pass;
+}
+
+// ============================================================
+// TEST 10: ETM Netlist (declarative wiring, stopwatch pipeline)
+// ============================================================
+
+#define NET_START_EDGES     64      // pcnt.thresh: stopwatch starts
+#define NET_STOP_EDGES      192     // pcnt.limit: stopwatch stops
+#define NET_COMPILES        1000
+
+static const char *stopwatch_src =
+    "# Timer1 runs between two edge counts; Timer0 timestamps both\n"
+    "pcnt.thresh -> timer1.start, timer0.capture\n"
+    "pcnt.limit  -> timer1.stop, timer0.stop\n";
+
+static bool test_etm_netlist(void) {
+    printf("\n");
+    printf("----------------------------------------------------------------------\n");
+    printf("  TEST 10: ETM Netlist (declarative wiring, stopwatch pipeline)\n");
+    printf("----------------------------------------------------------------------\n");
+
+    pcnt_unit_handle_t unit = NULL;
+    pcnt_channel_handle_t chan = NULL;
+    gptimer_handle_t timers[2] = { NULL, NULL };
+    etm_net_t net;
+    etm_net_init(&net, "stopwatch");
+    bool pass = false;
+
+    if (etm_pcnt_new_counter(TEST_GPIO, NET_STOP_EDGES, &unit, &chan) != ESP_OK) {
+        printf("  PCNT setup failed\n");
+        goto cleanup;
+    }
+    pcnt_unit_add_watch_point(unit, NET_START_EDGES);
+    pcnt_unit_add_watch_point(unit, NET_STOP_EDGES);    // enables the limit event
+    gptimer_config_t tcfg = {
+        .clk_src = GPTIMER_CLK_SRC_DEFAULT,
+        .direction = GPTIMER_COUNT_UP,
+        .resolution_hz = 1000000,
+    };
+    for (int i = 0; i < 2; i++) {
+        if (gptimer_new_timer(&tcfg, &timers[i]) != ESP_OK) {
+            printf("  Timer setup failed\n");
+            goto cleanup;
+        }
+        gptimer_enable(timers[i]);
+    }
+
+    int free_before = etm_channel_free_count();
+    if (etm_net_parse(&net, stopwatch_src) != ESP_OK || etm_net_load(&net) != ESP_OK) {
+        printf("  Netlist load failed\n");
+        goto cleanup;
+    }
+    for (int i = 0; i < net.num_edges; i++) {
+        printf("  %-12s → ETM CH%d → %s\n", net.edges[i].event, net.channels[i], net.edges[i].task);
+    }
+    printf("  ETM channels free: %d → %d of %d\n", free_before, etm_channel_free_count(), ETM_NUM_CHANNELS);
+
+    // Misconnections fail at build or load time, not on the wire
+    etm_net_t bad;
+    etm_net_init(&bad, "opposed");
+    bool rejects = etm_net_parse(&bad, "pcnt.zero -> timer1.start, timer1.stop") == ESP_ERR_INVALID_STATE;
+    etm_net_init(&bad, "unknown");
+    rejects = rejects && etm_net_parse(&bad, "pcnt.zero -> timer2.start") == ESP_ERR_INVALID_ARG;
+    etm_net_init(&bad, "shared");
+    rejects = rejects && etm_net_connect(&bad, "pcnt.thresh", "gpio.ch0.set", ETM_CHANNEL_AUTO) == ESP_OK &&
+              etm_net_load(&bad) == ESP_ERR_INVALID_STATE;
+    etm_net_init(&bad, "busy");
+    rejects = rejects && etm_net_connect(&bad, "pcnt.zero", "gpio.ch0.set", net.channels[0]) == ESP_OK &&
+              etm_net_load(&bad) == ESP_ERR_INVALID_STATE;
+    printf("  Rejects opposed tasks, unknown name, shared event, busy channel: %s\n",
+           rejects ? "yes" : "NO");
+
+    // Timer0 free-runs as the reference; Timer1 waits for the netlist
+    gptimer_set_raw_count(timers[0], 0);
+    gptimer_set_raw_count(timers[1], 0);
+    gptimer_start(timers[0]);
+    pcnt_unit_enable(unit);
+    pcnt_unit_clear_count(unit);
+    pcnt_unit_start(unit);
+
+    parlio_transmit_config_t tx_cfg = { .idle_value = 0 };
+    parlio_tx_unit_transmit(parlio, pattern_256_edges, NET_STOP_EDGES * 2, &tx_cfg);
+    parlio_tx_unit_wait_all_done(parlio, 100);
+
+    uint64_t window = 0, captured = 0, stopped = 0;
+    bool halted = timer_is_stopped(timers[0]) && timer_is_stopped(timers[1]);
+    gptimer_get_raw_count(timers[1], &window);
+    gptimer_get_captured_count(timers[0], &captured);
+    gptimer_get_raw_count(timers[0], &stopped);
+
+    // One edge per microsecond at the PARLIO clock
+    int expected_us = (NET_STOP_EDGES - NET_START_EDGES) * 2 * 1000000 / PARLIO_CLK_HZ;
+    int64_t span = (int64_t)(stopped - captured);
+    printf("  Edges %d..%d: Timer1 window %llu us, Timer0 %llu → %llu (%lld us), expected %d us\n",
+           NET_START_EDGES, NET_STOP_EDGES, window, captured, stopped, span, expected_us);
+
+    // Compile cost: text to resolved edges, without touching the matrix
+    etm_net_t scratch;
+#ifdef PULSE_LAB_HOST
+    struct timespec w0, w1;
+    clock_gettime(CLOCK_MONOTONIC, &w0);
+#endif
+    int64_t t0 = esp_timer_get_time();
+    for (int i = 0; i < NET_COMPILES; i++) {
+        etm_net_init(&scratch, "stopwatch");
+        etm_net_parse(&scratch, stopwatch_src);
+    }
+    int64_t compile_us = esp_timer_get_time() - t0;
+    printf("  Compile: %.2f us per netlist (%d edges, %d runs)\n",
+           (double)compile_us / NET_COMPILES, scratch.num_edges, NET_COMPILES);
+#ifdef PULSE_LAB_HOST
+    clock_gettime(CLOCK_MONOTONIC, &w1);
+    double wall_us = ((w1.tv_sec - w0.tv_sec) * 1e9 + (w1.tv_nsec - w0.tv_nsec)) / 1e3;
+    printf("  Compile on the simulator, wall clock: %.2f us per netlist\n", wall_us / NET_COMPILES);
+#endif
+
+    char dot[512];
+    etm_net_export_dot(&net, dot, sizeof(dot));
+    printf("\n%s\n", dot);
+
+    pass = rejects && halted &&
+           window + 1 >= (uint64_t)expected_us && window <= (uint64_t)expected_us + 1 &&
+           span >= expected_us - 1 && span <= expected_us + 1;
+
+cleanup:
+    etm_net_unload(&net);
+    for (int i = 0; i < 2; i++) {
+        if (!timers[i]) continue;
+        gptimer_stop(timers[i]);
+        gptimer_disable(timers[i]);
+        gptimer_del_timer(timers[i]);
+    }
+    if (unit) {
+        pcnt_unit_stop(unit);
+        pcnt_unit_disable(unit);
+        if (chan) pcnt_del_channel(chan);
+        pcnt_del_unit(unit);
+    }
+    printf("  Result: %s\n", pass ? "PASS" : "FAIL");
+    return pass;
+}
+
+// ============================================================
+// TEST 11: Cascaded Counter (wide counts with no CPU carries)
+// ============================================================
+
+#define CASCADE_CARRY_GPIO  6       // carry line: ETM drives it, upper PCNT units count it
+#define CASCADE_STAGES      3       // tests 1-3's PCNT unit is still allocated
+#define CASCADE_TRIALS      100
+#define CASCADE_SWEEP_TX    16      // 64-byte transmissions per sweep step: 4096 edges, 32 carries
+
+typedef struct {
+    const char *name;
+    int limits[CASCADE_STAGES];
+} cascade_case_t;
+
+typedef struct {
+    uint32_t reads, torn;
+    uint64_t last, count;
+} cascade_run_t;
+
+static void cascade_sample(pcnt_cascade_t *c, uint64_t expected, cascade_run_t *run) {
+    uint64_t v = pcnt_cascade_read(c);
+    run->torn += (v < run->last || v > expected);
+    run->reads++;
+    run->last = v;
+}
+
+// Streams the 1 MiB program, reading the cascade after every queued
+// transaction and then until the last one completes
+static void cascade_stream(pcnt_cascade_t *c, const pattern_prog_t *prog, uint64_t expected, cascade_run_t *run) {
+    parlio_transmit_config_t tx_cfg = { .idle_value = 0 };
+    int issued = 0;
+    tx_done_count = 0;
+    for (int i = 0; i < prog->num_ops; i++) {
+        for (uint32_t r = 0; r < prog->ops[i].repeat; r++) {
+            parlio_tx_unit_transmit(parlio, prog->ops[i].buf, prog->ops[i].bytes * 8, &tx_cfg);
+            issued++;
+            cascade_sample(c, expected, run);
+        }
+    }
+    while (tx_done_count < issued) cascade_sample(c, expected, run);
+    parlio_tx_unit_wait_all_done(parlio, 30000);
+    run->count = pcnt_cascade_read(c);
+}
+
+// Max input rate at which the cascade still counts exactly: PARLIO
+// clocks up from the demo's until a count is wrong or PARLIO refuses the
+// clock. 0x55 puts one level change on the input per PARLIO cycle, so
+// rising edges arrive at half the clock. The PARLIO unit is rebuilt at
+// each clock and back at PARLIO_CLK_HZ on return; false if that fails.
+static bool cascade_rate_sweep(pcnt_cascade_t *c) {
+    static const uint32_t clocks_mhz[] = { 2, 10, 20, 40, 60, 80, 120, 240 };
+    const uint64_t expected = (uint64_t)CASCADE_SWEEP_TX * sizeof(pattern_256_edges) * 4;
+    parlio_transmit_config_t tx_cfg = { .idle_value = 0 };
+    uint32_t exact_mhz = 0, miscount_mhz = 0, refused_mhz = 0;
+    uint64_t miscount = 0;
+
+    printf("\n");
+    printf("  Input rate sweep, %llu edges per step:\n", (unsigned long long)expected);
+    printf("  %-12s %12s %10s\n", "PARLIO", "Input rate", "Count");
+    for (size_t i = 0; i < sizeof(clocks_mhz) / sizeof(clocks_mhz[0]); i++) {
+        parlio_tx_unit_disable(parlio);
+        parlio_del_tx_unit(parlio);
+        parlio = NULL;
+        if (setup_parlio(clocks_mhz[i] * 1000000) != ESP_OK) {
+            refused_mhz = clocks_mhz[i];
+            break;
+        }
+        pcnt_cascade_clear(c);
+        for (int t = 0; t < CASCADE_SWEEP_TX; t++) {
+            parlio_tx_unit_transmit(parlio, pattern_256_edges, sizeof(pattern_256_edges) * 8, &tx_cfg);
+        }
+        parlio_tx_unit_wait_all_done(parlio, 1000);
+        uint64_t count = pcnt_cascade_read(c);
+        printf("  %8lu MHz %8.1f M/s %10llu%s\n", (unsigned long)clocks_mhz[i],
+               clocks_mhz[i] / 2.0, (unsigned long long)count, count == expected ? "" : "  miscount");
+        if (count != expected) {
+            miscount_mhz = clocks_mhz[i];
+            miscount = count;
+            break;
+        }
+        exact_mhz = clocks_mhz[i];
+    }
+
+    if (exact_mhz) {
+        printf("  Max exact input rate: %.1f M edges/s (PARLIO %lu MHz)\n",
+               exact_mhz / 2.0, (unsigned long)exact_mhz);
+    }
+    if (miscount_mhz) {
+        printf("  First miscount: PARLIO %lu MHz, %llu of %llu edges\n", (unsigned long)miscount_mhz,
+               (unsigned long long)miscount, (unsigned long long)expected);
+    } else if (refused_mhz) {
+        printf("  No miscount up to the fastest clock PARLIO accepts (%lu MHz refused)\n",
+               (unsigned long)refused_mhz);
+    } else {
+        printf("  No miscount up to the fastest clock tried\n");
+    }
+
+    if (parlio) {
+        parlio_tx_unit_disable(parlio);
+        parlio_del_tx_unit(parlio);
+        parlio = NULL;
+    }
+    if (setup_parlio(PARLIO_CLK_HZ) != ESP_OK) return false;
+    parlio_tx_event_callbacks_t cbs = { .on_trans_done = parlio_done_cb };
+    parlio_tx_unit_register_event_callbacks(parlio, &cbs, NULL);
+    return exact_mhz > 0;
+}
+
+static bool test_pcnt_cascade(void) {
+    printf("\n");
+    printf("----------------------------------------------------------------------\n");
+    printf("  TEST 11: Cascaded Counter (wide counts, no CPU carries)\n");
+    printf("----------------------------------------------------------------------\n");
+
+    // Stage 0 period, then pairwise coprime upper moduli
+    static const cascade_case_t cases[] = {
+        { "Wide",   { 32766, 32767, 32765 } },
+        { "Stress", { 128, 253, 255 } },      // upper stages wrap over 100 times
+    };
+    const int n_cases = sizeof(cases) / sizeof(cases[0]);
+    const uint64_t expected = (uint64_t)STREAM_BYTES * 4;
+    bool pass = true;
+    int wide_bits = 0;
+
+    pattern_prog_t prog;
+    pattern_prog_init(&prog);
+    if (pattern_prog_add_replay(&prog, pattern_256_edges, sizeof(pattern_256_edges),
+                                pattern_block, sizeof(pattern_block), STREAM_BYTES) != ESP_OK) {
+        printf("  Pattern program failed\n");
+        printf("  Result: FAIL\n");
+        return false;
+    }
+
+    printf("  GPIO%d ─► stage 0 ─ETM─► carry GPIO%d ─► stages 1..%d, %llu edges per run\n",
+           TEST_GPIO, CASCADE_CARRY_GPIO, CASCADE_STAGES - 1, (unsigned long long)expected);
+    printf("\n");
+    printf("  %-8s %-20s %5s %8s %8s %8s %6s %10s\n",
+           "Config", "Limits", "Bits", "Carries", "Reads", "Retries", "Torn", "Count");
+    for (int k = 0; k < n_cases; k++) {
+        pcnt_cascade_config_t cfg = {
+            .input_gpio = TEST_GPIO,
+            .carry_gpio = CASCADE_CARRY_GPIO,
+            .num_stages = CASCADE_STAGES,
+        };
+        memcpy(cfg.limits, cases[k].limits, sizeof(cases[k].limits));
+        pcnt_cascade_t c;
+        if (pcnt_cascade_new(&cfg, &c) != ESP_OK) {
+            printf("  %-8s setup failed\n", cases[k].name);
+            pass = false;
+            continue;
+        }
+        pcnt_cascade_clear(&c);
+        pcnt_cascade_start(&c);
+        cascade_run_t run = {0};
+        cascade_stream(&c, &prog, expected, &run);
+
+        char limits[24];
+        snprintf(limits, sizeof(limits), "%d/%d/%d", cfg.limits[0], cfg.limits[1], cfg.limits[2]);
+        printf("  %-8s %-20s %5d %8llu %8lu %8lu %6lu %10llu\n", cases[k].name, limits,
+               pcnt_cascade_bits(&c), (unsigned long long)(run.count / cfg.limits[0]),
+               (unsigned long)run.reads, (unsigned long)c.retries, (unsigned long)run.torn,
+               (unsigned long long)run.count);
+        if (k == 0) wide_bits = pcnt_cascade_bits(&c);
+        pass = pass && run.count == expected && run.torn == 0;
+        pcnt_cascade_del(&c);
+    }
+    printf("  Torn = a read that went backwards or past the stream: none allowed\n");
+
+    // Carry latency: the input edge that wraps stage 0 captures the timer,
+    // the carry edge it produces stops it (both measurement hops cancel)
+    pcnt_cascade_config_t cfg = {
+        .input_gpio = TEST_GPIO,
+        .carry_gpio = CASCADE_CARRY_GPIO,
+        .limits = { 128, 253, 255 },
+        .num_stages = CASCADE_STAGES,
+    };
+    pcnt_cascade_t c;
+    gptimer_handle_t timer = NULL;
+    esp_etm_event_handle_t input_rise = NULL, carry_rise = NULL;
+    esp_etm_task_handle_t capture = NULL, stop = NULL;
+    esp_etm_channel_handle_t routes[2] = { NULL, NULL };
+    gptimer_config_t tcfg = {
+        .clk_src = GPTIMER_CLK_SRC_DEFAULT,
+        .direction = GPTIMER_COUNT_UP,
+        .resolution_hz = BENCH_TIMER_HZ,
+    };
+    gpio_etm_event_config_t ecfg = { .edge = GPIO_ETM_EVENT_EDGE_POS };
+    gptimer_etm_task_config_t capcfg = { .task_type = GPTIMER_ETM_TASK_CAPTURE };
+    gptimer_etm_task_config_t stopcfg = { .task_type = GPTIMER_ETM_TASK_STOP_COUNT };
+    esp_etm_channel_config_t chcfg = {0};
+    int taken = 0;
+    uint64_t lat_min = UINT64_MAX, lat_max = 0;
+    if (pcnt_cascade_new(&cfg, &c) != ESP_OK ||
+        gptimer_new_timer(&tcfg, &timer) != ESP_OK ||
+        gpio_new_etm_event(&ecfg, &input_rise) != ESP_OK ||
+        gpio_etm_event_bind_gpio(input_rise, TEST_GPIO) != ESP_OK ||
+        gpio_new_etm_event(&ecfg, &carry_rise) != ESP_OK ||
+        gpio_etm_event_bind_gpio(carry_rise, CASCADE_CARRY_GPIO) != ESP_OK ||
+        gptimer_new_etm_task(timer, &capcfg, &capture) != ESP_OK ||
+        gptimer_new_etm_task(timer, &stopcfg, &stop) != ESP_OK ||
+        esp_etm_new_channel(&chcfg, &routes[0]) != ESP_OK ||
+        esp_etm_new_channel(&chcfg, &routes[1]) != ESP_OK) {
+        printf("  Latency setup failed\n");
+        pass = false;
+        goto cleanup;
+    }
+    esp_etm_channel_connect(routes[0], input_rise, capture);
+    esp_etm_channel_connect(routes[1], carry_rise, stop);
+    esp_etm_channel_enable(routes[0]);
+    esp_etm_channel_enable(routes[1]);
+    gptimer_enable(timer);
+    pcnt_cascade_start(&c);
+
+    static double carry_ns[CASCADE_TRIALS];
+    parlio_transmit_config_t tx_cfg = { .idle_value = 0 };
+    for (int i = 0; i < CASCADE_TRIALS; i++) {
+        pcnt_cascade_clear(&c);
+        gptimer_stop(timer);
+        gptimer_set_raw_count(timer, 0);
+        gptimer_start(timer);
+        parlio_tx_unit_transmit(parlio, pattern_256_edges, cfg.limits[0] * 2, &tx_cfg);
+        parlio_tx_unit_wait_all_done(parlio, 100);
+
+        uint64_t stopped, crossing;
+        gptimer_get_raw_count(timer, &stopped);
+        gptimer_get_captured_count(timer, &crossing);
+        if (stopped < crossing || stopped - crossing > BENCH_MAX_TICKS || pcnt_cascade_read(&c) != (uint64_t)cfg.limits[0]) {
+            continue;
+        }
+        uint64_t lat = stopped - crossing;
+        if (lat < lat_min) lat_min = lat;
+        if (lat > lat_max) lat_max = lat;
+        carry_ns[taken++] = (double)lat * BENCH_NS_PER_TICK;
+    }
+    printf("\n");
+    printf("  Carry latency (wrapping edge → carry edge): %llu..%llu ns, %d / %d trials\n",
+           taken ? (unsigned long long)lat_min * BENCH_NS_PER_TICK : 0ULL,
+           (unsigned long long)lat_max * BENCH_NS_PER_TICK, taken, CASCADE_TRIALS);
+    printf("  Wide range: %d bits from %d x 16-bit units, CPU reads only\n", wide_bits, CASCADE_STAGES);
+    bench_begin("05_turing_fabric");
+    bench_samples(&(bench_case_t){ .name = "carry_latency", .params = "stages=3,tick_ns=25" },
+                  carry_ns, taken, 1);
+    bench_end();
+    pass = pass && taken == CASCADE_TRIALS && wide_bits >= 32;
+    pass = cascade_rate_sweep(&c) && pass;
+
+cleanup:
+    for (int i = 0; i < 2; i++) {
+        if (!routes[i]) continue;
+        esp_etm_channel_disable(routes[i]);
+        esp_etm_del_channel(routes[i]);
+    }
+    if (capture) esp_etm_del_task(capture);
+    if (stop) esp_etm_del_task(stop);
+    if (input_rise) esp_etm_del_event(input_rise);
+    if (carry_rise) esp_etm_del_event(carry_rise);
+    if (timer) {
+        gptimer_stop(timer);
+        gptimer_disable(timer);
+        gptimer_del_timer(timer);
+    }
+    pcnt_cascade_del(&c);
+    printf("  Result: %s\n", pass ? "PASS" : "FAIL");
+    return pass;
+}
+
 // ============================================================
 // Main Entry Point
 // ============================================================
@@ -471,11 +1663,12 @@ void app_main(void) {
         return;
     }
     
-    ret = setup_parlio();
+    ret = setup_parlio(PARLIO_CLK_HZ);
     if (ret != ESP_OK) {
         printf("  PARLIO setup failed: %s\n", esp_err_to_name(ret));
         return;
     }
+    ESP_LOGI(TAG, "PARLIO: GPIO%d at %d Hz with loopback", TEST_GPIO, PARLIO_CLK_HZ);
     
     setup_patterns();
     
@@ -485,7 +1678,7 @@ void app_main(void) {
     
     // Run tests
     int passed = 0;
-    int total = 4;
+    int total = 11;
     
     if (test_parlio_pcnt()) passed++;
     vTaskDelay(pdMS_TO_TICKS(100));
@@ -497,6 +1690,27 @@ void app_main(void) {
     vTaskDelay(pdMS_TO_TICKS(100));
     
     if (test_autonomous_operation()) passed++;
+    vTaskDelay(pdMS_TO_TICKS(100));
+    
+    if (test_ternary_tm()) passed++;
+    vTaskDelay(pdMS_TO_TICKS(100));
+    
+    if (test_multiway_branch()) passed++;
+    vTaskDelay(pdMS_TO_TICKS(100));
+    
+    if (test_hardware_loop()) passed++;
+    vTaskDelay(pdMS_TO_TICKS(100));
+    
+    if (test_branch_benchmark()) passed++;
+    vTaskDelay(pdMS_TO_TICKS(100));
+    
+    if (test_pattern_program()) passed++;
+    vTaskDelay(pdMS_TO_TICKS(100));
+    
+    if (test_etm_netlist()) passed++;
+    vTaskDelay(pdMS_TO_TICKS(100));
+    
+    if (test_pcnt_cascade()) passed++;
     
     // Summary
     printf("\n");
@@ -515,6 +1729,13 @@ void app_main(void) {
         printf("    [x] Conditional branching (PCNT → ETM → Timer)\n");
         printf("    [x] State modification (PCNT counter, GPIO)\n");
         printf("    [x] Autonomous operation (CPU idle)\n");
+        printf("    [x] Ternary Turing machine (compiled transition table)\n");
+        printf("    [x] Multi-way branching (hardware switch/case)\n");
+        printf("    [x] Hardware FOR loop (PCNT terminal count → ETM)\n");
+        printf("    [x] Branch latency and throughput (timer capture)\n");
+        printf("    [x] Long streams from small buffers (pattern programs)\n");
+        printf("    [x] Declarative wiring (ETM netlist + channel allocator)\n");
+        printf("    [x] Wide counts in hardware (cascaded PCNT units)\n");
         printf("\n");
         printf("  The silicon thinks. The CPU sleeps.\n");
     } else {
@@ -525,6 +1746,9 @@ void app_main(void) {
     printf("\n");
     printf("======================================================================\n");
     
+#ifdef PULSE_LAB_HOST
+    return;
+#endif
     while (1) {
         vTaskDelay(pdMS_TO_TICKS(1000));
     }
@@ -0,0 +1,325 @@
+/**
+ * etm_net.c - Declarative ETM netlists
+ *
+ * See etm_net.h. Channels come from the etm_switch allocator, so nets,
+ * switches and the Turing machine's routes never hand out the same
+ * channel twice.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include <stdlib.h>
+#include "esp_log.h"
+#include "etm_net.h"
+#include "etm_regs.h"
+
+static const char *TAG = "ETM_NET";
+
+// ============================================================
+// Names
+// ============================================================
+
+typedef struct {
+    const char *name;
+    uint8_t id;
+} etm_name_t;
+
+static const etm_name_t event_names[] = {
+    { "pcnt.thresh",    PCNT_EVT_CNT_EQ_THRESH },
+    { "pcnt.limit",     PCNT_EVT_CNT_EQ_LMT },
+    { "pcnt.zero",      PCNT_EVT_CNT_EQ_ZERO },
+    { "timer0.alarm",   TIMER0_EVT_CNT_CMP_TIMER0 },
+    { "timer1.alarm",   TIMER1_EVT_CNT_CMP_TIMER0 },
+};
+
+// Timer task IDs interleave the two hardware timers: add N for timerN
+static const etm_name_t timer_tasks[] = {
+    { "start",          TIMER0_TASK_CNT_START_TIMER0 },
+    { "stop",           TIMER0_TASK_CNT_STOP_TIMER0 },
+    { "alarm",          TIMER0_TASK_ALARM_START_TIMER0 },
+    { "reload",         TIMER0_TASK_CNT_RELOAD_TIMER0 },
+    { "capture",        TIMER0_TASK_CNT_CAP_TIMER0 },
+};
+
+// GPIO IDs come in banks of eight channels: add K for gpio.chK
+static const etm_name_t gpio_events[] = {
+    { "rise",           GPIO_EVT_CH0_RISE_EDGE },
+    { "fall",           GPIO_EVT_CH0_FALL_EDGE },
+    { "any",            GPIO_EVT_CH0_ANY_EDGE },
+};
+
+static const etm_name_t gpio_tasks[] = {
+    { "set",            GPIO_TASK_CH0_SET },
+    { "clear",          GPIO_TASK_CH0_CLEAR },
+    { "toggle",         GPIO_TASK_CH0_TOGGLE },
+};
+
+#define COUNT(a)    (int)(sizeof(a) / sizeof((a)[0]))
+
+static int find(const etm_name_t *table, int n, const char *name) {
+    for (int i = 0; i < n; i++) {
+        if (strcmp(table[i].name, name) == 0) return table[i].id;
+    }
+    return -1;
+}
+
+// "<prefix>K.<suffix>" with K in 0..max-1
+static int find_indexed(const char *name, const char *prefix, int max,
+                        const etm_name_t *table, int n) {
+    size_t len = strlen(prefix);
+    if (strncmp(name, prefix, len) != 0) return -1;
+    int k = name[len] - '0';
+    if (k < 0 || k >= max || name[len + 1] != '.') return -1;
+    int id = find(table, n, name + len + 2);
+    return (id < 0) ? -1 : id + k;
+}
+
+static int event_id(const char *name) {
+    int id = find(event_names, COUNT(event_names), name);
+    if (id < 0) id = find_indexed(name, "gpio.ch", 8, gpio_events, COUNT(gpio_events));
+    return id;
+}
+
+static int task_id(const char *name) {
+    int id = find_indexed(name, "timer", 2, timer_tasks, COUNT(timer_tasks));
+    if (id < 0) id = find_indexed(name, "gpio.ch", 8, gpio_tasks, COUNT(gpio_tasks));
+    return id;
+}
+
+// Tasks that undo each other on the same unit
+static const uint8_t opposite_tasks[][2] = {
+    { TIMER0_TASK_CNT_START_TIMER0, TIMER0_TASK_CNT_STOP_TIMER0 },
+    { TIMER1_TASK_CNT_START_TIMER0, TIMER1_TASK_CNT_STOP_TIMER0 },
+    { GPIO_TASK_CH0_SET,            GPIO_TASK_CH0_CLEAR },
+    { GPIO_TASK_CH1_SET,            GPIO_TASK_CH1_CLEAR },
+    { GPIO_TASK_CH2_SET,            GPIO_TASK_CH2_CLEAR },
+    { GPIO_TASK_CH3_SET,            GPIO_TASK_CH3_CLEAR },
+    { GPIO_TASK_CH4_SET,            GPIO_TASK_CH4_CLEAR },
+    { GPIO_TASK_CH5_SET,            GPIO_TASK_CH5_CLEAR },
+    { GPIO_TASK_CH6_SET,            GPIO_TASK_CH6_CLEAR },
+    { GPIO_TASK_CH7_SET,            GPIO_TASK_CH7_CLEAR },
+};
+
+// The task that undoes this one on the same unit, or -1
+static int opposite_task(int id) {
+    for (int i = 0; i < COUNT(opposite_tasks); i++) {
+        if (opposite_tasks[i][0] == id) return opposite_tasks[i][1];
+        if (opposite_tasks[i][1] == id) return opposite_tasks[i][0];
+    }
+    return -1;
+}
+
+// ============================================================
+// Building
+// ============================================================
+
+void etm_net_init(etm_net_t *net, const char *name) {
+    memset(net, 0, sizeof(*net));
+    net->name = name;
+}
+
+static esp_err_t add_edge(etm_net_t *net, const char *event, const char *task, int channel, int line) {
+    if (net->loaded) return ESP_ERR_INVALID_STATE;
+    int ev = event_id(event), tk = task_id(task);
+    if (ev < 0 || tk < 0) {
+        ESP_LOGE(TAG, "%s:%d: unknown %s '%s'", net->name, line,
+                 ev < 0 ? "event" : "task", ev < 0 ? event : task);
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (channel != ETM_CHANNEL_AUTO && (channel < 0 || channel >= ETM_NUM_CHANNELS)) {
+        ESP_LOGE(TAG, "%s:%d: ETM CH%d out of range (0..%d)", net->name, line, channel, ETM_NUM_CHANNELS - 1);
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (int i = 0; i < net->num_edges; i++) {
+        const etm_net_edge_t *e = &net->edges[i];
+        if (channel != ETM_CHANNEL_AUTO && e->channel == channel) {
+            ESP_LOGE(TAG, "%s:%d: ETM CH%d already used by line %d", net->name, line, channel, e->line);
+            return ESP_ERR_INVALID_STATE;
+        }
+        if (e->event_id != ev) continue;
+        if (e->task_id == tk || e->task_id == opposite_task(tk)) {
+            ESP_LOGE(TAG, "%s:%d: %s -> %s %s %s (line %d)", net->name, line, event, task,
+                     e->task_id == tk ? "repeats" : "opposes", e->task, e->line);
+            return ESP_ERR_INVALID_STATE;
+        }
+    }
+    if (net->num_edges >= ETM_NET_MAX_EDGES) {
+        ESP_LOGE(TAG, "%s: at most %d edges", net->name, ETM_NET_MAX_EDGES);
+        return ESP_ERR_NO_MEM;
+    }
+
+    etm_net_edge_t *e = &net->edges[net->num_edges++];
+    snprintf(e->event, sizeof(e->event), "%s", event);
+    snprintf(e->task, sizeof(e->task), "%s", task);
+    e->event_id = (uint8_t)ev;
+    e->task_id = (uint8_t)tk;
+    e->channel = channel;
+    e->line = line;
+    return ESP_OK;
+}
+
+esp_err_t etm_net_connect(etm_net_t *net, const char *event, const char *task, int channel) {
+    return add_edge(net, event, task, channel, 0);
+}
+
+// Trims in place; returns the first non-blank character
+static char *trim(char *s) {
+    while (isspace((unsigned char)*s)) s++;
+    char *end = s + strlen(s);
+    while (end > s && isspace((unsigned char)end[-1])) *--end = '\0';
+    return s;
+}
+
+static esp_err_t parse_line(etm_net_t *net, char *s, int line) {
+    char *hash = strchr(s, '#');
+    if (hash) *hash = '\0';
+    s = trim(s);
+    if (*s == '\0') return ESP_OK;
+
+    char *arrow = strstr(s, "->");
+    if (!arrow) {
+        ESP_LOGE(TAG, "%s:%d: expected 'event -> task'", net->name, line);
+        return ESP_ERR_INVALID_ARG;
+    }
+    *arrow = '\0';
+    char *event = trim(s);
+    char *tasks = arrow + 2;
+
+    int channel = ETM_CHANNEL_AUTO;
+    char *at = strchr(tasks, '@');
+    if (at) {
+        *at = '\0';
+        char *end;
+        channel = (int)strtol(at + 1, &end, 10);
+        if (end == at + 1 || *trim(end) != '\0') {
+            ESP_LOGE(TAG, "%s:%d: bad channel '@%s'", net->name, line, at + 1);
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+
+    // Fan-out: one edge per task, on consecutive channels
+    char *save;
+    for (char *task = strtok_r(tasks, ",", &save); task; task = strtok_r(NULL, ",", &save)) {
+        esp_err_t ret = add_edge(net, event, trim(task), channel, line);
+        if (ret != ESP_OK) return ret;
+        if (channel != ETM_CHANNEL_AUTO) channel++;
+    }
+    return ESP_OK;
+}
+
+esp_err_t etm_net_parse(etm_net_t *net, const char *text) {
+    char buf[128];
+    int line = 0;
+    while (*text) {
+        line++;
+        size_t len = strcspn(text, "\n");
+        if (len >= sizeof(buf)) {
+            ESP_LOGE(TAG, "%s:%d: line too long", net->name, line);
+            return ESP_ERR_INVALID_ARG;
+        }
+        memcpy(buf, text, len);
+        buf[len] = '\0';
+        esp_err_t ret = parse_line(net, buf, line);
+        if (ret != ESP_OK) return ret;
+        text += len + (text[len] == '\n');
+    }
+    return ESP_OK;
+}
+
+// ============================================================
+// Loading
+// ============================================================
+
+// Events consumed by loaded nets, one net per event; routes written by
+// anything else are found by scanning the enabled channels
+static uint32_t net_events[8];
+
+static bool event_taken(uint8_t id) {
+    return (net_events[id / 32] >> (id & 31)) & 1;
+}
+
+static bool channel_enabled(int ch) {
+    uint32_t ena = (ch < 32) ? ETM_REG(ETM_CH_ENA_AD0_REG) : ETM_REG(ETM_CH_ENA_AD1_REG);
+    return (ena >> (ch & 31)) & 1;
+}
+
+static void release_channels(etm_net_t *net, int upto) {
+    for (int i = 0; i < upto; i++) etm_channel_release(net->channels[i]);
+}
+
+esp_err_t etm_net_load(etm_net_t *net) {
+    if (net->loaded || net->num_edges == 0) return ESP_ERR_INVALID_STATE;
+
+    // Another listener of one of our events would fire with it
+    for (int i = 0; i < net->num_edges; i++) {
+        if (!event_taken(net->edges[i].event_id)) continue;
+        ESP_LOGE(TAG, "%s: another net already consumes %s", net->name, net->edges[i].event);
+        return ESP_ERR_INVALID_STATE;
+    }
+    for (int ch = 0; ch < ETM_NUM_CHANNELS; ch++) {
+        if (!channel_enabled(ch)) continue;
+        uint32_t evt = ETM_REG(ETM_CH_EVT_ID_REG(ch));
+        for (int i = 0; i < net->num_edges; i++) {
+            if (evt != net->edges[i].event_id) continue;
+            ESP_LOGE(TAG, "%s: ETM CH%d already consumes %s", net->name, ch, net->edges[i].event);
+            return ESP_ERR_INVALID_STATE;
+        }
+    }
+
+    for (int i = 0; i < net->num_edges; i++) {
+        int ch = net->edges[i].channel;
+        esp_err_t ret = (ch == ETM_CHANNEL_AUTO) ? etm_channel_alloc(&net->channels[i])
+                                                 : etm_channel_reserve(ch);
+        if (ch != ETM_CHANNEL_AUTO) net->channels[i] = ch;
+        if (ret != ESP_OK) {
+            release_channels(net, i);
+            return ret;
+        }
+    }
+
+    // Routes, then every enable in one write per register
+    uint32_t mask[2] = {0};
+    for (int i = 0; i < net->num_edges; i++) {
+        int ch = net->channels[i];
+        ETM_REG(ETM_CH_EVT_ID_REG(ch)) = net->edges[i].event_id;
+        ETM_REG(ETM_CH_TASK_ID_REG(ch)) = net->edges[i].task_id;
+        mask[ch / 32] |= 1u << (ch & 31);
+        net_events[net->edges[i].event_id / 32] |= 1u << (net->edges[i].event_id & 31);
+    }
+    if (mask[0]) ETM_REG(ETM_CH_ENA_SET_REG) = mask[0];
+    if (mask[1]) ETM_REG(ETM_CH_ENA_AD1_SET_REG) = mask[1];
+
+    net->loaded = true;
+    return ESP_OK;
+}
+
+void etm_net_unload(etm_net_t *net) {
+    if (!net->loaded) return;
+    uint64_t mask = 0;
+    for (int i = 0; i < net->num_edges; i++) {
+        mask |= 1ULL << net->channels[i];
+        net_events[net->edges[i].event_id / 32] &= ~(1u << (net->edges[i].event_id & 31));
+    }
+    etm_channel_release_mask(mask);
+    net->loaded = false;
+}
+
+// ============================================================
+// Export
+// ============================================================
+
+int etm_net_export_dot(const etm_net_t *net, char *buf, size_t len) {
+    int n = snprintf(buf, len, "digraph \"%s\" {\n  rankdir=LR;\n", net->name);
+    for (int i = 0; i < net->num_edges; i++) {
+        const etm_net_edge_t *e = &net->edges[i];
+        char label[16];
+        if (net->loaded) snprintf(label, sizeof(label), "CH%d", net->channels[i]);
+        else if (e->channel != ETM_CHANNEL_AUTO) snprintf(label, sizeof(label), "@%d", e->channel);
+        else snprintf(label, sizeof(label), "auto");
+        n += snprintf(buf + (n < (int)len ? n : (int)len), n < (int)len ? len - n : 0,
+                      "  \"%s\" -> \"%s\" [label=\"%s\"];\n", e->event, e->task, label);
+    }
+    n += snprintf(buf + (n < (int)len ? n : (int)len), n < (int)len ? len - n : 0, "}\n");
+    return n;
+}
@@ -0,0 +1,60 @@
+/**
+ * etm_net.h - Declarative ETM netlists
+ *
+ * A netlist names event → task edges instead of poking IDs into fixed
+ * channels:
+ *
+ *   # stopwatch between two edge counts
+ *   pcnt.thresh -> timer1.start, timer0.capture
+ *   pcnt.limit  -> timer1.stop, timer0.stop   @20
+ *
+ * One edge per task; a line fans one event out to several tasks on
+ * consecutive channels, from @N or from the channel allocator. Names:
+ *
+ *   events  pcnt.thresh  pcnt.limit  pcnt.zero  timerN.alarm
+ *           gpio.chK.rise  gpio.chK.fall  gpio.chK.any
+ *   tasks   timerN.start  .stop  .alarm  .reload  .capture
+ *           gpio.chK.set  gpio.chK.clear  gpio.chK.toggle
+ *
+ * (N = 0..1 hardware timer, K = 0..7 GPIO ETM channel.) Building a net
+ * rejects unknown names, duplicate edges and one event driving opposite
+ * tasks (start and stop, set and clear). Loading rejects busy channels
+ * and events another enabled channel already consumes, all or nothing.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "etm_switch.h"
+
+#define ETM_NET_MAX_EDGES       16
+#define ETM_NET_NAME_LEN        20
+
+typedef struct {
+    char event[ETM_NET_NAME_LEN];
+    char task[ETM_NET_NAME_LEN];
+    uint8_t event_id, task_id;
+    int channel;                // fixed, or ETM_CHANNEL_AUTO
+    int line;                   // source line, 0 from etm_net_connect()
+} etm_net_edge_t;
+
+typedef struct {
+    const char *name;
+    etm_net_edge_t edges[ETM_NET_MAX_EDGES];
+    int num_edges;
+    int channels[ETM_NET_MAX_EDGES];    // assigned by load
+    bool loaded;
+} etm_net_t;
+
+void etm_net_init(etm_net_t *net, const char *name);
+esp_err_t etm_net_connect(etm_net_t *net, const char *event, const char *task, int channel);
+esp_err_t etm_net_parse(etm_net_t *net, const char *text);
+
+esp_err_t etm_net_load(etm_net_t *net);
+void etm_net_unload(etm_net_t *net);
+
+// Graphviz dot; returns the length it needed, like snprintf
+int etm_net_export_dot(const etm_net_t *net, char *buf, size_t len);
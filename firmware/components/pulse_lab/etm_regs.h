@@ -0,0 +1,40 @@
+/**
+ * etm_regs.h - Bare-metal ETM register access for the fabric demos
+ *
+ * PCNT has no ETM binding in ESP-IDF, so channels are wired by writing
+ * event and task IDs straight into the matrix. Host builds point the
+ * same macros at the register file of host/etm_sim.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "soc/soc_etm_source.h"
+
+#ifdef PULSE_LAB_HOST
+// Host build: the register file of host/etm_sim stands in for the SoC
+#include "etm_sim.h"
+#define ETM_BASE                    ETM_SIM_ETM_BASE
+#define PCR_BASE                    ETM_SIM_PCR_BASE
+#define CPU_RELAX()                 etm_sim_cpu_relax()
+#else
+#define ETM_BASE                    0x600B8000
+#define PCR_BASE                    0x60096000
+#define CPU_RELAX()                 __asm__ volatile("nop")
+#endif
+
+#define ETM_NUM_CHANNELS            50
+
+#define ETM_CH_ENA_AD0_REG          (ETM_BASE + 0x00)
+#define ETM_CH_ENA_SET_REG          (ETM_BASE + 0x04)
+#define ETM_CH_ENA_CLR_REG          (ETM_BASE + 0x08)
+#define ETM_CH_ENA_AD1_REG          (ETM_BASE + 0x0C)
+#define ETM_CH_ENA_AD1_SET_REG      (ETM_BASE + 0x10)
+#define ETM_CH_ENA_AD1_CLR_REG      (ETM_BASE + 0x14)
+#define ETM_CH_EVT_ID_REG(n)        (ETM_BASE + 0x18 + (n) * 8)
+#define ETM_CH_TASK_ID_REG(n)       (ETM_BASE + 0x1C + (n) * 8)
+
+#define ETM_REG(addr)               (*(volatile uint32_t*)(addr))
+
+// PCR for ETM clock
+#define PCR_SOC_ETM_CONF            (PCR_BASE + 0x90)
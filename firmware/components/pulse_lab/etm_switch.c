@@ -0,0 +1,290 @@
+/**
+ * etm_switch.c - Multi-way hardware branching on PCNT events
+ *
+ * See etm_switch.h. Routes are written straight into the ETM matrix
+ * (PCNT has no ETM binding in ESP-IDF); the allocator tracks the
+ * channels it handed out and treats any enabled channel as taken. It
+ * also ungates the ETM block, which only IDF's esp_etm driver would.
+ */
+
+#include <string.h>
+#include "esp_log.h"
+#include "etm_switch.h"
+#include "etm_regs.h"
+
+static const char *TAG = "ETM_SW";
+
+// ============================================================
+// Channel Allocator
+// ============================================================
+
+static uint64_t channels_owned;
+
+// Out of reset with its clock on; a running block keeps its routes
+static void etm_clock_on(void) {
+    volatile uint32_t *conf = (volatile uint32_t*)PCR_SOC_ETM_CONF;
+    if ((*conf & 3) == 1) return;
+    *conf &= ~(1 << 1);  // Clear reset
+    *conf |= (1 << 0);   // Enable clock
+}
+
+static bool channel_enabled(int ch) {
+    uint32_t ena = (ch < 32) ? ETM_REG(ETM_CH_ENA_AD0_REG) : ETM_REG(ETM_CH_ENA_AD1_REG);
+    return (ena >> (ch & 31)) & 1;
+}
+
+static bool channel_busy(int ch) {
+    return ((channels_owned >> ch) & 1) || channel_enabled(ch);
+}
+
+esp_err_t etm_channel_reserve(int channel) {
+    if (channel < 0 || channel >= ETM_NUM_CHANNELS) {
+        ESP_LOGE(TAG, "ETM CH%d out of range (0..%d)", channel, ETM_NUM_CHANNELS - 1);
+        return ESP_ERR_INVALID_ARG;
+    }
+    etm_clock_on();
+    if (channel_busy(channel)) {
+        ESP_LOGE(TAG, "ETM CH%d already in use", channel);
+        return ESP_ERR_INVALID_STATE;
+    }
+    channels_owned |= 1ULL << channel;
+    return ESP_OK;
+}
+
+// Top-down: IDF's esp_etm driver hands out channels from CH0 up
+esp_err_t etm_channel_alloc(int *channel) {
+    etm_clock_on();
+    for (int ch = ETM_NUM_CHANNELS - 1; ch >= 0; ch--) {
+        if (channel_busy(ch)) continue;
+        channels_owned |= 1ULL << ch;
+        *channel = ch;
+        return ESP_OK;
+    }
+    ESP_LOGE(TAG, "all %d ETM channels in use", ETM_NUM_CHANNELS);
+    return ESP_ERR_NOT_FOUND;
+}
+
+void etm_channel_release(int channel) {
+    if (channel < 0 || channel >= ETM_NUM_CHANNELS) return;
+    if (channel < 32) ETM_REG(ETM_CH_ENA_CLR_REG) = 1u << channel;
+    else ETM_REG(ETM_CH_ENA_AD1_CLR_REG) = 1u << (channel - 32);
+    channels_owned &= ~(1ULL << channel);
+}
+
+void etm_channel_release_mask(uint64_t mask) {
+    mask &= (1ULL << ETM_NUM_CHANNELS) - 1;
+    if ((uint32_t)mask) ETM_REG(ETM_CH_ENA_CLR_REG) = (uint32_t)mask;
+    if (mask >> 32) ETM_REG(ETM_CH_ENA_AD1_CLR_REG) = (uint32_t)(mask >> 32);
+    channels_owned &= ~mask;
+}
+
+int etm_channel_free_count(void) {
+    int n = 0;
+    for (int ch = 0; ch < ETM_NUM_CHANNELS; ch++) n += !channel_busy(ch);
+    return n;
+}
+
+// ============================================================
+// Switch
+// ============================================================
+
+// High limits of the counters made here, newest last; IDF has no getter.
+// A deleted unit's handle comes back from the heap for the next unit and
+// takes over its entry.
+#define TRACKED_COUNTERS    8
+
+static struct {
+    pcnt_unit_handle_t unit;
+    int high_limit;
+} counter_limits[TRACKED_COUNTERS];
+static int counter_next;
+
+static void track_counter(pcnt_unit_handle_t unit, int high_limit) {
+    for (int i = 0; i < TRACKED_COUNTERS; i++) {
+        if (counter_limits[i].unit == unit) {
+            counter_limits[i].high_limit = high_limit;
+            return;
+        }
+    }
+    counter_limits[counter_next].unit = unit;
+    counter_limits[counter_next].high_limit = high_limit;
+    counter_next = (counter_next + 1) % TRACKED_COUNTERS;
+}
+
+// The unit's high limit, or -1 if it was not made by etm_pcnt_new_counter()
+static int counter_high_limit(pcnt_unit_handle_t unit) {
+    for (int i = 0; i < TRACKED_COUNTERS; i++) {
+        if (counter_limits[i].unit == unit) return counter_limits[i].high_limit;
+    }
+    return -1;
+}
+
+esp_err_t etm_pcnt_new_counter(int gpio, int high_limit,
+                               pcnt_unit_handle_t *unit, pcnt_channel_handle_t *chan) {
+    pcnt_unit_config_t cfg = {
+        .low_limit = -1,
+        .high_limit = high_limit,
+    };
+    esp_err_t ret = pcnt_new_unit(&cfg, unit);
+    if (ret != ESP_OK) return ret;
+    track_counter(*unit, high_limit);
+
+    pcnt_chan_config_t chan_cfg = {
+        .edge_gpio_num = gpio,
+        .level_gpio_num = -1,
+    };
+    ret = pcnt_new_channel(*unit, &chan_cfg, chan);
+    if (ret != ESP_OK) return ret;
+    pcnt_channel_set_edge_action(*chan, PCNT_CHANNEL_EDGE_ACTION_INCREASE, PCNT_CHANNEL_EDGE_ACTION_HOLD);
+    return ESP_OK;
+}
+
+static uint32_t case_event(const etm_case_t *c) {
+    return (c->kind == ETM_CASE_PCNT_LIMIT) ? PCNT_EVT_CNT_EQ_LMT : PCNT_EVT_CNT_EQ_THRESH;
+}
+
+void etm_switch_init(etm_switch_t *sw) {
+    memset(sw, 0, sizeof(*sw));
+}
+
+esp_err_t etm_switch_add_case(etm_switch_t *sw, const etm_case_t *c) {
+    if (sw->loaded) return ESP_ERR_INVALID_STATE;
+    if (c->kind != ETM_CASE_PCNT_LIMIT && c->kind != ETM_CASE_PCNT_WATCH) return ESP_ERR_INVALID_ARG;
+
+    // Shared events: a second case of the same kind could not be told apart
+    for (int i = 0; i < sw->num_cases; i++) {
+        if (sw->cases[i].kind == c->kind) {
+            ESP_LOGE(TAG, "case %d: event %lu already taken by case %d (PCNT events are shared by all units)",
+                     sw->num_cases, (unsigned long)case_event(c), i);
+            return ESP_ERR_INVALID_STATE;
+        }
+    }
+    if (sw->num_cases >= ETM_SWITCH_MAX_CASES) {
+        ESP_LOGE(TAG, "at most %d cases", ETM_SWITCH_MAX_CASES);
+        return ESP_ERR_NO_MEM;
+    }
+    if (c->num_sources < 1 || c->num_sources > ETM_CASE_MAX_SOURCES ||
+        c->num_tasks < 1 || c->num_tasks > ETM_CASE_MAX_TASKS) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (int i = 0; i < c->num_sources; i++) {
+        int t = c->sources[i].threshold;
+        if (!c->sources[i].unit || t <= 0 || t > 32767) {
+            ESP_LOGE(TAG, "case %d: bad threshold %d", sw->num_cases, t);
+            return ESP_ERR_INVALID_ARG;
+        }
+        // Below the limit the watch point would raise THRESH, not LMT
+        if (c->kind == ETM_CASE_PCNT_LIMIT) {
+            int limit = counter_high_limit(c->sources[i].unit);
+            if (limit != t) {
+                if (limit < 0) {
+                    ESP_LOGE(TAG, "case %d: limit source not made by etm_pcnt_new_counter()", sw->num_cases);
+                } else {
+                    ESP_LOGE(TAG, "case %d: threshold %d is not the unit's high limit %d",
+                             sw->num_cases, t, limit);
+                }
+                return ESP_ERR_INVALID_ARG;
+            }
+        }
+    }
+    if (c->channel != ETM_CHANNEL_AUTO &&
+        (c->channel < 0 || c->channel + c->num_tasks > ETM_NUM_CHANNELS)) {
+        ESP_LOGE(TAG, "case %d: ETM CH%d..%d out of range (0..%d)", sw->num_cases,
+                 c->channel, c->channel + c->num_tasks - 1, ETM_NUM_CHANNELS - 1);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    sw->cases[sw->num_cases++] = *c;
+    return ESP_OK;
+}
+
+static void release_channels(etm_switch_t *sw, int upto_case, int upto_task) {
+    for (int i = 0; i <= upto_case && i < sw->num_cases; i++) {
+        int n = (i == upto_case) ? upto_task : sw->cases[i].num_tasks;
+        for (int k = 0; k < n; k++) etm_channel_release(sw->channels[i][k]);
+    }
+}
+
+static void remove_watch_points(etm_switch_t *sw, int upto_case, int upto_source) {
+    for (int i = 0; i <= upto_case && i < sw->num_cases; i++) {
+        const etm_case_t *c = &sw->cases[i];
+        int n = (i == upto_case) ? upto_source : c->num_sources;
+        for (int s = 0; s < n; s++) pcnt_unit_remove_watch_point(c->sources[s].unit, c->sources[s].threshold);
+    }
+}
+
+esp_err_t etm_switch_load(etm_switch_t *sw) {
+    if (sw->loaded || sw->num_cases == 0) return ESP_ERR_INVALID_STATE;
+    esp_err_t ret;
+
+    // Channels
+    for (int i = 0; i < sw->num_cases; i++) {
+        const etm_case_t *c = &sw->cases[i];
+        for (int k = 0; k < c->num_tasks; k++) {
+            if (c->channel == ETM_CHANNEL_AUTO) {
+                ret = etm_channel_alloc(&sw->channels[i][k]);
+            } else {
+                sw->channels[i][k] = c->channel + k;
+                ret = etm_channel_reserve(c->channel + k);
+            }
+            if (ret != ESP_OK) {
+                release_channels(sw, i, k);
+                return ret;
+            }
+        }
+    }
+
+    // Any other listener of our events would fire with them
+    for (int ch = 0; ch < ETM_NUM_CHANNELS; ch++) {
+        if (!channel_enabled(ch)) continue;
+        uint32_t evt = ETM_REG(ETM_CH_EVT_ID_REG(ch));
+        for (int i = 0; i < sw->num_cases; i++) {
+            if (evt != case_event(&sw->cases[i])) continue;
+            ESP_LOGE(TAG, "ETM CH%d also consumes event %lu", ch, (unsigned long)evt);
+            release_channels(sw, sw->num_cases - 1, sw->cases[sw->num_cases - 1].num_tasks);
+            return ESP_ERR_INVALID_STATE;
+        }
+    }
+
+    // A watch point on a limit enables its event on the hardware
+    for (int i = 0; i < sw->num_cases; i++) {
+        const etm_case_t *c = &sw->cases[i];
+        for (int s = 0; s < c->num_sources; s++) {
+            ret = pcnt_unit_add_watch_point(c->sources[s].unit, c->sources[s].threshold);
+            if (ret != ESP_OK) {
+                ESP_LOGE(TAG, "case %d: watch point %d: %s", i, c->sources[s].threshold, esp_err_to_name(ret));
+                remove_watch_points(sw, i, s);
+                release_channels(sw, sw->num_cases - 1, sw->cases[sw->num_cases - 1].num_tasks);
+                return ret;
+            }
+        }
+    }
+
+    // Routes, then every enable in one write per register
+    uint32_t mask[2] = {0};
+    for (int i = 0; i < sw->num_cases; i++) {
+        const etm_case_t *c = &sw->cases[i];
+        for (int k = 0; k < c->num_tasks; k++) {
+            int ch = sw->channels[i][k];
+            ETM_REG(ETM_CH_EVT_ID_REG(ch)) = case_event(c);
+            ETM_REG(ETM_CH_TASK_ID_REG(ch)) = c->tasks[k];
+            mask[ch / 32] |= 1u << (ch & 31);
+        }
+    }
+    if (mask[0]) ETM_REG(ETM_CH_ENA_SET_REG) = mask[0];
+    if (mask[1]) ETM_REG(ETM_CH_ENA_AD1_SET_REG) = mask[1];
+
+    sw->loaded = true;
+    return ESP_OK;
+}
+
+void etm_switch_unload(etm_switch_t *sw) {
+    if (!sw->loaded) return;
+    uint64_t mask = 0;
+    for (int i = 0; i < sw->num_cases; i++) {
+        for (int k = 0; k < sw->cases[i].num_tasks; k++) mask |= 1ULL << sw->channels[i][k];
+    }
+    etm_channel_release_mask(mask);
+    remove_watch_points(sw, sw->num_cases - 1, sw->cases[sw->num_cases - 1].num_sources);
+    sw->loaded = false;
+}
@@ -0,0 +1,87 @@
+/**
+ * etm_switch.h - Multi-way hardware branching on PCNT events
+ *
+ * A switch maps PCNT thresholds to ETM tasks, one ETM channel per task,
+ * so the fabric picks a branch with no CPU wake-up. On the C6 the PCNT
+ * ETM events are shared by all units, so cases are told apart by event
+ * kind, not by unit:
+ *
+ *   ETM_CASE_PCNT_LIMIT   a unit reaches its high limit  → PCNT_EVT_CNT_EQ_LMT
+ *   ETM_CASE_PCNT_WATCH   a unit reaches a watch point   → PCNT_EVT_CNT_EQ_THRESH
+ *
+ * A case may gather thresholds from several units (any of them fires it)
+ * and fan out to several tasks. With a rising count the cases nest: a
+ * count past the higher threshold has fired the lower case too, so the
+ * taken branch is the number of cases fired (thermometer code), and no
+ * case fired is the default. Test 5's read and test 6's switch decode
+ * it that way.
+ *
+ * Channels come from an allocator over the C6's 50 ETM channels that
+ * also sees channels enabled by raw register pokes.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "driver/pulse_cnt.h"
+
+#define ETM_CHANNEL_AUTO        (-1)
+
+#define ETM_SWITCH_MAX_CASES    2       // PCNT events with a threshold: LMT, THRESH
+#define ETM_CASE_MAX_SOURCES    4       // C6 PCNT units
+#define ETM_CASE_MAX_TASKS      4
+
+typedef enum {
+    ETM_CASE_PCNT_LIMIT,
+    ETM_CASE_PCNT_WATCH,
+} etm_case_kind_t;
+
+typedef struct {
+    pcnt_unit_handle_t unit;
+    int threshold;              // edges; LIMIT cases: the unit's high limit (checked)
+} etm_case_source_t;
+
+typedef struct {
+    etm_case_kind_t kind;
+    etm_case_source_t sources[ETM_CASE_MAX_SOURCES];
+    int num_sources;
+    uint8_t tasks[ETM_CASE_MAX_TASKS];
+    int num_tasks;
+    int channel;                // first of num_tasks channels, or ETM_CHANNEL_AUTO
+} etm_case_t;
+
+typedef struct {
+    etm_case_t cases[ETM_SWITCH_MAX_CASES];
+    int num_cases;
+    int channels[ETM_SWITCH_MAX_CASES][ETM_CASE_MAX_TASKS];    // assigned by load
+    bool loaded;
+} etm_switch_t;
+
+// ============================================================
+// Channel Allocator
+// ============================================================
+
+esp_err_t etm_channel_reserve(int channel);
+esp_err_t etm_channel_alloc(int *channel);     // highest free channel
+void etm_channel_release(int channel);         // also disables it
+void etm_channel_release_mask(uint64_t mask);  // a set of channels, one write per register
+int etm_channel_free_count(void);
+
+// ============================================================
+// Switch
+// ============================================================
+
+// Rising-edge counter on gpio, limits -1 .. high_limit. LIMIT case
+// sources must come from here: the switch checks their high limit.
+esp_err_t etm_pcnt_new_counter(int gpio, int high_limit,
+                               pcnt_unit_handle_t *unit, pcnt_channel_handle_t *chan);
+
+void etm_switch_init(etm_switch_t *sw);
+esp_err_t etm_switch_add_case(etm_switch_t *sw, const etm_case_t *c);
+
+// Takes the channels, adds the watch points and enables every route in
+// one write; all or nothing
+esp_err_t etm_switch_load(etm_switch_t *sw);
+void etm_switch_unload(etm_switch_t *sw);
@@ -0,0 +1,175 @@
+/**
+ * net_arena.h - Arena and pool allocation for network state and buffers
+ *
+ * An arena is one cache-line aligned block taken up front. Allocations
+ * bump a cursor (O(1), every one NET_ARENA_ALIGN aligned) and are never
+ * freed one by one: net_arena_reset() drops them all in O(1) between
+ * runs, and a mark/rewind pair drops everything since the mark.
+ *
+ *   device  heap_caps_aligned_alloc() with the caller's caps, e.g.
+ *           MALLOC_CAP_DMA | MALLOC_CAP_8BIT for PARLIO pattern buffers
+ *   host    anonymous mmap, advised onto transparent hugepages from 2 MiB
+ *
+ * A pool hands out fixed-size objects (networks, snapshots) carved from
+ * an arena, with O(1) get, put and reset.
+ *
+ * Both keep counts: allocations, bytes in use and the peak, for the
+ * benchmarks to report.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "esp_heap_caps.h"
+
+#ifndef ESP_PLATFORM
+#include <sys/mman.h>
+#endif
+
+#define NET_ARENA_ALIGN     64                  // Cache line; covers DMA's 4
+#define NET_ARENA_HUGE      (2u * 1024 * 1024)  // Host hugepage size
+
+typedef struct {
+    uint8_t *base;
+    size_t capacity;
+    size_t used;
+    size_t peak;            // Most bytes in use at once, across resets
+    uint32_t allocs;        // Allocations since init
+    uint32_t failed;        // Allocations that did not fit
+    uint32_t resets;
+    bool mapped;            // Host: mmap'd (hugepage-advised)
+} net_arena_t;
+
+static inline size_t net_arena_round(size_t n) {
+    return (n + NET_ARENA_ALIGN - 1) & ~(size_t)(NET_ARENA_ALIGN - 1);
+}
+
+/** Reserve `capacity` bytes. Returns 0, or -1 without memory (capacity 0). */
+static inline int net_arena_init(net_arena_t *a, size_t capacity, uint32_t caps) {
+    memset(a, 0, sizeof(*a));
+    a->capacity = net_arena_round(capacity ? capacity : 1);
+#ifndef ESP_PLATFORM
+    if (a->capacity >= NET_ARENA_HUGE) {
+        a->capacity = (a->capacity + NET_ARENA_HUGE - 1) & ~(size_t)(NET_ARENA_HUGE - 1);
+        void *p = mmap(NULL, a->capacity, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) {
+            a->capacity = 0;
+            return -1;
+        }
+#ifdef MADV_HUGEPAGE
+        madvise(p, a->capacity, MADV_HUGEPAGE);
+#endif
+        a->base = p;
+        a->mapped = true;
+        return 0;
+    }
+#endif
+    a->base = heap_caps_aligned_alloc(NET_ARENA_ALIGN, a->capacity, caps);
+    if (!a->base) {
+        a->capacity = 0;    // Every alloc then fails instead of offsetting NULL
+        return -1;
+    }
+    return 0;
+}
+
+static inline void net_arena_destroy(net_arena_t *a) {
+#ifndef ESP_PLATFORM
+    if (a->mapped) {
+        munmap(a->base, a->capacity);
+        a->base = NULL;
+        return;
+    }
+#endif
+    heap_caps_free(a->base);
+    a->base = NULL;
+}
+
+/** `size` bytes, NET_ARENA_ALIGN aligned, or NULL when the arena is full. */
+static inline void *net_arena_alloc(net_arena_t *a, size_t size) {
+    size_t need = net_arena_round(size);
+    if (need > a->capacity - a->used) {
+        a->failed++;
+        return NULL;
+    }
+    void *p = a->base + a->used;
+    a->used += need;
+    a->allocs++;
+    if (a->used > a->peak) a->peak = a->used;
+    return p;
+}
+
+/** net_arena_alloc(), zeroed. */
+static inline void *net_arena_zalloc(net_arena_t *a, size_t size) {
+    void *p = net_arena_alloc(a, size);
+    if (p) memset(p, 0, size);
+    return p;
+}
+
+static inline size_t net_arena_mark(const net_arena_t *a) { return a->used; }
+static inline void net_arena_rewind(net_arena_t *a, size_t mark) { a->used = mark; }
+
+/** Drop every allocation. */
+static inline void net_arena_reset(net_arena_t *a) {
+    a->used = 0;
+    a->resets++;
+}
+
+// ============================================================
+// Pools of fixed-size objects
+// ============================================================
+
+typedef struct net_pool_free { struct net_pool_free *next; } net_pool_free_t;
+
+typedef struct {
+    uint8_t *slots;
+    size_t stride;          // Object size rounded to NET_ARENA_ALIGN
+    uint32_t count;
+    uint32_t fresh;         // Slots never handed out since the last reset
+    net_pool_free_t *free_list;
+    uint32_t in_use;
+    uint32_t peak;
+    uint32_t gets;
+} net_pool_t;
+
+/** `count` objects of `size` bytes from `a`. Returns 0, or -1 if it is full. */
+static inline int net_pool_init(net_pool_t *p, net_arena_t *a, size_t size, uint32_t count) {
+    memset(p, 0, sizeof(*p));
+    p->stride = net_arena_round(size < sizeof(net_pool_free_t) ? sizeof(net_pool_free_t) : size);
+    p->slots = net_arena_alloc(a, p->stride * count);
+    p->count = count;
+    return p->slots ? 0 : -1;
+}
+
+/** An object (contents undefined), or NULL when all are in use. */
+static inline void *net_pool_get(net_pool_t *p) {
+    void *obj;
+    if (p->free_list) {
+        obj = p->free_list;
+        p->free_list = p->free_list->next;
+    } else if (p->fresh < p->count) {
+        obj = p->slots + (size_t)p->fresh++ * p->stride;
+    } else {
+        return NULL;
+    }
+    p->gets++;
+    if (++p->in_use > p->peak) p->peak = p->in_use;
+    return obj;
+}
+
+static inline void net_pool_put(net_pool_t *p, void *obj) {
+    net_pool_free_t *f = obj;
+    f->next = p->free_list;
+    p->free_list = f;
+    p->in_use--;
+}
+
+/** Return every object at once. */
+static inline void net_pool_reset(net_pool_t *p) {
+    p->free_list = NULL;
+    p->fresh = 0;
+    p->in_use = 0;
+}
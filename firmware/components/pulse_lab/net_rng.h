@@ -0,0 +1,81 @@
+/**
+ * net_rng.h - Random numbers for network initialization
+ *
+ * Two generators behind one interface:
+ *
+ *   NET_RNG_LCG      The demos' original prng(): state * 1103515245 + 12345,
+ *                    15 bits out. net_rng_lcg(seed) reproduces the sequence
+ *                    init_network() has always drawn.
+ *   NET_RNG_COUNTER  SplitMix64 on a counter: draw i of a stream is
+ *                    mix(key + (i + 1) * golden), 32 bits out. The key comes
+ *                    from (seed, network id, stream), so every network of an
+ *                    ensemble has its own streams. Any draw can be computed
+ *                    directly, without shared state or a particular order.
+ *
+ * Both are value types: one per network, no globals. net_rng_skip() jumps
+ * either kind ahead in O(log n).
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define NET_RNG_GOLDEN      0x9E3779B97F4A7C15ULL
+#define NET_RNG_LCG_MUL     1103515245u
+#define NET_RNG_LCG_ADD     12345u
+
+typedef enum { NET_RNG_LCG, NET_RNG_COUNTER } net_rng_mode_t;
+
+typedef struct {
+    net_rng_mode_t mode;
+    uint32_t lcg;           // NET_RNG_LCG: generator state
+    uint64_t key;           // NET_RNG_COUNTER: stream key
+    uint64_t counter;       // NET_RNG_COUNTER: draws taken
+} net_rng_t;
+
+// SplitMix64 finalizer (a bijection on 64 bits)
+static inline uint64_t net_rng_mix(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Distinct (network, stream) pairs get distinct keys under one seed
+static inline uint64_t net_rng_key(uint32_t seed, uint32_t network, uint32_t stream) {
+    uint64_t k = net_rng_mix((uint64_t)seed + NET_RNG_GOLDEN);
+    return net_rng_mix(k ^ ((uint64_t)network << 32 | stream));
+}
+
+/** Draw `index` of the counter stream `key`. */
+static inline uint32_t net_rng_at(uint64_t key, uint64_t index) {
+    return (uint32_t)(net_rng_mix(key + (index + 1) * NET_RNG_GOLDEN) >> 32);
+}
+
+static inline net_rng_t net_rng_lcg(uint32_t seed) {
+    return (net_rng_t){ .mode = NET_RNG_LCG, .lcg = seed };
+}
+
+static inline net_rng_t net_rng_counter(uint32_t seed, uint32_t network, uint32_t stream) {
+    return (net_rng_t){ .mode = NET_RNG_COUNTER, .key = net_rng_key(seed, network, stream) };
+}
+
+/** Next draw: 15 bits from the LCG, 32 bits from the counter stream. */
+static inline uint32_t net_rng_next(net_rng_t *r) {
+    if (r->mode == NET_RNG_COUNTER) return net_rng_at(r->key, r->counter++);
+    r->lcg = r->lcg * NET_RNG_LCG_MUL + NET_RNG_LCG_ADD;
+    return (r->lcg >> 16) & 0x7fff;
+}
+
+/** Advance by n draws (the LCG composes its affine step by squaring). */
+static inline void net_rng_skip(net_rng_t *r, uint64_t n) {
+    if (r->mode == NET_RNG_COUNTER) {
+        r->counter += n;
+        return;
+    }
+    uint32_t mul = NET_RNG_LCG_MUL, add = NET_RNG_LCG_ADD;
+    for (; n; n >>= 1) {
+        if (n & 1) r->lcg = r->lcg * mul + add;
+        add = add * (mul + 1);
+        mul = mul * mul;
+    }
+}
@@ -0,0 +1,197 @@
+/**
+ * pulse_bench.h - Benchmark harness shared by the demos
+ *
+ * A case is a named function that does `iterations` units of work, with
+ * parameters ("lanes=16,mode=q15") and a throughput unit. bench_run():
+ *
+ *   1. calibrates: doubles the iteration count until one batch takes
+ *      BENCH_BATCH_US
+ *   2. warms up: runs batches, untimed, for BENCH_WARMUP_US
+ *   3. samples: times batches until BENCH_BUDGET_US has passed (at least
+ *      BENCH_MIN_SAMPLES, at most BENCH_MAX_SAMPLES)
+ *
+ * It reports min/p50/p99/max time per iteration over the batches, and
+ * throughput at the median. Measurements taken elsewhere (per-trial
+ * latencies off a hardware timer) go through bench_samples() instead.
+ *
+ * Each result prints as a table row. bench_end() then prints one JSON line
+ * per case for tests/verify_claims.py and dashboards (if a table holds
+ * more than BENCH_MAX_CASES, the held lines are flushed early instead):
+ *
+ *   BENCH {"demo":"03_spectral_oscillator","case":"evolve_step",
+ *          "params":{"coupling":0.3},"platform":"esp32c6","iterations":512,
+ *          "samples":96,"min_ns":...,"p50_ns":...,"p99_ns":...,"max_ns":...,
+ *          "mean_ns":...,"throughput":...,"unit":"steps/s"}
+ *
+ * Time is esp_timer_get_time(). The host build maps it to clock_gettime()
+ * ("platform":"host"), or to simulated time in the ETM simulator
+ * ("platform":"host-sim").
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_timer.h"
+
+#define BENCH_BATCH_US      2000    // Calibrated length of one timed batch
+#define BENCH_WARMUP_US     20000
+#define BENCH_BUDGET_US     200000  // Sampling time per case
+#define BENCH_MIN_SAMPLES   5
+#define BENCH_MAX_SAMPLES   256
+#define BENCH_MAX_ITERS     (1u << 24)
+#define BENCH_MAX_CASES     16      // Results held for bench_end() (flushed early when full)
+
+#if defined(ESP_TIMER_SIMULATED)
+#define BENCH_PLATFORM      "host-sim"
+#elif defined(PULSE_LAB_HOST)
+#define BENCH_PLATFORM      "host"
+#else
+#define BENCH_PLATFORM      "esp32c6"
+#endif
+
+typedef struct {
+    const char *name;
+    const char *params;         // "key=value,..." or NULL
+    const char *unit;           // Work unit ("steps"), or NULL: no throughput
+    double work;                // Units per iteration (0 means 1)
+    void (*fn)(void *ctx, uint32_t iterations);
+    void *ctx;
+} bench_case_t;
+
+typedef struct {
+    const char *name;
+    const char *params;
+    const char *unit;
+    uint32_t iterations;        // Per timed batch
+    int samples;
+    double min_ns, p50_ns, p99_ns, max_ns, mean_ns;     // Per iteration
+    double throughput;          // Units per second at p50
+} bench_result_t;
+
+static const char *bench_demo = "";
+static bench_result_t bench_results[BENCH_MAX_CASES];
+static int bench_count;
+
+static inline int bench_cmp(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Nearest rank of sorted samples
+static inline double bench_percentile(const double *sorted, int n, int pct) {
+    int rank = (n * pct + 99) / 100;
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+// "a=1,b=x" as a JSON object; numbers stay numbers
+static inline void bench_print_params(const char *params) {
+    printf("{");
+    for (const char *p = params; p && *p;) {
+        const char *eq = strchr(p, '='), *end = strchr(p, ',');
+        if (!end) end = p + strlen(p);
+        if (!eq || eq > end) break;
+        const char *val = eq + 1;
+        size_t len = end - val;
+        bool number = len > 0 && strspn(val, "-+.0123456789eE") >= len;
+        printf("%s\"%.*s\":%s%.*s%s", p == params ? "" : ",", (int)(eq - p), p,
+               number ? "" : "\"", (int)len, val, number ? "" : "\"");
+        p = *end ? end + 1 : end;
+    }
+    printf("}");
+}
+
+// JSON lines of the held results; empties the table
+static inline void bench_flush(void) {
+    for (int i = 0; i < bench_count; i++) {
+        const bench_result_t *r = &bench_results[i];
+        printf("BENCH {\"demo\":\"%s\",\"case\":\"%s\",\"params\":", bench_demo, r->name);
+        bench_print_params(r->params);
+        printf(",\"platform\":\"%s\",\"iterations\":%lu,\"samples\":%d,"
+               "\"min_ns\":%.1f,\"p50_ns\":%.1f,\"p99_ns\":%.1f,\"max_ns\":%.1f,\"mean_ns\":%.1f",
+               BENCH_PLATFORM, (unsigned long)r->iterations, r->samples,
+               r->min_ns, r->p50_ns, r->p99_ns, r->max_ns, r->mean_ns);
+        if (r->unit) printf(",\"throughput\":%.1f,\"unit\":\"%s/s\"", r->throughput, r->unit);
+        printf("}\n");
+    }
+    bench_count = 0;
+}
+
+/** Start a table of results for `demo` (the firmware directory name). */
+static inline void bench_begin(const char *demo) {
+    bench_demo = demo;
+    bench_count = 0;
+    printf("\n  %-40s %10s %10s %10s %10s  %s\n", "Case", "Min us", "p50 us", "p99 us",
+           "Max us", "Throughput");
+    printf("  ---------------------------------------- ---------- ---------- ---------- ----------"
+           "  ----------------\n");
+}
+
+/** Summarize per-iteration times `ns[0..n)` (sorted in place) and print a row. */
+static inline bench_result_t bench_samples(const bench_case_t *c, double *ns, int n,
+                                           uint32_t iterations) {
+    bench_result_t r = {
+        .name = c->name, .params = c->params, .unit = c->unit,
+        .iterations = iterations, .samples = n,
+    };
+    if (n > 0) {
+        qsort(ns, n, sizeof(double), bench_cmp);
+        double sum = 0;
+        for (int i = 0; i < n; i++) sum += ns[i];
+        r.min_ns = ns[0];
+        r.p50_ns = bench_percentile(ns, n, 50);
+        r.p99_ns = bench_percentile(ns, n, 99);
+        r.max_ns = ns[n - 1];
+        r.mean_ns = sum / n;
+        if (c->unit && r.p50_ns > 0) r.throughput = (c->work > 0 ? c->work : 1) * 1e9 / r.p50_ns;
+    }
+
+    char label[41];
+    snprintf(label, sizeof(label), c->params ? "%s [%s]" : "%s", c->name, c->params);
+    printf("  %-40s %10.3f %10.3f %10.3f %10.3f", label, r.min_ns / 1e3, r.p50_ns / 1e3,
+           r.p99_ns / 1e3, r.max_ns / 1e3);
+    if (c->unit) printf("  %.0f %s/s", r.throughput, c->unit);
+    printf("\n");
+
+    if (bench_count == BENCH_MAX_CASES) bench_flush();
+    bench_results[bench_count++] = r;
+    return r;
+}
+
+/** Calibrate, warm up and time case `c`; print its row. */
+static inline bench_result_t bench_run(const bench_case_t *c) {
+    static double ns[BENCH_MAX_SAMPLES];
+    uint32_t iterations = 1;
+    for (;;) {
+        int64_t t0 = esp_timer_get_time();
+        c->fn(c->ctx, iterations);
+        if (esp_timer_get_time() - t0 >= BENCH_BATCH_US || iterations >= BENCH_MAX_ITERS) break;
+        iterations *= 2;
+    }
+
+    // Bounded in batches too: simulated clocks only move on driver calls
+    int64_t start = esp_timer_get_time();
+    for (int w = 0; w < BENCH_WARMUP_US / BENCH_BATCH_US &&
+                    esp_timer_get_time() - start < BENCH_WARMUP_US; w++) {
+        c->fn(c->ctx, iterations);
+    }
+
+    int n = 0;
+    start = esp_timer_get_time();
+    while (n < BENCH_MAX_SAMPLES &&
+           (n < BENCH_MIN_SAMPLES || esp_timer_get_time() - start < BENCH_BUDGET_US)) {
+        int64_t t0 = esp_timer_get_time();
+        c->fn(c->ctx, iterations);
+        ns[n++] = (double)(esp_timer_get_time() - t0) * 1e3 / iterations;
+    }
+    return bench_samples(c, ns, n, iterations);
+}
+
+/** One JSON line per result since bench_begin(). */
+static inline void bench_end(void) {
+    printf("\n");
+    bench_flush();
+}
@@ -0,0 +1,177 @@
+/**
+ * pulse_stages.h - Per-stage cycle counters inside a step function
+ *
+ * The benchmarks time whole calls; this splits a call into its stages.
+ * A function marks where its stages end, and each stage's duration goes
+ * into that stage's histogram:
+ *
+ *   STAGE_SET(spectral_step_stages, "spectral_step",
+ *             "inject", "rotate+decay", "coupling", "coherence");
+ *
+ *   void spectral_step(...) {
+ *       STAGE_BEGIN();
+ *       ...inject...
+ *       STAGE_END(spectral_step_stages, 0);
+ *       ...rotate...
+ *       STAGE_END(spectral_step_stages, 1);
+ *
+ * Off unless built with PULSE_STAGE_PROFILE=1 (host: cmake
+ * -DPULSE_STAGE_PROFILE=ON, device: idf.py -DPULSE_STAGE_PROFILE=1 build).
+ * Off, every macro expands to nothing and no counters exist, so the
+ * instrumented code compiles exactly as before.
+ *
+ * Clock:
+ *   device  esp_cpu_get_cycle_count(): the C6's machine performance
+ *           counter CSR, CPU cycles
+ *   host    rdtsc on x86 (TSC ticks), clock_gettime() elsewhere (ns)
+ *
+ * Histograms have 4 bins per power of two, so reported percentiles are
+ * bin lower bounds, within 19% of the true value. Each mark costs two
+ * clock reads, and its bookkeeping is not charged to the next stage.
+ * Counters are plain globals: profile from one thread. Nested sets (a
+ * learn step around instrumented evolve steps) include the inner marks'
+ * overhead.
+ */
+
+#pragma once
+
+#ifndef PULSE_STAGE_PROFILE
+#define PULSE_STAGE_PROFILE 0
+#endif
+
+// Report label of a network's size, e.g. "bands=4,neurons=4"
+#define STAGE_STR_(x)               #x
+#define STAGE_STR(x)                STAGE_STR_(x)
+#define STAGE_SIZE(bands, neurons)  "bands=" STAGE_STR(bands) ",neurons=" STAGE_STR(neurons)
+
+#if PULSE_STAGE_PROFILE
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef ESP_PLATFORM
+#include "esp_cpu.h"
+#define STAGE_CLOCK         "cycles"
+static inline uint32_t stage_clock(void) { return (uint32_t)esp_cpu_get_cycle_count(); }
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define STAGE_CLOCK         "TSC ticks"
+static inline uint32_t stage_clock(void) { return (uint32_t)__rdtsc(); }
+#else
+#include <time.h>
+#define STAGE_CLOCK         "ns"
+static inline uint32_t stage_clock(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec);
+}
+#endif
+
+#define STAGE_MAX           6       // Stages per set
+#define STAGE_SUB_BITS      2       // 4 bins per power of two
+#define STAGE_BINS          (4 * 31)
+
+typedef struct {
+    uint32_t count;
+    uint32_t min, max;
+    uint64_t total;
+    uint32_t bins[STAGE_BINS];
+} stage_counter_t;
+
+typedef struct {
+    const char *title;
+    const char *names[STAGE_MAX];
+    stage_counter_t stage[STAGE_MAX];
+} stage_set_t;
+
+// Durations (mod 2^32, so counter wrap is harmless) to bins: 0-3 exact,
+// then [4 + s, 5 + s) << (msb - 2) for sub-bin s
+static inline int stage_bin(uint32_t d) {
+    if (d < 4) return (int)d;
+    int msb = 31 - __builtin_clz(d);
+    return (msb - 1) * 4 + (int)((d >> (msb - STAGE_SUB_BITS)) & 3);
+}
+
+static inline uint32_t stage_bin_floor(int bin) {
+    if (bin < 4) return (uint32_t)bin;
+    return (uint32_t)(4 + bin % 4) << (bin / 4 - 1);
+}
+
+/** Charge the time since `t0` to stage `i`; returns the next stage's start. */
+static inline uint32_t stage_record(stage_set_t *set, int i, uint32_t t0) {
+    uint32_t d = stage_clock() - t0;
+    stage_counter_t *c = &set->stage[i];
+    if (c->count == 0 || d < c->min) c->min = d;
+    if (d > c->max) c->max = d;
+    c->count++;
+    c->total += d;
+    c->bins[stage_bin(d)]++;
+    return stage_clock();
+}
+
+static inline void stage_reset(stage_set_t *set) {
+    memset(set->stage, 0, sizeof(set->stage));
+}
+
+// Lower bound of the bin holding the pct-th percentile (nearest rank)
+static inline uint32_t stage_percentile(const stage_counter_t *c, int pct) {
+    uint32_t rank = (uint32_t)(((uint64_t)c->count * pct + 99) / 100), seen = 0;
+    for (int b = 0; b < STAGE_BINS; b++) {
+        seen += c->bins[b];
+        if (rank > 0 && seen >= rank) return stage_bin_floor(b);
+    }
+    return 0;
+}
+
+/** Print the set's stages since the last reset; `params` labels the run. */
+static inline void stage_report(const stage_set_t *set, const char *params) {
+    uint64_t total = 0;
+    for (int i = 0; i < STAGE_MAX && set->names[i]; i++) total += set->stage[i].total;
+
+    printf("\n  Stages of %s [%s], %s\n", set->title, params, STAGE_CLOCK);
+    printf("  %-14s %9s %10s %10s %10s %10s %10s %7s\n", "Stage", "Calls", "Min", "p50",
+           "p99", "Max", "Mean", "Share");
+    printf("  -------------- --------- ---------- ---------- ---------- ---------- ----------"
+           " -------\n");
+    for (int i = 0; i < STAGE_MAX && set->names[i]; i++) {
+        const stage_counter_t *c = &set->stage[i];
+        printf("  %-14s %9lu %10lu %10lu %10lu %10lu %10.1f %6.1f%%\n", set->names[i],
+               (unsigned long)c->count, (unsigned long)c->min,
+               (unsigned long)stage_percentile(c, 50), (unsigned long)stage_percentile(c, 99),
+               (unsigned long)c->max, c->count ? (double)c->total / c->count : 0.0,
+               total ? 100.0 * c->total / total : 0.0);
+    }
+
+    // Histogram by power of two: share of calls from each 2^k up (bins
+    // under 0.1% left out; Max above has the tail)
+    printf("\n  %-14s %s\n", "Histogram", "from 2^k: % of calls");
+    for (int i = 0; i < STAGE_MAX && set->names[i]; i++) {
+        const stage_counter_t *c = &set->stage[i];
+        printf("  %-14s", set->names[i]);
+        for (int k = 0; k < 32; k++) {
+            uint32_t n = 0;
+            for (int b = 0; b < STAGE_BINS; b++) {
+                if (stage_bin_floor(b) >> k == 1) n += c->bins[b];
+            }
+            if (n && 1000.0 * n >= c->count) printf("  2^%d: %.1f", k, 100.0 * n / c->count);
+        }
+        printf("\n");
+    }
+}
+
+#define STAGE_SET(var, name, ...)   stage_set_t var = { .title = name, .names = { __VA_ARGS__ } }
+#define STAGE_BEGIN()               uint32_t stage_t0_ = stage_clock()
+#define STAGE_END(set, i)           (stage_t0_ = stage_record(&(set), (i), stage_t0_))
+#define STAGE_RESET(set)            stage_reset(&(set))
+#define STAGE_REPORT(set, params)   stage_report(&(set), (params))
+
+#else
+
+#define STAGE_SET(var, name, ...)   struct stage_set_unused_
+#define STAGE_BEGIN()               ((void)0)
+#define STAGE_END(set, i)           ((void)0)
+#define STAGE_RESET(set)            ((void)0)
+#define STAGE_REPORT(set, params)   ((void)0)
+
+#endif
@@ -0,0 +1,817 @@
+/**
+ * etm_sim.c - Discrete-event model of the ESP32-C6 ETM fabric
+ *
+ * One global simulator, like the one global SoC it stands in for.
+ * See etm_sim.h for what is and is not modelled.
+ */
+
+#include "etm_sim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "soc/soc_etm_source.h"
+
+uint32_t etm_sim_etm_regs[ETM_SIM_ETM_REG_WORDS];
+uint32_t etm_sim_pcr_regs[ETM_SIM_PCR_REG_WORDS];
+
+// Register word indices
+#define REG_ENA_AD0         (0x00 / 4)
+#define REG_ENA_AD0_SET     (0x04 / 4)
+#define REG_ENA_AD0_CLR     (0x08 / 4)
+#define REG_ENA_AD1         (0x0C / 4)
+#define REG_ENA_AD1_SET     (0x10 / 4)
+#define REG_ENA_AD1_CLR     (0x14 / 4)
+#define REG_EVT_ID(n)       ((0x18 + (n) * 8) / 4)
+#define REG_TASK_ID(n)      ((0x1C + (n) * 8) / 4)
+#define REG_PCR_ETM_CONF    (0x90 / 4)
+
+#define PCR_ETM_CLK_EN      (1u << 0)
+#define PCR_ETM_RST_EN      (1u << 1)
+
+#define ID_SPACE            256
+
+// ============================================================
+// Event Queue
+// ============================================================
+
+enum {
+    EV_PARLIO,          // PARLIO output changes level
+    EV_PARLIO_DONE,     // PARLIO transaction finished
+    EV_ALARM,           // GPTimer reached its alarm
+    EV_TASK,            // ETM task arrives at its peripheral
+    EV_PCNT_SAMPLE,     // PCNT input sampler looks at a pin again
+};
+
+typedef struct {
+    uint64_t t;
+    uint64_t seq;       // FIFO among equal timestamps
+    uint8_t kind;
+    uint8_t unit;
+    uint16_t arg;
+    uint32_t gen;       // stale alarms are dropped
+} sim_event_t;
+
+static sim_event_t *heap;
+static size_t heap_len, heap_cap;
+static uint64_t heap_seq;
+
+static inline bool ev_before(const sim_event_t *a, const sim_event_t *b) {
+    return a->t < b->t || (a->t == b->t && a->seq < b->seq);
+}
+
+static void heap_push(uint64_t t, uint8_t kind, uint8_t unit, uint16_t arg, uint32_t gen) {
+    if (heap_len == heap_cap) {
+        heap_cap = heap_cap ? heap_cap * 2 : 256;
+        heap = realloc(heap, heap_cap * sizeof(sim_event_t));
+        if (!heap) {
+            fprintf(stderr, "etm_sim: out of memory for event queue\n");
+            abort();
+        }
+    }
+    sim_event_t e = { t, heap_seq++, kind, unit, arg, gen };
+    size_t i = heap_len++;
+    while (i > 0) {
+        size_t p = (i - 1) / 2;
+        if (!ev_before(&e, &heap[p])) break;
+        heap[i] = heap[p];
+        i = p;
+    }
+    heap[i] = e;
+}
+
+static sim_event_t heap_pop(void) {
+    sim_event_t top = heap[0];
+    sim_event_t last = heap[--heap_len];
+    size_t i = 0;
+    for (;;) {
+        size_t c = 2 * i + 1;
+        if (c >= heap_len) break;
+        if (c + 1 < heap_len && ev_before(&heap[c + 1], &heap[c])) c++;
+        if (!ev_before(&heap[c], &last)) break;
+        heap[i] = heap[c];
+        i = c;
+    }
+    if (heap_len) heap[i] = last;
+    return top;
+}
+
+// ============================================================
+// Simulator State
+// ============================================================
+
+typedef struct {
+    uint32_t res_hz;
+    bool up;
+    bool running;
+    uint64_t base;          // count at t0
+    uint64_t t0;
+    bool alarm_en;
+    bool auto_reload;
+    uint64_t alarm;
+    uint64_t reload;
+    uint64_t capture;
+    uint32_t gen;
+    etm_sim_timer_cb_t cb;
+    void *ctx;
+} sim_timer_t;
+
+typedef struct {
+    int edge_gpio;
+    int level_gpio;
+    uint8_t pos, neg;       // edge actions
+    uint8_t high, low;      // level actions
+} sim_pcnt_chan_t;
+
+typedef struct {
+    bool running;
+    int count;
+    int low, high;
+    int thres[ETM_SIM_PCNT_THRESHOLDS];
+    bool thres_en[ETM_SIM_PCNT_THRESHOLDS];
+    bool watch_zero, watch_low, watch_high;
+    sim_pcnt_chan_t chan[ETM_SIM_PCNT_CHANNELS];
+    etm_sim_pcnt_cb_t cb;
+    void *ctx;
+} sim_pcnt_t;
+
+typedef struct {
+    const uint8_t *data;
+    size_t bits;
+    uint32_t idle;
+} sim_trans_t;
+
+typedef struct {
+    uint32_t clk_hz;
+    int width;
+    int gpio[ETM_SIM_PARLIO_MAX_WIDTH];
+    bool msb_first;
+    int depth;
+    sim_trans_t queue[ETM_SIM_PARLIO_MAX_QUEUE];
+    int q_head, q_len;
+    bool busy;
+    sim_trans_t cur;
+    size_t cycle, cycles;
+    uint64_t t_start;
+    uint32_t out;           // word currently on the pins
+    etm_sim_parlio_cb_t cb;
+    void *ctx;
+} sim_parlio_t;
+
+// A PCNT channel listening on a GPIO edge input
+typedef struct {
+    uint8_t unit, ch;
+} gpio_listener_t;
+
+#define GPIO_MAX_LISTENERS  (ETM_SIM_PCNT_UNITS * ETM_SIM_PCNT_CHANNELS)
+
+static uint64_t now;
+static bool in_isr;
+static uint64_t blocked_cpu_ns;     // see etm_sim_blocked_cpu_ns()
+static etm_sim_stats_t stats;
+
+static sim_timer_t timers[ETM_SIM_TIMERS];
+static sim_pcnt_t pcnts[ETM_SIM_PCNT_UNITS];
+static sim_parlio_t parlios[ETM_SIM_PARLIO_UNITS];
+
+static uint8_t gpio_level[ETM_SIM_GPIOS];
+static gpio_listener_t gpio_listeners[ETM_SIM_GPIOS][GPIO_MAX_LISTENERS];
+static uint8_t gpio_listener_count[ETM_SIM_GPIOS];
+static uint8_t pcnt_seen[ETM_SIM_GPIOS];                    // level the PCNT sampler last took
+static uint64_t pcnt_seen_t[ETM_SIM_GPIOS];                 // when; UINT64_MAX = never
+static bool pcnt_resample[ETM_SIM_GPIOS];                   // EV_PCNT_SAMPLE queued
+static uint32_t gpio_etm_pins[ETM_SIM_GPIO_ETM_CHANNELS];    // pin mask per task channel
+static uint8_t gpio_etm_events[ETM_SIM_GPIOS];              // event channel mask per pin
+
+// ETM routing, rebuilt from the register file when it changes
+static bool etm_active;
+static uint16_t route_start[ID_SPACE + 1];
+static uint8_t route_task[ETM_SIM_CHANNELS];
+static uint32_t etm_shadow[ETM_SIM_ETM_REG_WORDS];
+static uint32_t pcr_shadow;
+
+static inline void pcnt_edge(int u, int ch, bool rising);
+
+// ============================================================
+// ETM Matrix
+// ============================================================
+
+static void etm_rebuild(void) {
+    uint64_t ena = etm_sim_etm_regs[REG_ENA_AD0] |
+                   ((uint64_t)etm_sim_etm_regs[REG_ENA_AD1] << 32);
+
+    // Counting sort of enabled channels by event ID
+    uint16_t count[ID_SPACE] = {0};
+    for (int ch = 0; ch < ETM_SIM_CHANNELS; ch++) {
+        if (ena & (1ULL << ch)) count[etm_sim_etm_regs[REG_EVT_ID(ch)] & 0xFF]++;
+    }
+    route_start[0] = 0;
+    for (int e = 0; e < ID_SPACE; e++) route_start[e + 1] = route_start[e] + count[e];
+    uint16_t fill[ID_SPACE];
+    memcpy(fill, route_start, sizeof(fill));
+    for (int ch = 0; ch < ETM_SIM_CHANNELS; ch++) {
+        if (!(ena & (1ULL << ch))) continue;
+        uint32_t e = etm_sim_etm_regs[REG_EVT_ID(ch)] & 0xFF;
+        route_task[fill[e]++] = (uint8_t)etm_sim_etm_regs[REG_TASK_ID(ch)];
+    }
+}
+
+// Fold write-1-to-set/clear registers and pick up any pokes since last time
+static void etm_sync(void) {
+    uint32_t *r = etm_sim_etm_regs;
+    if (r[REG_ENA_AD0_SET] | r[REG_ENA_AD0_CLR] | r[REG_ENA_AD1_SET] | r[REG_ENA_AD1_CLR]) {
+        r[REG_ENA_AD0] = (r[REG_ENA_AD0] | r[REG_ENA_AD0_SET]) & ~r[REG_ENA_AD0_CLR];
+        r[REG_ENA_AD1] = ((r[REG_ENA_AD1] | r[REG_ENA_AD1_SET]) & ~r[REG_ENA_AD1_CLR]) &
+                         ((1u << (ETM_SIM_CHANNELS - 32)) - 1);
+        r[REG_ENA_AD0_SET] = r[REG_ENA_AD0_CLR] = 0;
+        r[REG_ENA_AD1_SET] = r[REG_ENA_AD1_CLR] = 0;
+    }
+    uint32_t conf = etm_sim_pcr_regs[REG_PCR_ETM_CONF];
+    if (conf == pcr_shadow && memcmp(r, etm_shadow, sizeof(etm_shadow)) == 0) return;
+
+    // Holding the block in reset clears its channel configuration
+    if (conf & PCR_ETM_RST_EN) memset(r, 0, sizeof(etm_sim_etm_regs));
+    etm_active = (conf & (PCR_ETM_CLK_EN | PCR_ETM_RST_EN)) == PCR_ETM_CLK_EN;
+    etm_rebuild();
+    memcpy(etm_shadow, r, sizeof(etm_shadow));
+    pcr_shadow = conf;
+}
+
+// delay_ns: time from the cause (an edge) to the event leaving its peripheral
+static inline void etm_raise_after(uint32_t event_id, uint64_t delay_ns) {
+    if (!etm_active) return;
+    stats.etm_events++;
+    for (int i = route_start[event_id]; i < route_start[event_id + 1]; i++) {
+        heap_push(now + delay_ns + ETM_SIM_ETM_LATENCY_NS, EV_TASK, 0, route_task[i], 0);
+    }
+}
+
+static inline void etm_raise(uint32_t event_id) {
+    etm_raise_after(event_id, 0);
+}
+
+void etm_sim_etm_clock(bool on) {
+    if (on) etm_sim_pcr_regs[REG_PCR_ETM_CONF] = PCR_ETM_CLK_EN;
+    else etm_sim_pcr_regs[REG_PCR_ETM_CONF] = PCR_ETM_RST_EN;
+    etm_sync();
+}
+
+void etm_sim_channel_set(int ch, uint32_t event_id, uint32_t task_id, bool enable) {
+    etm_sim_etm_regs[REG_EVT_ID(ch)] = event_id;
+    etm_sim_etm_regs[REG_TASK_ID(ch)] = task_id;
+    int reg = (ch < 32) ? (enable ? REG_ENA_AD0_SET : REG_ENA_AD0_CLR)
+                        : (enable ? REG_ENA_AD1_SET : REG_ENA_AD1_CLR);
+    etm_sim_etm_regs[reg] = 1u << (ch & 31);
+    etm_sync();
+}
+
+// ============================================================
+// GPIO
+// ============================================================
+
+// PCNT inputs are sampled, so a level held for less than
+// ETM_SIM_PCNT_SAMPLE_NS may be missed: the counters see a change no
+// sooner than that after the last one they saw, and then only the level
+// the pin has by then. Faster input aliases into miscounts.
+static void pcnt_input(int gpio) {
+    int level = gpio_level[gpio];
+    if (level == pcnt_seen[gpio]) return;
+    if (pcnt_seen_t[gpio] != UINT64_MAX && now < pcnt_seen_t[gpio] + ETM_SIM_PCNT_SAMPLE_NS) {
+        if (!pcnt_resample[gpio]) {
+            pcnt_resample[gpio] = true;
+            heap_push(pcnt_seen_t[gpio] + ETM_SIM_PCNT_SAMPLE_NS, EV_PCNT_SAMPLE, (uint8_t)gpio, 0, 0);
+        }
+        return;
+    }
+    pcnt_seen[gpio] = (uint8_t)level;
+    pcnt_seen_t[gpio] = now;
+    for (int i = 0; i < gpio_listener_count[gpio]; i++) {
+        pcnt_edge(gpio_listeners[gpio][i].unit, gpio_listeners[gpio][i].ch, level);
+    }
+}
+
+static inline void gpio_drive(int gpio, int level) {
+    if (gpio < 0 || gpio >= ETM_SIM_GPIOS || gpio_level[gpio] == level) return;
+    gpio_level[gpio] = (uint8_t)level;
+    stats.edges++;
+    if (gpio_listener_count[gpio]) pcnt_input(gpio);
+    for (uint32_t chans = gpio_etm_events[gpio]; chans; chans &= chans - 1) {
+        int ch = __builtin_ctz(chans);
+        etm_raise((level ? GPIO_EVT_CH0_RISE_EDGE : GPIO_EVT_CH0_FALL_EDGE) + ch);
+        etm_raise(GPIO_EVT_CH0_ANY_EDGE + ch);
+    }
+}
+
+void etm_sim_gpio_set(int gpio, int level) {
+    etm_sync();
+    gpio_drive(gpio, level ? 1 : 0);
+}
+
+int etm_sim_gpio_get(int gpio) {
+    return (gpio >= 0 && gpio < ETM_SIM_GPIOS) ? gpio_level[gpio] : 0;
+}
+
+void etm_sim_gpio_etm_bind(int gpio, int task_ch) {
+    if (gpio < 0 || gpio >= ETM_SIM_GPIOS) return;
+    for (int ch = 0; ch < ETM_SIM_GPIO_ETM_CHANNELS; ch++) gpio_etm_pins[ch] &= ~(1u << gpio);
+    if (task_ch >= 0 && task_ch < ETM_SIM_GPIO_ETM_CHANNELS) gpio_etm_pins[task_ch] |= 1u << gpio;
+}
+
+void etm_sim_gpio_etm_event_bind(int gpio, int event_ch) {
+    if (event_ch < 0 || event_ch >= ETM_SIM_GPIO_ETM_CHANNELS) return;
+    for (int g = 0; g < ETM_SIM_GPIOS; g++) gpio_etm_events[g] &= ~(1u << event_ch);
+    if (gpio >= 0 && gpio < ETM_SIM_GPIOS) gpio_etm_events[gpio] |= 1u << event_ch;
+}
+
+// GPIO_TASK_CHn_SET / CLEAR / TOGGLE: three banks of eight channels
+static void gpio_etm_task(uint32_t task_id) {
+    int bank = (task_id - GPIO_TASK_CH0_SET) / ETM_SIM_GPIO_ETM_CHANNELS;
+    uint32_t pins = gpio_etm_pins[(task_id - GPIO_TASK_CH0_SET) % ETM_SIM_GPIO_ETM_CHANNELS];
+    while (pins) {
+        int g = __builtin_ctz(pins);
+        pins &= pins - 1;
+        gpio_drive(g, (bank == 0) ? 1 : (bank == 1) ? 0 : !gpio_level[g]);
+    }
+}
+
+// ============================================================
+// GPTimer
+// ============================================================
+
+static uint64_t timer_count(const sim_timer_t *tm) {
+    if (!tm->running) return tm->base;
+    uint64_t ticks = (uint64_t)(((unsigned __int128)(now - tm->t0) * tm->res_hz) / ETM_SIM_NS_PER_S);
+    return tm->up ? tm->base + ticks : tm->base - ticks;
+}
+
+static void timer_rebase(sim_timer_t *tm, uint64_t count) {
+    tm->base = count;
+    tm->t0 = now;
+}
+
+static void timer_schedule(int t) {
+    sim_timer_t *tm = &timers[t];
+    tm->gen++;
+    if (!tm->running || !tm->alarm_en) return;
+
+    uint64_t count = timer_count(tm);
+    bool passed = tm->up ? (count >= tm->alarm) : (count <= tm->alarm);
+    uint64_t when = now;
+    if (!passed) {
+        uint64_t ticks = tm->up ? tm->alarm - tm->base : tm->base - tm->alarm;
+        unsigned __int128 ns = ((unsigned __int128)ticks * ETM_SIM_NS_PER_S + tm->res_hz - 1) / tm->res_hz;
+        when = tm->t0 + (uint64_t)ns;
+        if (when < now) when = now;
+    }
+    heap_push(when, EV_ALARM, (uint8_t)t, 0, tm->gen);
+}
+
+static void timer_alarm(int t) {
+    sim_timer_t *tm = &timers[t];
+    uint64_t count = timer_count(tm);
+    uint64_t alarm = tm->alarm;
+
+    // Hardware clears alarm enable on the alarm; the driver re-arms for auto-reload
+    if (tm->auto_reload) {
+        timer_rebase(tm, tm->reload);
+        timer_schedule(t);
+    } else {
+        tm->alarm_en = false;
+    }
+    etm_raise(t == 0 ? TIMER0_EVT_CNT_CMP_TIMER0 : TIMER1_EVT_CNT_CMP_TIMER0);
+    if (tm->cb) tm->cb(t, count, alarm, tm->ctx);
+}
+
+void etm_sim_timer_config(int t, uint32_t resolution_hz, bool count_up) {
+    sim_timer_t *tm = &timers[t];
+    memset(tm, 0, sizeof(*tm));
+    tm->res_hz = resolution_hz;
+    tm->up = count_up;
+}
+
+void etm_sim_timer_start(int t) {
+    sim_timer_t *tm = &timers[t];
+    if (tm->running) return;
+    tm->running = true;
+    tm->t0 = now;
+    timer_schedule(t);
+}
+
+void etm_sim_timer_stop(int t) {
+    sim_timer_t *tm = &timers[t];
+    if (!tm->running) return;
+    tm->base = timer_count(tm);
+    tm->running = false;
+    tm->gen++;
+}
+
+bool etm_sim_timer_running(int t) {
+    return timers[t].running;
+}
+
+void etm_sim_timer_set_count(int t, uint64_t count) {
+    timer_rebase(&timers[t], count);
+    timer_schedule(t);
+}
+
+uint64_t etm_sim_timer_get_count(int t) {
+    return timer_count(&timers[t]);
+}
+
+uint64_t etm_sim_timer_get_capture(int t) {
+    return timers[t].capture;
+}
+
+void etm_sim_timer_set_alarm(int t, bool enable, uint64_t alarm, uint64_t reload, bool auto_reload) {
+    sim_timer_t *tm = &timers[t];
+    tm->alarm_en = enable;
+    tm->alarm = alarm;
+    tm->reload = reload;
+    tm->auto_reload = auto_reload;
+    timer_schedule(t);
+}
+
+void etm_sim_timer_set_callback(int t, etm_sim_timer_cb_t cb, void *ctx) {
+    timers[t].cb = cb;
+    timers[t].ctx = ctx;
+}
+
+// ============================================================
+// PCNT
+// ============================================================
+
+enum { EDGE_HOLD, EDGE_INC, EDGE_DEC };
+enum { LEVEL_KEEP, LEVEL_INVERSE, LEVEL_HOLD };
+
+static void pcnt_check(int u) {
+    sim_pcnt_t *p = &pcnts[u];
+    int v = p->count;
+
+    // Reaching a limit resets the counter
+    if (v == p->high || v == p->low) {
+        p->count = 0;
+        etm_raise_after(PCNT_EVT_CNT_EQ_LMT, ETM_SIM_PCNT_LATENCY_NS);
+        if (p->cb && ((v == p->high && p->watch_high) || (v == p->low && p->watch_low))) {
+            p->cb(u, v, p->ctx);
+        }
+        return;
+    }
+    for (int i = 0; i < ETM_SIM_PCNT_THRESHOLDS; i++) {
+        if (p->thres_en[i] && v == p->thres[i]) {
+            etm_raise_after(PCNT_EVT_CNT_EQ_THRESH, ETM_SIM_PCNT_LATENCY_NS);
+            if (p->cb) p->cb(u, v, p->ctx);
+        }
+    }
+    if (v == 0) {
+        etm_raise_after(PCNT_EVT_CNT_EQ_ZERO, ETM_SIM_PCNT_LATENCY_NS);
+        if (p->cb && p->watch_zero) p->cb(u, v, p->ctx);
+    }
+}
+
+static inline void pcnt_edge(int u, int ch, bool rising) {
+    sim_pcnt_t *p = &pcnts[u];
+    if (!p->running) return;
+    const sim_pcnt_chan_t *c = &p->chan[ch];
+
+    int act = rising ? c->pos : c->neg;
+    if (c->level_gpio >= 0) {
+        int lv = gpio_level[c->level_gpio] ? c->high : c->low;
+        if (lv == LEVEL_HOLD) return;
+        if (lv == LEVEL_INVERSE) act = (act == EDGE_INC) ? EDGE_DEC : (act == EDGE_DEC) ? EDGE_INC : EDGE_HOLD;
+    }
+    if (act == EDGE_HOLD) return;
+    p->count += (act == EDGE_INC) ? 1 : -1;
+    pcnt_check(u);
+}
+
+void etm_sim_pcnt_config(int u, int low_limit, int high_limit) {
+    sim_pcnt_t *p = &pcnts[u];
+    memset(p, 0, sizeof(*p));
+    p->low = low_limit;
+    p->high = high_limit;
+    for (int ch = 0; ch < ETM_SIM_PCNT_CHANNELS; ch++) {
+        p->chan[ch].edge_gpio = -1;
+        p->chan[ch].level_gpio = -1;
+    }
+}
+
+void etm_sim_pcnt_channel(int u, int ch, int edge_gpio, int level_gpio) {
+    sim_pcnt_chan_t *c = &pcnts[u].chan[ch];
+
+    // Detach from the previous edge input
+    if (c->edge_gpio >= 0) {
+        int g = c->edge_gpio, n = 0;
+        for (int i = 0; i < gpio_listener_count[g]; i++) {
+            if (gpio_listeners[g][i].unit != u || gpio_listeners[g][i].ch != ch) {
+                gpio_listeners[g][n++] = gpio_listeners[g][i];
+            }
+        }
+        gpio_listener_count[g] = (uint8_t)n;
+    }
+    c->edge_gpio = (edge_gpio >= 0 && edge_gpio < ETM_SIM_GPIOS) ? edge_gpio : -1;
+    c->level_gpio = (level_gpio >= 0 && level_gpio < ETM_SIM_GPIOS) ? level_gpio : -1;
+    if (c->edge_gpio >= 0) {
+        int g = c->edge_gpio;
+        if (gpio_listener_count[g] == 0) pcnt_seen[g] = gpio_level[g];
+        gpio_listeners[g][gpio_listener_count[g]++] = (gpio_listener_t){ (uint8_t)u, (uint8_t)ch };
+    }
+}
+
+void etm_sim_pcnt_edge_action(int u, int ch, int pos, int neg) {
+    pcnts[u].chan[ch].pos = (uint8_t)pos;
+    pcnts[u].chan[ch].neg = (uint8_t)neg;
+}
+
+void etm_sim_pcnt_level_action(int u, int ch, int high, int low) {
+    pcnts[u].chan[ch].high = (uint8_t)high;
+    pcnts[u].chan[ch].low = (uint8_t)low;
+}
+
+int etm_sim_pcnt_add_watch(int u, int value) {
+    sim_pcnt_t *p = &pcnts[u];
+    if (value == 0) { p->watch_zero = true; return 0; }
+    if (value == p->high) { p->watch_high = true; return 0; }
+    if (value == p->low) { p->watch_low = true; return 0; }
+    for (int i = 0; i < ETM_SIM_PCNT_THRESHOLDS; i++) {
+        if (!p->thres_en[i]) {
+            p->thres_en[i] = true;
+            p->thres[i] = value;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+int etm_sim_pcnt_remove_watch(int u, int value) {
+    sim_pcnt_t *p = &pcnts[u];
+    if (value == 0 && p->watch_zero) { p->watch_zero = false; return 0; }
+    if (value == p->high && p->watch_high) { p->watch_high = false; return 0; }
+    if (value == p->low && p->watch_low) { p->watch_low = false; return 0; }
+    for (int i = 0; i < ETM_SIM_PCNT_THRESHOLDS; i++) {
+        if (p->thres_en[i] && p->thres[i] == value) {
+            p->thres_en[i] = false;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+void etm_sim_pcnt_start(int u) { pcnts[u].running = true; }
+void etm_sim_pcnt_stop(int u) { pcnts[u].running = false; }
+void etm_sim_pcnt_clear(int u) { pcnts[u].count = 0; }
+int etm_sim_pcnt_get(int u) { return pcnts[u].count; }
+
+void etm_sim_pcnt_set_callback(int u, etm_sim_pcnt_cb_t cb, void *ctx) {
+    pcnts[u].cb = cb;
+    pcnts[u].ctx = ctx;
+}
+
+// ============================================================
+// PARLIO TX
+// ============================================================
+
+static inline uint32_t parlio_word(const sim_parlio_t *p, size_t cycle) {
+    size_t bit = cycle * p->width;
+    if (p->width == 1) {
+        uint8_t byte = p->cur.data[bit >> 3];
+        return (byte >> (p->msb_first ? 7 - (bit & 7) : (bit & 7))) & 1u;
+    }
+    uint32_t w = 0;
+    for (int j = 0; j < p->width; j++, bit++) {
+        uint8_t byte = p->cur.data[bit >> 3];
+        w |= ((byte >> (p->msb_first ? 7 - (bit & 7) : (bit & 7))) & 1u) << j;
+    }
+    return w;
+}
+
+// 64-bit is enough: a transaction would need 1.8e10 cycles to overflow
+static inline uint64_t parlio_cycle_time(const sim_parlio_t *p, size_t cycle) {
+    return p->t_start + ((uint64_t)cycle * ETM_SIM_NS_PER_S) / p->clk_hz;
+}
+
+static void parlio_output(sim_parlio_t *p, uint32_t w) {
+    uint32_t diff = w ^ p->out;
+    p->out = w;
+    for (int j = 0; diff; j++, diff >>= 1) {
+        if (diff & 1u) gpio_drive(p->gpio[j], (w >> j) & 1u);
+    }
+}
+
+static void parlio_begin(int u) {
+    sim_parlio_t *p = &parlios[u];
+    p->cur = p->queue[p->q_head];
+    p->q_head = (p->q_head + 1) % ETM_SIM_PARLIO_MAX_QUEUE;
+    p->q_len--;
+    p->busy = true;
+    p->cycle = 0;
+    p->cycles = p->cur.bits / p->width;
+    p->t_start = now + ETM_SIM_PARLIO_SETUP_NS;
+    if (p->cycles == 0) heap_push(p->t_start, EV_PARLIO_DONE, (uint8_t)u, 0, 0);
+    else heap_push(p->t_start, EV_PARLIO, (uint8_t)u, 0, 0);
+}
+
+static void parlio_step(int u) {
+    sim_parlio_t *p = &parlios[u];
+    uint32_t w = parlio_word(p, p->cycle);
+    parlio_output(p, w);
+
+    // Skip ahead to the next cycle that changes a pin
+    size_t k = p->cycle + 1;
+    while (k < p->cycles && parlio_word(p, k) == w) k++;
+    if (k < p->cycles) {
+        p->cycle = k;
+        heap_push(parlio_cycle_time(p, k), EV_PARLIO, (uint8_t)u, 0, 0);
+    } else {
+        heap_push(parlio_cycle_time(p, p->cycles), EV_PARLIO_DONE, (uint8_t)u, 0, 0);
+    }
+}
+
+static void parlio_done(int u) {
+    sim_parlio_t *p = &parlios[u];
+    parlio_output(p, p->cur.idle & ((p->width >= 32) ? ~0u : ((1u << p->width) - 1)));
+    p->busy = false;
+    if (p->q_len) parlio_begin(u);
+    if (p->cb) p->cb(u, p->ctx);
+}
+
+void etm_sim_parlio_config(int u, uint32_t clk_hz, int width, const int *gpios,
+                           bool msb_first, int queue_depth) {
+    sim_parlio_t *p = &parlios[u];
+    memset(p, 0, sizeof(*p));
+    p->clk_hz = clk_hz;
+    p->width = width;
+    for (int j = 0; j < ETM_SIM_PARLIO_MAX_WIDTH; j++) p->gpio[j] = (j < width) ? gpios[j] : -1;
+    p->msb_first = msb_first;
+    p->depth = (queue_depth < 1) ? 1 : (queue_depth > ETM_SIM_PARLIO_MAX_QUEUE) ? ETM_SIM_PARLIO_MAX_QUEUE : queue_depth;
+}
+
+int etm_sim_parlio_transmit(int u, const uint8_t *data, size_t bits, uint32_t idle_value) {
+    sim_parlio_t *p = &parlios[u];
+    if (p->q_len >= p->depth) return -1;
+    int slot = (p->q_head + p->q_len) % ETM_SIM_PARLIO_MAX_QUEUE;
+    p->queue[slot] = (sim_trans_t){ data, bits, idle_value };
+    p->q_len++;
+    if (!p->busy) parlio_begin(u);
+    return 0;
+}
+
+int etm_sim_parlio_pending(int u) {
+    return parlios[u].q_len + (parlios[u].busy ? 1 : 0);
+}
+
+bool etm_sim_parlio_queue_full(int u) {
+    return parlios[u].q_len >= parlios[u].depth;
+}
+
+void etm_sim_parlio_set_callback(int u, etm_sim_parlio_cb_t cb, void *ctx) {
+    parlios[u].cb = cb;
+    parlios[u].ctx = ctx;
+}
+
+// ============================================================
+// ETM Tasks
+// ============================================================
+
+static void run_task(uint32_t task_id) {
+    stats.etm_tasks++;
+    if (task_id >= GPIO_TASK_CH0_SET && task_id <= GPIO_TASK_CH7_TOGGLE) {
+        gpio_etm_task(task_id);
+        return;
+    }
+    switch (task_id) {
+        case TIMER0_TASK_CNT_START_TIMER0:  etm_sim_timer_start(0); break;
+        case TIMER1_TASK_CNT_START_TIMER0:  etm_sim_timer_start(1); break;
+        case TIMER0_TASK_CNT_STOP_TIMER0:   etm_sim_timer_stop(0); break;
+        case TIMER1_TASK_CNT_STOP_TIMER0:   etm_sim_timer_stop(1); break;
+        case TIMER0_TASK_ALARM_START_TIMER0:
+        case TIMER1_TASK_ALARM_START_TIMER0: {
+            int t = (task_id == TIMER0_TASK_ALARM_START_TIMER0) ? 0 : 1;
+            timers[t].alarm_en = true;
+            timer_schedule(t);
+            break;
+        }
+        case TIMER0_TASK_CNT_RELOAD_TIMER0:
+        case TIMER1_TASK_CNT_RELOAD_TIMER0: {
+            int t = (task_id == TIMER0_TASK_CNT_RELOAD_TIMER0) ? 0 : 1;
+            timer_rebase(&timers[t], timers[t].reload);
+            timer_schedule(t);
+            break;
+        }
+        case TIMER0_TASK_CNT_CAP_TIMER0:    timers[0].capture = timer_count(&timers[0]); break;
+        case TIMER1_TASK_CNT_CAP_TIMER0:    timers[1].capture = timer_count(&timers[1]); break;
+        default:
+            stats.unhandled_tasks++;
+            break;
+    }
+}
+
+// ============================================================
+// Engine
+// ============================================================
+
+static void dispatch(const sim_event_t *e) {
+    stats.events++;
+    switch (e->kind) {
+        case EV_PARLIO:         parlio_step(e->unit); break;
+        case EV_PARLIO_DONE:    parlio_done(e->unit); break;
+        case EV_ALARM:
+            if (e->gen == timers[e->unit].gen) timer_alarm(e->unit);
+            break;
+        case EV_TASK:           run_task(e->arg); break;
+        case EV_PCNT_SAMPLE:
+            pcnt_resample[e->unit] = false;
+            pcnt_input(e->unit);
+            break;
+    }
+}
+
+void etm_sim_reset(void) {
+    heap_len = 0;
+    heap_seq = 0;
+    now = 0;
+    in_isr = false;
+    blocked_cpu_ns = 0;
+    memset(&stats, 0, sizeof(stats));
+    memset(timers, 0, sizeof(timers));
+    for (int u = 0; u < ETM_SIM_PCNT_UNITS; u++) etm_sim_pcnt_config(u, -32768, 32767);
+    memset(parlios, 0, sizeof(parlios));
+    memset(gpio_level, 0, sizeof(gpio_level));
+    memset(gpio_listener_count, 0, sizeof(gpio_listener_count));
+    memset(pcnt_seen, 0, sizeof(pcnt_seen));
+    memset(pcnt_seen_t, 0xFF, sizeof(pcnt_seen_t));
+    memset(pcnt_resample, 0, sizeof(pcnt_resample));
+    memset(gpio_etm_pins, 0, sizeof(gpio_etm_pins));
+    memset(gpio_etm_events, 0, sizeof(gpio_etm_events));
+    memset(etm_sim_etm_regs, 0, sizeof(etm_sim_etm_regs));
+    memset(etm_sim_pcr_regs, 0, sizeof(etm_sim_pcr_regs));
+    etm_sim_pcr_regs[REG_PCR_ETM_CONF] = PCR_ETM_RST_EN;    // power-on: gated, in reset
+    pcr_shadow = ~0u;
+    etm_sync();
+}
+
+uint64_t etm_sim_now(void) {
+    return now;
+}
+
+bool etm_sim_in_isr(void) {
+    return in_isr;
+}
+
+const etm_sim_stats_t *etm_sim_stats(void) {
+    return &stats;
+}
+
+static uint64_t thread_cpu_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static bool run_events(bool (*busy)(void *ctx), void *ctx, uint64_t t_limit_ns) {
+    etm_sync();
+    while (!busy || busy(ctx)) {
+        if (heap_len == 0 || heap[0].t > t_limit_ns) {
+            // Nothing left that could clear busy: an unbounded wait returns now
+            if (t_limit_ns > now && t_limit_ns != UINT64_MAX) now = t_limit_ns;
+            return !busy;
+        }
+        sim_event_t e = heap_pop();
+        now = e.t;
+        in_isr = true;
+        dispatch(&e);
+        in_isr = false;
+    }
+    return true;
+}
+
+bool etm_sim_run_while(bool (*busy)(void *ctx), void *ctx, uint64_t t_limit_ns) {
+    // Callbacks cannot block: time only moves from the CPU side
+    if (in_isr) return busy ? !busy(ctx) : true;
+    if (!busy) return run_events(NULL, NULL, t_limit_ns);
+    uint64_t t0 = thread_cpu_ns();
+    bool cleared = run_events(busy, ctx, t_limit_ns);
+    blocked_cpu_ns += thread_cpu_ns() - t0;
+    return cleared;
+}
+
+uint64_t etm_sim_blocked_cpu_ns(void) {
+    return blocked_cpu_ns;
+}
+
+void etm_sim_run_until(uint64_t t_ns) {
+    etm_sim_run_while(NULL, NULL, t_ns);
+}
+
+void etm_sim_advance(uint64_t ns) {
+    etm_sim_run_until(now + ns);
+}
+
+void etm_sim_cpu_relax(void) {
+    etm_sim_run_until(now + ETM_SIM_CPU_RELAX_NS);
+}
+
+__attribute__((constructor))
+static void etm_sim_power_on(void) {
+    etm_sim_reset();
+}
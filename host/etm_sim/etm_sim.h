@@ -0,0 +1,189 @@
+/**
+ * etm_sim.h - Discrete-event model of the ESP32-C6 ETM fabric
+ *
+ * Lets the fabric demos (05_turing_fabric and friends) run on a desktop.
+ * Peripherals post timestamped events (nanoseconds of virtual time) into
+ * one min-heap; the Event Task Matrix routes peripheral events to
+ * peripheral tasks through a 50-channel matrix that is read from a
+ * register file the firmware pokes exactly as it pokes the real one.
+ * ETM_SIM_ETM_BASE / ETM_SIM_PCR_BASE stand in for 0x600B8000 / 0x60096000.
+ *
+ * Modelled:
+ *   GPTimer  count at resolution_hz, alarm (one-shot or auto-reload),
+ *            ETM tasks START / ALARM_START / STOP / RELOAD / CAPTURE,
+ *            ETM event on alarm
+ *   PCNT     per-channel edge/level actions, limits (reset to 0), two
+ *            threshold watch points, ETM events THRESH / LMT / ZERO
+ *   PARLIO   queued TX transactions decoded into GPIO edges at the
+ *            output clock, done callback per transaction
+ *   GPIO     one net per pin: every writer is seen by every reader,
+ *            so loopback is implicit; ETM tasks SET / CLEAR / TOGGLE
+ *            on eight task channels, each driving any set of pins;
+ *            ETM events RISE / FALL / ANY edge on eight event channels,
+ *            one pin each
+ *
+ * Not modelled: driver software cost beyond a flat charge per driver
+ * call, bus contention, DMA descriptor fetch beyond a flat setup delay.
+ * The PCNT ETM events are shared by all units, as on the C6.
+ *
+ * Virtual time only moves when the CPU side asks it to: vTaskDelay(),
+ * blocking driver calls, and etm_sim_cpu_relax() inside busy-wait loops.
+ * Callbacks run from inside the event loop ("ISR context").
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ============================================================
+// Sizes (C6 SoC capabilities)
+// ============================================================
+
+#define ETM_SIM_CHANNELS            50
+#define ETM_SIM_TIMERS              2
+#define ETM_SIM_PCNT_UNITS          4
+#define ETM_SIM_PCNT_CHANNELS       2
+#define ETM_SIM_PCNT_THRESHOLDS     2
+#define ETM_SIM_PARLIO_UNITS        1
+#define ETM_SIM_PARLIO_MAX_WIDTH    16
+#define ETM_SIM_PARLIO_MAX_QUEUE    64
+#define ETM_SIM_GPIOS               31
+#define ETM_SIM_GPIO_ETM_CHANNELS   8
+
+// ============================================================
+// Timing Model (override with -D to explore)
+// ============================================================
+
+#ifndef ETM_SIM_ETM_LATENCY_NS
+#define ETM_SIM_ETM_LATENCY_NS      25      // event → task, ~2 APB cycles at 80 MHz
+#endif
+#ifndef ETM_SIM_PCNT_LATENCY_NS
+#define ETM_SIM_PCNT_LATENCY_NS     25      // edge → PCNT event, input synchroniser
+#endif
+#ifndef ETM_SIM_PCNT_SAMPLE_NS
+#define ETM_SIM_PCNT_SAMPLE_NS      25      // shortest level a PCNT input sees, 2 APB samples at 80 MHz
+#endif
+#ifndef ETM_SIM_PARLIO_SETUP_NS
+#define ETM_SIM_PARLIO_SETUP_NS     500     // DMA fetch before a transaction's first bit
+#endif
+#ifndef ETM_SIM_DRIVER_CALL_NS
+#define ETM_SIM_DRIVER_CALL_NS      1000    // flat CPU cost of one driver call
+#endif
+#ifndef ETM_SIM_CPU_RELAX_NS
+#define ETM_SIM_CPU_RELAX_NS        25      // one busy-wait iteration, 4 cycles at 160 MHz
+#endif
+
+#define ETM_SIM_NS_PER_S            1000000000ULL
+
+// ============================================================
+// Register File
+// ============================================================
+// Same offsets as the SoC: ETM +0x00 CH_ENA_AD0, +0x04 SET, +0x08 CLR,
+// +0x0C CH_ENA_AD1, +0x10 SET, +0x14 CLR, +0x18 + n*8 EVT_ID,
+// +0x1C + n*8 TASK_ID.  PCR +0x90 SOC_ETM_CONF (bit0 clock, bit1 reset).
+// Pokes take effect at the next simulator call, so a SET/CLR register
+// written twice in between keeps only the last value: give it every bit
+// in one write.
+
+#define ETM_SIM_ETM_REG_WORDS       128
+#define ETM_SIM_PCR_REG_WORDS       64
+
+extern uint32_t etm_sim_etm_regs[ETM_SIM_ETM_REG_WORDS];
+extern uint32_t etm_sim_pcr_regs[ETM_SIM_PCR_REG_WORDS];
+
+#define ETM_SIM_ETM_BASE            ((uintptr_t)etm_sim_etm_regs)
+#define ETM_SIM_PCR_BASE            ((uintptr_t)etm_sim_pcr_regs)
+
+// ============================================================
+// Engine
+// ============================================================
+
+typedef struct {
+    uint64_t events;            // queue entries dispatched
+    uint64_t edges;             // GPIO level changes
+    uint64_t etm_events;        // peripheral events raised while ETM is clocked
+    uint64_t etm_tasks;         // tasks delivered through enabled channels
+    uint64_t unhandled_tasks;   // delivered task IDs with no model
+} etm_sim_stats_t;
+
+void etm_sim_reset(void);
+uint64_t etm_sim_now(void);
+void etm_sim_run_until(uint64_t t_ns);
+void etm_sim_advance(uint64_t ns);
+// Run while busy(ctx) holds, up to t_limit_ns. Returns true if busy cleared.
+// With a busy predicate the caller is blocked (driver or FreeRTOS wait).
+bool etm_sim_run_while(bool (*busy)(void *ctx), void *ctx, uint64_t t_limit_ns);
+// Host thread CPU time spent modelling hardware while the firmware was
+// blocked, in ns: what the device's CPU would have spent idle
+uint64_t etm_sim_blocked_cpu_ns(void);
+void etm_sim_cpu_relax(void);
+bool etm_sim_in_isr(void);
+const etm_sim_stats_t *etm_sim_stats(void);
+
+// Convenience writers for the register file (same effect as poking it)
+void etm_sim_etm_clock(bool on);
+void etm_sim_channel_set(int ch, uint32_t event_id, uint32_t task_id, bool enable);
+
+// ============================================================
+// GPIO
+// ============================================================
+
+void etm_sim_gpio_set(int gpio, int level);
+int etm_sim_gpio_get(int gpio);
+// Attach a pin to a GPIO ETM task channel (-1 detaches it)
+void etm_sim_gpio_etm_bind(int gpio, int task_ch);
+// Point a GPIO ETM event channel at a pin (-1 unbinds it)
+void etm_sim_gpio_etm_event_bind(int gpio, int event_ch);
+
+// ============================================================
+// GPTimer
+// ============================================================
+
+typedef void (*etm_sim_timer_cb_t)(int timer, uint64_t count, uint64_t alarm, void *ctx);
+
+void etm_sim_timer_config(int t, uint32_t resolution_hz, bool count_up);
+void etm_sim_timer_start(int t);
+void etm_sim_timer_stop(int t);
+bool etm_sim_timer_running(int t);
+void etm_sim_timer_set_count(int t, uint64_t count);
+uint64_t etm_sim_timer_get_count(int t);
+uint64_t etm_sim_timer_get_capture(int t);
+void etm_sim_timer_set_alarm(int t, bool enable, uint64_t alarm, uint64_t reload, bool auto_reload);
+void etm_sim_timer_set_callback(int t, etm_sim_timer_cb_t cb, void *ctx);
+
+// ============================================================
+// PCNT
+// ============================================================
+// Action values match the IDF enums: edge HOLD/INCREASE/DECREASE = 0/1/2,
+// level KEEP/INVERSE/HOLD = 0/1/2.
+
+typedef void (*etm_sim_pcnt_cb_t)(int unit, int value, void *ctx);
+
+void etm_sim_pcnt_config(int u, int low_limit, int high_limit);
+void etm_sim_pcnt_channel(int u, int ch, int edge_gpio, int level_gpio);
+void etm_sim_pcnt_edge_action(int u, int ch, int pos, int neg);
+void etm_sim_pcnt_level_action(int u, int ch, int high, int low);
+int etm_sim_pcnt_add_watch(int u, int value);       // 0, or -1 if no free slot
+int etm_sim_pcnt_remove_watch(int u, int value);    // 0, or -1 if not watched
+void etm_sim_pcnt_start(int u);
+void etm_sim_pcnt_stop(int u);
+void etm_sim_pcnt_clear(int u);
+int etm_sim_pcnt_get(int u);
+void etm_sim_pcnt_set_callback(int u, etm_sim_pcnt_cb_t cb, void *ctx);
+
+// ============================================================
+// PARLIO TX
+// ============================================================
+
+typedef void (*etm_sim_parlio_cb_t)(int unit, void *ctx);
+
+void etm_sim_parlio_config(int u, uint32_t clk_hz, int width, const int *gpios,
+                           bool msb_first, int queue_depth);
+// Queues a transaction; payload is read in place (DMA semantics).
+// Returns 0, or -1 if the queue is full.
+int etm_sim_parlio_transmit(int u, const uint8_t *data, size_t bits, uint32_t idle_value);
+int etm_sim_parlio_pending(int u);                  // queued + in flight
+bool etm_sim_parlio_queue_full(int u);
+void etm_sim_parlio_set_callback(int u, etm_sim_parlio_cb_t cb, void *ctx);
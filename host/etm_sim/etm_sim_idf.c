@@ -0,0 +1,786 @@
+/**
+ * etm_sim_idf.c - ESP-IDF driver API on top of the ETM fabric simulator
+ *
+ * Handles wrap simulator unit indices. State machines and argument checks
+ * follow the IDF drivers closely enough that misuse which fails on the
+ * device also fails here. Every call from task context is charged
+ * ETM_SIM_DRIVER_CALL_NS of simulated CPU time.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "etm_sim.h"
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_etm.h"
+#include "esp_private/etm_interface.h"
+#include "driver/gpio.h"
+#include "driver/gpio_etm.h"
+#include "driver/gptimer.h"
+#include "driver/pulse_cnt.h"
+#include "driver/parlio_tx.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "soc/soc_etm_source.h"
+
+// Pick up register pokes, then pay for the call
+static void driver_call(void) {
+    if (etm_sim_in_isr()) return;
+    etm_sim_advance(ETM_SIM_DRIVER_CALL_NS);
+}
+
+// ============================================================
+// esp_err / esp_log
+// ============================================================
+
+const char *esp_err_to_name(esp_err_t code) {
+    switch (code) {
+        case ESP_OK:                return "ESP_OK";
+        case ESP_FAIL:              return "ESP_FAIL";
+        case ESP_ERR_NO_MEM:        return "ESP_ERR_NO_MEM";
+        case ESP_ERR_INVALID_ARG:   return "ESP_ERR_INVALID_ARG";
+        case ESP_ERR_INVALID_STATE: return "ESP_ERR_INVALID_STATE";
+        case ESP_ERR_INVALID_SIZE:  return "ESP_ERR_INVALID_SIZE";
+        case ESP_ERR_NOT_FOUND:     return "ESP_ERR_NOT_FOUND";
+        case ESP_ERR_NOT_SUPPORTED: return "ESP_ERR_NOT_SUPPORTED";
+        case ESP_ERR_TIMEOUT:       return "ESP_ERR_TIMEOUT";
+        default:                    return "UNKNOWN ERROR";
+    }
+}
+
+void etm_sim_log(char level, const char *tag, const char *fmt, ...) {
+    printf("%c (%llu) %s: ", level, (unsigned long long)(etm_sim_now() / 1000000), tag);
+    va_list ap;
+    va_start(ap, fmt);
+    vprintf(fmt, ap);
+    va_end(ap);
+    printf("\n");
+}
+
+// ============================================================
+// GPIO
+// ============================================================
+
+esp_err_t gpio_reset_pin(gpio_num_t gpio_num) {
+    if (gpio_num < 0 || gpio_num >= ETM_SIM_GPIOS) return ESP_ERR_INVALID_ARG;
+    driver_call();
+    etm_sim_gpio_set(gpio_num, 0);
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_direction(gpio_num_t gpio_num, gpio_mode_t mode) {
+    if (gpio_num < 0 || gpio_num >= ETM_SIM_GPIOS) return ESP_ERR_INVALID_ARG;
+    driver_call();
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level) {
+    if (gpio_num < 0 || gpio_num >= ETM_SIM_GPIOS) return ESP_ERR_INVALID_ARG;
+    driver_call();
+    etm_sim_gpio_set(gpio_num, level ? 1 : 0);
+    return ESP_OK;
+}
+
+esp_err_t gpio_config(const gpio_config_t *config) {
+    if (!config || (config->pin_bit_mask >> ETM_SIM_GPIOS)) return ESP_ERR_INVALID_ARG;
+    driver_call();
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio_num) {
+    return etm_sim_gpio_get(gpio_num);
+}
+
+// ============================================================
+// ETM
+// ============================================================
+
+struct esp_etm_channel_t {
+    int ch;
+    bool used, enabled;
+    uint32_t event_id, task_id;
+};
+
+static struct esp_etm_channel_t etm_channels[ETM_SIM_CHANNELS];
+
+static esp_etm_event_handle_t new_etm_event(uint32_t id) {
+    esp_etm_event_handle_t event = calloc(1, sizeof(*event));
+    if (event) {
+        event->event_id = (int)id;
+        event->gpio_ch = -1;
+    }
+    return event;
+}
+
+static esp_etm_task_handle_t new_etm_task(uint32_t id, int gpio_ch) {
+    esp_etm_task_handle_t task = calloc(1, sizeof(*task));
+    if (task) {
+        task->task_id = (int)id;
+        task->gpio_ch = gpio_ch;
+    }
+    return task;
+}
+
+esp_err_t esp_etm_new_channel(const esp_etm_channel_config_t *config, esp_etm_channel_handle_t *ret_chan) {
+    if (!config || !ret_chan) return ESP_ERR_INVALID_ARG;
+    driver_call();
+    for (int ch = 0; ch < ETM_SIM_CHANNELS; ch++) {
+        if (etm_channels[ch].used) continue;
+        etm_channels[ch] = (struct esp_etm_channel_t){ .ch = ch, .used = true };
+        *ret_chan = &etm_channels[ch];
+        return ESP_OK;
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t esp_etm_del_channel(esp_etm_channel_handle_t chan) {
+    if (!chan) return ESP_ERR_INVALID_ARG;
+    if (chan->enabled) return ESP_ERR_INVALID_STATE;
+    driver_call();
+    etm_sim_channel_set(chan->ch, 0, 0, false);
+    chan->used = false;
+    return ESP_OK;
+}
+
+esp_err_t esp_etm_channel_enable(esp_etm_channel_handle_t chan) {
+    if (!chan) return ESP_ERR_INVALID_ARG;
+    if (chan->enabled) return ESP_ERR_INVALID_STATE;
+    driver_call();
+    etm_sim_channel_set(chan->ch, chan->event_id, chan->task_id, true);
+    chan->enabled = true;
+    return ESP_OK;
+}
+
+esp_err_t esp_etm_channel_disable(esp_etm_channel_handle_t chan) {
+    if (!chan) return ESP_ERR_INVALID_ARG;
+    if (!chan->enabled) return ESP_ERR_INVALID_STATE;
+    driver_call();
+    etm_sim_channel_set(chan->ch, chan->event_id, chan->task_id, false);
+    chan->enabled = false;
+    return ESP_OK;
+}
+
+esp_err_t esp_etm_channel_connect(esp_etm_channel_handle_t chan, esp_etm_event_handle_t event, esp_etm_task_handle_t task) {
+    if (!chan) return ESP_ERR_INVALID_ARG;
+    driver_call();
+    chan->event_id = event ? event->event_id : 0;
+    chan->task_id = task ? task->task_id : 0;
+    etm_sim_channel_set(chan->ch, chan->event_id, chan->task_id, chan->enabled);
+    return ESP_OK;
+}
+
+static bool gpio_etm_event_used[ETM_SIM_GPIO_ETM_CHANNELS];
+static uint8_t gpio_etm_channel_used[ETM_SIM_GPIO_ETM_CHANNELS];    // task handles on the channel
+
+esp_err_t esp_etm_del_event(esp_etm_event_handle_t event) {
+    if (!event) return ESP_ERR_INVALID_ARG;
+    if (event->gpio_ch >= 0) {
+        etm_sim_gpio_etm_event_bind(-1, event->gpio_ch);
+        gpio_etm_event_used[event->gpio_ch] = false;
+    }
+    free(event);
+    return ESP_OK;
+}
+
+esp_err_t esp_etm_del_task(esp_etm_task_handle_t task) {
+    if (!task) return ESP_ERR_INVALID_ARG;
+    if (task->pins) return ESP_ERR_INVALID_STATE;    // remove the GPIOs first
+    if (task->gpio_ch >= 0) gpio_etm_channel_used[task->gpio_ch]--;
+    free(task);
+    return ESP_OK;
+}
+
+// ============================================================
+// GPIO ETM
+// ============================================================
+
+esp_err_t gpio_new_etm_event(const gpio_etm_event_config_t *config, esp_etm_event_handle_t *ret_event) {
+    if (!config || !ret_event) return ESP_ERR_INVALID_ARG;
+    uint32_t bank;
+    switch (config->edge) {
+        case GPIO_ETM_EVENT_EDGE_POS: bank = GPIO_EVT_CH0_RISE_EDGE; break;
+        case GPIO_ETM_EVENT_EDGE_NEG: bank = GPIO_EVT_CH0_FALL_EDGE; break;
+        case GPIO_ETM_EVENT_EDGE_ANY: bank = GPIO_EVT_CH0_ANY_EDGE; break;
+        default: return ESP_ERR_INVALID_ARG;
+    }
+    driver_call();
+    for (int ch = 0; ch < ETM_SIM_GPIO_ETM_CHANNELS; ch++) {
+        if (gpio_etm_event_used[ch]) continue;
+        esp_etm_event_handle_t event = new_etm_event(bank + ch);
+        if (!event) return ESP_ERR_NO_MEM;
+        event->gpio_ch = ch;
+        gpio_etm_event_used[ch] = true;
+        *ret_event = event;
+        return ESP_OK;
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t gpio_etm_event_bind_gpio(esp_etm_event_handle_t event, int gpio_num) {
+    if (!event || event->gpio_ch < 0 || gpio_num < 0 || gpio_num >= ETM_SIM_GPIOS) return ESP_ERR_INVALID_ARG;
+    driver_call();
+    etm_sim_gpio_etm_event_bind(gpio_num, event->gpio_ch);
+    return ESP_OK;
+}
+
+esp_err_t gpio_new_etm_task(const gpio_etm_task_config_t *config, esp_etm_task_handle_t *ret_task, ...) {
+    if (!config || !ret_task || !config->actions[0]) return ESP_ERR_INVALID_ARG;
+    static const uint32_t bank[GPIO_ETM_TASK_ACTION_MAX] = {
+        [GPIO_ETM_TASK_ACTION_SET] = GPIO_TASK_CH0_SET,
+        [GPIO_ETM_TASK_ACTION_CLR] = GPIO_TASK_CH0_CLEAR,
+        [GPIO_ETM_TASK_ACTION_TOG] = GPIO_TASK_CH0_TOGGLE,
+    };
+    int n = 0;
+    bool seen[GPIO_ETM_TASK_ACTION_MAX] = {false};
+    while (n < GPIO_ETM_TASK_ACTION_MAX && config->actions[n]) {
+        gpio_etm_task_action_t a = config->actions[n++];
+        if (a < GPIO_ETM_TASK_ACTION_SET || a >= GPIO_ETM_TASK_ACTION_MAX || seen[a]) return ESP_ERR_INVALID_ARG;
+        seen[a] = true;
+    }
+    driver_call();
+    int ch = 0;
+    while (ch < ETM_SIM_GPIO_ETM_CHANNELS && gpio_etm_channel_used[ch]) ch++;
+    if (ch == ETM_SIM_GPIO_ETM_CHANNELS) return ESP_ERR_NOT_FOUND;
+
+    va_list ap;
+    va_start(ap, ret_task);
+    esp_etm_task_handle_t *out = ret_task;
+    for (int i = 0; i < n; i++) {
+        if (i > 0) out = va_arg(ap, esp_etm_task_handle_t *);
+        esp_etm_task_handle_t task = new_etm_task(bank[config->actions[i]] + ch, ch);
+        if (!task) {
+            va_end(ap);
+            return ESP_ERR_NO_MEM;
+        }
+        gpio_etm_channel_used[ch]++;
+        *out = task;
+    }
+    va_end(ap);
+    return ESP_OK;
+}
+
+esp_err_t gpio_etm_task_add_gpio(esp_etm_task_handle_t task, uint32_t gpio_num) {
+    if (!task || task->gpio_ch < 0 || gpio_num >= ETM_SIM_GPIOS) return ESP_ERR_INVALID_ARG;
+    driver_call();
+    etm_sim_gpio_etm_bind(gpio_num, task->gpio_ch);
+    task->pins |= 1u << gpio_num;
+    return ESP_OK;
+}
+
+esp_err_t gpio_etm_task_rm_gpio(esp_etm_task_handle_t task, uint32_t gpio_num) {
+    if (!task || task->gpio_ch < 0 || gpio_num >= ETM_SIM_GPIOS) return ESP_ERR_INVALID_ARG;
+    if (!(task->pins & (1u << gpio_num))) return ESP_ERR_INVALID_STATE;
+    driver_call();
+    etm_sim_gpio_etm_bind(gpio_num, -1);
+    task->pins &= ~(1u << gpio_num);
+    return ESP_OK;
+}
+
+// ============================================================
+// GPTimer
+// ============================================================
+
+typedef enum { FSM_INIT, FSM_ENABLE, FSM_RUN } driver_fsm_t;
+
+struct gptimer_t {
+    int id;
+    bool used;
+    driver_fsm_t fsm;
+    gptimer_alarm_cb_t on_alarm;
+    void *user_ctx;
+};
+
+static struct gptimer_t gptimers[ETM_SIM_TIMERS];
+
+static void gptimer_alarm_trampoline(int t, uint64_t count, uint64_t alarm, void *ctx) {
+    struct gptimer_t *timer = ctx;
+    if (!timer->on_alarm) return;
+    gptimer_alarm_event_data_t edata = { .count_value = count, .alarm_value = alarm };
+    timer->on_alarm(timer, &edata, timer->user_ctx);
+}
+
+esp_err_t gptimer_new_timer(const gptimer_config_t *config, gptimer_handle_t *ret_timer) {
+    if (!config || !ret_timer || config->resolution_hz == 0) return ESP_ERR_INVALID_ARG;
+    driver_call();
+    for (int t = 0; t < ETM_SIM_TIMERS; t++) {
+        if (gptimers[t].used) continue;
+        gptimers[t] = (struct gptimer_t){ .id = t, .used = true, .fsm = FSM_INIT };
+        etm_sim_timer_config(t, config->resolution_hz, config->direction == GPTIMER_COUNT_UP);
+        etm_sim_timer_set_callback(t, gptimer_alarm_trampoline, &gptimers[t]);
+        *ret_timer = &gptimers[t];
+        return ESP_OK;
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t gptimer_del_timer(gptimer_handle_t timer) {
+    if (!timer) return ESP_ERR_INVALID_ARG;
+    if (timer->fsm != FSM_INIT) return ESP_ERR_INVALID_STATE;
+    driver_call();
+    etm_sim_timer_set_callback(timer->id, NULL, NULL);
+    timer->used = false;
+    return ESP_OK;
+}
+
+esp_err_t gptimer_set_raw_count(gptimer_handle_t timer, uint64_t value) {
+    if (!timer) return ESP_ERR_INVALID_ARG;
+    driver_call();
+    etm_sim_timer_set_count(timer->id, value);
+    return ESP_OK;
+}
+
+esp_err_t gptimer_get_raw_count(gptimer_handle_t timer, uint64_t *value) {
+    if (!timer || !value) return ESP_ERR_INVALID_ARG;
+    driver_call();
+    *value = etm_sim_timer_get_count(timer->id);
+    return ESP_OK;
+}
+
+esp_err_t gptimer_get_captured_count(gptimer_handle_t timer, uint64_t *value) {
+    if (!timer || !value) return ESP_ERR_INVALID_ARG;
+    driver_call();
+    *value = etm_sim_timer_get_capture(timer->id);
+    return ESP_OK;
+}
+
+esp_err_t gptimer_register_event_callbacks(gptimer_handle_t timer, const gptimer_event_callbacks_t *cbs, void *user_data) {
+    if (!timer || !cbs) return ESP_ERR_INVALID_ARG;
+    if (timer->fsm != FSM_INIT) return ESP_ERR_INVALID_STATE;
+    driver_call();
+    timer->on_alarm = cbs->on_alarm;
+    timer->user_ctx = user_data;
+    return ESP_OK;
+}
+
+esp_err_t gptimer_set_alarm_action(gptimer_handle_t timer, const gptimer_alarm_config_t *config) {
+    if (!timer) return ESP_ERR_INVALID_ARG;
+    driver_call();
+    if (config) {
+        etm_sim_timer_set_alarm(timer->id, true, config->alarm_count, config->reload_count,
+                                config->flags.auto_reload_on_alarm);
+    } else {
+        etm_sim_timer_set_alarm(timer->id, false, 0, 0, false);
+    }
+    return ESP_OK;
+}
+
+esp_err_t gptimer_enable(gptimer_handle_t timer) {
+    if (!timer) return ESP_ERR_INVALID_ARG;
+    if (timer->fsm != FSM_INIT) return ESP_ERR_INVALID_STATE;
+    driver_call();
+    timer->fsm = FSM_ENABLE;
+    return ESP_OK;
+}
+
+esp_err_t gptimer_disable(gptimer_handle_t timer) {
+    if (!timer) return ESP_ERR_INVALID_ARG;
+    if (timer->fsm != FSM_ENABLE) return ESP_ERR_INVALID_STATE;
+    driver_call();
+    timer->fsm = FSM_INIT;
+    return ESP_OK;
+}
+
+esp_err_t gptimer_start(gptimer_handle_t timer) {
+    if (!timer) return ESP_ERR_INVALID_ARG;
+    if (timer->fsm != FSM_ENABLE) return ESP_ERR_INVALID_STATE;
+    driver_call();
+    etm_sim_timer_start(timer->id);
+    timer->fsm = FSM_RUN;
+    return ESP_OK;
+}
+
+// The driver's state is its own: a timer stopped by ETM is still "running"
+// as far as the driver knows, exactly as on the device
+esp_err_t gptimer_stop(gptimer_handle_t timer) {
+    if (!timer) return ESP_ERR_INVALID_ARG;
+    if (timer->fsm != FSM_RUN) return ESP_ERR_INVALID_STATE;
+    driver_call();
+    etm_sim_timer_stop(timer->id);
+    timer->fsm = FSM_ENABLE;
+    return ESP_OK;
+}
+
+esp_err_t gptimer_new_etm_event(gptimer_handle_t timer, const gptimer_etm_event_config_t *config, esp_etm_event_handle_t *out_event) {
+    if (!timer || !config || !out_event) return ESP_ERR_INVALID_ARG;
+    if (config->event_type != GPTIMER_ETM_EVENT_ALARM_MATCH) return ESP_ERR_INVALID_ARG;
+    *out_event = new_etm_event(TIMER0_EVT_CNT_CMP_TIMER0 + timer->id);
+    return *out_event ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+esp_err_t gptimer_new_etm_task(gptimer_handle_t timer, const gptimer_etm_task_config_t *config, esp_etm_task_handle_t *out_task) {
+    if (!timer || !config || !out_task) return ESP_ERR_INVALID_ARG;
+    static const uint32_t task0[GPTIMER_ETM_TASK_MAX] = {
+        [GPTIMER_ETM_TASK_START_COUNT] = TIMER0_TASK_CNT_START_TIMER0,
+        [GPTIMER_ETM_TASK_STOP_COUNT]  = TIMER0_TASK_CNT_STOP_TIMER0,
+        [GPTIMER_ETM_TASK_EN_ALARM]    = TIMER0_TASK_ALARM_START_TIMER0,
+        [GPTIMER_ETM_TASK_RELOAD]      = TIMER0_TASK_CNT_RELOAD_TIMER0,
+        [GPTIMER_ETM_TASK_CAPTURE]     = TIMER0_TASK_CNT_CAP_TIMER0,
+    };
+    if (config->task_type >= GPTIMER_ETM_TASK_MAX) return ESP_ERR_INVALID_ARG;
+    *out_task = new_etm_task(task0[config->task_type] + timer->id, -1);
+    return *out_task ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+// ============================================================
+// PCNT
+// ============================================================
+
+#define PCNT_LIMIT_MIN  (-32768)
+#define PCNT_LIMIT_MAX  32767
+
+struct pcnt_chan_t {
+    struct pcnt_unit_t *unit;
+    int id;
+    bool used;
+};
+
+struct pcnt_unit_t {
+    int id;
+    bool used;
+    driver_fsm_t fsm;
+    int low_limit, high_limit;
+    bool accum;             // flags.accum_count: limits fold into accum_value
+    int accum_value;
+    struct pcnt_chan_t chans[ETM_SIM_PCNT_CHANNELS];
+    pcnt_watch_cb_t on_reach;
+    void *user_ctx;
+};
+
+static struct pcnt_unit_t pcnt_units[ETM_SIM_PCNT_UNITS];
+
+static void pcnt_watch_trampoline(int u, int value, void *ctx) {
+    struct pcnt_unit_t *unit = ctx;
+    if (unit->accum && (value == unit->high_limit || value == unit->low_limit)) unit->accum_value += value;
+    if (!unit->on_reach) return;
+    pcnt_watch_event_data_t edata = { .watch_point_value = value };
+    unit->on_reach(unit, &edata, unit->user_ctx);
+}
+
+esp_err_t pcnt_new_unit(const pcnt_unit_config_t *config, pcnt_unit_handle_t *ret_unit) {
+    if (!config || !ret_unit) return ESP_ERR_INVALID_ARG;
+    if (config->low_limit >= 0 || config->high_limit <= 0 ||
+        config->low_limit < PCNT_LIMIT_MIN || config->high_limit > PCNT_LIMIT_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    driver_call();
+    for (int u = 0; u < ETM_SIM_PCNT_UNITS; u++) {
+        if (pcnt_units[u].used) continue;
+        pcnt_units[u] = (struct pcnt_unit_t){
+            .id = u, .used = true, .fsm = FSM_INIT,
+            .low_limit = config->low_limit, .high_limit = config->high_limit,
+            .accum = config->flags.accum_count,
+        };
+        etm_sim_pcnt_config(u, config->low_limit, config->high_limit);
+        etm_sim_pcnt_set_callback(u, pcnt_watch_trampoline, &pcnt_units[u]);
+        *ret_unit = &pcnt_units[u];
+        return ESP_OK;
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t pcnt_del_unit(pcnt_unit_handle_t unit) {
+    if (!unit) return ESP_ERR_INVALID_ARG;
+    if (unit->fsm != FSM_INIT) return ESP_ERR_INVALID_STATE;
+    for (int ch = 0; ch < ETM_SIM_PCNT_CHANNELS; ch++) {
+        if (unit->chans[ch].used) return ESP_ERR_INVALID_STATE;
+    }
+    driver_call();
+    etm_sim_pcnt_set_callback(unit->id, NULL, NULL);
+    unit->used = false;
+    return ESP_OK;
+}
+
+esp_err_t pcnt_unit_enable(pcnt_unit_handle_t unit) {
+    if (!unit) return ESP_ERR_INVALID_ARG;
+    if (unit->fsm != FSM_INIT) return ESP_ERR_INVALID_STATE;
+    driver_call();
+    unit->fsm = FSM_ENABLE;
+    return ESP_OK;
+}
+
+esp_err_t pcnt_unit_disable(pcnt_unit_handle_t unit) {
+    if (!unit) return ESP_ERR_INVALID_ARG;
+    if (unit->fsm != FSM_ENABLE) return ESP_ERR_INVALID_STATE;
+    driver_call();
+    unit->fsm = FSM_INIT;
+    return ESP_OK;
+}
+
+esp_err_t pcnt_unit_start(pcnt_unit_handle_t unit) {
+    if (!unit) return ESP_ERR_INVALID_ARG;
+    if (unit->fsm != FSM_ENABLE) return ESP_ERR_INVALID_STATE;
+    driver_call();
+    etm_sim_pcnt_start(unit->id);
+    return ESP_OK;
+}
+
+esp_err_t pcnt_unit_stop(pcnt_unit_handle_t unit) {
+    if (!unit) return ESP_ERR_INVALID_ARG;
+    if (unit->fsm != FSM_ENABLE) return ESP_ERR_INVALID_STATE;
+    driver_call();
+    etm_sim_pcnt_stop(unit->id);
+    return ESP_OK;
+}
+
+esp_err_t pcnt_unit_clear_count(pcnt_unit_handle_t unit) {
+    if (!unit) return ESP_ERR_INVALID_ARG;
+    driver_call();
+    etm_sim_pcnt_clear(unit->id);
+    unit->accum_value = 0;
+    return ESP_OK;
+}
+
+esp_err_t pcnt_unit_get_count(pcnt_unit_handle_t unit, int *value) {
+    if (!unit || !value) return ESP_ERR_INVALID_ARG;
+    driver_call();
+    *value = unit->accum_value + etm_sim_pcnt_get(unit->id);
+    return ESP_OK;
+}
+
+esp_err_t pcnt_unit_register_event_callbacks(pcnt_unit_handle_t unit, const pcnt_event_callbacks_t *cbs, void *user_data) {
+    if (!unit || !cbs) return ESP_ERR_INVALID_ARG;
+    if (unit->fsm != FSM_INIT) return ESP_ERR_INVALID_STATE;
+    driver_call();
+    unit->on_reach = cbs->on_reach;
+    unit->user_ctx = user_data;
+    return ESP_OK;
+}
+
+esp_err_t pcnt_unit_add_watch_point(pcnt_unit_handle_t unit, int watch_point) {
+    if (!unit || watch_point < unit->low_limit || watch_point > unit->high_limit) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    driver_call();
+    return (etm_sim_pcnt_add_watch(unit->id, watch_point) == 0) ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t pcnt_unit_remove_watch_point(pcnt_unit_handle_t unit, int watch_point) {
+    if (!unit) return ESP_ERR_INVALID_ARG;
+    driver_call();
+    return (etm_sim_pcnt_remove_watch(unit->id, watch_point) == 0) ? ESP_OK : ESP_ERR_INVALID_STATE;
+}
+
+esp_err_t pcnt_new_channel(pcnt_unit_handle_t unit, const pcnt_chan_config_t *config, pcnt_channel_handle_t *ret_chan) {
+    if (!unit || !config || !ret_chan) return ESP_ERR_INVALID_ARG;
+    if (unit->fsm != FSM_INIT) return ESP_ERR_INVALID_STATE;
+    driver_call();
+    for (int ch = 0; ch < ETM_SIM_PCNT_CHANNELS; ch++) {
+        struct pcnt_chan_t *chan = &unit->chans[ch];
+        if (chan->used) continue;
+        *chan = (struct pcnt_chan_t){ .unit = unit, .id = ch, .used = true };
+        etm_sim_pcnt_channel(unit->id, ch, config->edge_gpio_num, config->level_gpio_num);
+        etm_sim_pcnt_edge_action(unit->id, ch, PCNT_CHANNEL_EDGE_ACTION_HOLD, PCNT_CHANNEL_EDGE_ACTION_HOLD);
+        etm_sim_pcnt_level_action(unit->id, ch, PCNT_CHANNEL_LEVEL_ACTION_KEEP, PCNT_CHANNEL_LEVEL_ACTION_KEEP);
+        *ret_chan = chan;
+        return ESP_OK;
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t pcnt_del_channel(pcnt_channel_handle_t chan) {
+    if (!chan) return ESP_ERR_INVALID_ARG;
+    driver_call();
+    etm_sim_pcnt_channel(chan->unit->id, chan->id, -1, -1);
+    chan->used = false;
+    return ESP_OK;
+}
+
+esp_err_t pcnt_channel_set_edge_action(pcnt_channel_handle_t chan, pcnt_channel_edge_action_t pos_act, pcnt_channel_edge_action_t neg_act) {
+    if (!chan) return ESP_ERR_INVALID_ARG;
+    driver_call();
+    etm_sim_pcnt_edge_action(chan->unit->id, chan->id, pos_act, neg_act);
+    return ESP_OK;
+}
+
+esp_err_t pcnt_channel_set_level_action(pcnt_channel_handle_t chan, pcnt_channel_level_action_t high_act, pcnt_channel_level_action_t low_act) {
+    if (!chan) return ESP_ERR_INVALID_ARG;
+    driver_call();
+    etm_sim_pcnt_level_action(chan->unit->id, chan->id, high_act, low_act);
+    return ESP_OK;
+}
+
+// ============================================================
+// PARLIO TX
+// ============================================================
+
+struct parlio_tx_unit_t {
+    int id;
+    bool used;
+    driver_fsm_t fsm;
+    size_t max_transfer_size;
+    parlio_tx_done_callback_t on_trans_done;
+    void *user_ctx;
+};
+
+static struct parlio_tx_unit_t parlio_units[ETM_SIM_PARLIO_UNITS];
+
+static void parlio_done_trampoline(int u, void *ctx) {
+    struct parlio_tx_unit_t *unit = ctx;
+    if (!unit->on_trans_done) return;
+    parlio_tx_done_event_data_t edata = {0};
+    unit->on_trans_done(unit, &edata, unit->user_ctx);
+}
+
+esp_err_t parlio_new_tx_unit(const parlio_tx_unit_config_t *config, parlio_tx_unit_handle_t *ret_unit) {
+    if (!config || !ret_unit || config->output_clk_freq_hz == 0 || config->trans_queue_depth == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    size_t w = config->data_width;
+    if (w == 0 || w > PARLIO_TX_UNIT_MAX_DATA_WIDTH || (w & (w - 1))) return ESP_ERR_INVALID_ARG;
+    driver_call();
+    for (int u = 0; u < ETM_SIM_PARLIO_UNITS; u++) {
+        if (parlio_units[u].used) continue;
+        parlio_units[u] = (struct parlio_tx_unit_t){
+            .id = u, .used = true, .fsm = FSM_INIT,
+            .max_transfer_size = config->max_transfer_size,
+        };
+        int gpios[PARLIO_TX_UNIT_MAX_DATA_WIDTH];
+        for (size_t j = 0; j < PARLIO_TX_UNIT_MAX_DATA_WIDTH; j++) gpios[j] = config->data_gpio_nums[j];
+        etm_sim_parlio_config(u, config->output_clk_freq_hz, (int)w, gpios,
+                              config->bit_pack_order == PARLIO_BIT_PACK_ORDER_MSB,
+                              (int)config->trans_queue_depth);
+        etm_sim_parlio_set_callback(u, parlio_done_trampoline, &parlio_units[u]);
+        *ret_unit = &parlio_units[u];
+        return ESP_OK;
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t parlio_del_tx_unit(parlio_tx_unit_handle_t unit) {
+    if (!unit) return ESP_ERR_INVALID_ARG;
+    if (unit->fsm != FSM_INIT) return ESP_ERR_INVALID_STATE;
+    driver_call();
+    etm_sim_parlio_set_callback(unit->id, NULL, NULL);
+    unit->used = false;
+    return ESP_OK;
+}
+
+esp_err_t parlio_tx_unit_enable(parlio_tx_unit_handle_t unit) {
+    if (!unit) return ESP_ERR_INVALID_ARG;
+    if (unit->fsm != FSM_INIT) return ESP_ERR_INVALID_STATE;
+    driver_call();
+    unit->fsm = FSM_ENABLE;
+    return ESP_OK;
+}
+
+esp_err_t parlio_tx_unit_disable(parlio_tx_unit_handle_t unit) {
+    if (!unit) return ESP_ERR_INVALID_ARG;
+    if (unit->fsm != FSM_ENABLE) return ESP_ERR_INVALID_STATE;
+    driver_call();
+    unit->fsm = FSM_INIT;
+    return ESP_OK;
+}
+
+static bool parlio_queue_full(void *ctx) {
+    return etm_sim_parlio_queue_full(((struct parlio_tx_unit_t *)ctx)->id);
+}
+
+static bool parlio_busy(void *ctx) {
+    return etm_sim_parlio_pending(((struct parlio_tx_unit_t *)ctx)->id) > 0;
+}
+
+esp_err_t parlio_tx_unit_transmit(parlio_tx_unit_handle_t tx_unit, const void *payload, size_t payload_bits, const parlio_transmit_config_t *config) {
+    if (!tx_unit || !payload || !config || payload_bits == 0) return ESP_ERR_INVALID_ARG;
+    if ((payload_bits + 7) / 8 > tx_unit->max_transfer_size) return ESP_ERR_INVALID_ARG;
+    if (tx_unit->fsm != FSM_ENABLE) return ESP_ERR_INVALID_STATE;
+    driver_call();
+
+    // Blocks for a free slot unless told not to, like the device
+    if (etm_sim_parlio_queue_full(tx_unit->id)) {
+        if (config->flags.queue_nonblocking || etm_sim_in_isr()) return ESP_ERR_INVALID_STATE;
+        etm_sim_run_while(parlio_queue_full, tx_unit, UINT64_MAX);
+    }
+    etm_sim_parlio_transmit(tx_unit->id, payload, payload_bits, config->idle_value);
+    return ESP_OK;
+}
+
+esp_err_t parlio_tx_unit_wait_all_done(parlio_tx_unit_handle_t tx_unit, int timeout_ms) {
+    if (!tx_unit) return ESP_ERR_INVALID_ARG;
+    driver_call();
+    uint64_t limit = (timeout_ms < 0) ? UINT64_MAX : etm_sim_now() + (uint64_t)timeout_ms * 1000000ULL;
+    return etm_sim_run_while(parlio_busy, tx_unit, limit) ? ESP_OK : ESP_ERR_TIMEOUT;
+}
+
+esp_err_t parlio_tx_unit_register_event_callbacks(parlio_tx_unit_handle_t tx_unit, const parlio_tx_event_callbacks_t *cbs, void *user_data) {
+    if (!tx_unit || !cbs) return ESP_ERR_INVALID_ARG;
+    driver_call();
+    tx_unit->on_trans_done = cbs->on_trans_done;
+    tx_unit->user_ctx = user_data;
+    return ESP_OK;
+}
+
+// ============================================================
+// FreeRTOS Semaphores
+// ============================================================
+
+struct etm_sim_sem_t {
+    volatile bool given;
+};
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void) {
+    return calloc(1, sizeof(struct etm_sim_sem_t));
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t sem) {
+    free(sem);
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) {
+    if (sem->given) return pdFALSE;
+    sem->given = true;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t *higher_prio_woken) {
+    BaseType_t ret = xSemaphoreGive(sem);
+    if (ret == pdTRUE && higher_prio_woken) *higher_prio_woken = pdTRUE;
+    return ret;
+}
+
+static bool sem_empty(void *ctx) {
+    return !((SemaphoreHandle_t)ctx)->given;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks) {
+    if (!sem->given && ticks > 0) {
+        uint64_t limit = (ticks == portMAX_DELAY) ? UINT64_MAX : etm_sim_now() + (uint64_t)ticks * 1000000ULL;
+        etm_sim_run_while(sem_empty, sem, limit);
+    }
+    if (!sem->given) return pdFALSE;
+    sem->given = false;
+    return pdTRUE;
+}
+
+// ============================================================
+// FreeRTOS Task Notifications
+// ============================================================
+
+struct etm_sim_task_t {
+    volatile uint32_t notify;
+};
+
+static struct etm_sim_task_t main_task;
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+    return &main_task;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higher_prio_woken) {
+    task->notify++;
+    if (higher_prio_woken) *higher_prio_woken = pdTRUE;
+}
+
+static bool notify_empty(void *ctx) {
+    return ((TaskHandle_t)ctx)->notify == 0;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks) {
+    if (main_task.notify == 0 && ticks > 0) {
+        uint64_t limit = (ticks == portMAX_DELAY) ? UINT64_MAX : etm_sim_now() + (uint64_t)ticks * 1000000ULL;
+        etm_sim_run_while(notify_empty, &main_task, limit);
+    }
+    uint32_t value = main_task.notify;
+    if (value) main_task.notify = clear_on_exit ? 0 : value - 1;
+    return value;
+}
@@ -0,0 +1,42 @@
+/**
+ * Host shim for driver/gpio_etm.h (ETM simulator builds)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_etm.h"
+
+typedef enum {
+    GPIO_ETM_EVENT_EDGE_POS = 1,
+    GPIO_ETM_EVENT_EDGE_NEG,
+    GPIO_ETM_EVENT_EDGE_ANY,
+} gpio_etm_event_edge_t;
+
+typedef struct {
+    gpio_etm_event_edge_t edge;
+} gpio_etm_event_config_t;
+
+typedef enum {
+    GPIO_ETM_TASK_ACTION_SET = 1,
+    GPIO_ETM_TASK_ACTION_CLR,
+    GPIO_ETM_TASK_ACTION_TOG,
+    GPIO_ETM_TASK_ACTION_MAX,
+} gpio_etm_task_action_t;
+
+// One GPIO task channel, one task handle per action (IDF 5.3+)
+typedef struct {
+    union {
+        gpio_etm_task_action_t action;
+        gpio_etm_task_action_t actions[GPIO_ETM_TASK_ACTION_MAX];
+    };
+} gpio_etm_task_config_t;
+
+esp_err_t gpio_new_etm_event(const gpio_etm_event_config_t *config, esp_etm_event_handle_t *ret_event);
+esp_err_t gpio_etm_event_bind_gpio(esp_etm_event_handle_t event, int gpio_num);
+// Further actions return their handles through the variadic arguments;
+// GPIOs added to any of them are bound to the shared channel
+esp_err_t gpio_new_etm_task(const gpio_etm_task_config_t *config, esp_etm_task_handle_t *ret_task, ...);
+esp_err_t gpio_etm_task_add_gpio(esp_etm_task_handle_t task, uint32_t gpio_num);
+esp_err_t gpio_etm_task_rm_gpio(esp_etm_task_handle_t task, uint32_t gpio_num);
@@ -0,0 +1,77 @@
+/**
+ * Host shim for driver/parlio_tx.h (ETM simulator builds)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "driver/gpio.h"
+
+#define PARLIO_TX_UNIT_MAX_DATA_WIDTH 16
+
+typedef struct parlio_tx_unit_t *parlio_tx_unit_handle_t;
+
+typedef enum {
+    PARLIO_CLK_SRC_DEFAULT = 0,
+    PARLIO_CLK_SRC_PLL_F240M = 0,
+    PARLIO_CLK_SRC_XTAL = 1,
+    PARLIO_CLK_SRC_EXTERNAL = 2,
+} parlio_clock_source_t;
+
+typedef enum {
+    PARLIO_SAMPLE_EDGE_NEG,
+    PARLIO_SAMPLE_EDGE_POS,
+} parlio_sample_edge_t;
+
+typedef enum {
+    PARLIO_BIT_PACK_ORDER_LSB,
+    PARLIO_BIT_PACK_ORDER_MSB,
+} parlio_bit_pack_order_t;
+
+typedef struct {
+    parlio_clock_source_t clk_src;
+    gpio_num_t clk_in_gpio_num;
+    uint32_t input_clk_src_freq_hz;
+    uint32_t output_clk_freq_hz;
+    size_t data_width;
+    gpio_num_t data_gpio_nums[PARLIO_TX_UNIT_MAX_DATA_WIDTH];
+    gpio_num_t clk_out_gpio_num;
+    gpio_num_t valid_gpio_num;
+    size_t trans_queue_depth;
+    size_t max_transfer_size;
+    parlio_sample_edge_t sample_edge;
+    parlio_bit_pack_order_t bit_pack_order;
+    struct {
+        uint32_t clk_gate_en: 1;
+        uint32_t io_loop_back: 1;
+        uint32_t allow_pd: 1;
+    } flags;
+} parlio_tx_unit_config_t;
+
+typedef struct {
+    uint32_t idle_value;
+    struct {
+        uint32_t queue_nonblocking: 1;
+    } flags;
+} parlio_transmit_config_t;
+
+typedef struct {
+    uint32_t reserved;
+} parlio_tx_done_event_data_t;
+
+typedef bool (*parlio_tx_done_callback_t)(parlio_tx_unit_handle_t tx_unit, const parlio_tx_done_event_data_t *edata, void *user_ctx);
+
+typedef struct {
+    parlio_tx_done_callback_t on_trans_done;
+} parlio_tx_event_callbacks_t;
+
+esp_err_t parlio_new_tx_unit(const parlio_tx_unit_config_t *config, parlio_tx_unit_handle_t *ret_unit);
+esp_err_t parlio_del_tx_unit(parlio_tx_unit_handle_t unit);
+esp_err_t parlio_tx_unit_enable(parlio_tx_unit_handle_t unit);
+esp_err_t parlio_tx_unit_disable(parlio_tx_unit_handle_t unit);
+esp_err_t parlio_tx_unit_transmit(parlio_tx_unit_handle_t tx_unit, const void *payload, size_t payload_bits, const parlio_transmit_config_t *config);
+esp_err_t parlio_tx_unit_wait_all_done(parlio_tx_unit_handle_t tx_unit, int timeout_ms);
+esp_err_t parlio_tx_unit_register_event_callbacks(parlio_tx_unit_handle_t tx_unit, const parlio_tx_event_callbacks_t *cbs, void *user_data);
@@ -0,0 +1,8 @@
+/**
+ * Host shim for esp_attr.h (ETM simulator builds)
+ */
+
+#pragma once
+
+#define IRAM_ATTR
+#define DRAM_ATTR
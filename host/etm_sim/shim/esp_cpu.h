@@ -0,0 +1,25 @@
+/**
+ * Host shim for esp_cpu.h (ETM simulator builds)
+ *
+ * The simulator charges no simulated time to CPU work, so CPU-only
+ * intervals come from the host's own counter: TSC ticks on x86, ns
+ * elsewhere. Like the device counter, it wraps at 32 bits.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+typedef uint32_t esp_cpu_cycle_count_t;
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+static inline esp_cpu_cycle_count_t esp_cpu_get_cycle_count(void) { return (uint32_t)__rdtsc(); }
+#else
+#include <time.h>
+static inline esp_cpu_cycle_count_t esp_cpu_get_cycle_count(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec);
+}
+#endif
@@ -0,0 +1,30 @@
+/**
+ * Host shim for esp_etm.h (ETM simulator builds)
+ *
+ * The IDF ETM driver: channels are allocated from the driver's own
+ * bookkeeping, lowest first, and written into the simulated matrix.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+typedef struct esp_etm_channel_t *esp_etm_channel_handle_t;
+typedef struct esp_etm_event_t *esp_etm_event_handle_t;
+typedef struct esp_etm_task_t *esp_etm_task_handle_t;
+
+typedef struct {
+    struct {
+        uint32_t allow_pd: 1;
+    } flags;
+} esp_etm_channel_config_t;
+
+esp_err_t esp_etm_new_channel(const esp_etm_channel_config_t *config, esp_etm_channel_handle_t *ret_chan);
+esp_err_t esp_etm_del_channel(esp_etm_channel_handle_t chan);
+esp_err_t esp_etm_channel_enable(esp_etm_channel_handle_t chan);
+esp_err_t esp_etm_channel_disable(esp_etm_channel_handle_t chan);
+esp_err_t esp_etm_channel_connect(esp_etm_channel_handle_t chan, esp_etm_event_handle_t event, esp_etm_task_handle_t task);
+esp_err_t esp_etm_del_event(esp_etm_event_handle_t event);
+esp_err_t esp_etm_del_task(esp_etm_task_handle_t task);
@@ -0,0 +1,17 @@
+/**
+ * Host shim for esp_log.h (ETM simulator builds)
+ *
+ * Same line format as the device, timestamped in virtual milliseconds.
+ */
+
+#pragma once
+
+#include "esp_err.h"
+
+void etm_sim_log(char level, const char *tag, const char *fmt, ...)
+    __attribute__((format(printf, 3, 4)));
+
+#define ESP_LOGE(tag, fmt, ...) etm_sim_log('E', tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) etm_sim_log('W', tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...) etm_sim_log('I', tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGD(tag, fmt, ...) do { (void)(tag); } while (0)
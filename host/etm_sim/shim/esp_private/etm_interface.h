@@ -0,0 +1,22 @@
+/**
+ * Host shim for esp_private/etm_interface.h (ETM simulator builds)
+ *
+ * The IDF ETM handle layout: the matrix event / task ID comes first, so
+ * code routing raw PCNT events onto driver-allocated tasks can read it.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_etm.h"
+
+struct esp_etm_event_t {
+    int event_id;
+    int gpio_ch;            // simulator: GPIO event channel, -1 for other peripherals
+};
+
+struct esp_etm_task_t {
+    int task_id;
+    int gpio_ch;            // simulator: GPIO task channel, -1 for other peripherals
+    uint32_t pins;          // simulator: GPIOs added to this task
+};
@@ -0,0 +1,17 @@
+/**
+ * Host shim for esp_timer.h (ETM simulator builds)
+ *
+ * Microseconds of simulated time, so intervals measured by the firmware
+ * line up with the simulated peripherals.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "etm_sim.h"
+
+#define ESP_TIMER_SIMULATED 1   // Benchmarks report "platform":"host-sim"
+
+static inline int64_t esp_timer_get_time(void) {
+    return (int64_t)(etm_sim_now() / 1000);
+}
@@ -0,0 +1,18 @@
+/**
+ * Host shim for freertos/semphr.h (ETM simulator builds)
+ *
+ * Binary semaphores on virtual time: a take blocks by running the
+ * simulated fabric until a callback gives it or the timeout passes.
+ */
+
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct etm_sim_sem_t *SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+void vSemaphoreDelete(SemaphoreHandle_t sem);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem);
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t *higher_prio_woken);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks);
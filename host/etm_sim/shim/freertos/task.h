@@ -0,0 +1,22 @@
+/**
+ * Host shim for freertos/task.h (ETM simulator builds)
+ *
+ * A delay runs the simulated fabric for that long instead of sleeping.
+ * There is one task, so its notification is a single counter; a take
+ * runs the fabric until an ISR gives it.
+ */
+
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+#include "etm_sim.h"
+
+static inline void vTaskDelay(TickType_t ticks) {
+    etm_sim_advance((uint64_t)ticks * 1000000ULL);
+}
+
+typedef struct etm_sim_task_t *TaskHandle_t;
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higher_prio_woken);
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks);
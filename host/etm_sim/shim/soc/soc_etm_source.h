@@ -0,0 +1,81 @@
+/**
+ * Host shim for soc/soc_etm_source.h
+ *
+ * The ETM event and task IDs the simulator models. IDs the demos and
+ * docs already use keep their C6 values (PCNT 45/46, timer compare 48,
+ * timer stop 92, GPIO events and tasks 1..24); the device build uses IDF's full
+ * header.
+ */
+
+#pragma once
+
+// Events: GPIO event channels 0..7, one bank per edge
+#define GPIO_EVT_CH0_RISE_EDGE              1
+#define GPIO_EVT_CH1_RISE_EDGE              2
+#define GPIO_EVT_CH2_RISE_EDGE              3
+#define GPIO_EVT_CH3_RISE_EDGE              4
+#define GPIO_EVT_CH4_RISE_EDGE              5
+#define GPIO_EVT_CH5_RISE_EDGE              6
+#define GPIO_EVT_CH6_RISE_EDGE              7
+#define GPIO_EVT_CH7_RISE_EDGE              8
+#define GPIO_EVT_CH0_FALL_EDGE              9
+#define GPIO_EVT_CH1_FALL_EDGE              10
+#define GPIO_EVT_CH2_FALL_EDGE              11
+#define GPIO_EVT_CH3_FALL_EDGE              12
+#define GPIO_EVT_CH4_FALL_EDGE              13
+#define GPIO_EVT_CH5_FALL_EDGE              14
+#define GPIO_EVT_CH6_FALL_EDGE              15
+#define GPIO_EVT_CH7_FALL_EDGE              16
+#define GPIO_EVT_CH0_ANY_EDGE               17
+#define GPIO_EVT_CH1_ANY_EDGE               18
+#define GPIO_EVT_CH2_ANY_EDGE               19
+#define GPIO_EVT_CH3_ANY_EDGE               20
+#define GPIO_EVT_CH4_ANY_EDGE               21
+#define GPIO_EVT_CH5_ANY_EDGE               22
+#define GPIO_EVT_CH6_ANY_EDGE               23
+#define GPIO_EVT_CH7_ANY_EDGE               24
+
+// Events: PCNT and timers
+#define PCNT_EVT_CNT_EQ_THRESH              45
+#define PCNT_EVT_CNT_EQ_LMT                 46
+#define PCNT_EVT_CNT_EQ_ZERO                47
+#define TIMER0_EVT_CNT_CMP_TIMER0           48
+#define TIMER1_EVT_CNT_CMP_TIMER0           49
+
+// Tasks: GPIO task channels 0..7, one bank per action
+#define GPIO_TASK_CH0_SET                   1
+#define GPIO_TASK_CH1_SET                   2
+#define GPIO_TASK_CH2_SET                   3
+#define GPIO_TASK_CH3_SET                   4
+#define GPIO_TASK_CH4_SET                   5
+#define GPIO_TASK_CH5_SET                   6
+#define GPIO_TASK_CH6_SET                   7
+#define GPIO_TASK_CH7_SET                   8
+#define GPIO_TASK_CH0_CLEAR                 9
+#define GPIO_TASK_CH1_CLEAR                 10
+#define GPIO_TASK_CH2_CLEAR                 11
+#define GPIO_TASK_CH3_CLEAR                 12
+#define GPIO_TASK_CH4_CLEAR                 13
+#define GPIO_TASK_CH5_CLEAR                 14
+#define GPIO_TASK_CH6_CLEAR                 15
+#define GPIO_TASK_CH7_CLEAR                 16
+#define GPIO_TASK_CH0_TOGGLE                17
+#define GPIO_TASK_CH1_TOGGLE                18
+#define GPIO_TASK_CH2_TOGGLE                19
+#define GPIO_TASK_CH3_TOGGLE                20
+#define GPIO_TASK_CH4_TOGGLE                21
+#define GPIO_TASK_CH5_TOGGLE                22
+#define GPIO_TASK_CH6_TOGGLE                23
+#define GPIO_TASK_CH7_TOGGLE                24
+
+// Tasks: timers (group 0 / group 1 interleaved)
+#define TIMER0_TASK_CNT_START_TIMER0        88
+#define TIMER1_TASK_CNT_START_TIMER0        89
+#define TIMER0_TASK_ALARM_START_TIMER0      90
+#define TIMER1_TASK_ALARM_START_TIMER0      91
+#define TIMER0_TASK_CNT_STOP_TIMER0         92
+#define TIMER1_TASK_CNT_STOP_TIMER0         93
+#define TIMER0_TASK_CNT_RELOAD_TIMER0       94
+#define TIMER1_TASK_CNT_RELOAD_TIMER0       95
+#define TIMER0_TASK_CNT_CAP_TIMER0          96
+#define TIMER1_TASK_CNT_CAP_TIMER0          97
@@ -0,0 +1,169 @@
+/**
+ * ensemble_bench.c - Throughput of the demo 03 network ensemble
+ *
+ * Builds N different networks: network k has its own phases and masks
+ * (counter stream k of --seed), a coupling spread over --coupling lo:hi
+ * and its own random 4-bit input (or --input for all). It advances them
+ * three ways and reports network-steps per second:
+ *
+ *   scalar     spectral_step() on one network after another, one thread
+ *   lanes      spectral_lanes_step() blocks of SPECTRAL_LANES, one thread
+ *   threads    the same blocks sharded over --threads
+ *
+ * Every network's final state is compared byte for byte with the scalar
+ * run. All state lives in one net_arena (hugepage-advised when it is
+ * large); its allocation count and peak bytes are reported.
+ *
+ *   ensemble_bench [--networks N] [--steps S] [--seed S] [--coupling lo:hi]
+ *                  [--input a,b,c,d] [--feedback] [--threads T]
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "spectral_ensemble.h"
+
+#define INPUT_STREAM    1       // Counter stream of each network's input
+
+static double wall_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "usage: %s [--networks N] [--steps S] [--seed S] [--coupling lo:hi]\n"
+            "          [--input a,b,c,d] [--feedback] [--threads T]\n", prog);
+}
+
+static bool same_network(const spectral_network_t *a, const spectral_network_t *b) {
+    return memcmp(a, b, SPECTRAL_STATE_BYTES) == 0 && a->coherence == b->coherence;
+}
+
+static void print_row(const char *name, int threads, double elapsed, double work,
+                      double base, int mismatches) {
+    printf("  %-8s | %7d | %8.3f | %10.2f M | %6.1fx | %s\n", name, threads, elapsed,
+           work / elapsed / 1e6, base / elapsed, mismatches ? "NO" : "yes");
+}
+
+int main(int argc, char **argv) {
+    int num_networks = 4096, steps = 500, threads = 0;
+    uint32_t seed = SPECTRAL_SEED;
+    float coupling_lo = 0.1f, coupling_hi = 1.0f;
+    bool feedback = false, shared_input = false;
+    uint8_t input[INPUT_DIM] = {0};
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i], *val = i + 1 < argc ? argv[i + 1] : NULL;
+        if (!strcmp(arg, "--feedback")) { feedback = true; continue; }
+        if (!val) { usage(argv[0]); return 1; }
+        i++;
+        if (!strcmp(arg, "--networks")) num_networks = atoi(val);
+        else if (!strcmp(arg, "--steps")) steps = atoi(val);
+        else if (!strcmp(arg, "--seed")) seed = (uint32_t)strtoul(val, NULL, 0);
+        else if (!strcmp(arg, "--threads")) threads = atoi(val);
+        else if (!strcmp(arg, "--coupling")) {
+            if (sscanf(val, "%f:%f", &coupling_lo, &coupling_hi) != 2) {
+                usage(argv[0]);
+                return 1;
+            }
+        } else if (!strcmp(arg, "--input")) {
+            int v[INPUT_DIM];
+            if (sscanf(val, "%d,%d,%d,%d", &v[0], &v[1], &v[2], &v[3]) != INPUT_DIM) {
+                usage(argv[0]);
+                return 1;
+            }
+            for (int k = 0; k < INPUT_DIM; k++) input[k] = (uint8_t)v[k];
+            shared_input = true;
+        } else { usage(argv[0]); return 1; }
+    }
+    if (num_networks < 1 || steps < 1) { usage(argv[0]); return 1; }
+    if (threads <= 0) threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+
+    spectral_init_tables();
+    size_t net_bytes = net_arena_round(num_networks * sizeof(spectral_network_t));
+    net_arena_t arena;
+    if (net_arena_init(&arena, 2 * net_bytes + net_arena_round(num_networks * INPUT_DIM)
+                               + ensemble_bytes(num_networks), MALLOC_CAP_8BIT)) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    spectral_network_t *nets = net_arena_alloc(&arena, num_networks * sizeof(spectral_network_t));
+    spectral_network_t *scalar = net_arena_alloc(&arena, num_networks * sizeof(spectral_network_t));
+    uint8_t (*inputs)[INPUT_DIM] = net_arena_alloc(&arena, num_networks * sizeof(*inputs));
+    spectral_ensemble_t ensemble;
+    if (!nets || !scalar || !inputs || ensemble_init(&ensemble, &arena, num_networks)) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    for (int k = 0; k < num_networks; k++) {
+        float coupling = num_networks > 1
+            ? coupling_lo + (coupling_hi - coupling_lo) * k / (num_networks - 1) : coupling_lo;
+        net_rng_t rng = net_rng_counter(seed, (uint32_t)k, SPECTRAL_STREAM_INIT);
+        spectral_init_rng(&nets[k], coupling, &rng);
+        net_rng_t in_rng = net_rng_counter(seed, (uint32_t)k, INPUT_STREAM);
+        for (int d = 0; d < INPUT_DIM; d++) {
+            inputs[k][d] = shared_input ? input[d] : net_rng_next(&in_rng) & 0x0F;
+        }
+    }
+    const spectral_feedback_t *fb = feedback ? &SPECTRAL_FEEDBACK : NULL;
+    double work = (double)num_networks * steps;
+
+    printf("\n");
+    printf("======================================================================\n");
+    printf("  SPECTRAL NETWORK ENSEMBLE: %d networks x %d steps\n", num_networks, steps);
+    printf("======================================================================\n");
+    printf("\n");
+    printf("  Networks: seed %u streams, coupling %.2f..%.2f, %s, feedback %s\n", seed,
+           coupling_lo, coupling_hi, shared_input ? "one input" : "random 4-bit inputs",
+           feedback ? "on" : "off");
+    printf("  Layout: %d blocks of %d lanes, %zu bytes per block\n", ensemble.num_blocks,
+           SPECTRAL_LANES, sizeof(spectral_lanes_t));
+    printf("  Memory: %zu-byte arena (%s), %u allocations, peak %zu bytes\n",
+           arena.capacity, arena.mapped ? "mmap, hugepages advised" : "heap",
+           (unsigned)arena.allocs, arena.peak);
+    printf("\n");
+    printf("  Engine   | Threads | Time (s) | Net-steps/s  | Speedup | Bit-exact\n");
+    printf("  ---------+---------+----------+--------------+---------+----------\n");
+
+    memcpy(scalar, nets, num_networks * sizeof(spectral_network_t));
+    double t0 = wall_s();
+    for (int k = 0; k < num_networks; k++) {
+        for (int t = 0; t < steps; t++) {
+            if (fb) spectral_step_feedback_with(&scalar[k], inputs[k], fb);
+            else spectral_step(&scalar[k], inputs[k]);
+        }
+    }
+    double base = wall_s() - t0;
+    print_row("scalar", 1, base, work, base, 0);
+
+    int failures = 0;
+    int runs[2] = { 1, threads };
+    for (int r = 0; r < (threads > 1 ? 2 : 1); r++) {
+        for (int k = 0; k < num_networks; k++) ensemble_load(&ensemble, k, &nets[k], inputs[k]);
+        t0 = wall_s();
+        ensemble_run(&ensemble, steps, fb, runs[r]);
+        double elapsed = wall_s() - t0;
+
+        int mismatches = 0;
+        for (int k = 0; k < num_networks; k++) {
+            spectral_network_t out = nets[k];
+            ensemble_store(&ensemble, k, &out);
+            mismatches += !same_network(&out, &scalar[k]);
+        }
+        failures += mismatches;
+        print_row(r ? "threads" : "lanes", runs[r], elapsed, work, base, mismatches);
+    }
+
+    printf("\n");
+    if (failures) printf("  %d networks differ from spectral_step()\n", failures);
+    printf("  Result: %s\n", failures ? "FAIL" : "PASS");
+    printf("\n");
+
+    net_arena_destroy(&arena);
+    return failures ? 1 : 0;
+}
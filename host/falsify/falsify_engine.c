@@ -0,0 +1,442 @@
+/**
+ * falsify_engine.c - Native engine for tests/falsify_etm.py
+ *
+ * See falsify_engine.h. The step follows SpectralOscillator.evolve_step()
+ * operation for operation, and the means are summed the way NumPy sums
+ * them (pairwise, eight lanes), so a run matches the NumPy engine bit for
+ * bit on the same libm. `falsify_etm.py --parity` checks that.
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "falsify_engine.h"
+#include "job_pool.h"
+
+static const double band_decay[FE_BANDS] = {0.98, 0.90, 0.70, 0.30};
+static const double band_freq[FE_BANDS] = {0.1, 0.3, 1.0, 3.0};
+
+#define COHERENCE_HIGH      0.6
+#define COHERENCE_LOW       0.25
+#define COUPLING_DECAY      0.995
+#define COUPLING_GROWTH     1.005
+#define COUPLING_MIN        0.01
+#define COUPLING_MAX        2.0
+#define TWO_PI              (2 * M_PI)
+#define SCORE_WINDOW        100     // F3: steps scored at the end of a run
+
+// ============================================================
+// NumPy arithmetic
+// ============================================================
+
+// np.add.reduce on a contiguous float64 array
+static double pairwise_sum(const double *a, long n) {
+    if (n < 8) {
+        double res = 0.;
+        for (long i = 0; i < n; i++) res += a[i];
+        return res;
+    }
+    if (n <= 128) {
+        double r[8];
+        long i;
+        memcpy(r, a, sizeof(r));
+        for (i = 8; i < n - (n % 8); i += 8) {
+            for (int j = 0; j < 8; j++) r[j] += a[i + j];
+        }
+        double res = ((r[0] + r[1]) + (r[2] + r[3])) + ((r[4] + r[5]) + (r[6] + r[7]));
+        for (; i < n; i++) res += a[i];
+        return res;
+    }
+    long n2 = n / 2;
+    n2 -= n2 % 8;
+    return pairwise_sum(a, n2) + pairwise_sum(a + n2, n - n2);
+}
+
+static double np_mean(const double *a, long n) {
+    return pairwise_sum(a, n) / n;
+}
+
+static double np_std(const double *a, long n) {
+    double mean = np_mean(a, n), *sq = malloc(n * sizeof(double));
+    if (!sq) return NAN;
+    for (long i = 0; i < n; i++) sq[i] = (a[i] - mean) * (a[i] - mean);
+    double var = np_mean(sq, n);
+    free(sq);
+    return sqrt(var);
+}
+
+// Float % as NumPy does it: the result takes the divisor's sign
+static inline double np_mod(double a, double b) {
+    double r = fmod(a, b);
+    if (r == 0) return copysign(0.0, b);
+    return ((r < 0) != (b < 0)) ? r + b : r;
+}
+
+static inline double np_clip(double x, double lo, double hi) {
+    return x < lo ? lo : x > hi ? hi : x;
+}
+
+static int cabs_scaled;
+
+void fe_set_numpy_cabs(int scaled) {
+    cabs_scaled = scaled;
+}
+
+static double np_cabs(double re, double im) {
+    if (!cabs_scaled) return hypot(re, im);
+    double x = fabs(re), y = fabs(im), big = fmax(x, y), small = fmin(x, y);
+    if (big == 0) return 0.0;
+    double q = small / big;
+    return big * sqrt(fma(q, q, 1.0));
+}
+
+// ============================================================
+// Oscillator
+// ============================================================
+
+typedef struct {
+    double phase[FE_BANDS][FE_PER_BAND];
+    double mag[FE_BANDS][FE_PER_BAND];
+    double coupling;
+} osc_t;
+
+static void osc_init(osc_t *o, const double *phases) {
+    memcpy(o->phase, phases, sizeof(o->phase));
+    for (int b = 0; b < FE_BANDS; b++) {
+        for (int n = 0; n < FE_PER_BAND; n++) o->mag[b][n] = 0.9;
+    }
+    o->coupling = 0.5;
+}
+
+static void osc_wrap(osc_t *o) {
+    for (int b = 0; b < FE_BANDS; b++) {
+        for (int n = 0; n < FE_PER_BAND; n++) o->phase[b][n] = np_mod(o->phase[b][n], TWO_PI);
+    }
+}
+
+// |mean(exp(i * phase))| over oscillators with magnitude > 0.01
+static double osc_coherence(const osc_t *o) {
+    double z[2 * FE_OSCILLATORS];
+    long n = 0;
+    for (int b = 0; b < FE_BANDS; b++) {
+        for (int k = 0; k < FE_PER_BAND; k++) {
+            if (o->mag[b][k] > 0.01) {
+                z[n++] = cos(o->phase[b][k]);
+                z[n++] = sin(o->phase[b][k]);
+            }
+        }
+    }
+    if (!n) return 0.0;
+
+    // Complex pairwise sum: four complex lanes once there are eight scalars
+    double re = 0., im = 0.;
+    long i = 0;
+    if (n >= 8) {
+        double r[8];
+        memcpy(r, z, sizeof(r));
+        for (i = 8; i < n - (n % 8); i += 8) {
+            for (int j = 0; j < 8; j++) r[j] += z[i + j];
+        }
+        re = (r[0] + r[2]) + (r[4] + r[6]);
+        im = (r[1] + r[3]) + (r[5] + r[7]);
+    }
+    for (; i < n; i += 2) {
+        re += z[i];
+        im += z[i + 1];
+    }
+    // complex / count divides by multiplying with the reciprocal
+    double scale = 1.0 / (double)(n / 2);
+    return np_cabs(re * scale, im * scale);
+}
+
+/**
+ * evolve_step(); fixed_k is fixed_coupling, NaN for None.
+ */
+static void osc_step(osc_t *o, double input_energy, bool use_feedback, double fixed_k) {
+    if (input_energy > 0) {
+        for (int b = 0; b < FE_BANDS; b++) {
+            for (int n = 0; n < FE_PER_BAND; n++) {
+                if (o->mag[b][n] < 0.5) o->mag[b][n] += 0.1 * input_energy;
+            }
+        }
+    }
+
+    for (int b = 0; b < FE_BANDS; b++) {
+        double advance = band_freq[b] * 0.1;
+        for (int n = 0; n < FE_PER_BAND; n++) {
+            o->phase[b][n] += advance;
+            o->mag[b][n] *= band_decay[b];
+        }
+    }
+    osc_wrap(o);
+
+    // Kuramoto pull between bands; each dst sees the pulls already applied
+    double K = isnan(fixed_k) ? o->coupling : fixed_k;
+    if (K >= 0.01) {
+        for (int src = 0; src < FE_BANDS; src++) {
+            for (int dst = 0; dst < FE_BANDS; dst++) {
+                if (src == dst) continue;
+                double s[FE_PER_BAND];
+                for (int n = 0; n < FE_PER_BAND; n++) s[n] = sin(o->phase[src][n] - o->phase[dst][n]);
+                double pull = K * np_mean(s, FE_PER_BAND) * 0.1;
+                for (int n = 0; n < FE_PER_BAND; n++) o->phase[dst][n] += pull;
+            }
+        }
+        osc_wrap(o);
+    }
+
+    if (use_feedback) {
+        double coherence = osc_coherence(o);
+        if (coherence > COHERENCE_HIGH) {
+            o->coupling *= COUPLING_DECAY;
+        } else if (coherence < COHERENCE_LOW) {
+            o->coupling *= COUPLING_GROWTH;
+        }
+        o->coupling = np_clip(o->coupling, COUPLING_MIN, COUPLING_MAX);
+    } else if (!isnan(fixed_k)) {
+        o->coupling = fixed_k;
+    }
+}
+
+// ============================================================
+// F1: reducibility
+// ============================================================
+
+typedef struct {
+    const double *phases, *inputs;
+    int steps, precision;
+    uint64_t *hashes;
+} f1_ctx_t;
+
+static inline uint64_t mix64(uint64_t h, uint64_t v) {
+    h ^= v + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+    h ^= h >> 31;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    return h ^ (h >> 29);
+}
+
+// get_state_hash(): phases, magnitudes and coupling quantized to `bins`
+static uint64_t osc_state_hash(const osc_t *o, int precision) {
+    long bins = 1L << precision;
+    uint64_t h = 0;
+    for (int b = 0; b < FE_BANDS; b++) {
+        for (int n = 0; n < FE_PER_BAND; n++) {
+            long q = (long)(o->phase[b][n] * bins / TWO_PI) % bins;
+            h = mix64(h, (uint64_t)(q < 0 ? q + bins : q));
+        }
+    }
+    for (int b = 0; b < FE_BANDS; b++) {
+        for (int n = 0; n < FE_PER_BAND; n++) {
+            long q = (long)(o->mag[b][n] * bins);
+            h = mix64(h, (uint64_t)(q < 0 ? 0 : q > bins - 1 ? bins - 1 : q));
+        }
+    }
+    return mix64(h, (uint64_t)(long)(o->coupling * bins));
+}
+
+static void f1_job(int run, void *arg) {
+    f1_ctx_t *c = arg;
+    uint64_t *out = c->hashes + (size_t)run * c->steps;
+    osc_t o;
+    osc_init(&o, c->phases);
+    for (int s = 0; s < c->steps; s++) {
+        out[s] = osc_state_hash(&o, c->precision);
+        osc_step(&o, c->inputs[run], true, NAN);
+    }
+}
+
+static int cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+int fe_f1_reducibility(const double *phases, const double *inputs, int num_inputs,
+                       int steps_per_input, int precision_bits, int threads,
+                       uint64_t *unique_states, uint64_t *transitions) {
+    if (!phases || !inputs || num_inputs < 1 || steps_per_input < 0 ||
+        precision_bits < 1 || precision_bits > 30 || !unique_states || !transitions) {
+        return -1;
+    }
+    size_t total = (size_t)num_inputs * steps_per_input;
+    f1_ctx_t c = {
+        .phases = phases, .inputs = inputs, .steps = steps_per_input, .precision = precision_bits,
+        .hashes = malloc((total ? total : 1) * sizeof(uint64_t)),
+    };
+    if (!c.hashes) return -1;
+    run_jobs(num_inputs, threads, f1_job, &c);
+
+    qsort(c.hashes, total, sizeof(uint64_t), cmp_u64);
+    uint64_t unique = 0;
+    for (size_t i = 0; i < total; i++) {
+        if (i == 0 || c.hashes[i] != c.hashes[i - 1]) unique++;
+    }
+    free(c.hashes);
+    // Every visited state is recorded with its first successor
+    *unique_states = unique;
+    *transitions = unique;
+    return 0;
+}
+
+// ============================================================
+// F2: separability
+// ============================================================
+
+typedef struct {
+    const double *phases;
+    int steps;
+    double *coherence_diff, *coupling_diff;
+} f2_ctx_t;
+
+static void f2_job(int trial, void *arg) {
+    f2_ctx_t *c = arg;
+    const double *p = c->phases + (size_t)trial * FE_OSCILLATORS;
+    double *dc = malloc(2 * c->steps * sizeof(double)), *dk = dc + c->steps;
+    if (!dc) {
+        c->coherence_diff[trial] = c->coupling_diff[trial] = NAN;
+        return;
+    }
+    osc_t coupled, separated;
+    osc_init(&coupled, p);
+    osc_init(&separated, p);
+    double prev_coherence = osc_coherence(&separated);
+
+    for (int s = 0; s < c->steps; s++) {
+        double input = 0.3 * sin(s * 0.1);
+        osc_step(&coupled, input, true, NAN);
+
+        // Feedback from the previous step's coherence
+        osc_step(&separated, input, false, NAN);
+        if (prev_coherence > COHERENCE_HIGH) {
+            separated.coupling *= COUPLING_DECAY;
+        } else if (prev_coherence < COHERENCE_LOW) {
+            separated.coupling *= COUPLING_GROWTH;
+        }
+        separated.coupling = np_clip(separated.coupling, COUPLING_MIN, COUPLING_MAX);
+
+        double coherence = osc_coherence(&separated);
+        dc[s] = fabs(osc_coherence(&coupled) - coherence);
+        dk[s] = fabs(coupled.coupling - separated.coupling);
+        prev_coherence = coherence;
+    }
+    c->coherence_diff[trial] = np_mean(dc, c->steps);
+    c->coupling_diff[trial] = np_mean(dk, c->steps);
+    free(dc);
+}
+
+int fe_f2_separability(const double *phases, int num_trials, int num_steps, int threads,
+                       double *coherence_diff, double *coupling_diff) {
+    if (!phases || num_trials < 1 || num_steps < 1 || !coherence_diff || !coupling_diff) return -1;
+    f2_ctx_t c = {
+        .phases = phases, .steps = num_steps,
+        .coherence_diff = coherence_diff, .coupling_diff = coupling_diff,
+    };
+    run_jobs(num_trials, threads, f2_job, &c);
+    return 0;
+}
+
+// ============================================================
+// F3 v2: phase causality
+// ============================================================
+
+typedef struct {
+    const double *phases_a, *phases_b;
+    int steps;
+    double *final_divergence, *correlation;
+} f3_ctx_t;
+
+// np.corrcoef(a, b)[0, 1]
+static double pearson(const double *a, const double *b, long n) {
+    double ma = np_mean(a, n), mb = np_mean(b, n), saa = 0, sbb = 0, sab = 0;
+    for (long i = 0; i < n; i++) {
+        double da = a[i] - ma, db = b[i] - mb;
+        saa += da * da;
+        sbb += db * db;
+        sab += da * db;
+    }
+    double r = sab / sqrt(saa) / sqrt(sbb);
+    return isnan(r) ? r : np_clip(r, -1.0, 1.0);
+}
+
+static void f3_job(int trial, void *arg) {
+    f3_ctx_t *c = arg;
+    double *ka = malloc(2 * c->steps * sizeof(double)), *kb = ka + c->steps;
+    if (!ka) {
+        c->final_divergence[trial] = c->correlation[trial] = NAN;
+        return;
+    }
+    osc_t a, b;
+    osc_init(&a, c->phases_a + (size_t)trial * FE_OSCILLATORS);
+    osc_init(&b, c->phases_b + (size_t)trial * FE_OSCILLATORS);
+
+    for (int s = 0; s < c->steps; s++) {
+        double input = 0.3 * sin(s * 0.1) + 0.3;
+        osc_step(&a, input, true, NAN);
+        osc_step(&b, input, true, NAN);
+        ka[s] = a.coupling;
+        kb[s] = b.coupling;
+    }
+    c->final_divergence[trial] = fabs(ka[c->steps - 1] - kb[c->steps - 1]);
+    c->correlation[trial] = pearson(ka, kb, c->steps);
+    free(ka);
+}
+
+int fe_f3_causality(const double *phases_a, const double *phases_b, int num_trials,
+                    int num_steps, int threads, double *final_divergence, double *correlation) {
+    if (!phases_a || !phases_b || num_trials < 1 || num_steps < 1 ||
+        !final_divergence || !correlation) {
+        return -1;
+    }
+    f3_ctx_t c = {
+        .phases_a = phases_a, .phases_b = phases_b, .steps = num_steps,
+        .final_divergence = final_divergence, .correlation = correlation,
+    };
+    run_jobs(num_trials, threads, f3_job, &c);
+    return 0;
+}
+
+// ============================================================
+// F3: constant K
+// ============================================================
+
+typedef struct {
+    const double *phases, *k_values;
+    int steps;
+    double *final_coherence, *stability, *final_coupling;
+} f3k_ctx_t;
+
+static void f3k_job(int run, void *arg) {
+    f3k_ctx_t *c = arg;
+    double *coherence = malloc(c->steps * sizeof(double)), k = c->k_values[run];
+    if (!coherence) {
+        c->final_coherence[run] = c->stability[run] = c->final_coupling[run] = NAN;
+        return;
+    }
+    osc_t o;
+    osc_init(&o, c->phases);
+    for (int s = 0; s < c->steps; s++) {
+        osc_step(&o, 0.3 * sin(s * 0.1), isnan(k), k);
+        coherence[s] = osc_coherence(&o);
+    }
+    int window = c->steps < SCORE_WINDOW ? c->steps : SCORE_WINDOW;
+    const double *tail = coherence + c->steps - window;
+    c->final_coherence[run] = np_mean(tail, window);
+    c->stability[run] = 1.0 / (np_std(tail, window) + 0.01);
+    c->final_coupling[run] = o.coupling;
+    free(coherence);
+}
+
+int fe_f3_constant_k(const double *phases, const double *k_values, int num_runs, int num_steps,
+                     int threads, double *final_coherence, double *stability,
+                     double *final_coupling) {
+    if (!phases || !k_values || num_runs < 1 || num_steps < 1 ||
+        !final_coherence || !stability || !final_coupling) {
+        return -1;
+    }
+    f3k_ctx_t c = {
+        .phases = phases, .k_values = k_values, .steps = num_steps,
+        .final_coherence = final_coherence, .stability = stability, .final_coupling = final_coupling,
+    };
+    run_jobs(num_runs, threads, f3k_job, &c);
+    return 0;
+}
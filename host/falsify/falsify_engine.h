@@ -0,0 +1,60 @@
+/**
+ * falsify_engine.h - Native engine for tests/falsify_etm.py
+ *
+ * The float SpectralOscillator model of the falsification suite, stepped
+ * in C, with the trial loops of F1-F3 spread over threads. The caller
+ * passes the initial phases (16 per oscillator, band-major) from NumPy's
+ * seeded generator, so both engines start from the same state.
+ *
+ * Called through ctypes. Each entry point returns 0, or -1 on bad
+ * arguments or when out of memory. threads <= 0 means one per online CPU.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define FE_BANDS            4
+#define FE_PER_BAND         4
+#define FE_OSCILLATORS      (FE_BANDS * FE_PER_BAND)
+
+/**
+ * How the NumPy being matched takes |z| of a complex: 0 = libm hypot(),
+ * 1 = its SIMD loop, max * sqrt(fma(q, q, 1)) with q = min / max. The
+ * Python side probes NumPy once and sets this before any run.
+ */
+void fe_set_numpy_cabs(int scaled);
+
+/**
+ * F1: from phases, run steps_per_input steps for each input energy (one
+ * run per thread) and count the distinct quantized states visited. States
+ * are compared by a 64-bit hash of the quantized tuple.
+ */
+int fe_f1_reducibility(const double *phases, const double *inputs, int num_inputs,
+                       int steps_per_input, int precision_bits, int threads,
+                       uint64_t *unique_states, uint64_t *transitions);
+
+/**
+ * F2: per trial, coupled vs delayed-feedback trajectories from the same
+ * phases; mean |coherence| and |coupling| differences over the steps.
+ */
+int fe_f2_separability(const double *phases, int num_trials, int num_steps, int threads,
+                       double *coherence_diff, double *coupling_diff);
+
+/**
+ * F3 v2: per trial, two systems (phases_a, phases_b) on the same input;
+ * final |coupling| divergence and the Pearson correlation of the coupling
+ * trajectories (NaN when one is constant, as np.corrcoef).
+ */
+int fe_f3_causality(const double *phases_a, const double *phases_b, int num_trials,
+                    int num_steps, int threads, double *final_divergence, double *correlation);
+
+/**
+ * F3 (constant K): one run per entry of k_values from the same phases; a
+ * NaN entry runs with coherence feedback instead. Reports the mean and
+ * stability, 1 / (std + 0.01), of the coherence over the last 100 steps
+ * and the final coupling.
+ */
+int fe_f3_constant_k(const double *phases, const double *k_values, int num_runs, int num_steps,
+                     int threads, double *final_coherence, double *stability,
+                     double *final_coupling);
@@ -0,0 +1,420 @@
+/**
+ * feedback_sweep.c - Claim 6 ablation over a grid of feedback parameters
+ *
+ * Demo 03's ablation (test_coherence_feedback_ablation) runs once, with the
+ * compile-time COHERENCE_*_THRESHOLD, COUPLING_DECAY / COUPLING_GROWTH and
+ * an initial coupling of 0.5. This tool runs the same spectral_trace() /
+ * spectral_ablation_score() for every point of a grid over those five
+ * parameters and reports each point's statistics and verdict:
+ *
+ *   - The control run (no feedback) depends only on the initial coupling,
+ *     so it is computed once per coupling value and shared.
+ *   - Points run in parallel on job_pool, one job each, in blocks of
+ *     SWEEP_BLOCK. Each finished block is written out in grid order, so
+ *     memory stays flat however large the grid.
+ *   - --csv writes one row per point. --columns DIR writes one .npy file
+ *     per column (np.load(..., mmap_mode="r") reads them in place).
+ *
+ * An axis is a value, a list "a,b,c" or "lo:hi:n" (n points, both ends
+ * included). Coupling varies slowest, growth fastest.
+ *
+ *   feedback_sweep [--coupling AXIS] [--high AXIS] [--low AXIS] [--decay AXIS]
+ *                  [--growth AXIS] [--steps N] [--input a,b,c,d] [--threads T]
+ *                  [--csv FILE|-] [--columns DIR]
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include "spectral_net.h"
+#include "job_pool.h"
+
+#define SWEEP_BLOCK     4096    // Points per parallel batch
+#define MAX_AXIS        4096    // Values per axis
+
+enum { AX_COUPLING, AX_HIGH, AX_LOW, AX_DECAY, AX_GROWTH, NUM_AXES };
+enum { VERDICT_FALSIFIED, VERDICT_PARTIAL, VERDICT_VERIFIED };
+
+static const char *AXIS_NAMES[NUM_AXES] = { "coupling", "high", "low", "decay", "growth" };
+static const char *VERDICT_NAMES[3] = { "FALSIFIED", "PARTIAL", "VERIFIED" };
+
+typedef struct {
+    double *values;
+    int count;
+} axis_t;
+
+// One output row; every field is 4 bytes so each column is a flat array
+typedef struct {
+    int32_t point;
+    float coupling;
+    int32_t high;
+    int32_t low;
+    float decay;
+    float growth;
+    float final_no_fb;          // Avg coupling after the run, without feedback
+    float final_fb;             // ... with feedback
+    float change_fb;
+    float variance_no_fb;
+    float variance_fb;
+    int32_t coherence_no_fb;    // Coherence at the last step
+    int32_t coherence_fb;
+    int32_t coupling_changed;
+    int32_t feedback_different;
+    int32_t verdict;
+} row_t;
+
+typedef enum { COL_I32, COL_F32 } col_type_t;
+
+typedef struct {
+    const char *name;
+    col_type_t type;
+    size_t offset;
+} column_t;
+
+#define COL(field, type) { #field, type, offsetof(row_t, field) }
+
+static const column_t COLUMNS[] = {
+    COL(point, COL_I32),          COL(coupling, COL_F32),
+    COL(high, COL_I32),           COL(low, COL_I32),
+    COL(decay, COL_F32),          COL(growth, COL_F32),
+    COL(final_no_fb, COL_F32),    COL(final_fb, COL_F32),
+    COL(change_fb, COL_F32),      COL(variance_no_fb, COL_F32),
+    COL(variance_fb, COL_F32),    COL(coherence_no_fb, COL_I32),
+    COL(coherence_fb, COL_I32),   COL(coupling_changed, COL_I32),
+    COL(feedback_different, COL_I32), COL(verdict, COL_I32),
+};
+#define NUM_COLUMNS     (int)(sizeof(COLUMNS) / sizeof(COLUMNS[0]))
+
+typedef struct {
+    axis_t axis[NUM_AXES];
+    uint8_t input[INPUT_DIM];
+    int steps;
+    spectral_trace_t *controls;     // One per coupling value
+    int64_t block_start;
+    row_t *rows;                    // The current block
+} sweep_t;
+
+// ============================================================
+// Grid
+// ============================================================
+
+static bool parse_axis(const char *spec, axis_t *axis) {
+    double lo, hi;
+    int n;
+    char tail;
+    if (sscanf(spec, "%lf:%lf:%d%c", &lo, &hi, &n, &tail) == 3) {
+        if (n < 1 || n > MAX_AXIS) return false;
+        axis->count = n;
+        for (int i = 0; i < n; i++) {
+            axis->values[i] = n == 1 ? lo : lo + (hi - lo) * i / (n - 1);
+        }
+        return true;
+    }
+    axis->count = 0;
+    for (const char *p = spec; *p;) {
+        char *end;
+        double v = strtod(p, &end);
+        if (end == p || axis->count == MAX_AXIS) return false;
+        axis->values[axis->count++] = v;
+        if (*end == ',') end++;
+        else if (*end) return false;
+        p = end;
+    }
+    return axis->count > 0;
+}
+
+static int64_t grid_size(const sweep_t *s) {
+    int64_t n = 1;
+    for (int a = 0; a < NUM_AXES; a++) n *= s->axis[a].count;
+    return n;
+}
+
+// Mixed-radix digits of `point`, growth fastest
+static void grid_point(const sweep_t *s, int64_t point, int idx[NUM_AXES]) {
+    for (int a = NUM_AXES - 1; a >= 0; a--) {
+        idx[a] = (int)(point % s->axis[a].count);
+        point /= s->axis[a].count;
+    }
+}
+
+// ============================================================
+// Jobs
+// ============================================================
+
+static void control_job(int i, void *ctx) {
+    sweep_t *s = ctx;
+    spectral_trace(&s->controls[i], (float)s->axis[AX_COUPLING].values[i], NULL,
+                   s->input, s->steps);
+}
+
+static void point_job(int i, void *ctx) {
+    sweep_t *s = ctx;
+    int64_t point = s->block_start + i;
+    int idx[NUM_AXES];
+    grid_point(s, point, idx);
+
+    row_t *r = &s->rows[i];
+    r->point = (int32_t)point;
+    r->coupling = (float)s->axis[AX_COUPLING].values[idx[AX_COUPLING]];
+    r->high = (int32_t)s->axis[AX_HIGH].values[idx[AX_HIGH]];
+    r->low = (int32_t)s->axis[AX_LOW].values[idx[AX_LOW]];
+    r->decay = (float)s->axis[AX_DECAY].values[idx[AX_DECAY]];
+    r->growth = (float)s->axis[AX_GROWTH].values[idx[AX_GROWTH]];
+
+    spectral_feedback_t fb = SPECTRAL_FEEDBACK;
+    fb.high_threshold = r->high;
+    fb.low_threshold = r->low;
+    fb.decay = r->decay;
+    fb.growth = r->growth;
+
+    spectral_ablation_t a;
+    a.run[0] = s->controls[idx[AX_COUPLING]];
+    spectral_trace(&a.run[1], r->coupling, &fb, s->input, s->steps);
+    spectral_ablation_score(&a);
+
+    const int last = ABLATION_SAMPLES - 1;
+    r->final_no_fb = a.run[0].coupling[last];
+    r->final_fb = a.run[1].coupling[last];
+    r->change_fb = a.change[1];
+    r->variance_no_fb = a.variance[0];
+    r->variance_fb = a.variance[1];
+    r->coherence_no_fb = a.run[0].coherence[last];
+    r->coherence_fb = a.run[1].coherence[last];
+    r->coupling_changed = a.coupling_changed;
+    r->feedback_different = a.feedback_different;
+    r->verdict = a.coupling_changed && a.feedback_different ? VERDICT_VERIFIED
+               : a.coupling_changed ? VERDICT_PARTIAL : VERDICT_FALSIFIED;
+}
+
+// ============================================================
+// Output
+// ============================================================
+
+static void csv_header(FILE *f) {
+    for (int c = 0; c < NUM_COLUMNS; c++) fprintf(f, "%s%s", c ? "," : "", COLUMNS[c].name);
+    fprintf(f, "\n");
+}
+
+static void csv_rows(FILE *f, const row_t *rows, int n) {
+    for (int i = 0; i < n; i++) {
+        const char *base = (const char *)&rows[i];
+        for (int c = 0; c < NUM_COLUMNS; c++) {
+            const void *v = base + COLUMNS[c].offset;
+            if (c) fputc(',', f);
+            if (COLUMNS[c].type == COL_I32) fprintf(f, "%d", *(const int32_t *)v);
+            else fprintf(f, "%.9g", *(const float *)v);
+        }
+        fputc('\n', f);
+    }
+}
+
+// .npy version 1.0: magic, header length, dict padded to 64 bytes
+static bool npy_header(FILE *f, col_type_t type, int64_t count) {
+    char dict[128];
+    int len = snprintf(dict, sizeof(dict),
+                       "{'descr': '%s', 'fortran_order': False, 'shape': (%lld,), }",
+                       type == COL_I32 ? "<i4" : "<f4", (long long)count);
+    int padded = (10 + len + 1 + 63) / 64 * 64 - 10;
+    uint8_t head[10] = { 0x93, 'N', 'U', 'M', 'P', 'Y', 1, 0,
+                         (uint8_t)(padded & 0xff), (uint8_t)(padded >> 8) };
+    fwrite(head, 1, sizeof(head), f);
+    fprintf(f, "%s%*s\n", dict, padded - len - 1, "");
+    return !ferror(f);
+}
+
+static void npy_rows(FILE *const *files, const row_t *rows, int n) {
+    for (int c = 0; c < NUM_COLUMNS; c++) {
+        for (int i = 0; i < n; i++) {
+            fwrite((const char *)&rows[i] + COLUMNS[c].offset, 4, 1, files[c]);
+        }
+    }
+}
+
+// ============================================================
+// Main
+// ============================================================
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "usage: %s [--coupling AXIS] [--high AXIS] [--low AXIS] [--decay AXIS]\n"
+            "          [--growth AXIS] [--steps N] [--input a,b,c,d] [--threads T]\n"
+            "          [--csv FILE|-] [--columns DIR]\n"
+            "  AXIS: v | a,b,c | lo:hi:n\n", prog);
+}
+
+static double wall_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv) {
+    static double values[NUM_AXES][MAX_AXIS];
+    const char *specs[NUM_AXES] = {
+        "0.1:0.9:3", "8000:32000:4", "0:12000:4", "0.99:1:3", "1:1.01:3",
+    };
+    int threads = 0;
+    const char *csv = NULL, *columns = NULL;
+    sweep_t s = { .input = {8, 8, 8, 8}, .steps = ABLATION_STEPS };
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i], *val = i + 1 < argc ? argv[i + 1] : NULL;
+        if (!val || strncmp(arg, "--", 2)) { usage(argv[0]); return 1; }
+        i++;
+        int a;
+        for (a = 0; a < NUM_AXES && strcmp(arg + 2, AXIS_NAMES[a]); a++) {}
+        if (a < NUM_AXES) specs[a] = val;
+        else if (!strcmp(arg, "--steps")) s.steps = atoi(val);
+        else if (!strcmp(arg, "--threads")) threads = atoi(val);
+        else if (!strcmp(arg, "--csv")) csv = val;
+        else if (!strcmp(arg, "--columns")) columns = val;
+        else if (!strcmp(arg, "--input")) {
+            int v[INPUT_DIM];
+            if (sscanf(val, "%d,%d,%d,%d", &v[0], &v[1], &v[2], &v[3]) != INPUT_DIM) {
+                usage(argv[0]);
+                return 1;
+            }
+            for (int k = 0; k < INPUT_DIM; k++) s.input[k] = (uint8_t)v[k];
+        } else { usage(argv[0]); return 1; }
+    }
+    for (int a = 0; a < NUM_AXES; a++) {
+        s.axis[a].values = values[a];
+        if (!parse_axis(specs[a], &s.axis[a])) {
+            fprintf(stderr, "bad --%s axis: %s\n", AXIS_NAMES[a], specs[a]);
+            return 1;
+        }
+    }
+    if (s.steps < 10 || s.steps % 10) {
+        fprintf(stderr, "--steps must be a positive multiple of 10\n");
+        return 1;
+    }
+    int64_t num_points = grid_size(&s);
+    if (num_points > INT32_MAX) {
+        fprintf(stderr, "grid of %lld points is too large\n", (long long)num_points);
+        return 1;
+    }
+
+    FILE *csv_file = NULL, *col_files[NUM_COLUMNS] = { 0 };
+    if (csv) {
+        csv_file = strcmp(csv, "-") ? fopen(csv, "w") : stdout;
+        if (!csv_file) {
+            fprintf(stderr, "cannot write %s\n", csv);
+            return 1;
+        }
+        csv_header(csv_file);
+    }
+    if (columns) {
+        mkdir(columns, 0777);
+        for (int c = 0; c < NUM_COLUMNS; c++) {
+            char path[1024];
+            snprintf(path, sizeof(path), "%s/%s.npy", columns, COLUMNS[c].name);
+            col_files[c] = fopen(path, "wb");
+            if (!col_files[c] || !npy_header(col_files[c], COLUMNS[c].type, num_points)) {
+                fprintf(stderr, "cannot write %s\n", path);
+                return 1;
+            }
+        }
+    }
+
+    spectral_init_tables();
+    s.controls = calloc(s.axis[AX_COUPLING].count, sizeof(spectral_trace_t));
+    s.rows = calloc(SWEEP_BLOCK, sizeof(row_t));
+    if (!s.controls || !s.rows) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    // The report goes to stderr when the CSV takes stdout
+    FILE *out = csv_file == stdout ? stderr : stdout;
+    fprintf(out, "\n");
+    fprintf(out, "======================================================================\n");
+    fprintf(out, "  CLAIM 6 ABLATION SWEEP: Coherence Feedback Parameters\n");
+    fprintf(out, "======================================================================\n");
+    fprintf(out, "\n");
+    fprintf(out, "  Input {%d,%d,%d,%d}, %d steps per run, %lld points:\n",
+            s.input[0], s.input[1], s.input[2], s.input[3], s.steps, (long long)num_points);
+    for (int a = 0; a < NUM_AXES; a++) {
+        const axis_t *ax = &s.axis[a];
+        if (ax->count == 1) fprintf(out, "    %-8s  %g\n", AXIS_NAMES[a], ax->values[0]);
+        else fprintf(out, "    %-8s  %d values, %g .. %g\n", AXIS_NAMES[a], ax->count,
+                     ax->values[0], ax->values[ax->count - 1]);
+    }
+
+    double t0 = wall_s();
+    run_jobs(s.axis[AX_COUPLING].count, threads, control_job, &s);
+
+    int64_t verdicts[3] = { 0 };
+    int64_t *verified[NUM_AXES];
+    for (int a = 0; a < NUM_AXES; a++) verified[a] = calloc(s.axis[a].count, sizeof(int64_t));
+    float final_min = 1e30f, final_max = -1e30f;
+
+    for (s.block_start = 0; s.block_start < num_points; s.block_start += SWEEP_BLOCK) {
+        int n = (int)(num_points - s.block_start < SWEEP_BLOCK
+                      ? num_points - s.block_start : SWEEP_BLOCK);
+        run_jobs(n, threads, point_job, &s);
+
+        for (int i = 0; i < n; i++) {
+            const row_t *r = &s.rows[i];
+            verdicts[r->verdict]++;
+            if (r->final_fb < final_min) final_min = r->final_fb;
+            if (r->final_fb > final_max) final_max = r->final_fb;
+            if (r->verdict == VERDICT_VERIFIED) {
+                int idx[NUM_AXES];
+                grid_point(&s, r->point, idx);
+                for (int a = 0; a < NUM_AXES; a++) verified[a][idx[a]]++;
+            }
+        }
+        if (csv_file) csv_rows(csv_file, s.rows, n);
+        if (columns) npy_rows(col_files, s.rows, n);
+    }
+    double elapsed = wall_s() - t0;
+
+    bool write_ok = true;
+    if (csv_file && csv_file != stdout) write_ok &= fclose(csv_file) == 0;
+    for (int c = 0; c < NUM_COLUMNS; c++) {
+        if (col_files[c]) write_ok &= fclose(col_files[c]) == 0;
+    }
+
+    fprintf(out, "\n");
+    fprintf(out, "  Verdict    | Points    | Share\n");
+    fprintf(out, "  -----------+-----------+-------\n");
+    for (int v = VERDICT_VERIFIED; v >= VERDICT_FALSIFIED; v--) {
+        fprintf(out, "  %-10s | %9lld | %4.0f%%\n", VERDICT_NAMES[v], (long long)verdicts[v],
+                100.0 * verdicts[v] / num_points);
+    }
+
+    // Share of VERIFIED along each axis that varies and is short enough to list
+    for (int a = 0; a < NUM_AXES; a++) {
+        const axis_t *ax = &s.axis[a];
+        if (ax->count < 2 || ax->count > 16) continue;
+        int64_t per_value = num_points / ax->count;
+        fprintf(out, "\n  %-8s |", AXIS_NAMES[a]);
+        for (int i = 0; i < ax->count; i++) fprintf(out, " %7.6g", ax->values[i]);
+        fprintf(out, "\n  verified |");
+        for (int i = 0; i < ax->count; i++) {
+            fprintf(out, " %6.0f%%", 100.0 * verified[a][i] / per_value);
+        }
+        fprintf(out, "\n");
+    }
+
+    fprintf(out, "\n");
+    fprintf(out, "  Final coupling with feedback: %.4f .. %.4f\n", final_min, final_max);
+    fprintf(out, "  Runs: %lld in %.2f s (%.0f points/s, %.2f M steps/s)\n",
+            (long long)(num_points + s.axis[AX_COUPLING].count), elapsed,
+            num_points / elapsed,
+            (double)(num_points + s.axis[AX_COUPLING].count) * s.steps / elapsed / 1e6);
+    fprintf(out, "\n");
+
+    for (int a = 0; a < NUM_AXES; a++) free(verified[a]);
+    free(s.controls);
+    free(s.rows);
+    if (!write_ok) {
+        fprintf(stderr, "error writing results\n");
+        return 1;
+    }
+    return 0;
+}
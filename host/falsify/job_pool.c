@@ -0,0 +1,39 @@
+/**
+ * job_pool.c - Indexed jobs spread over a few pthreads
+ *
+ * See job_pool.h.
+ */
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include "job_pool.h"
+
+typedef struct {
+    void (*job)(int index, void *ctx);
+    void *ctx;
+    int num_jobs;
+    atomic_int next;
+} pool_t;
+
+static void *pool_worker(void *arg) {
+    pool_t *p = arg;
+    for (int i; (i = atomic_fetch_add(&p->next, 1)) < p->num_jobs;) p->job(i, p->ctx);
+    return NULL;
+}
+
+void run_jobs(int num_jobs, int threads, void (*job)(int, void *), void *ctx) {
+    if (threads <= 0) threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads > num_jobs) threads = num_jobs;
+    if (threads < 1) threads = 1;
+
+    pool_t p = { .job = job, .ctx = ctx, .num_jobs = num_jobs };
+    atomic_init(&p.next, 0);
+    pthread_t tid[threads];
+    int started = 0;
+    for (int t = 1; t < threads; t++) {
+        if (pthread_create(&tid[started], NULL, pool_worker, &p) == 0) started++;
+    }
+    pool_worker(&p);
+    for (int t = 0; t < started; t++) pthread_join(tid[t], NULL);
+}
@@ -0,0 +1,12 @@
+/**
+ * job_pool.h - Indexed jobs spread over a few pthreads
+ *
+ * run_jobs() calls job(i, ctx) once for every i in [0, num_jobs) and
+ * returns when all have finished. Jobs are handed out one at a time, so
+ * uneven jobs balance themselves; the calling thread works too.
+ * threads <= 0 means one per online CPU.
+ */
+
+#pragma once
+
+void run_jobs(int num_jobs, int threads, void (*job)(int index, void *ctx), void *ctx);
@@ -0,0 +1,334 @@
+/**
+ * q15_cycles.c - Exact cycles and attractors of the demo 03 Q15 network
+ *
+ * Under a constant input the firmware network (spectral_net.c) is a map on
+ * a finite state: oscillators, phase velocities and coupling. Every orbit
+ * therefore ends in a cycle. falsify_etm.py's get_state_hash() estimates
+ * that by quantizing a float model; this tool steps the firmware code
+ * itself and finds each orbit's cycle exactly:
+ *
+ *   - Brent's algorithm on the raw state bytes (no hashing, no collisions)
+ *     gives the period lambda; a second pass with the hare lambda steps
+ *     ahead gives the transient mu. Two network snapshots per thread, so
+ *     memory stays flat for runs of 10^9 steps and more.
+ *   - Each cycle is named by the smallest 64-bit hash of its states, the
+ *     same from whichever state the orbit entered it. Seeds that share a
+ *     name share an attractor; their count is its basin.
+ *
+ * The map is fixed by the input masks of the demo's network (SPECTRAL_SEED),
+ * the input vector, the initial coupling and the feedback switch. Seeds
+ * only choose the 16 initial phases (seed 0 keeps the demo's own). Seeds
+ * run in parallel, one job each.
+ *
+ *   q15_cycles [--seeds N] [--first-seed S] [--input a,b,c,d] [--coupling K]
+ *              [--feedback] [--max-steps N] [--threads T] [--top N] [--csv FILE]
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "spectral_net.h"
+#include "job_pool.h"
+
+typedef enum { ORBIT_CYCLE, ORBIT_UNDECIDED } orbit_status_t;
+
+typedef struct {
+    uint32_t seed;
+    orbit_status_t status;
+    uint64_t transient;     // mu: steps before the orbit enters its cycle
+    uint64_t period;        // lambda
+    uint64_t attractor;     // smallest state hash on the cycle
+    uint64_t steps;         // map evaluations spent on this seed
+} orbit_t;
+
+typedef struct {
+    spectral_network_t base;
+    uint8_t input[INPUT_DIM];
+    bool feedback;
+    uint64_t max_steps;
+    uint32_t first_seed;
+    orbit_t *orbits;
+} search_t;
+
+// ============================================================
+// The map
+// ============================================================
+
+static inline void step(const search_t *s, spectral_network_t *net) {
+    if (s->feedback) spectral_step_feedback(net, s->input);
+    else spectral_step(net, s->input);
+}
+
+static inline bool same_state(const spectral_network_t *a, const spectral_network_t *b) {
+    return memcmp(a, b, SPECTRAL_STATE_BYTES) == 0;
+}
+
+static inline uint64_t mix64(uint64_t h, uint64_t v) {
+    h ^= v + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+    h ^= h >> 31;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    return h ^ (h >> 29);
+}
+
+static uint64_t state_hash(const spectral_network_t *net) {
+    const uint8_t *p = (const uint8_t *)net;
+    uint64_t h = 0;
+    for (size_t i = 0; i < SPECTRAL_STATE_BYTES; i += 8) {
+        uint64_t w = 0;
+        memcpy(&w, p + i, SPECTRAL_STATE_BYTES - i < 8 ? SPECTRAL_STATE_BYTES - i : 8);
+        h = mix64(h, w);
+    }
+    return h;
+}
+
+// The demo's LCG, restarted per seed for the initial phases only
+static void start_state(const search_t *s, uint32_t seed, spectral_network_t *net) {
+    *net = s->base;
+    if (seed == 0) return;
+    net_rng_t rng = net_rng_lcg(seed);
+    for (int b = 0; b < NUM_BANDS; b++) {
+        for (int n = 0; n < NEURONS_PER_BAND; n++) {
+            spectral_set_phase(net, b, n, net_rng_next(&rng) & 0xFF);
+        }
+    }
+}
+
+// ============================================================
+// Brent's cycle detection
+// ============================================================
+
+static void find_cycle(const search_t *s, uint32_t seed, orbit_t *o) {
+    spectral_network_t tortoise, hare;
+    memset(o, 0, sizeof(*o));
+    o->seed = seed;
+
+    // Period: the tortoise waits at powers of two for the hare to come round
+    start_state(s, seed, &tortoise);
+    hare = tortoise;
+    step(s, &hare);
+    uint64_t power = 1, lambda = 1, steps = 1;
+    while (!same_state(&tortoise, &hare)) {
+        if (steps >= s->max_steps) {
+            o->status = ORBIT_UNDECIDED;
+            o->steps = steps;
+            return;
+        }
+        if (power == lambda) {
+            tortoise = hare;
+            power <<= 1;
+            lambda = 0;
+        }
+        step(s, &hare);
+        lambda++;
+        steps++;
+    }
+
+    // Transient: restart with the hare lambda ahead; they meet at the cycle
+    start_state(s, seed, &tortoise);
+    hare = tortoise;
+    for (uint64_t i = 0; i < lambda; i++) step(s, &hare);
+    uint64_t mu = 0;
+    while (!same_state(&tortoise, &hare)) {
+        step(s, &tortoise);
+        step(s, &hare);
+        mu++;
+    }
+
+    // Name the cycle by its smallest state hash
+    uint64_t name = state_hash(&hare);
+    for (uint64_t i = 1; i < lambda; i++) {
+        step(s, &hare);
+        uint64_t h = state_hash(&hare);
+        if (h < name) name = h;
+    }
+
+    o->status = ORBIT_CYCLE;
+    o->transient = mu;
+    o->period = lambda;
+    o->attractor = name;
+    o->steps = steps + lambda + 2 * mu + (lambda - 1);
+}
+
+static void seed_job(int i, void *ctx) {
+    search_t *s = ctx;
+    find_cycle(s, s->first_seed + (uint32_t)i, &s->orbits[i]);
+}
+
+// ============================================================
+// Basin statistics
+// ============================================================
+
+typedef struct {
+    uint64_t attractor, period;
+    uint64_t transient_min, transient_max, transient_sum;
+    uint32_t first_seed;
+    int basin;
+} basin_t;
+
+static int cmp_orbit(const void *a, const void *b) {
+    const orbit_t *x = a, *y = b;
+    if (x->status != y->status) return x->status < y->status ? -1 : 1;
+    if (x->attractor != y->attractor) return x->attractor < y->attractor ? -1 : 1;
+    return x->seed < y->seed ? -1 : x->seed > y->seed;
+}
+
+static int cmp_basin(const void *a, const void *b) {
+    const basin_t *x = a, *y = b;
+    if (x->basin != y->basin) return x->basin > y->basin ? -1 : 1;
+    return x->first_seed < y->first_seed ? -1 : x->first_seed > y->first_seed;
+}
+
+// Orbits sorted by cmp_orbit in, one entry per attractor out
+static int collect_basins(const orbit_t *orbits, int n, basin_t *basins) {
+    int count = 0;
+    for (int i = 0; i < n && orbits[i].status == ORBIT_CYCLE; i++) {
+        const orbit_t *o = &orbits[i];
+        if (count == 0 || basins[count - 1].attractor != o->attractor) {
+            basins[count++] = (basin_t){ .attractor = o->attractor, .period = o->period,
+                                         .transient_min = o->transient, .first_seed = o->seed };
+        }
+        basin_t *b = &basins[count - 1];
+        if (o->transient < b->transient_min) b->transient_min = o->transient;
+        if (o->transient > b->transient_max) b->transient_max = o->transient;
+        b->transient_sum += o->transient;
+        b->basin++;
+    }
+    qsort(basins, count, sizeof(basin_t), cmp_basin);
+    return count;
+}
+
+// ============================================================
+// Main
+// ============================================================
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "usage: %s [--seeds N] [--first-seed S] [--input a,b,c,d] [--coupling K]\n"
+            "          [--feedback] [--max-steps N] [--threads T] [--top N] [--csv FILE]\n", prog);
+}
+
+static double wall_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv) {
+    int num_seeds = 64, threads = 0, top = 10;
+    uint32_t first_seed = 1;
+    float coupling = 0.5f;
+    const char *csv = NULL;
+    search_t s = { .input = {8, 8, 8, 8}, .max_steps = 100000000ULL };
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i], *val = i + 1 < argc ? argv[i + 1] : NULL;
+        if (!strcmp(arg, "--feedback")) { s.feedback = true; continue; }
+        if (!val) { usage(argv[0]); return 1; }
+        i++;
+        if (!strcmp(arg, "--seeds")) num_seeds = atoi(val);
+        else if (!strcmp(arg, "--first-seed")) first_seed = (uint32_t)strtoul(val, NULL, 0);
+        else if (!strcmp(arg, "--coupling")) coupling = strtof(val, NULL);
+        else if (!strcmp(arg, "--max-steps")) s.max_steps = (uint64_t)strtod(val, NULL);  // 1e9 works
+        else if (!strcmp(arg, "--threads")) threads = atoi(val);
+        else if (!strcmp(arg, "--top")) top = atoi(val);
+        else if (!strcmp(arg, "--csv")) csv = val;
+        else if (!strcmp(arg, "--input")) {
+            int v[INPUT_DIM];
+            if (sscanf(val, "%d,%d,%d,%d", &v[0], &v[1], &v[2], &v[3]) != INPUT_DIM) {
+                usage(argv[0]);
+                return 1;
+            }
+            for (int k = 0; k < INPUT_DIM; k++) s.input[k] = (uint8_t)v[k];
+        } else { usage(argv[0]); return 1; }
+    }
+    if (num_seeds < 1 || s.max_steps < 1) { usage(argv[0]); return 1; }
+
+    spectral_init_tables();
+    spectral_init(&s.base, coupling, SPECTRAL_SEED);
+    s.first_seed = first_seed;
+    s.orbits = calloc(num_seeds, sizeof(orbit_t));
+    basin_t *basins = calloc(num_seeds, sizeof(basin_t));
+    if (!s.orbits || !basins) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    printf("\n");
+    printf("======================================================================\n");
+    printf("  Q15 OSCILLATOR NETWORK: EXACT CYCLES AND ATTRACTORS\n");
+    printf("======================================================================\n");
+    printf("\n");
+    printf("  Map: input {%d,%d,%d,%d}, coupling %.3f, feedback %s\n",
+           s.input[0], s.input[1], s.input[2], s.input[3], coupling, s.feedback ? "on" : "off");
+    printf("  State: %zu bytes (oscillators, velocities, coupling)\n", SPECTRAL_STATE_BYTES);
+    printf("  Seeds: %u..%u, up to %llu steps each\n", first_seed,
+           first_seed + (uint32_t)num_seeds - 1, (unsigned long long)s.max_steps);
+
+    double t0 = wall_s();
+    run_jobs(num_seeds, threads, seed_job, &s);
+    double elapsed = wall_s() - t0;
+
+    if (csv) {
+        FILE *f = fopen(csv, "w");
+        if (!f) {
+            fprintf(stderr, "cannot write %s\n", csv);
+            return 1;
+        }
+        fprintf(f, "seed,status,transient,period,attractor,steps\n");
+        for (int i = 0; i < num_seeds; i++) {
+            const orbit_t *o = &s.orbits[i];
+            fprintf(f, "%u,%s,%llu,%llu,%016llx,%llu\n", o->seed,
+                    o->status == ORBIT_CYCLE ? "cycle" : "undecided",
+                    (unsigned long long)o->transient, (unsigned long long)o->period,
+                    (unsigned long long)o->attractor, (unsigned long long)o->steps);
+        }
+        fclose(f);
+    }
+
+    uint64_t total_steps = 0, transient_sum = 0, transient_max = 0;
+    int undecided = 0, fixed_points = 0;
+    for (int i = 0; i < num_seeds; i++) {
+        const orbit_t *o = &s.orbits[i];
+        total_steps += o->steps;
+        if (o->status == ORBIT_UNDECIDED) { undecided++; continue; }
+        transient_sum += o->transient;
+        if (o->transient > transient_max) transient_max = o->transient;
+    }
+    qsort(s.orbits, num_seeds, sizeof(orbit_t), cmp_orbit);
+    int num_basins = collect_basins(s.orbits, num_seeds, basins);
+    for (int i = 0; i < num_basins; i++) fixed_points += basins[i].period == 1;
+    int resolved = num_seeds - undecided;
+
+    printf("\n");
+    printf("  Attractor        |  Period  | Basin | Share | Transient min / mean / max\n");
+    printf("  -----------------+----------+-------+-------+---------------------------\n");
+    for (int i = 0; i < num_basins && i < top; i++) {
+        const basin_t *b = &basins[i];
+        printf("  %016llx | %8llu | %5d | %4.0f%% | %llu / %.0f / %llu\n",
+               (unsigned long long)b->attractor, (unsigned long long)b->period, b->basin,
+               100.0 * b->basin / num_seeds, (unsigned long long)b->transient_min,
+               (double)b->transient_sum / b->basin, (unsigned long long)b->transient_max);
+    }
+    if (num_basins > top) printf("  ... %d more\n", num_basins - top);
+
+    printf("\n");
+    printf("  Seeds resolved:        %d / %d", resolved, num_seeds);
+    if (undecided) printf("  (%d without a cycle in %llu steps)", undecided,
+                          (unsigned long long)s.max_steps);
+    printf("\n");
+    printf("  Distinct attractors:   %d (%d fixed points)\n", num_basins, fixed_points);
+    if (resolved) {
+        printf("  Largest basin:         %.0f%% of seeds\n", 100.0 * basins[0].basin / num_seeds);
+        printf("  Transient mean / max:  %.0f / %llu steps\n",
+               (double)transient_sum / resolved, (unsigned long long)transient_max);
+    }
+    printf("  Map evaluations:       %llu in %.2f s (%.2f M steps/s)\n",
+           (unsigned long long)total_steps, elapsed, total_steps / elapsed / 1e6);
+    printf("\n");
+
+    free(s.orbits);
+    free(basins);
+    return 0;
+}
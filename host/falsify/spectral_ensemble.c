@@ -0,0 +1,42 @@
+/**
+ * spectral_ensemble.c - Many demo 03 networks stepped in parallel
+ *
+ * See spectral_ensemble.h.
+ */
+
+#include "spectral_ensemble.h"
+#include "job_pool.h"
+
+int ensemble_init(spectral_ensemble_t *e, net_arena_t *arena, int count) {
+    e->count = count;
+    e->num_blocks = (count + SPECTRAL_LANES - 1) / SPECTRAL_LANES;
+    e->blocks = net_arena_zalloc(arena, (size_t)e->num_blocks * sizeof(spectral_lanes_t));
+    return e->blocks ? 0 : -1;
+}
+
+void ensemble_load(spectral_ensemble_t *e, int i, const spectral_network_t *net,
+                   const uint8_t *input) {
+    spectral_lanes_load(&e->blocks[i / SPECTRAL_LANES], i % SPECTRAL_LANES, net, input);
+}
+
+void ensemble_store(const spectral_ensemble_t *e, int i, spectral_network_t *net) {
+    spectral_lanes_store(&e->blocks[i / SPECTRAL_LANES], i % SPECTRAL_LANES, net);
+}
+
+typedef struct {
+    spectral_ensemble_t *e;
+    int steps;
+    const spectral_feedback_t *fb;
+} run_t;
+
+static void block_job(int i, void *ctx) {
+    const run_t *r = ctx;
+    spectral_lanes_t *block = &r->e->blocks[i];
+    for (int t = 0; t < r->steps; t++) spectral_lanes_step(block, r->fb);
+}
+
+void ensemble_run(spectral_ensemble_t *e, int steps, const spectral_feedback_t *fb,
+                  int threads) {
+    run_t r = { .e = e, .steps = steps, .fb = fb };
+    run_jobs(e->num_blocks, threads, block_job, &r);
+}
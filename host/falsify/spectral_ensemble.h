@@ -0,0 +1,56 @@
+/**
+ * spectral_ensemble.h - Many demo 03 networks stepped in parallel
+ *
+ * One 16-oscillator network is far too small to keep a core busy. An
+ * ensemble stores N networks contiguously as blocks of SPECTRAL_LANES
+ * lockstep lanes (spectral_lanes_t), one network per lane. Each block is
+ * stepped by spectral_lanes_step(), which the compiler vectorizes across
+ * networks. Blocks are sharded over threads with job_pool. Each network
+ * has its own input and coupling, and results are bit-exact with
+ * spectral_step() on every network alone.
+ *
+ * The blocks come from a caller's net_arena: dropping an ensemble is
+ * net_arena_reset(), and the arena's counts say what it cost.
+ */
+
+#pragma once
+
+#include "spectral_net.h"
+#include "net_arena.h"
+
+typedef struct {
+    int count;                  // Networks
+    int num_blocks;             // ceil(count / SPECTRAL_LANES)
+    spectral_lanes_t *blocks;   // Contiguous, cache-line aligned
+} spectral_ensemble_t;
+
+/** Arena bytes ensemble_init() takes for `count` networks. */
+static inline size_t ensemble_bytes(int count) {
+    return net_arena_round((size_t)(count + SPECTRAL_LANES - 1) / SPECTRAL_LANES
+                           * sizeof(spectral_lanes_t));
+}
+
+/**
+ * Room for `count` networks from `arena`, all lanes zero.
+ * Returns 0, or -1 if the arena is full.
+ */
+int ensemble_init(spectral_ensemble_t *e, net_arena_t *arena, int count);
+
+/** Network i of the ensemble is `net` under constant `input`. */
+void ensemble_load(spectral_ensemble_t *e, int i, const spectral_network_t *net,
+                   const uint8_t *input);
+
+/** Copy network i's evolving state (and coherence) back into `net`. */
+void ensemble_store(const spectral_ensemble_t *e, int i, spectral_network_t *net);
+
+static inline int16_t ensemble_coherence(const spectral_ensemble_t *e, int i) {
+    return e->blocks[i / SPECTRAL_LANES].coherence[i % SPECTRAL_LANES];
+}
+
+/**
+ * `steps` steps of every network, with feedback rule `fb` or none (NULL).
+ * Each block runs all its steps in one job while it is in cache.
+ * threads <= 0 means one per online CPU.
+ */
+void ensemble_run(spectral_ensemble_t *e, int steps, const spectral_feedback_t *fb,
+                  int threads);
@@ -0,0 +1,56 @@
+/**
+ * ep_kernels.c - Demo 04 kernels for reference/pulse_native.py
+ *
+ * See pulse_kernels.h. The demo keeps its network in file-scope statics,
+ * so this file compiles equilibrium_prop.c into itself (PULSE_LAB_HOST,
+ * host shims) and exports thin wrappers around its functions. The math
+ * is the firmware's, line for line; app_main() comes along unused.
+ */
+
+#include "equilibrium_prop.c"
+#include "pulse_kernels.h"
+
+void pk_ep_init(int q15) {
+    static bool tables_ready;
+    if (!tables_ready) {
+        init_trig_tables();
+        tables_ready = true;
+    }
+    learn_mode = q15 ? LEARN_Q15 : LEARN_FLOAT;
+    learn_couplings = true;
+    learn_mask_bands = 0;
+    init_network();
+}
+
+void *pk_ep_network(void) {
+    return &net;
+}
+
+size_t pk_ep_network_size(void) {
+    return sizeof(net);
+}
+
+uint32_t *pk_ep_round_state(void) {
+    return &round_state;
+}
+
+int32_t pk_ep_learn_step(const uint8_t *input, int16_t target) {
+    return learn_step(input, target);
+}
+
+void pk_ep_train(const uint8_t *inputs, const int16_t *targets, int count, int epochs,
+                 int32_t *losses) {
+    for (int e = 0; e < epochs; e++) {
+        int32_t loss = 0;
+        for (int s = 0; s < count; s++) loss += learn_step(inputs + s * INPUT_DIM, targets[s]);
+        losses[e] = loss;
+    }
+}
+
+int16_t pk_ep_forward(const uint8_t *input) {
+    return forward_pass(input);
+}
+
+void pk_ep_forward_batch(const uint8_t *inputs, int count, int16_t *outputs) {
+    forward_pass_batch((const uint8_t (*)[INPUT_DIM])inputs, count, outputs);
+}
@@ -0,0 +1,117 @@
+/**
+ * pulse_kernels.c - Demo 01-03 kernels for reference/pulse_native.py
+ *
+ * See pulse_kernels.h. Demo 03 is spectral_net.c itself; the demo 02 dot
+ * product is reference_dot(), the loop the demo checks PCNT against.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#include "pulse_kernels.h"
+#include "spectral_net.h"
+
+uint64_t pk_count_edges(const uint8_t *samples, size_t count, int lane) {
+    uint64_t edges = 0;
+    unsigned prev = 0;
+    for (size_t i = 0; i < count; i++) {
+        unsigned level = (samples[i] >> lane) & 1;
+        edges += level & ~prev;
+        prev = level;
+    }
+    return edges;
+}
+
+void pk_ternary_dot(const uint8_t *inputs, int count, int dim, const uint32_t *pos,
+                    const uint32_t *neg, int neurons, int32_t *out) {
+    for (int s = 0; s < count; s++) {
+        const uint8_t *x = inputs + (size_t)s * dim;
+        for (int n = 0; n < neurons; n++) {
+            int32_t result = 0;
+            for (int i = 0; i < dim; i++) {
+                if (pos[n] & (1u << i)) result += x[i];
+                if (neg[n] & (1u << i)) result -= x[i];
+            }
+            out[(size_t)s * neurons + n] = result;
+        }
+    }
+}
+
+// ============================================================
+// Demo 03
+// ============================================================
+
+static bool tables_ready;
+
+static void ensure_tables(void) {
+    if (!tables_ready) {
+        spectral_init_tables();
+        tables_ready = true;
+    }
+}
+
+size_t pk_spectral_size(void) {
+    return sizeof(spectral_network_t);
+}
+
+void pk_trig_tables(int16_t *sin_out, int16_t *cos_out) {
+    spectral_network_t probe;
+    ensure_tables();
+    for (int i = 0; i < 256; i++) {
+        spectral_set_phase(&probe, 0, 0, (uint8_t)i);
+        cos_out[i] = probe.oscillator[0][0].real;
+        sin_out[i] = probe.oscillator[0][0].imag;
+    }
+}
+
+void pk_spectral_init(void *nets, int count, float coupling, uint32_t seed) {
+    spectral_network_t *net = nets;
+    ensure_tables();
+    for (int k = 0; k < count; k++) spectral_init(&net[k], coupling, seed);
+}
+
+void pk_spectral_init_streams(void *nets, int count, float coupling, uint32_t seed,
+                              uint32_t first_id) {
+    spectral_network_t *net = nets;
+    ensure_tables();
+    for (int k = 0; k < count; k++) {
+        net_rng_t rng = net_rng_counter(seed, first_id + (uint32_t)k, SPECTRAL_STREAM_INIT);
+        spectral_init_rng(&net[k], coupling, &rng);
+    }
+}
+
+void pk_spectral_run(void *nets, int count, const uint8_t *input, int steps, int feedback,
+                     int16_t *coherence) {
+    spectral_network_t *net = nets;
+    spectral_lanes_t lanes;
+    ensure_tables();
+    // SPECTRAL_LANES networks at a time in lockstep; spare lanes stay zero.
+    // A block pays off from about a third full (lanes are ~3x a network).
+    for (int first = 0; first < count; first += SPECTRAL_LANES) {
+        int width = count - first < SPECTRAL_LANES ? count - first : SPECTRAL_LANES;
+        if (width * 3 < SPECTRAL_LANES) {
+            for (int k = first; k < count; k++) {
+                for (int t = 0; t < steps; t++) {
+                    if (feedback) spectral_step_feedback(&net[k], input);
+                    else spectral_step(&net[k], input);
+                    if (coherence) coherence[(size_t)t * count + k] = net[k].coherence;
+                }
+            }
+            break;
+        }
+        memset(&lanes, 0, sizeof(lanes));
+        for (int k = 0; k < width; k++) spectral_lanes_load(&lanes, k, &net[first + k], input);
+        for (int t = 0; t < steps; t++) {
+            spectral_lanes_step(&lanes, feedback ? &SPECTRAL_FEEDBACK : NULL);
+            if (!coherence) continue;
+            for (int k = 0; k < width; k++) {
+                coherence[(size_t)t * count + first + k] = lanes.coherence[k];
+            }
+        }
+        for (int k = 0; k < width; k++) spectral_lanes_store(&lanes, k, &net[first + k]);
+    }
+}
+
+int16_t pk_spectral_band_coherence(const void *net, int band) {
+    ensure_tables();
+    return spectral_band_coherence(net, band);
+}
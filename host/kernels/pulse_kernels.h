@@ -0,0 +1,95 @@
+/**
+ * pulse_kernels.h - The firmware's compute kernels as a host library
+ *
+ * What reference/pulse_native.py loads through ctypes, so the reference
+ * implementations and the notebook run the firmware's integer math
+ * instead of Python loops:
+ *
+ *   01  edge counting over a PARLIO sample stream (what PCNT counts)
+ *   02  ternary dot products, reference_dot() of demo 02 over a batch
+ *   03  the Q15 oscillator network, spectral_net.c linked as is
+ *   04  learn_step() / forward_pass() of equilibrium_prop.c, compiled in
+ *
+ * Demo 03 networks live in caller memory: an array of spectral_network_t
+ * (pk_spectral_size() bytes each) that NumPy owns and views in place.
+ * Demo 04 keeps the firmware's single global network; pk_ep_network()
+ * points at it so NumPy can view its state without a copy.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================
+// Demo 01 / 02
+// ============================================================
+
+/** Rising edges on bit `lane` of a byte-per-sample stream, from a low line. */
+uint64_t pk_count_edges(const uint8_t *samples, size_t count, int lane);
+
+/**
+ * out[s * neurons + n] = sum over i < dim of +/- inputs[s * dim + i], the
+ * sign from bit i of pos[n] / neg[n]. count samples.
+ */
+void pk_ternary_dot(const uint8_t *inputs, int count, int dim, const uint32_t *pos,
+                    const uint32_t *neg, int neurons, int32_t *out);
+
+// ============================================================
+// Demo 03: spectral_network_t arrays
+// ============================================================
+
+size_t pk_spectral_size(void);
+
+/** The 256-entry Q15 sine and cosine tables the network rotates with. */
+void pk_trig_tables(int16_t *sin_out, int16_t *cos_out);
+
+/** init_network() of demo 03 for each of `count` networks. */
+void pk_spectral_init(void *nets, int count, float coupling, uint32_t seed);
+
+/**
+ * Independent networks: network k draws its phases and masks from the
+ * counter stream (seed, first_id + k), so it is the same whatever `count`
+ * or the batch it is made in.
+ */
+void pk_spectral_init_streams(void *nets, int count, float coupling, uint32_t seed,
+                              uint32_t first_id);
+
+/**
+ * `steps` steps of every network under one input, with or without
+ * coherence feedback, SPECTRAL_LANES networks at a time in lockstep. If `coherence` is not NULL it receives each
+ * network's coherence after every step, steps x count, step-major.
+ */
+void pk_spectral_run(void *nets, int count, const uint8_t *input, int steps, int feedback,
+                     int16_t *coherence);
+
+int16_t pk_spectral_band_coherence(const void *net, int band);
+
+// ============================================================
+// Demo 04: the firmware's network_t
+// ============================================================
+
+/** Trig tables and init_network(); q15 selects LEARN_Q15 over LEARN_FLOAT. */
+void pk_ep_init(int q15);
+
+void *pk_ep_network(void);
+size_t pk_ep_network_size(void);
+
+/** The stochastic-rounding xorshift state, for replaying an update. */
+uint32_t *pk_ep_round_state(void);
+
+/** learn_step(): free phase, nudged phase, update. Returns the loss * 65536. */
+int32_t pk_ep_learn_step(const uint8_t *input, int16_t target);
+
+/**
+ * `epochs` passes of learn_step() over `count` samples in order, as
+ * train_and_evaluate() does; losses[e] is the summed loss of epoch e.
+ */
+void pk_ep_train(const uint8_t *inputs, const int16_t *targets, int count, int epochs,
+                 int32_t *losses);
+
+/** forward_pass(): free phase only, the Gamma - Delta output phase. */
+int16_t pk_ep_forward(const uint8_t *input);
+
+/** forward_pass_batch(): the lockstep lanes, bit-exact with pk_ep_forward(). */
+void pk_ep_forward_batch(const uint8_t *inputs, int count, int16_t *outputs);
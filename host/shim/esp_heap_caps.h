@@ -0,0 +1,23 @@
+/**
+ * Host shim for esp_heap_caps.h
+ *
+ * Every host allocation is "DMA capable"; the caps are accepted and ignored.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#define MALLOC_CAP_DMA      (1 << 3)
+#define MALLOC_CAP_8BIT     (1 << 2)
+
+static inline void *heap_caps_aligned_alloc(size_t alignment, size_t size, uint32_t caps) {
+    void *p = NULL;
+    if (alignment < sizeof(void *)) alignment = sizeof(void *);
+    return posix_memalign(&p, alignment, size) == 0 ? p : NULL;
+}
+
+static inline void heap_caps_free(void *ptr) {
+    free(ptr);
+}
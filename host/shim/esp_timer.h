@@ -0,0 +1,17 @@
+/**
+ * Host shim for esp_timer.h
+ *
+ * esp_timer_get_time() returns microseconds since an arbitrary epoch,
+ * same contract as on the device.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+
+static inline int64_t esp_timer_get_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
@@ -0,0 +1,20 @@
+/**
+ * Host shim for freertos/FreeRTOS.h
+ *
+ * Only what the demos use: tick types and pdMS_TO_TICKS.
+ * One tick = one millisecond on the host.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+
+#define pdTRUE              1
+#define pdFALSE             0
+#define portMAX_DELAY       ((TickType_t)0xffffffffUL)
+#define pdMS_TO_TICKS(ms)   ((TickType_t)(ms))
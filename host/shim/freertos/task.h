@@ -0,0 +1,16 @@
+/**
+ * Host shim for freertos/task.h
+ */
+
+#pragma once
+
+#include <time.h>
+#include "freertos/FreeRTOS.h"
+
+static inline void vTaskDelay(TickType_t ticks) {
+    struct timespec ts = {
+        .tv_sec = ticks / 1000,
+        .tv_nsec = (long)(ticks % 1000) * 1000000L,
+    };
+    nanosleep(&ts, NULL);
+}
@@ -0,0 +1,13 @@
+/**
+ * host_main.c - Run a demo's app_main() as a normal host process
+ *
+ * On the device app_main() is called by the IDF startup task. Here we
+ * just call it; demos return instead of idling when PULSE_LAB_HOST is set.
+ */
+
+void app_main(void);
+
+int main(void) {
+    app_main();
+    return 0;
+}
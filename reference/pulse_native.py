@@ -0,0 +1,252 @@
+"""
+ctypes bindings for host/kernels/ (the pulse_kernels library)
+
+The firmware's own C kernels, for pulse_arithmetic.py --engine native and
+the notebook. Build the library with the host tree:
+
+    cmake -S host -B build-host && cmake --build build-host --target pulse_kernels
+
+The library is looked up in $PULSE_KERNELS, then build-host/ at the
+repository root.
+
+State stays in NumPy without copies. Demo 03 networks are a structured
+array (SPECTRAL_DTYPE, one record per network) that the C code steps in
+place. Demo 04 has one global network in the firmware; ep_network() is a
+structured view of that memory.
+"""
+
+import ctypes
+import os
+from pathlib import Path
+
+import numpy as np
+
+_REPO = Path(__file__).resolve().parent.parent
+_NAMES = ["libpulse_kernels.so", "libpulse_kernels.dylib", "pulse_kernels.dll"]
+
+# spectral_network_t (firmware/03_spectral_oscillator/main/spectral_net.h)
+SPECTRAL_DTYPE = np.dtype([
+    ("oscillator", "<i2", (4, 4, 2)),       # [band][neuron][real, imag]
+    ("phase_velocity", "<i2", (4, 4)),
+    ("coupling", "<f4", (4, 4)),
+    ("input_pos_mask", "<u4", (4, 4)),
+    ("input_neg_mask", "<u4", (4, 4)),
+    ("coherence", "<i2"),
+], align=True)
+
+# network_t (firmware/04_equilibrium_prop/main/equilibrium_prop.c)
+EP_DTYPE = np.dtype([
+    ("oscillator", "<i2", (4, 4, 2)),
+    ("phase_velocity", "<i2", (4, 4)),
+    ("coupling", "<f4", (4, 4)),
+    ("input_pos_mask", "<u4", (4, 4)),
+    ("input_neg_mask", "<u4", (4, 4)),
+    ("coupling_q15", "<i2", (4, 4)),
+    ("band_decay_q15", "<i2", (4,)),
+    ("band_velocity", "<i2", (4,)),
+], align=True)
+
+_u8 = np.ctypeslib.ndpointer(dtype=np.uint8, flags="C_CONTIGUOUS")
+_u32 = np.ctypeslib.ndpointer(dtype=np.uint32, flags="C_CONTIGUOUS")
+_i16 = np.ctypeslib.ndpointer(dtype=np.int16, flags="C_CONTIGUOUS")
+_i32 = np.ctypeslib.ndpointer(dtype=np.int32, flags="C_CONTIGUOUS")
+_spectral = np.ctypeslib.ndpointer(dtype=SPECTRAL_DTYPE, flags=("C_CONTIGUOUS", "WRITEABLE"))
+_int = ctypes.c_int
+
+_lib = None
+
+
+def _load():
+    global _lib
+    if _lib is not None:
+        return _lib
+    candidates = []
+    if os.environ.get("PULSE_KERNELS"):
+        candidates.append(Path(os.environ["PULSE_KERNELS"]))
+    candidates += [_REPO / "build-host" / name for name in _NAMES]
+    for path in candidates:
+        if path.is_file():
+            break
+    else:
+        raise RuntimeError(
+            "pulse_kernels library not found; build it with\n"
+            "  cmake -S host -B build-host && cmake --build build-host --target pulse_kernels\n"
+            "or point PULSE_KERNELS at it"
+        )
+
+    lib = ctypes.CDLL(str(path))
+    lib.pk_count_edges.argtypes = [_u8, ctypes.c_size_t, _int]
+    lib.pk_count_edges.restype = ctypes.c_uint64
+    lib.pk_ternary_dot.argtypes = [_u8, _int, _int, _u32, _u32, _int, _i32]
+    lib.pk_ternary_dot.restype = None
+    lib.pk_spectral_size.restype = ctypes.c_size_t
+    lib.pk_trig_tables.argtypes = [_i16, _i16]
+    lib.pk_trig_tables.restype = None
+    lib.pk_spectral_init.argtypes = [_spectral, _int, ctypes.c_float, ctypes.c_uint32]
+    lib.pk_spectral_init.restype = None
+    lib.pk_spectral_init_streams.argtypes = [_spectral, _int, ctypes.c_float, ctypes.c_uint32,
+                                             ctypes.c_uint32]
+    lib.pk_spectral_init_streams.restype = None
+    lib.pk_spectral_run.argtypes = [_spectral, _int, _u8, _int, _int, ctypes.c_void_p]
+    lib.pk_spectral_run.restype = None
+    lib.pk_spectral_band_coherence.argtypes = [_spectral, _int]
+    lib.pk_spectral_band_coherence.restype = ctypes.c_int16
+    lib.pk_ep_init.argtypes = [_int]
+    lib.pk_ep_init.restype = None
+    lib.pk_ep_network.restype = ctypes.c_void_p
+    lib.pk_ep_network_size.restype = ctypes.c_size_t
+    lib.pk_ep_round_state.restype = ctypes.c_void_p
+    lib.pk_ep_learn_step.argtypes = [_u8, ctypes.c_int16]
+    lib.pk_ep_learn_step.restype = ctypes.c_int32
+    lib.pk_ep_train.argtypes = [_u8, _i16, _int, _int, _i32]
+    lib.pk_ep_train.restype = None
+    lib.pk_ep_forward.argtypes = [_u8]
+    lib.pk_ep_forward.restype = ctypes.c_int16
+    lib.pk_ep_forward_batch.argtypes = [_u8, _int, _i16]
+    lib.pk_ep_forward_batch.restype = None
+
+    # The dtypes above must be the C layouts
+    if lib.pk_spectral_size() != SPECTRAL_DTYPE.itemsize:
+        raise RuntimeError(f"spectral_network_t is {lib.pk_spectral_size()} bytes, "
+                           f"SPECTRAL_DTYPE {SPECTRAL_DTYPE.itemsize}")
+    if lib.pk_ep_network_size() != EP_DTYPE.itemsize:
+        raise RuntimeError(f"network_t is {lib.pk_ep_network_size()} bytes, "
+                           f"EP_DTYPE {EP_DTYPE.itemsize}")
+    _lib = lib
+    return lib
+
+
+def available() -> bool:
+    """Is the library built (and does its layout match)?"""
+    try:
+        _load()
+    except (RuntimeError, OSError):
+        return False
+    return True
+
+
+def _view(address: int, dtype: np.dtype, count: int = 1) -> np.ndarray:
+    """Writable NumPy view of C memory."""
+    buf = (ctypes.c_uint8 * (dtype.itemsize * count)).from_address(address)
+    return np.frombuffer(buf, dtype=dtype)
+
+
+def _input(x) -> np.ndarray:
+    return np.ascontiguousarray(x, dtype=np.uint8)
+
+
+# =============================================================================
+# Demo 01 / 02
+# =============================================================================
+
+
+def count_edges(samples, lane: int = 0) -> int:
+    """Rising edges on one bit lane of a byte-per-sample stream."""
+    return int(_load().pk_count_edges(_input(samples), len(samples), lane))
+
+
+def pulse_train(num_pulses: int, lane: int = 0) -> np.ndarray:
+    """num_pulses high/low sample pairs on `lane`."""
+    return np.tile(np.array([1 << lane, 0], dtype=np.uint8), num_pulses)
+
+
+def ternary_dot(inputs, pos_masks, neg_masks) -> np.ndarray:
+    """(samples, neurons) dot products; inputs is (samples, dim) or (dim,)."""
+    x = _input(np.atleast_2d(inputs))
+    pos = np.ascontiguousarray(pos_masks, dtype=np.uint32)
+    neg = np.ascontiguousarray(neg_masks, dtype=np.uint32)
+    out = np.empty((x.shape[0], len(pos)), dtype=np.int32)
+    _load().pk_ternary_dot(x, x.shape[0], x.shape[1], pos, neg, len(pos), out)
+    return out
+
+
+# =============================================================================
+# Demo 03: Q15 spectral oscillator networks
+# =============================================================================
+
+
+def trig_tables():
+    """The network's (sin, cos) Q15 tables, 256 entries each."""
+    sin, cos = np.empty(256, dtype=np.int16), np.empty(256, dtype=np.int16)
+    _load().pk_trig_tables(sin, cos)
+    return sin, cos
+
+
+def spectral_networks(count: int = 1, coupling: float = 0.5, seed: int = 12345,
+                      first_id: int = None) -> np.ndarray:
+    """`count` copies of the demo's network, initialized by the firmware.
+
+    With first_id, network k is instead drawn from its own counter stream
+    (seed, first_id + k): an ensemble of different networks, each one the
+    same however the ensemble is split into batches.
+    """
+    nets = np.zeros(count, dtype=SPECTRAL_DTYPE)
+    if first_id is None:
+        _load().pk_spectral_init(nets, count, coupling, seed)
+    else:
+        _load().pk_spectral_init_streams(nets, count, coupling, seed, first_id)
+    return nets
+
+
+def spectral_run(nets: np.ndarray, input_vec, steps: int, feedback: bool = False,
+                 record: bool = False):
+    """Step every network in place; with record, the (steps, count) coherence."""
+    coherence = np.empty((steps, len(nets)), dtype=np.int16) if record else None
+    _load().pk_spectral_run(nets, len(nets), _input(input_vec), steps, int(feedback),
+                            coherence.ctypes.data if record else None)
+    return coherence
+
+
+def band_coherence(nets: np.ndarray, band: int) -> np.ndarray:
+    """Within-band coherence (Q15) of each network."""
+    lib = _load()
+    return np.array([lib.pk_spectral_band_coherence(nets[k:k + 1], band)
+                     for k in range(len(nets))], dtype=np.int16)
+
+
+# =============================================================================
+# Demo 04: equilibrium propagation
+# =============================================================================
+
+
+def ep_init(q15: bool = True) -> np.ndarray:
+    """init_network() with Q15 or float couplings; returns ep_network()."""
+    _load().pk_ep_init(int(q15))
+    return ep_network()
+
+
+def ep_network() -> np.ndarray:
+    """The firmware's network as a one-record view (writes go to C)."""
+    return _view(_load().pk_ep_network(), EP_DTYPE)
+
+
+def ep_round_state() -> np.ndarray:
+    """The stochastic-rounding state as a one-element uint32 view."""
+    return _view(_load().pk_ep_round_state(), np.dtype(np.uint32))
+
+
+def ep_learn_step(input_vec, target: int) -> int:
+    """One learn_step(); returns the loss * 65536."""
+    return int(_load().pk_ep_learn_step(_input(input_vec), target))
+
+
+def ep_train(inputs, targets, epochs: int) -> np.ndarray:
+    """Summed loss * 65536 of each epoch over (inputs, targets) in order."""
+    x = _input(inputs)
+    t = np.ascontiguousarray(targets, dtype=np.int16)
+    losses = np.empty(epochs, dtype=np.int32)
+    _load().pk_ep_train(x, t, len(t), epochs, losses)
+    return losses
+
+
+def ep_forward(input_vec) -> int:
+    """Output phase (Gamma - Delta) of one free phase."""
+    return int(_load().pk_ep_forward(_input(input_vec)))
+
+
+def ep_forward_batch(inputs) -> np.ndarray:
+    """ep_forward() over (samples, 4) inputs, in lockstep lanes."""
+    x = _input(inputs)
+    out = np.empty(len(x), dtype=np.int16)
+    _load().pk_ep_forward_batch(x, len(x), out)
+    return out
@@ -0,0 +1,373 @@
+#!/usr/bin/env python3
+"""
+Benchmark result store and regression comparator.
+
+Keeps every benchmark run in a JSON-lines file, one record per case, and
+compares runs. Records are the firmware's `BENCH {...}` lines (see
+firmware/components/pulse_lab/pulse_bench.h) plus where they came from:
+
+    run      id of the recording (UTC time in ms + commit; unique in the store)
+    commit   git HEAD when recorded, "dirty" if the tree had changes
+    machine  host name (host runs) or the board's label
+    config   free-form build configuration ("Release", "sdkconfig-a")
+
+A case is keyed by (demo, case, params, platform, machine, config), so a
+host result is never compared with a device one, nor a simulated clock
+with a real one.
+
+Regressions are judged on the median time per iteration. Each record has
+its own noise estimate: the p50-p99 spread, taken as 2.33 sigma of a
+normal distribution, gives the standard error of the median as
+1.25 sigma / sqrt(samples). When the baseline has three or more runs of a
+case, the scatter of their medians (MAD) is added, since run-to-run drift
+is usually larger than within-run noise. A change is flagged when it is
+beyond --sigma standard errors AND at least --min-change of the baseline.
+With fewer baseline runs the drift is unknown, so a flagged change is
+reported as "insufficient baseline" rather than judged.
+
+Usage:
+    python verify_claims.py --host build-host --bench-out runs.jsonl
+    python bench_store.py record runs.jsonl --config Release
+    python bench_store.py record device.txt      # raw serial capture works too
+    python bench_store.py runs
+    python bench_store.py compare                # latest run vs the ones before it
+    python bench_store.py compare --base v0.3.0 --head HEAD
+    python bench_store.py trend --demo 04_equilibrium_prop --case learn_step
+
+`compare` exits with status 1 if any case regressed against a baseline of
+three or more runs.
+"""
+
+import argparse
+import json
+import math
+import platform
+import statistics
+import subprocess
+import sys
+import time
+from pathlib import Path
+from typing import Dict, List, Optional, Tuple
+
+REPO = Path(__file__).resolve().parent.parent
+DEFAULT_STORE = REPO / "bench-results" / "results.jsonl"
+BENCH_PREFIX = "BENCH "
+P99_SIGMAS = 2.326          # Normal quantile of p99
+MEDIAN_SE = 1.2533          # Standard error of a median, in sigma / sqrt(n)
+MAD_SIGMA = 1.4826          # MAD to sigma, normal
+MIN_SCATTER_RUNS = 3        # Baseline runs needed to estimate run-to-run scatter
+
+Key = Tuple[str, ...]
+
+
+# ============================================================
+# Store
+# ============================================================
+
+def git_commit() -> Tuple[str, bool]:
+    """HEAD and whether the tree has uncommitted changes."""
+    try:
+        head = subprocess.run(["git", "rev-parse", "HEAD"], cwd=REPO, capture_output=True,
+                              text=True, check=True).stdout.strip()
+        dirty = subprocess.run(["git", "status", "--porcelain", "--untracked-files=no"],
+                               cwd=REPO, capture_output=True, text=True).stdout.strip() != ""
+        return head, dirty
+    except (subprocess.CalledProcessError, FileNotFoundError):
+        return "unknown", False
+
+
+def resolve_rev(rev: str) -> str:
+    """A git revision as a full commit hash (or as given, if git can't)."""
+    try:
+        return subprocess.run(["git", "rev-parse", "--verify", rev + "^{commit}"], cwd=REPO,
+                              capture_output=True, text=True, check=True).stdout.strip()
+    except (subprocess.CalledProcessError, FileNotFoundError):
+        return rev
+
+
+def parse_records(text: str) -> List[dict]:
+    """Benchmark records from BENCH lines, or from bare JSON lines (--bench-out)."""
+    records = []
+    for line in text.splitlines():
+        line = line.strip()
+        if line.startswith(BENCH_PREFIX):
+            line = line[len(BENCH_PREFIX):]
+        elif not line.startswith("{"):
+            continue
+        try:
+            rec = json.loads(line)
+        except json.JSONDecodeError:
+            continue    # Cut off by a capture window
+        if "case" in rec and "p50_ns" in rec:
+            records.append(rec)
+    return records
+
+
+def load(store: Path) -> List[dict]:
+    if not store.exists():
+        return []
+    with open(store) as f:
+        return [json.loads(line) for line in f if line.strip()]
+
+
+def record(store: Path, records: List[dict], config: str, machine: Optional[str],
+           commit: Optional[str] = None) -> str:
+    """Append `records` as one run; returns the run id."""
+    head, dirty = git_commit()
+    if commit:
+        head, dirty = resolve_rev(commit), False
+    now = time.time()
+    stamp = time.strftime("%Y%m%dT%H%M%S", time.gmtime(now)) + f".{int(now * 1000) % 1000:03d}Z"
+    run = f"{stamp}-{head[:8]}"
+    # Two recordings in one millisecond still get separate runs
+    taken = {r["run"] for r in load(store)}
+    suffix = 2
+    while run in taken:
+        run = f"{stamp}-{head[:8]}-{suffix}"
+        suffix += 1
+    store.parent.mkdir(parents=True, exist_ok=True)
+    with open(store, "a") as f:
+        for rec in records:
+            meta = {
+                "run": run,
+                "time": stamp,
+                "commit": head,
+                "dirty": dirty,
+                "machine": machine or (platform.node() if rec.get("platform", "").startswith("host")
+                                       else rec.get("platform", "device")),
+                "config": config,
+            }
+            f.write(json.dumps({**meta, **rec}) + "\n")
+    return run
+
+
+def key_of(rec: dict) -> Key:
+    params = ",".join(f"{k}={v}" for k, v in rec.get("params", {}).items())
+    return (rec["demo"], rec["case"], params, rec.get("platform", ""),
+            rec.get("machine", ""), rec.get("config", ""))
+
+
+def key_name(key: Key) -> str:
+    demo, case, params, plat, machine, config = key
+    name = f"{demo} {case}" + (f" [{params}]" if params else "")
+    return f"{name} ({plat}, {machine}, {config})"
+
+
+def runs_in_order(records: List[dict]) -> List[str]:
+    seen: Dict[str, str] = {}
+    for rec in records:
+        seen.setdefault(rec["run"], rec["time"])
+    return sorted(seen, key=lambda r: (seen[r], r))
+
+
+# ============================================================
+# Noise and comparison
+# ============================================================
+
+def median_se(rec: dict) -> float:
+    """Standard error of a record's median, in ns."""
+    sigma = max(rec["p99_ns"] - rec["p50_ns"], 0.0) / P99_SIGMAS
+    return MEDIAN_SE * sigma / math.sqrt(max(rec.get("samples", 1), 1))
+
+
+def summarize(recs: List[dict]) -> Tuple[float, float]:
+    """Baseline median and its standard error from one or more runs of a case."""
+    medians = [r["p50_ns"] for r in recs]
+    center = statistics.median(medians)
+    se = math.sqrt(sum(median_se(r) ** 2 for r in recs)) / len(recs)
+    if len(recs) >= MIN_SCATTER_RUNS:
+        mad = statistics.median(abs(m - center) for m in medians)
+        se = math.hypot(se, MAD_SIGMA * mad)
+    return center, se
+
+
+def compare(base: List[dict], head: List[dict], sigma: float,
+            min_change: float) -> List[dict]:
+    """One row per case present in both sets."""
+    by_key: Dict[Key, List[dict]] = {}
+    for rec in base:
+        by_key.setdefault(key_of(rec), []).append(rec)
+    head_by_key: Dict[Key, List[dict]] = {}
+    for rec in head:
+        head_by_key.setdefault(key_of(rec), []).append(rec)
+
+    rows = []
+    for key in sorted(head_by_key):
+        if key not in by_key:
+            continue
+        b, b_se = summarize(by_key[key])
+        h, h_se = summarize(head_by_key[key])
+        se = math.hypot(b_se, h_se)
+        change = (h - b) / b if b > 0 else 0.0
+        z = (h - b) / se if se > 0 else (math.inf if h != b else 0.0)
+        if abs(change) < min_change or abs(z) < sigma:
+            verdict = "ok"
+        elif len(by_key[key]) < MIN_SCATTER_RUNS:
+            # Within-run spread alone misses run-to-run drift
+            verdict = "insufficient baseline"
+        else:
+            verdict = "REGRESSION" if h > b else "improved"
+        rows.append({
+            "key": key, "base_ns": b, "head_ns": h, "change": change, "z": z,
+            "base_runs": len(by_key[key]), "verdict": verdict,
+        })
+    return rows
+
+
+# ============================================================
+# Commands
+# ============================================================
+
+def cmd_record(args) -> int:
+    records = []
+    for path in args.files or ["-"]:
+        text = sys.stdin.read() if path == "-" else Path(path).read_text(errors="replace")
+        records += parse_records(text)
+    if not records:
+        print("  No benchmark records found", file=sys.stderr)
+        return 1
+    run = record(args.store, records, args.config, args.machine, args.commit)
+    print(f"  Recorded {len(records)} cases as run {run} in {args.store}")
+    return 0
+
+
+def cmd_runs(args) -> int:
+    records = load(args.store)
+    print(f"\n  {'Run':32s} {'Commit':10s} {'Dirty':5s} {'Machine':16s} {'Config':12s} Cases")
+    print(f"  {'-' * 32} {'-' * 10} {'-' * 5} {'-' * 16} {'-' * 12} -----")
+    for run in runs_in_order(records):
+        recs = [r for r in records if r["run"] == run]
+        r = recs[0]
+        print(f"  {run:32s} {r['commit'][:10]:10s} {'yes' if r['dirty'] else 'no':5s} "
+              f"{r['machine'][:16]:16s} {r['config'][:12]:12s} {len(recs):5d}")
+    print()
+    return 0
+
+
+def select(records: List[dict], rev: Optional[str], run: Optional[str]) -> List[dict]:
+    if run:
+        return [r for r in records if r["run"] == run]
+    commit = resolve_rev(rev)
+    return [r for r in records if r["commit"] == commit or r["commit"].startswith(rev)]
+
+
+def cmd_compare(args) -> int:
+    records = load(args.store)
+    order = runs_in_order(records)
+    if not order:
+        print(f"  No runs in {args.store}", file=sys.stderr)
+        return 1
+
+    if args.head or args.head_run:
+        head = select(records, args.head, args.head_run)
+    else:
+        head = [r for r in records if r["run"] == order[-1]]
+    head_runs = {r["run"] for r in head}
+    if args.base or args.base_run:
+        base = select(records, args.base, args.base_run)
+    else:
+        # The last --window runs before the head
+        first_head = min(order.index(r) for r in head_runs)
+        earlier = order[max(0, first_head - args.window):first_head]
+        base = [r for r in records if r["run"] in earlier]
+    base = [r for r in base if r["run"] not in head_runs]
+    if not head or not base:
+        print("  Nothing to compare: need a head and a baseline run", file=sys.stderr)
+        return 1
+
+    rows = compare(base, head, args.sigma, args.min_change)
+    print(f"\n  Baseline: {len({r['run'] for r in base})} run(s), head: {', '.join(sorted(head_runs))}")
+    print(f"  Flagged beyond {args.sigma:g} sigma and {100 * args.min_change:g}% of the baseline median\n")
+    print(f"  {'Case':72s} {'Base us':>10s} {'Head us':>10s} {'Change':>8s} {'z':>7s}  Verdict")
+    print(f"  {'-' * 72} {'-' * 10} {'-' * 10} {'-' * 8} {'-' * 7}  -------")
+    for row in rows:
+        z = f"{row['z']:7.1f}" if math.isfinite(row["z"]) else "    inf"
+        print(f"  {key_name(row['key'])[:72]:72s} {row['base_ns'] / 1e3:10.3f} "
+              f"{row['head_ns'] / 1e3:10.3f} {100 * row['change']:+7.1f}% {z}  {row['verdict']}")
+
+    regressions = sum(r["verdict"] == "REGRESSION" for r in rows)
+    improved = sum(r["verdict"] == "improved" for r in rows)
+    unjudged = sum(r["verdict"] == "insufficient baseline" for r in rows)
+    print(f"\n  {len(rows)} cases: {regressions} regressed, {improved} improved")
+    if unjudged:
+        print(f"  {unjudged} changed beyond the within-run noise with under "
+              f"{MIN_SCATTER_RUNS} baseline runs: record more runs to judge them")
+    print(f"  Result: {'FAIL' if regressions else 'PASS'}\n")
+    return 1 if regressions else 0
+
+
+def cmd_trend(args) -> int:
+    records = [r for r in load(args.store)
+               if (not args.demo or r["demo"] == args.demo)
+               and (not args.case or r["case"] == args.case)
+               and (not args.platform or r.get("platform") == args.platform)]
+    by_key: Dict[Key, List[dict]] = {}
+    for rec in records:
+        by_key.setdefault(key_of(rec), []).append(rec)
+    if not by_key:
+        print("  No matching cases", file=sys.stderr)
+        return 1
+
+    for key in sorted(by_key):
+        recs = sorted(by_key[key], key=lambda r: (r["time"], r["run"]))[-args.last:]
+        first = recs[0]["p50_ns"]
+        print(f"\n  {key_name(key)}")
+        print(f"  {'Time':20s} {'Commit':10s} {'p50 us':>10s} {'+-se us':>9s} {'vs first':>9s}  Step")
+        prev = None
+        for r in recs:
+            step = ""
+            if prev is not None:
+                rows = compare([prev], [r], args.sigma, args.min_change)
+                step = rows[0]["verdict"] if rows else ""
+            vs_first = 100 * (r["p50_ns"] - first) / first if first > 0 else 0.0
+            commit = r["commit"][:8] + ("+" if r["dirty"] else "")
+            print(f"  {r['time']:20s} {commit:10s} {r['p50_ns'] / 1e3:10.3f} "
+                  f"{median_se(r) / 1e3:9.3f} {vs_first:+8.1f}%  {step}")
+            prev = r
+    print()
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Benchmark result store and regression comparator")
+    parser.add_argument("--store", type=Path, default=DEFAULT_STORE,
+                        help=f"Result file (default: {DEFAULT_STORE.relative_to(REPO)})")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    p = sub.add_parser("record", help="Add a run from BENCH lines or --bench-out files")
+    p.add_argument("files", nargs="*", help="Files to read (default: stdin)")
+    p.add_argument("--config", default="default", help="Build configuration label")
+    p.add_argument("--machine", help="Machine label (default: host name, or the platform)")
+    p.add_argument("--commit", help="Commit the results belong to (default: HEAD)")
+    p.set_defaults(fn=cmd_record)
+
+    p = sub.add_parser("runs", help="List recorded runs")
+    p.set_defaults(fn=cmd_runs)
+
+    for name, fn, text in (("compare", cmd_compare, "Flag significant changes between runs"),
+                           ("trend", cmd_trend, "Median time per case over recorded runs")):
+        p = sub.add_parser(name, help=text)
+        p.add_argument("--sigma", type=float, default=3.0,
+                       help="Standard errors a change must exceed (default: 3)")
+        p.add_argument("--min-change", type=float, default=0.02,
+                       help="Smallest relative change flagged (default: 0.02)")
+        p.set_defaults(fn=fn)
+        if name == "compare":
+            p.add_argument("--base", help="Baseline commit (any git revision)")
+            p.add_argument("--head", help="Head commit (default: the latest run)")
+            p.add_argument("--base-run", help="Baseline run id")
+            p.add_argument("--head-run", help="Head run id")
+            p.add_argument("--window", type=int, default=5,
+                           help="Default baseline: this many runs before the head")
+        else:
+            p.add_argument("--demo", help="Only this demo (e.g. 04_equilibrium_prop)")
+            p.add_argument("--case", help="Only this case (e.g. learn_step)")
+            p.add_argument("--platform", help="Only this platform (esp32c6, host, host-sim)")
+            p.add_argument("--last", type=int, default=20, help="Runs to show per case")
+
+    args = parser.parse_args()
+    sys.exit(args.fn(args))
+
+
+if __name__ == "__main__":
+    main()
@@ -11,10 +11,19 @@ Usage:
     python falsify_etm.py --test F3   # Test triviality
     python falsify_etm.py --test F4   # Test simulation equivalence
     python falsify_etm.py --all       # Run all tests
+
+    python falsify_etm.py --engine native --trials 10000   # C engine, all cores
+    python falsify_etm.py --parity                         # native vs NumPy
+
+The native engine (host/falsify/, see falsify_native.py) steps the same
+float model in C and runs the trials in parallel; F4 is analytic and
+always runs here.
 """
 
 import numpy as np
 import argparse
+import contextlib
+import io
 from typing import Tuple, List, Dict
 import time
 
@@ -113,7 +122,11 @@ class SpectralOscillator:
             self.coupling = fixed_coupling
 
     def get_state_hash(self, precision: int = 8) -> Tuple:
-        """Discretize state for lookup table analysis."""
+        """Discretize state for lookup table analysis.
+
+        An estimate on the float model. For the firmware's Q15 network the
+        exact cycles and attractors come from host/falsify/q15_cycles.
+        """
         # Quantize phases to `precision` bits
         bins = 2**precision
         phase_quantized = (self.phases * bins / (2 * np.pi)).astype(int) % bins
@@ -127,12 +140,25 @@ class SpectralOscillator:
         )
 
 
+def initial_phases(seeds) -> np.ndarray:
+    """Starting phases of SpectralOscillator(seed=s), one row per seed."""
+    return np.stack([SpectralOscillator(seed=int(s)).phases.ravel() for s in seeds])
+
+
+def native_engine():
+    import falsify_native
+
+    return falsify_native
+
+
 # =============================================================================
 # F1: Reducibility Test
 # =============================================================================
 
 
-def test_F1_reducibility(num_steps: int = 10000, precision_bits: int = 8) -> dict:
+def test_F1_reducibility(
+    num_steps: int = 10000, precision_bits: int = 8, engine: str = "numpy", threads: int = 0
+) -> dict:
     """
     F1: Can oscillator dynamics be replaced by polynomial-size lookup table?
 
@@ -151,36 +177,42 @@ def test_F1_reducibility(num_steps: int = 10000, precision_bits: int = 8) -> dic
 
     osc = SpectralOscillator()
 
-    # Track unique states
-    states_visited = set()
-    transitions = {}  # state -> next_state
-
     # Run with varying inputs to explore state space
     inputs = [0.0, 0.1, 0.3, 0.5, 1.0]
 
-    for input_energy in inputs:
-        osc.reset()
-        for step in range(num_steps // len(inputs)):
-            state = osc.get_state_hash(precision_bits)
-            states_visited.add(state)
+    if engine == "native":
+        n_unique, n_transitions = native_engine().f1(
+            osc.phases, inputs, num_steps // len(inputs), precision_bits, threads
+        )
+    else:
+        # Track unique states
+        states_visited = set()
+        transitions = {}  # state -> next_state
+
+        for input_energy in inputs:
+            osc.reset()
+            for step in range(num_steps // len(inputs)):
+                state = osc.get_state_hash(precision_bits)
+                states_visited.add(state)
+
+                osc.evolve_step(input_energy=input_energy, use_feedback=True)
 
-            osc.evolve_step(input_energy=input_energy, use_feedback=True)
+                next_state = osc.get_state_hash(precision_bits)
 
-            next_state = osc.get_state_hash(precision_bits)
+                if state in transitions:
+                    if transitions[state] != next_state:
+                        # Non-deterministic! Same state -> different next states
+                        # This would be due to floating point, not true non-determinism
+                        pass
+                else:
+                    transitions[state] = next_state
 
-            if state in transitions:
-                if transitions[state] != next_state:
-                    # Non-deterministic! Same state -> different next states
-                    # This would be due to floating point, not true non-determinism
-                    pass
-            else:
-                transitions[state] = next_state
+        n_unique = len(states_visited)
+        n_transitions = len(transitions)
 
     # Analysis
     n_oscillators = osc.n_total
     max_poly_states = (2**precision_bits) ** 3  # Generous polynomial bound
-    n_unique = len(states_visited)
-    n_transitions = len(transitions)
 
     # Theoretical maximum states (exponential)
     theoretical_max = (2**precision_bits) ** (2 * n_oscillators + 1)
@@ -236,7 +268,9 @@ def test_F1_reducibility(num_steps: int = 10000, precision_bits: int = 8) -> dic
 # =============================================================================
 
 
-def test_F2_separability(num_steps: int = 500, num_trials: int = 10) -> dict:
+def test_F2_separability(
+    num_steps: int = 500, num_trials: int = 10, engine: str = "numpy", threads: int = 0
+) -> dict:
     """
     F2: Can discrete and continuous components be factored apart?
 
@@ -255,74 +289,84 @@ def test_F2_separability(num_steps: int = 500, num_trials: int = 10) -> dict:
 
     differences = []
 
-    for trial in range(num_trials):
-        seed = 12345 + trial
-
-        # Coupled system
-        osc_coupled = SpectralOscillator(seed=seed)
-        coupled_trajectory = []
-
-        for step in range(num_steps):
-            input_e = 0.3 * np.sin(step * 0.1)  # Varying input
-            osc_coupled.evolve_step(input_energy=input_e, use_feedback=True)
-            coupled_trajectory.append(
-                {
-                    "coherence": osc_coupled.get_coherence(),
-                    "coupling": osc_coupled.coupling,
-                    "phases": osc_coupled.phases.copy(),
-                }
+    if engine == "native":
+        seeds = 12345 + np.arange(num_trials)
+        coherence_diffs, coupling_diffs = native_engine().f2(
+            initial_phases(seeds), num_steps, threads
+        )
+        differences = [
+            {"coherence_diff": c, "coupling_diff": k}
+            for c, k in zip(coherence_diffs, coupling_diffs)
+        ]
+    else:
+        for trial in range(num_trials):
+            seed = 12345 + trial
+
+            # Coupled system
+            osc_coupled = SpectralOscillator(seed=seed)
+            coupled_trajectory = []
+
+            for step in range(num_steps):
+                input_e = 0.3 * np.sin(step * 0.1)  # Varying input
+                osc_coupled.evolve_step(input_energy=input_e, use_feedback=True)
+                coupled_trajectory.append(
+                    {
+                        "coherence": osc_coupled.get_coherence(),
+                        "coupling": osc_coupled.coupling,
+                        "phases": osc_coupled.phases.copy(),
+                    }
+                )
+
+            # Separated system: continuous evolves, but coupling feedback is
+            # computed on PREVIOUS step's coherence (delayed/decoupled)
+            osc_separated = SpectralOscillator(seed=seed)
+            separated_trajectory = []
+            prev_coherence = osc_separated.get_coherence()
+
+            for step in range(num_steps):
+                input_e = 0.3 * np.sin(step * 0.1)
+
+                # Evolve without feedback
+                osc_separated.evolve_step(input_energy=input_e, use_feedback=False)
+
+                # Apply feedback based on PREVIOUS coherence (decoupled)
+                if prev_coherence > SpectralOscillator.COHERENCE_HIGH:
+                    osc_separated.coupling *= SpectralOscillator.COUPLING_DECAY
+                elif prev_coherence < SpectralOscillator.COHERENCE_LOW:
+                    osc_separated.coupling *= SpectralOscillator.COUPLING_GROWTH
+                osc_separated.coupling = np.clip(
+                    osc_separated.coupling,
+                    SpectralOscillator.COUPLING_MIN,
+                    SpectralOscillator.COUPLING_MAX,
+                )
+
+                current_coherence = osc_separated.get_coherence()
+                separated_trajectory.append(
+                    {
+                        "coherence": current_coherence,
+                        "coupling": osc_separated.coupling,
+                        "phases": osc_separated.phases.copy(),
+                    }
+                )
+                prev_coherence = current_coherence
+
+            # Compare trajectories
+            coherence_diff = np.mean(
+                [
+                    abs(c["coherence"] - s["coherence"])
+                    for c, s in zip(coupled_trajectory, separated_trajectory)
+                ]
             )
-
-        # Separated system: continuous evolves, but coupling feedback is
-        # computed on PREVIOUS step's coherence (delayed/decoupled)
-        osc_separated = SpectralOscillator(seed=seed)
-        separated_trajectory = []
-        prev_coherence = osc_separated.get_coherence()
-
-        for step in range(num_steps):
-            input_e = 0.3 * np.sin(step * 0.1)
-
-            # Evolve without feedback
-            osc_separated.evolve_step(input_energy=input_e, use_feedback=False)
-
-            # Apply feedback based on PREVIOUS coherence (decoupled)
-            if prev_coherence > SpectralOscillator.COHERENCE_HIGH:
-                osc_separated.coupling *= SpectralOscillator.COUPLING_DECAY
-            elif prev_coherence < SpectralOscillator.COHERENCE_LOW:
-                osc_separated.coupling *= SpectralOscillator.COUPLING_GROWTH
-            osc_separated.coupling = np.clip(
-                osc_separated.coupling,
-                SpectralOscillator.COUPLING_MIN,
-                SpectralOscillator.COUPLING_MAX,
+            coupling_diff = np.mean(
+                [
+                    abs(c["coupling"] - s["coupling"])
+                    for c, s in zip(coupled_trajectory, separated_trajectory)
+                ]
             )
 
-            current_coherence = osc_separated.get_coherence()
-            separated_trajectory.append(
-                {
-                    "coherence": current_coherence,
-                    "coupling": osc_separated.coupling,
-                    "phases": osc_separated.phases.copy(),
-                }
+            differences.append(
+                {"coherence_diff": coherence_diff, "coupling_diff": coupling_diff}
             )
-            prev_coherence = current_coherence
-
-        # Compare trajectories
-        coherence_diff = np.mean(
-            [
-                abs(c["coherence"] - s["coherence"])
-                for c, s in zip(coupled_trajectory, separated_trajectory)
-            ]
-        )
-        coupling_diff = np.mean(
-            [
-                abs(c["coupling"] - s["coupling"])
-                for c, s in zip(coupled_trajectory, separated_trajectory)
-            ]
-        )
-
-        differences.append(
-            {"coherence_diff": coherence_diff, "coupling_diff": coupling_diff}
-        )
 
     avg_coherence_diff = np.mean([d["coherence_diff"] for d in differences])
     avg_coupling_diff = np.mean([d["coupling_diff"] for d in differences])
@@ -361,7 +405,9 @@ def test_F2_separability(num_steps: int = 500, num_trials: int = 10) -> dict:
 # =============================================================================
 
 
-def test_F3_triviality_v2(num_trials: int = 20, num_steps: int = 500) -> dict:
+def test_F3_triviality_v2(
+    num_trials: int = 20, num_steps: int = 500, engine: str = "numpy", threads: int = 0
+) -> dict:
     """
     F3 v2: Does continuous state (phase) causally affect discrete state (K)?
 
@@ -379,31 +425,41 @@ def test_F3_triviality_v2(num_trials: int = 20, num_steps: int = 500) -> dict:
 
     divergences = []
 
-    for trial in range(num_trials):
-        # Two systems with different random phases
-        osc_A = SpectralOscillator(seed=trial * 2)
-        osc_B = SpectralOscillator(seed=trial * 2 + 1)
-
-        # Same input sequence for both
-        np.random.seed(trial + 10000)
-        inputs = [0.3 * np.sin(i * 0.1) + 0.3 for i in range(num_steps)]
-
-        couplings_A = []
-        couplings_B = []
-
-        for inp in inputs:
-            osc_A.evolve_step(input_energy=inp, use_feedback=True)
-            osc_B.evolve_step(input_energy=inp, use_feedback=True)
-            couplings_A.append(osc_A.coupling)
-            couplings_B.append(osc_B.coupling)
-
-        # Measure divergence
-        final_divergence = abs(couplings_A[-1] - couplings_B[-1])
-        trajectory_corr = np.corrcoef(couplings_A, couplings_B)[0, 1]
-
-        divergences.append(
-            {"final_divergence": final_divergence, "correlation": trajectory_corr}
+    if engine == "native":
+        trials = np.arange(num_trials)
+        final_divergence, correlation = native_engine().f3(
+            initial_phases(trials * 2), initial_phases(trials * 2 + 1), num_steps, threads
         )
+        divergences = [
+            {"final_divergence": d, "correlation": c}
+            for d, c in zip(final_divergence, correlation)
+        ]
+    else:
+        for trial in range(num_trials):
+            # Two systems with different random phases
+            osc_A = SpectralOscillator(seed=trial * 2)
+            osc_B = SpectralOscillator(seed=trial * 2 + 1)
+
+            # Same input sequence for both
+            np.random.seed(trial + 10000)
+            inputs = [0.3 * np.sin(i * 0.1) + 0.3 for i in range(num_steps)]
+
+            couplings_A = []
+            couplings_B = []
+
+            for inp in inputs:
+                osc_A.evolve_step(input_energy=inp, use_feedback=True)
+                osc_B.evolve_step(input_energy=inp, use_feedback=True)
+                couplings_A.append(osc_A.coupling)
+                couplings_B.append(osc_B.coupling)
+
+            # Measure divergence
+            final_divergence = abs(couplings_A[-1] - couplings_B[-1])
+            trajectory_corr = np.corrcoef(couplings_A, couplings_B)[0, 1]
+
+            divergences.append(
+                {"final_divergence": final_divergence, "correlation": trajectory_corr}
+            )
 
     avg_divergence = np.mean([d["final_divergence"] for d in divergences])
     avg_correlation = np.mean([d["correlation"] for d in divergences])
@@ -436,7 +492,9 @@ def test_F3_triviality_v2(num_trials: int = 20, num_steps: int = 500) -> dict:
     }
 
 
-def test_F3_triviality(num_steps: int = 500, num_k_values: int = 50) -> dict:
+def test_F3_triviality(
+    num_steps: int = 500, num_k_values: int = 50, engine: str = "numpy", threads: int = 0
+) -> dict:
     """
     F3: Can coherence feedback be replaced by constant K?
 
@@ -479,23 +537,33 @@ def test_F3_triviality(num_steps: int = 500, num_k_values: int = 50) -> dict:
         final_coherence = np.mean(coherences[-100:])  # Last 100 steps
         coherence_stability = 1.0 / (np.std(coherences[-100:]) + 0.01)
 
+        return score_metrics(final_coherence, coherence_stability, couplings[-1])
+
+    def score_metrics(final_coherence, coherence_stability, final_coupling) -> dict:
         # Ideal coherence is somewhere in middle (not 0, not 1)
         coherence_quality = 1.0 - abs(final_coherence - 0.5) * 2
-
-        # Combined score
-        score = coherence_quality * coherence_stability
-
         return {
             "final_coherence": final_coherence,
             "stability": coherence_stability,
             "quality": coherence_quality,
-            "score": score,
-            "final_coupling": couplings[-1],
+            "score": coherence_quality * coherence_stability,
+            "final_coupling": final_coupling,
         }
 
-    # Run with dynamic K
-    osc_dynamic = SpectralOscillator(seed=12345)
-    dynamic_result = run_and_score(osc_dynamic, num_steps, use_feedback=True)
+    k_values = np.linspace(0.01, 2.0, num_k_values)
+
+    if engine == "native":
+        # Run 0 is the dynamic K (NaN = coherence feedback)
+        runs = native_engine().f3_constant_k(
+            SpectralOscillator(seed=12345).phases, np.concatenate([[np.nan], k_values]),
+            num_steps, threads,
+        )
+        native_results = [score_metrics(*r) for r in zip(*runs)]
+        dynamic_result = native_results[0]
+    else:
+        # Run with dynamic K
+        osc_dynamic = SpectralOscillator(seed=12345)
+        dynamic_result = run_and_score(osc_dynamic, num_steps, use_feedback=True)
 
     print(f"\n  Dynamic K (coherence feedback):")
     print(f"    Final coherence: {dynamic_result['final_coherence']:.4f}")
@@ -504,14 +572,16 @@ def test_F3_triviality(num_steps: int = 500, num_k_values: int = 50) -> dict:
     print(f"    Final K: {dynamic_result['final_coupling']:.4f}")
 
     # Grid search over constant K values
-    k_values = np.linspace(0.01, 2.0, num_k_values)
     best_constant_result = None
     best_constant_k = None
     all_constant_results = []
 
-    for k in k_values:
-        osc_constant = SpectralOscillator(seed=12345)  # Same seed!
-        result = run_and_score(osc_constant, num_steps, use_feedback=False, fixed_k=k)
+    for i, k in enumerate(k_values):
+        if engine == "native":
+            result = native_results[1 + i]
+        else:
+            osc_constant = SpectralOscillator(seed=12345)  # Same seed!
+            result = run_and_score(osc_constant, num_steps, use_feedback=False, fixed_k=k)
         result["k"] = k
         all_constant_results.append(result)
 
@@ -692,14 +762,90 @@ def test_F4_simulation(n_oscillators_range: List[int] = None) -> dict:
 # =============================================================================
 
 
+# =============================================================================
+# Parity: native engine vs NumPy
+# =============================================================================
+
+PARITY_RUNS = {
+    "F1": (test_F1_reducibility, {"num_steps": 2000}),
+    "F2": (test_F2_separability, {"num_steps": 200, "num_trials": 4}),
+    "F3": (test_F3_triviality_v2, {"num_trials": 4, "num_steps": 200}),
+    "F3_old": (test_F3_triviality, {"num_steps": 200, "num_k_values": 8}),
+}
+
+
+def run_parity(threads: int = 0) -> bool:
+    """Run F1-F3 small on both engines; every verdict field must match."""
+    print("\n" + "=" * 70)
+    print("  PARITY: native engine vs NumPy")
+    print("=" * 70)
+    print()
+    print(f"  {'Test':6} | {'Fields':>6} | {'Bit-exact':>9} | {'Max rel diff':>12} | {'NumPy':>8} | {'Native':>8} | {'Speedup':>8}")
+    print(f"  {'-' * 6}-+-{'-' * 6}-+-{'-' * 9}-+-{'-' * 12}-+-{'-' * 8}-+-{'-' * 8}-+-{'-' * 8}")
+
+    all_ok = True
+    for name, (test_fn, kwargs) in PARITY_RUNS.items():
+        timings, results = [], []
+        for engine in ("numpy", "native"):
+            with contextlib.redirect_stdout(io.StringIO()):
+                t0 = time.perf_counter()
+                results.append(test_fn(**kwargs, engine=engine, threads=threads))
+                timings.append(time.perf_counter() - t0)
+
+        ref, nat = results
+        exact, worst, ok = 0, 0.0, True
+        for key, a in ref.items():
+            b = nat[key]
+            if isinstance(a, (bool, np.bool_, str)):
+                ok &= a == b
+                exact += a == b
+                continue
+            a, b = float(a), float(b)
+            if a == b or (np.isnan(a) and np.isnan(b)):
+                exact += 1
+                continue
+            rel = abs(a - b) / max(abs(a), abs(b))
+            worst = max(worst, rel)
+            ok &= rel < 1e-9  # np.corrcoef sums through BLAS in its own order
+        all_ok &= ok
+        print(
+            f"  {name:6} | {len(ref):>6} | {exact:>9} | {worst:>12.1e} | "
+            f"{timings[0]:>7.2f}s | {timings[1]:>7.3f}s | {timings[0] / timings[1]:>7.0f}x"
+            + ("" if ok else "  MISMATCH")
+        )
+
+    print(f"\n  Result: {'PASS' if all_ok else 'FAIL'}")
+    return all_ok
+
+
+# =============================================================================
+# Main
+# =============================================================================
+
+
 def main():
     parser = argparse.ArgumentParser(description="ETM Falsification Tests")
     parser.add_argument(
         "--test", choices=["F1", "F2", "F3", "F4"], help="Run specific test"
     )
     parser.add_argument("--all", action="store_true", help="Run all tests")
+    parser.add_argument(
+        "--engine", choices=["numpy", "native"], default="numpy",
+        help="Oscillator engine for F1-F3 (native: host/falsify, all cores)",
+    )
+    parser.add_argument(
+        "--threads", type=int, default=0, help="Native engine threads (0 = all cores)"
+    )
+    parser.add_argument("--steps", type=int, help="Override steps (F1 total, per trial elsewhere)")
+    parser.add_argument("--trials", type=int, help="Override trials (F2, F3) / K values (F3_old)")
+    parser.add_argument(
+        "--parity", action="store_true", help="Check the native engine against NumPy"
+    )
     args = parser.parse_args()
 
+    if args.parity:
+        raise SystemExit(0 if run_parity(args.threads) else 1)
+
     tests = {
         "F1": test_F1_reducibility,
         "F2": test_F2_separability,
@@ -708,20 +854,29 @@ def main():
         "F4": test_F4_simulation,
     }
 
+    def run(name):
+        kwargs = {}
+        if name != "F4":
+            kwargs = {"engine": args.engine, "threads": args.threads}
+            if args.steps:
+                kwargs["num_steps"] = args.steps
+            if args.trials:
+                kwargs["num_k_values" if name == "F3_old" else "num_trials"] = args.trials
+            if name == "F1":
+                kwargs.pop("num_trials", None)
+        t0 = time.perf_counter()
+        result = tests[name](**kwargs)
+        result["seconds"] = time.perf_counter() - t0
+        return result
+
     results = []
 
     if args.test:
-        result = tests[args.test]()
-        results.append(result)
-    elif args.all:
-        for name, test_fn in tests.items():
-            result = test_fn()
-            results.append(result)
+        results.append(run(args.test))
     else:
-        # Default: run all
-        for name, test_fn in tests.items():
-            result = test_fn()
-            results.append(result)
+        # --all, and the default: run all
+        for name in tests:
+            results.append(run(name))
 
     # Summary
     print("\n")
@@ -729,15 +884,17 @@ def main():
     print("  FALSIFICATION SUMMARY")
     print("=" * 70)
     print()
-    print("  Test | Result")
-    print("  -----+------------------")
+    print(f"  Engine: {args.engine}")
+    print()
+    print("  Test | Result          | Time")
+    print("  -----+-----------------+---------")
 
     any_falsified = False
     for r in results:
         status = "FALSIFIED" if r["falsified"] else "NOT FALSIFIED"
         if r["falsified"]:
             any_falsified = True
-        print(f"  {r['test']:4} | {status}")
+        print(f"  {r['test']:4} | {status:15} | {r['seconds']:6.2f}s")
 
     print()
     if any_falsified:
@@ -0,0 +1,119 @@
+"""
+ctypes bindings for host/falsify/falsify_engine.c
+
+The native engine behind `falsify_etm.py --engine native`. Build it with
+the host tree:
+
+    cmake -S host -B build-host && cmake --build build-host --target falsify_engine
+
+The library is looked up in $FALSIFY_ENGINE, then build-host/ at the
+repository root.
+"""
+
+import ctypes
+import math
+import os
+from pathlib import Path
+
+import numpy as np
+
+_REPO = Path(__file__).resolve().parent.parent
+_NAMES = ["libfalsify_engine.so", "libfalsify_engine.dylib", "falsify_engine.dll"]
+
+_f64 = np.ctypeslib.ndpointer(dtype=np.float64, flags="C_CONTIGUOUS")
+_u64p = ctypes.POINTER(ctypes.c_uint64)
+_int = ctypes.c_int
+
+_lib = None
+
+
+def _load():
+    global _lib
+    if _lib is not None:
+        return _lib
+    candidates = []
+    if os.environ.get("FALSIFY_ENGINE"):
+        candidates.append(Path(os.environ["FALSIFY_ENGINE"]))
+    candidates += [_REPO / "build-host" / name for name in _NAMES]
+    for path in candidates:
+        if path.is_file():
+            break
+    else:
+        raise RuntimeError(
+            "falsify_engine library not found; build it with\n"
+            "  cmake -S host -B build-host && cmake --build build-host --target falsify_engine\n"
+            "or point FALSIFY_ENGINE at it"
+        )
+
+    lib = ctypes.CDLL(str(path))
+    lib.fe_set_numpy_cabs.argtypes = [_int]
+    lib.fe_set_numpy_cabs.restype = None
+    lib.fe_set_numpy_cabs(_numpy_cabs_is_scaled())
+    lib.fe_f1_reducibility.argtypes = [_f64, _f64, _int, _int, _int, _int, _u64p, _u64p]
+    lib.fe_f2_separability.argtypes = [_f64, _int, _int, _int, _f64, _f64]
+    lib.fe_f3_causality.argtypes = [_f64, _f64, _int, _int, _int, _f64, _f64]
+    lib.fe_f3_constant_k.argtypes = [_f64, _f64, _int, _int, _int, _f64, _f64, _f64]
+    for fn in (lib.fe_f1_reducibility, lib.fe_f2_separability,
+               lib.fe_f3_causality, lib.fe_f3_constant_k):
+        fn.restype = _int
+    _lib = lib
+    return lib
+
+
+def _numpy_cabs_is_scaled() -> int:
+    """Does this NumPy take complex abs by hypot() or by its SIMD loop?"""
+    rng = np.random.default_rng(0)
+    z = rng.standard_normal(256) + 1j * rng.standard_normal(256)
+    return int(any(float(a) != math.hypot(v.real, v.imag) for a, v in zip(np.abs(z), z)))
+
+
+def _phases(p) -> np.ndarray:
+    return np.ascontiguousarray(p, dtype=np.float64).reshape(-1, 16)
+
+
+def _check(ret: int, name: str):
+    if ret != 0:
+        raise RuntimeError(f"{name} failed (bad arguments or out of memory)")
+
+
+def f1(phases, inputs, steps_per_input: int, precision_bits: int, threads: int = 0):
+    """(unique_states, transitions) over one run per input energy."""
+    lib = _load()
+    inputs = np.ascontiguousarray(inputs, dtype=np.float64)
+    unique, transitions = ctypes.c_uint64(), ctypes.c_uint64()
+    _check(lib.fe_f1_reducibility(_phases(phases), inputs, len(inputs), steps_per_input,
+                                  precision_bits, threads, ctypes.byref(unique),
+                                  ctypes.byref(transitions)), "fe_f1_reducibility")
+    return unique.value, transitions.value
+
+
+def f2(phases, num_steps: int, threads: int = 0):
+    """Per-trial (coherence_diff, coupling_diff) arrays."""
+    lib = _load()
+    p = _phases(phases)
+    coherence, coupling = np.empty(len(p)), np.empty(len(p))
+    _check(lib.fe_f2_separability(p, len(p), num_steps, threads, coherence, coupling),
+           "fe_f2_separability")
+    return coherence, coupling
+
+
+def f3(phases_a, phases_b, num_steps: int, threads: int = 0):
+    """Per-trial (final_divergence, correlation) arrays."""
+    lib = _load()
+    a, b = _phases(phases_a), _phases(phases_b)
+    if len(a) != len(b):
+        raise ValueError("phases_a and phases_b need the same number of trials")
+    divergence, correlation = np.empty(len(a)), np.empty(len(a))
+    _check(lib.fe_f3_causality(a, b, len(a), num_steps, threads, divergence, correlation),
+           "fe_f3_causality")
+    return divergence, correlation
+
+
+def f3_constant_k(phases, k_values, num_steps: int, threads: int = 0):
+    """Per-run (final_coherence, stability, final_coupling); NaN K = feedback."""
+    lib = _load()
+    k = np.ascontiguousarray(k_values, dtype=np.float64)
+    coherence, stability, coupling = np.empty(len(k)), np.empty(len(k)), np.empty(len(k))
+    _check(lib.fe_f3_constant_k(_phases(phases), k, len(k), num_steps, threads,
+                                coherence, stability, coupling), "fe_f3_constant_k")
+    return coherence, stability, coupling
@@ -9,16 +9,25 @@ Requirements:
     - ESP32-C6 connected via USB
     - ESP-IDF installed and sourced
     - pyserial installed
+    (--host needs none of these, only a host build: see host/README.md)
 
 Usage:
     python verify_claims.py              # Run all tests
     python verify_claims.py --demo 1     # Run specific demo
     python verify_claims.py --port /dev/ttyUSB0  # Specify port
+    python verify_claims.py --host build-host    # Run the host build instead
+    python verify_claims.py --bench-out runs.jsonl  # Save benchmark results
+    python verify_claims.py --record     # Add them to bench_store.py's store
+
+Benchmarks come from the firmware's pulse_bench.h harness, which prints
+one "BENCH {...}" JSON line per case (min/p50/p99/max ns per iteration,
+throughput). They are collected from the output as is, not scraped from
+the human-readable tables.
 """
 
 import argparse
+import json
 import subprocess
-import serial
 import time
 import re
 import sys
@@ -31,13 +40,40 @@ BAUD_RATE = 115200
 FIRMWARE_DIR = Path(__file__).parent.parent / "firmware"
 TIMEOUT_FLASH = 120  # seconds
 TIMEOUT_MONITOR = 30  # seconds
+BENCH_PREFIX = "BENCH "
+
+# Host build targets (host/CMakeLists.txt); demo 01 has none
+HOST_TARGETS = {
+    2: "parallel_dot",
+    3: "spectral_oscillator",
+    4: "equilibrium_prop",
+}
+
+
+def parse_benchmarks(output: str) -> List[dict]:
+    """Benchmark records from pulse_bench.h's BENCH lines."""
+    records = []
+    for line in output.splitlines():
+        line = line.strip()
+        if not line.startswith(BENCH_PREFIX):
+            continue
+        try:
+            records.append(json.loads(line[len(BENCH_PREFIX):]))
+        except json.JSONDecodeError:
+            pass  # Line cut off by the capture window
+    return records
+
+
+def format_params(params: dict) -> str:
+    return ",".join(f"{k}={v}" for k, v in params.items())
 
 
 class ClaimVerifier:
     """Verifies claims by flashing and monitoring firmware."""
 
-    def __init__(self, port: str = DEFAULT_PORT):
+    def __init__(self, port: str = DEFAULT_PORT, host_build: Optional[Path] = None):
         self.port = port
+        self.host_build = host_build.resolve() if host_build else None
         self.results: Dict[str, dict] = {}
 
     def flash_firmware(self, demo_dir: Path) -> bool:
@@ -70,6 +106,7 @@ class ClaimVerifier:
     def capture_output(self, duration: float = 15.0) -> str:
         """Capture serial output from device."""
         print(f"  Capturing output for {duration}s...")
+        import serial  # Only needed with a board
 
         try:
             ser = serial.Serial(self.port, BAUD_RATE, timeout=1)
@@ -97,6 +134,22 @@ class ClaimVerifier:
             print(f"  ERROR: Serial error: {e}")
             return ""
 
+    def run_host(self, target: str) -> str:
+        """Run a host build target (in the build directory) and return its output."""
+        print(f"  Running host build {target}...")
+        try:
+            result = subprocess.run(
+                [str(self.host_build / target)],
+                cwd=self.host_build,
+                capture_output=True,
+                text=True,
+                timeout=TIMEOUT_FLASH,
+            )
+            return result.stdout
+        except (subprocess.TimeoutExpired, FileNotFoundError) as e:
+            print(f"  ERROR: {e}")
+            return ""
+
     def verify_demo_01(self, output: str) -> Tuple[bool, str]:
         """
         Verify Claim 1: Pulse counting performs addition.
@@ -311,24 +364,32 @@ class ClaimVerifier:
             "verified": False,
             "message": "",
             "output": "",
+            "benchmarks": [],
         }
 
-        demo_dir = FIRMWARE_DIR / demo_dirs[demo_num]
+        if self.host_build:
+            if demo_num not in HOST_TARGETS:
+                result["message"] = "No host build of this demo"
+                return result
+            output = self.run_host(HOST_TARGETS[demo_num])
+        else:
+            demo_dir = FIRMWARE_DIR / demo_dirs[demo_num]
 
-        if not demo_dir.exists():
-            result["message"] = f"Demo directory not found: {demo_dir}"
-            return result
+            if not demo_dir.exists():
+                result["message"] = f"Demo directory not found: {demo_dir}"
+                return result
 
-        # Flash
-        if not self.flash_firmware(demo_dir):
-            result["message"] = "Flash failed"
-            return result
-        result["flashed"] = True
+            # Flash
+            if not self.flash_firmware(demo_dir):
+                result["message"] = "Flash failed"
+                return result
+            result["flashed"] = True
 
-        # Capture output
-        duration = 20 if demo_num == 4 else 15  # EP needs more time
-        output = self.capture_output(duration)
+            # Capture output
+            duration = 30 if demo_num == 4 else 15  # EP needs more time
+            output = self.capture_output(duration)
         result["output"] = output
+        result["benchmarks"] = parse_benchmarks(output)
 
         if not output:
             result["message"] = "No output captured"
@@ -345,7 +406,8 @@ class ClaimVerifier:
         """Run all demos and return results."""
         results = []
 
-        for demo_num in [1, 2, 3, 4]:
+        demos = sorted(HOST_TARGETS) if self.host_build else [1, 2, 3, 4]
+        for demo_num in demos:
             print(f"\n{'=' * 60}")
             print(f"  DEMO {demo_num}")
             print(f"{'=' * 60}")
@@ -356,9 +418,28 @@ class ClaimVerifier:
             status = "VERIFIED" if result["verified"] else "FAILED"
             print(f"\n  Result: {status}")
             print(f"  {result['message']}")
+            self.print_benchmarks(result)
 
         return results
 
+    def print_benchmarks(self, result: dict):
+        """One line per benchmark case: median time and throughput."""
+        for b in result["benchmarks"]:
+            name = f"{b['case']} [{format_params(b['params'])}]" if b["params"] else b["case"]
+            line = f"    {name:44s} p50 {b['p50_ns'] / 1e3:10.3f} us"
+            if "throughput" in b:
+                line += f"  {b['throughput']:12.0f} {b['unit']}"
+            print(line)
+
+    def write_benchmarks(self, results: List[dict], path: Path):
+        """Append every benchmark record, one JSON object per line."""
+        with open(path, "a") as f:
+            for r in results:
+                for b in r["benchmarks"]:
+                    f.write(json.dumps(b) + "\n")
+        count = sum(len(r["benchmarks"]) for r in results)
+        print(f"  {count} benchmark results appended to {path}")
+
     def print_summary(self, results: List[dict]):
         """Print summary table."""
         print("\n")
@@ -402,6 +483,25 @@ def main():
     parser.add_argument(
         "--list", action="store_true", help="List claims without running tests"
     )
+    parser.add_argument(
+        "--host",
+        type=Path,
+        metavar="BUILD_DIR",
+        help="Run the host build in BUILD_DIR instead of flashing a board",
+    )
+    parser.add_argument(
+        "--bench-out",
+        type=Path,
+        metavar="FILE",
+        help="Append benchmark results to FILE as JSON lines",
+    )
+    parser.add_argument(
+        "--record",
+        nargs="?",
+        const="default",
+        metavar="CONFIG",
+        help="Store benchmark results as a run (see bench_store.py), labelled CONFIG",
+    )
     args = parser.parse_args()
 
     if args.list:
@@ -416,16 +516,24 @@ def main():
         print("Run with --demo N to test specific claim, or no args for all.")
         return
 
-    verifier = ClaimVerifier(port=args.port)
+    verifier = ClaimVerifier(port=args.port, host_build=args.host)
 
     if args.demo:
         print(f"\nRunning Demo {args.demo}...")
         result = verifier.run_demo(args.demo)
-        verifier.print_summary([result])
+        verifier.print_benchmarks(result)
+        results = [result]
     else:
         print("\nRunning all demos...")
         results = verifier.run_all()
-        verifier.print_summary(results)
+    verifier.print_summary(results)
+    if args.bench_out:
+        verifier.write_benchmarks(results, args.bench_out)
+    if args.record:
+        import bench_store
+        records = [b for r in results for b in r["benchmarks"]]
+        run = bench_store.record(bench_store.DEFAULT_STORE, records, args.record, None)
+        print(f"  {len(records)} benchmark results stored as run {run}")
 
 
 if __name__ == "__main__":